@@ -25,6 +25,12 @@ module spi_master_tb();
 
     wire cs_b, mosi, sclk, miso;
 
+    `ifdef VSL_BFM
+    /* Clock of the SPI master bus-functional model (Verilator integration
+    plugin, see verilator_bfm folder) - Not used by the design */
+    reg bfm_clk = 1'b0;
+    `endif
+
     /* SPI master - unit under test */
     spi_master i_spi_master (
         .cs_b   (cs_b),
@@ -34,15 +34,19 @@ SOFTWARE.
 
 int main(int argc, char** argv, char**) {
 
-    //Get arguments for port number and timeout
+    //Get arguments for port number, timeout and background socket I/O thread
     int port_number {5100};
     int timeout {5};
+    bool io_thread {false};
     if (argc > 1) {
         port_number = std::atoi(argv[1]);
     }
     if (argc > 2) {
         timeout = std::atoi(argv[2]);
     }
+    if (argc > 3) {
+        io_thread = (0 != std::atoi(argv[3]));
+    }
 
     // Setup context, defaults, and parse command line
     Verilated::debug(0);
@@ -81,6 +85,9 @@ int main(int argc, char** argv, char**) {
     vslx.register_event("spi_master_tb.i_spi_master.end_transaction",
         &topp->spi_master_tb->i_spi_master->end_transaction);
 
+    // Use a background socket I/O thread (optional)
+    vslx.set_io_thread(io_thread);
+
     // Run simulation
     int retval = vslx.run();
 
@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2026 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "verilated.h"
+#include "vsl.h"
+#include "Vspi_master_tb.h"
+#include "Vspi_master_tb__Syms.h"
+
+#include <cstdlib>
+#include <memory>
+
+//======================
+
+int main(int argc, char** argv, char**) {
+
+    //Get arguments for port number and timeout
+    int port_number {5100};
+    int timeout {5};
+    if (argc > 1) {
+        port_number = std::atoi(argv[1]);
+    }
+    if (argc > 2) {
+        timeout = std::atoi(argv[2]);
+    }
+
+    // Setup context, defaults, and parse command line
+    Verilated::debug(0);
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+
+    // Construct the Verilated model, from Vtop.h generated from Verilating
+    const std::unique_ptr<Vspi_master_tb> topp {new Vspi_master_tb{contextp.get()}};
+
+    // Create top VSL instance
+    vsl::VslInteg<Vspi_master_tb> vslx{topp.get(), port_number, timeout};
+
+    // Clock of the SPI master BFM - One SPI clock phase per rising edge, i.e.
+    // 10 Mbps as with the SPI master verilog model
+    vslx.register_clock("spi_master_tb.bfm_clk",
+        &topp->spi_master_tb->bfm_clk,
+        0.05, "us", 0.5
+    );
+
+    // SPI pins
+    vslx.register_scalar("spi_master_tb.cs_b",
+        &topp->spi_master_tb->i_spi_master->cs_b,
+        VLVT_UINT8, 1u);
+    vslx.register_scalar("spi_master_tb.sclk",
+        &topp->spi_master_tb->i_spi_master->sclk,
+        VLVT_UINT8, 1u);
+    vslx.register_scalar("spi_master_tb.mosi",
+        &topp->spi_master_tb->i_spi_master->mosi,
+        VLVT_UINT8, 1u);
+    vslx.register_scalar("spi_master_tb.miso",
+        &topp->spi_master_tb->i_spi_slave->miso,
+        VLVT_UINT8, 1u);
+
+    // SPI master bus-functional model, with commands "spi.<command>"
+    vsl::VslSpiPins pins {
+        "spi_master_tb.cs_b",
+        "spi_master_tb.sclk",
+        "spi_master_tb.mosi",
+        "spi_master_tb.miso"
+    };
+    if (0 > vslx.register_plugin(std::make_unique<vsl::VslSpiMaster>(
+        "spi", "spi_master_tb.bfm_clk", pins))) {
+        return 1;
+    }
+
+    // Run simulation
+    int retval = vslx.run();
+
+    return retval;
+}
@@ -0,0 +1,163 @@
+from verisocks.verisocks import Verisocks
+from verisocks.utils import setup_sim_run, find_free_port
+import logging
+import pytest
+import socket
+import random
+import time
+from os.path import join, dirname, abspath, relpath
+
+# Parameters
+HOST = socket.gethostbyname("localhost")
+TIMEOUT = 10
+NUM_BYTES = 8                   # Bytes per frame, including the CRC byte
+HALF_PERIOD = 0.05              # SPI clock half period, in us (10 Mbps)
+CS_B = "spi_master_tb.cs_b"
+SCLK = "spi_master_tb.sclk"
+MOSI = "spi_master_tb.mosi"
+MISO = "spi_master_tb.miso"
+cwd = relpath(dirname(abspath(__file__)))
+
+
+def setup_test(port=5100, timeout=10):
+    elab_cmd = ["make", "-C", cwd]
+    sim_cmd = [
+        join(cwd, "Vspi_master_tb"),
+        f"{port}",
+        f"{timeout}"
+    ]
+    pop = setup_sim_run(elab_cmd, sim_cmd, capture_output=True)
+    return pop
+
+
+def send_spi_bitbang(vs, tx_bytes):
+    """Transfers an SPI frame by toggling the SPI pins from the client, bit by
+    bit (mode 0, most-significant bit first)
+
+    Args:
+        * vs: Verisocks instance, connected
+        * tx_bytes: List of bytes to transmit
+    Returns:
+        * rx_bytes: List of bytes received from the SPI slave
+    """
+    vs.set(path=CS_B, value=0)
+    rx_bytes = []
+    for tx_byte in tx_bytes:
+        rx_byte = 0
+        for i in range(8):
+            vs.set(path=MOSI, value=(tx_byte >> (7 - i)) & 1)
+            vs.run(cb="for_time", time=HALF_PERIOD, time_unit="us")
+            miso = vs.get(sel="value", path=MISO)["value"]
+            rx_byte = (rx_byte << 1) | miso
+            vs.set(path=SCLK, value=1)
+            vs.run(cb="for_time", time=HALF_PERIOD, time_unit="us")
+            vs.set(path=SCLK, value=0)
+        rx_bytes.append(rx_byte)
+    vs.run(cb="for_time", time=HALF_PERIOD, time_unit="us")
+    vs.set(path=CS_B, value=1)
+    vs.run(cb="for_time", time=HALF_PERIOD, time_unit="us")
+    return rx_bytes
+
+
+def send_spi_bfm(vs, tx_bytes):
+    """Transfers an SPI frame with the SPI master bus-functional model, with a
+    single command
+
+    Args:
+        * vs: Verisocks instance, connected
+        * tx_bytes: List of bytes to transmit
+    Returns:
+        * rx_bytes: List of bytes received from the SPI slave
+    """
+    answer = vs.plugin("spi", "write", data=tx_bytes)
+    assert answer["type"] == "ack"
+    return answer["data"]
+
+
+@pytest.fixture
+def vs():
+    # Set up simulation and launch it as a separate process
+    port = find_free_port()
+    setup_test(port, TIMEOUT)
+    _vs = Verisocks(HOST, port)
+    _vs.connect()
+    yield _vs
+    # Teardown
+    try:
+        _vs.finish()
+    except ConnectionError:
+        logging.warning("Connection error - Finish command not possible")
+    _vs.close()
+
+
+def get_random_tx_bytes():
+    return [random.randint(0, 255) for i in range(NUM_BYTES)]
+
+
+def check_echo(vs, send_spi, num_frames):
+    """Checks that the slave returns the previous frame"""
+    rx = send_spi(vs, get_random_tx_bytes())
+    assert rx == [0]*(NUM_BYTES - 1) + [0x95]
+    tx = get_random_tx_bytes()
+    send_spi(vs, tx)
+    for i in range(num_frames):
+        tx_expected = tx
+        tx = get_random_tx_bytes()
+        rx = send_spi(vs, tx)
+        assert rx == tx_expected
+
+
+def bench(vs, send_spi, num_frames):
+    """Returns the average wall-clock time per frame, in ms"""
+    t_start = time.perf_counter()
+    for i in range(num_frames):
+        send_spi(vs, get_random_tx_bytes())
+    return 1.0e3*(time.perf_counter() - t_start)/num_frames
+
+
+def test_spi_bitbang(vs):
+    random.seed(57383)
+    vs.run(cb="for_time", time=1, time_unit="us")
+    check_echo(vs, send_spi_bitbang, 5)
+
+
+def test_spi_bfm(vs):
+    random.seed(57383)
+    vs.run(cb="for_time", time=1, time_unit="us")
+    t_start = vs.get(sel="sim_time")["time"]
+    check_echo(vs, send_spi_bfm, 50)
+    # One SPI clock phase per BFM clock edge, i.e. 16 edges per byte plus the
+    # chip select setup and hold edges. Each frame starts on the edge
+    # following the end of the previous one.
+    num_edges = 52*(16*NUM_BYTES + 3) - 1
+    t_sim = vs.get(sel="sim_time")["time"] - t_start
+    assert t_sim == pytest.approx(num_edges*HALF_PERIOD*1e-6)
+
+
+def test_spi_bench(vs):
+    """Compares bit-banged and BFM-driven transfers of the same frames"""
+    random.seed(57383)
+    vs.run(cb="for_time", time=1, time_unit="us")
+    t_bitbang = bench(vs, send_spi_bitbang, 5)
+    t_bfm = bench(vs, send_spi_bfm, 50)
+    logging.info(f"Bit-banged transfer: {t_bitbang:.3f} ms/frame")
+    logging.info(f"BFM-driven transfer: {t_bfm:.3f} ms/frame")
+    logging.info(f"Speed-up: {t_bitbang/t_bfm:.1f}")
+    assert t_bfm < t_bitbang
+
+
+if __name__ == "__main__":
+
+    port = find_free_port()
+    setup_test(port, TIMEOUT)
+    with Verisocks(HOST, port) as vs_cli:
+        random.seed(57383)
+        vs_cli.run(cb="for_time", time=1, time_unit="us")
+        for num_frames in (10, 100):
+            t_bitbang = bench(vs_cli, send_spi_bitbang, num_frames)
+            t_bfm = bench(vs_cli, send_spi_bfm, num_frames)
+            print(f"{num_frames} frames of {NUM_BYTES} bytes - "
+                  f"bit-banged: {t_bitbang:.3f} ms/frame, "
+                  f"BFM: {t_bfm:.3f} ms/frame, "
+                  f"speed-up: {t_bitbang/t_bfm:.1f}")
+        vs_cli.finish()
@@ -1,5 +1,5 @@
 from verisocks.verisocks import Verisocks
-from verisocks.utils import setup_sim_run, find_free_port
+from verisocks.utils import setup_sim_run, find_free_port, write_vectors
 import logging
 import pytest
 import socket
@@ -113,6 +113,131 @@ def test_counter(vs):
 	assert(answer["value"] == counter_value + 50)
 
 
+
+def test_sampler(vs):
+
+	# Release the reset
+	answer = vs.run("for_time", time=1.1, time_unit="us")
+	assert(answer["type"] == "ack")
+	answer = vs.set("arst_b", value=1)
+	assert(answer["type"] == "ack")
+
+	# Sample the counter on each rising edge of the clock
+	answer = vs.configure_sampler("clk", ["count"], capacity=64)
+	assert(answer["type"] == "ack")
+	assert(answer["columns"] == [{"path": "count", "dtype": "uint", "size": 2}])
+
+	# Run for 10 clock periods (1.4 us)
+	answer = vs.run("for_time", time=13.3, time_unit="us")
+	assert(answer["type"] == "ack")
+
+	# The values are sampled as seen by the design on each edge
+	samples = vs.get_samples()
+	assert(samples["count"] == 10)
+	assert(samples["dropped"] == 0)
+	assert(samples["value"]["count"] == list(range(10)))
+
+	# The buffers have been reset
+	samples = vs.get_samples()
+	assert(samples["count"] == 0)
+
+	# Edges beyond the capacity are dropped
+	answer = vs.configure_sampler("clk", ["count"], capacity=4)
+	assert(answer["type"] == "ack")
+	answer = vs.run("for_time", time=14, time_unit="us")
+	assert(answer["type"] == "ack")
+	samples = vs.get_samples()
+	assert(samples["count"] == 4)
+	assert(samples["dropped"] == 6)
+	assert(samples["value"]["count"] == [10, 11, 12, 13])
+
+	# Disarm the sampler
+	answer = vs.configure_sampler("clk", [], capacity=0)
+	assert(answer["type"] == "ack")
+
+
+def test_recorder(vs):
+
+	# Release the reset
+	answer = vs.run("for_time", time=1.1, time_unit="us")
+	assert(answer["type"] == "ack")
+	answer = vs.set("arst_b", value=1)
+	assert(answer["type"] == "ack")
+
+	# Keep the last 8 values, up to 3 samples after the counter reaches 20
+	answer = vs.configure_recorder("clk", ["count"], depth=8, post=3,
+		expr="count == 20")
+	assert(answer["type"] == "ack")
+	assert(answer["columns"] == [{"path": "count", "dtype": "uint", "size": 2}])
+
+	# Run for 40 clock periods (1.4 us), well beyond the trigger
+	answer = vs.run("for_time", time=56, time_unit="us")
+	assert(answer["type"] == "ack")
+	window = vs.get_recorder()
+	assert(window["count"] == 8)
+	assert(window["trigger"] == 4)
+	assert(window["frozen"])
+	assert(window["value"]["count"] == list(range(16, 24)))
+
+	# Manual trigger, taken on the next edge
+	answer = vs.configure_recorder("clk", ["count"], depth=4, post=1)
+	assert(answer["type"] == "ack")
+	answer = vs.run("for_time", time=14, time_unit="us")
+	assert(answer["type"] == "ack")
+	window = vs.get_recorder()
+	assert(window["count"] == 4)
+	assert(window["trigger"] == -1)
+	assert(not window["frozen"])
+	answer = vs.trigger_recorder()
+	assert(answer["type"] == "ack")
+	answer = vs.run("for_time", time=14, time_unit="us")
+	assert(answer["type"] == "ack")
+	window = vs.get_recorder()
+	assert(window["trigger"] == 2)
+	assert(window["frozen"])
+	values = window["value"]["count"]
+	assert(values == list(range(values[0], values[0] + 4)))
+
+	# Disarm the recorder
+	answer = vs.configure_recorder("clk", [], depth=0)
+	assert(answer["type"] == "ack")
+
+
+def test_play(vs, tmp_path):
+
+	# Reset released for 10 cycles, asserted for 1 cycle, released again
+	arst_b = [1]*10 + [0] + [1]*5
+	vec_path = str(tmp_path / "arst_b.vec")
+	write_vectors(vec_path, [{"path": "arst_b", "size": 1}],
+		[(value,) for value in arst_b])
+
+	answer = vs.run("for_time", time=1.1, time_unit="us")
+	assert(answer["type"] == "ack")
+	answer = vs.configure_sampler("clk", ["count"], capacity=64)
+	assert(answer["type"] == "ack")
+
+	# One row per rising edge of the clock, the first one right away
+	answer = vs.play(vec_path, clock="clk")
+	assert(answer["type"] == "ack")
+	assert(answer["rows"] == len(arst_b))
+	assert(not answer["triggered"])
+
+	# Each row is seen by the design on the next edge
+	samples = vs.get_samples()
+	assert(samples["value"]["count"] == list(range(10)) + [0, 0, 1, 2, 3, 4])
+	answer = vs.get(sel="value", path="count")
+	assert(answer["value"] == 5)
+
+	# Stop before the end of the file once the counter reaches 20
+	write_vectors(vec_path, [{"path": "arst_b", "size": 1}], [(1,)]*100)
+	answer = vs.play(vec_path, clock="clk", expr="count == 20")
+	assert(answer["type"] == "ack")
+	assert(answer["triggered"])
+	assert(answer["rows"] < 100)
+	answer = vs.get(sel="value", path="count")
+	assert(answer["value"] == 20)
+
+
 if __name__ == "__main__":
     port = find_free_port()
     setup_test(port, TIMEOUT)
@@ -0,0 +1,110 @@
+from verisocks.verisocks import Verisocks, VerisocksError
+from verisocks.utils import setup_sim_run, find_free_port
+import logging
+import pytest
+import socket
+from os.path import join, dirname, abspath, relpath
+
+# Parameters
+HOST = socket.gethostbyname("localhost")
+TIMEOUT = 10
+NUM_INSTANCES = 4
+cwd = relpath(dirname(abspath(__file__)))
+
+
+def setup_test(port=5100, timeout=10, num_instances=NUM_INSTANCES):
+    elab_cmd = ["make", "-C", cwd]
+    sim_cmd = [
+        join(cwd, "Vcounter"),
+        f"{port}",
+        f"{timeout}",
+        f"{num_instances}"
+    ]
+    pop = setup_sim_run(elab_cmd, sim_cmd, capture_output=True)
+    return pop
+
+
+@pytest.fixture
+def vs():
+    # Set up simulation and launch it as a separate process
+    port = find_free_port()
+    setup_test(port, TIMEOUT)
+    _vs = Verisocks(HOST, port)
+    _vs.connect()
+    yield _vs
+    # Teardown
+    try:
+        _vs.finish()
+    except ConnectionError:
+        logging.warning("Connection error - Finish command not possible")
+    _vs.close()
+
+
+def test_ensemble(vs):
+
+    answer = vs.get("sim_info")
+    assert answer["type"] == "result"
+    assert answer["instances"] == NUM_INSTANCES
+
+    # Release the reset of all the instances at once
+    answer = vs.run("for_time", time=1.1, time_unit="us")
+    assert answer["type"] == "ack"
+    assert answer["finished"] == [False]*NUM_INSTANCES
+    answer = vs.set("arst_b", value=1)
+    assert answer["type"] == "ack"
+
+    # All instances are simulated up to the same time
+    t1_us = 100
+    answer = vs.run("for_time", time=t1_us, time_unit="us")
+    assert answer["type"] == "ack"
+    answer = vs.get("sim_time")
+    assert answer["type"] == "result"
+    assert answer["time"] == pytest.approx([101.1e-6]*NUM_INSTANCES)
+
+    # Vectorized get, one value per instance
+    answer = vs.get("value", path="count")
+    assert answer["type"] == "result"
+    counts = answer["value"]
+    assert len(counts) == NUM_INSTANCES
+    assert counts == [counts[0]]*NUM_INSTANCES
+
+    # Per-instance values, then one array per path
+    answer = vs.set("arst_b", values=[k % 2 for k in range(NUM_INSTANCES)])
+    assert answer["type"] == "ack"
+    answer = vs.run("for_time", time=10, time_unit="us")
+    assert answer["type"] == "ack"
+    answer = vs.get("value", path=["arst_b", "count"])
+    assert answer["type"] == "result"
+    assert answer["value"]["arst_b"] == \
+        [k % 2 for k in range(NUM_INSTANCES)]
+    for k, count in enumerate(answer["value"]["count"]):
+        if k % 2:
+            assert count > counts[k]
+        else:
+            assert count == 0
+
+    # Wrong number of per-instance values
+    with pytest.raises(VerisocksError):
+        vs.set("arst_b", values=[1])
+
+    # An invalid value leaves all the instances unmodified
+    with pytest.raises(VerisocksError):
+        vs.set("arst_b", values=[0]*(NUM_INSTANCES - 1) + ["zz"])
+    answer = vs.get("value", path="arst_b")
+    assert answer["type"] == "result"
+    assert answer["value"] == [k % 2 for k in range(NUM_INSTANCES)]
+
+    # Commands which are not supported in ensemble mode
+    with pytest.raises(VerisocksError):
+        vs.run("to_next")
+    with pytest.raises(VerisocksError):
+        vs.send(command="fork")
+
+
+if __name__ == "__main__":
+    port = find_free_port()
+    setup_test(port, TIMEOUT)
+    with Verisocks(HOST, port) as vs_cli:
+        test_ensemble(vs_cli)
+
+# EOF
@@ -0,0 +1,73 @@
+/*
+Copyright (c) 2026 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "verilated.h"
+#include "vsl.h"
+#include "Vcounter.h"
+#include "Vcounter__Syms.h"
+
+#include <cstdlib>
+
+//======================
+
+int main(int argc, char** argv, char**) {
+
+    //Get arguments for port number, timeout and number of instances
+    int port_number {5100};
+    int timeout {5};
+    size_t num_instances {4};
+    if (argc > 1) {
+        port_number = std::atoi(argv[1]);
+    }
+    if (argc > 2) {
+        timeout = std::atoi(argv[2]);
+    }
+    if (argc > 3) {
+        num_instances = std::strtoul(argv[3], nullptr, 10);
+    }
+
+    // Setup defaults
+    Verilated::debug(0);
+
+    // Create the ensemble, with its own context and model for each instance
+    vsl::VslEnsemble<Vcounter> vslx{num_instances, port_number, timeout};
+
+    // Register public variables of each instance
+    for (size_t k = 0; k < vslx.size(); k++) {
+        Vcounter* topp = vslx.model(k);
+        vslx.instance(k).register_clock("clk",
+            &topp->clk,
+            1.4, "us", 0.6
+        );
+        vslx.instance(k).register_scalar("arst_b",
+            &topp->arst_b,
+            VLVT_UINT8, 1u);
+        vslx.instance(k).register_scalar("count",
+            &topp->count,
+            VLVT_UINT16, 10u);
+    }
+
+    // Run simulation
+    int retval = vslx.run();
+
+    return retval;
+}
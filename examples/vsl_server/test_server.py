@@ -0,0 +1,106 @@
+from verisocks.verisocks import Verisocks, VerisocksError
+from verisocks.utils import setup_sim_run, find_free_port
+import logging
+import pytest
+import socket
+from concurrent.futures import ThreadPoolExecutor
+from os.path import join, dirname, abspath, relpath
+
+# Parameters
+HOST = socket.gethostbyname("localhost")
+TIMEOUT = 10
+NUM_WORKERS = 2
+cwd = relpath(dirname(abspath(__file__)))
+
+
+def setup_test(port=5100, timeout=10, num_workers=NUM_WORKERS):
+    elab_cmd = ["make", "-C", cwd]
+    sim_cmd = [
+        join(cwd, "Vcounter"),
+        f"{port}",
+        f"{timeout}",
+        f"{num_workers}"
+    ]
+    pop = setup_sim_run(elab_cmd, sim_cmd, capture_output=True)
+    return pop
+
+
+@pytest.fixture(scope="module")
+def port():
+    # Launch a single server process for all the tests of the module
+    _port = find_free_port()
+    setup_test(_port, TIMEOUT)
+    return _port
+
+
+@pytest.fixture
+def vs(port):
+    # Each test is a new session, with its own model instance
+    _vs = Verisocks(HOST, port)
+    _vs.connect()
+    yield _vs
+    # Teardown
+    try:
+        _vs.finish()
+    except ConnectionError:
+        logging.warning("Connection error - Finish command not possible")
+    _vs.close()
+
+
+def count_after(vs, t_us):
+    answer = vs.run("for_time", time=1.1, time_unit="us")
+    assert answer["type"] == "ack"
+    answer = vs.set("arst_b", value=1)
+    assert answer["type"] == "ack"
+    answer = vs.run("for_time", time=t_us, time_unit="us")
+    assert answer["type"] == "ack"
+    answer = vs.get("value", path="count")
+    assert answer["type"] == "result"
+    return answer["value"]
+
+
+def test_session(vs):
+    answer = vs.get("sim_time")
+    assert answer["type"] == "result"
+    assert answer["time"] == 0.0
+    assert count_after(vs, 50) > 0
+
+
+def test_new_model(vs):
+    # The model of the previous test has been destroyed with its session
+    answer = vs.get("sim_time")
+    assert answer["type"] == "result"
+    assert answer["time"] == 0.0
+    answer = vs.get("value", path="count")
+    assert answer["type"] == "result"
+    assert answer["value"] == 0
+
+
+def test_concurrent_sessions(port):
+    # More clients than workers, so that some of the sessions are queued
+    def client(t_us):
+        with Verisocks(HOST, port) as vs:
+            count = count_after(vs, t_us)
+            vs.finish()
+            return count
+
+    durations = [20, 40, 20, 40]
+    with ThreadPoolExecutor(max_workers=len(durations)) as executor:
+        counts = list(executor.map(client, durations))
+    assert counts[0] == counts[2]
+    assert counts[1] == counts[3]
+    assert counts[1] > counts[0]
+
+
+def test_fork_refused(vs):
+    with pytest.raises(VerisocksError):
+        vs.send(command="fork")
+
+
+if __name__ == "__main__":
+    port = find_free_port()
+    setup_test(port, TIMEOUT)
+    with Verisocks(HOST, port) as vs_cli:
+        test_session(vs_cli)
+
+# EOF
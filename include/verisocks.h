@@ -49,6 +49,9 @@ PLI_INT32 verisocks_cb(p_cb_data cb_data);
 /** Specific runtime callback (value_change) */
 PLI_INT32 verisocks_cb_value_change(p_cb_data cb_data);
 
+/** Specific runtime callback (sample) */
+PLI_INT32 verisocks_cb_sample(p_cb_data cb_data);
+
 /** VPI register function */
 void verisocks_register_tf();
 
@@ -0,0 +1,130 @@
+/**************************************************************************//**
+@file vs_index.h
+@author jchabloz
+@brief Verisocks hierarchy index
+@date 2026-10-18
+******************************************************************************/
+/*
+MIT License
+
+Copyright (c) 2022-2025 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VS_INDEX_H
+#define VS_INDEX_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Type value used for index nodes which only represent a scope
+ */
+#define VS_INDEX_SCOPE (-1)
+
+/**
+ * @brief Opaque hierarchy index type
+ *
+ * The index stores dot-separated hierarchical paths (e.g. "tb.dut.count") as
+ * a trie in which each path segment name is interned only once.
+ */
+typedef struct vs_index vs_index_t;
+
+/**
+ * @brief Visitor function type for vs_index_match
+ *
+ * @param str_path Full path of the matching object (only valid during call)
+ * @param type Type associated with the object when it was added
+ * @param p_user User data pointer as passed to vs_index_match
+ * @return 0 to continue visiting, any other value stops the query
+ */
+typedef int (*vs_index_visitor_t)(const char *str_path, int type,
+    void *p_user);
+
+/**
+ * @brief Create an empty hierarchy index
+ *
+ * @return Pointer to the new index, NULL in case of error
+ */
+vs_index_t* vs_index_create(void);
+
+/**
+ * @brief Free a hierarchy index
+ *
+ * @param p_index Pointer to the index (can be NULL)
+ */
+void vs_index_free(vs_index_t *p_index);
+
+/**
+ * @brief Add an object path to a hierarchy index
+ *
+ * Intermediate scopes are created as needed. Adding an already existing path
+ * updates its type.
+ *
+ * @param p_index Pointer to the index
+ * @param str_path Dot-separated object path
+ * @param type Object type (any value >= 0)
+ * @return Returns 0 if successful, -1 in case of error
+ */
+int vs_index_add(vs_index_t *p_index, const char *str_path, int type);
+
+/**
+ * @brief Query a hierarchy index with a glob pattern
+ *
+ * The pattern is split into dot-separated segments. Within a segment, "*"
+ * matches any sequence of characters and "?" matches any single character.
+ * A segment consisting of "**" matches zero or more hierarchy levels. Only
+ * objects (i.e. not scope-only nodes) are reported, in insertion order and
+ * at most once per query.
+ *
+ * @param p_index Pointer to the index
+ * @param str_pattern Glob pattern
+ * @param visitor Function called for each matching object
+ * @param p_user User data pointer passed to the visitor function
+ * @return Number of visited objects, -1 in case of error
+ */
+int vs_index_match(vs_index_t *p_index, const char *str_pattern,
+    vs_index_visitor_t visitor, void *p_user);
+
+/**
+ * @brief Get the number of objects stored in a hierarchy index
+ *
+ * @param p_index Pointer to the index
+ * @return Number of objects (scope-only nodes are not counted)
+ */
+size_t vs_index_size(const vs_index_t *p_index);
+
+/**
+ * @brief Check if a string contains glob wildcard characters
+ *
+ * @param str String to be checked
+ * @return Returns 1 if str contains "*" or "?", 0 otherwise
+ */
+int vs_index_is_pattern(const char *str);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //VS_INDEX_H
+//EOF
@@ -0,0 +1,158 @@
+/**************************************************************************//**
+@file vs_io.h
+@author jchabloz
+@brief Verisocks background socket I/O
+@date 2026-10-18
+******************************************************************************/
+/*
+MIT License
+
+Copyright (c) 2022-2025 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VS_IO_H
+#define VS_IO_H
+
+#include <stdint.h>
+#include "cJSON.h"
+#include "vs_msg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Length of the I/O queues (has to be a power of 2)
+ */
+#define VS_IO_QUEUE_LEN 64u
+
+/**
+ * @brief Opaque type for a background socket I/O thread
+ *
+ * The I/O thread reads, frames and parses the messages received from a client
+ * socket and writes the messages to be returned to it. It exchanges them with
+ * the thread which started it through two single-producer, single-consumer
+ * lock-free queues (one per direction). The thread which started it is the
+ * only one allowed to call the other functions of this module.
+ */
+typedef struct vs_io vs_io_t;
+
+/**
+ * @brief Enum type for the messages received from an I/O thread
+ */
+typedef enum {
+    VS_IO_MSG_CMD,          ///Received and parsed JSON command
+    VS_IO_MSG_INVALID,      ///Received message cannot be parsed as JSON
+    VS_IO_MSG_CLOSED        ///Connection closed or lost
+} vs_io_msg_type_t;
+
+/**
+ * @brief Structure type for a message received from an I/O thread
+ */
+typedef struct vs_io_msg {
+    vs_io_msg_type_t type;  ///Message type
+    cJSON *p_cmd;           ///Parsed command (to be freed by the receiver)
+    vs_uuid_t uuid;         ///Transaction UUID, if valid
+} vs_io_msg_t;
+
+/**
+ * @brief Start a background I/O thread for a connected client socket
+ *
+ * The socket descriptor remains owned by the caller and is not closed when
+ * the I/O thread is stopped.
+ *
+ * @param fd Client socket descriptor
+ * @return Pointer to I/O thread struct, NULL in case of error
+ */
+vs_io_t* vs_io_start(int fd);
+
+/**
+ * @brief Stop a background I/O thread
+ *
+ * All the messages queued with vs_io_write are sent before the I/O thread
+ * terminates. Received commands which have not been read are discarded, as
+ * well as a partially received message.
+ *
+ * @param p_io Pointer to I/O thread struct (can be NULL)
+ */
+void vs_io_stop(vs_io_t *p_io);
+
+/**
+ * @brief Get the next message received by an I/O thread
+ *
+ * This function blocks until a message is available.
+ *
+ * @param p_io Pointer to I/O thread struct
+ * @param p_msg Pointer to the message struct to be filled
+ * @return Returns 0 if successful, -1 in case of error
+ */
+int vs_io_read(vs_io_t *p_io, vs_io_msg_t *p_msg);
+
+/**
+ * @brief Queue a message to be written by an I/O thread
+ *
+ * The message is copied and this function only blocks if the queue is full.
+ *
+ * @param p_io Pointer to I/O thread struct
+ * @param str_msg Message to be sent (e.g. as created by vs_msg_create_message)
+ * @param full_len Full message length, including pre-header and header
+ * @return Returns 0 if successful, -1 in case of error
+ */
+int vs_io_write(vs_io_t *p_io, const char *str_msg, size_t full_len);
+
+/**
+ * @brief Set the CPU affinity of an I/O thread
+ *
+ * @param p_io Pointer to I/O thread struct
+ * @param cpu CPU index to which the I/O thread is pinned
+ * @return Returns 0 if successful, -1 in case of error
+ */
+int vs_io_set_affinity(vs_io_t *p_io, int cpu);
+
+/**
+ * @brief Release an I/O thread struct in a forked child process
+ *
+ * Only the thread which called fork() exists in the child process, so that
+ * the I/O thread cannot be stopped there. This function frees the struct
+ * without joining the I/O thread and without sending the queued messages
+ * (they are sent by the parent process). Received commands which have not
+ * been read are discarded.
+ *
+ * @param p_io Pointer to I/O thread struct (can be NULL)
+ */
+void vs_io_release_forked(vs_io_t *p_io);
+
+/**
+ * @brief Find the running I/O thread for a socket descriptor
+ *
+ * Only the I/O threads started by the calling thread are considered.
+ *
+ * @param fd Client socket descriptor
+ * @return Pointer to I/O thread struct, NULL if none
+ */
+vs_io_t* vs_io_find(int fd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //VS_IO_H
+//EOF
@@ -41,6 +41,8 @@ extern "C" {
 
 #define VS_MSG_MAX_READ_TRIALS  10u //Defines how many read trials should be attempted
 #define VS_MSG_MAX_WRITE_TRIALS 10u //Defines how many write trials should be attempted
+#define VS_MSG_MIN_READ_SIZE 4096u  //Initial size of dynamically allocated read buffers
+#define VS_MSG_MAX_READ_SIZE (64u * 1024u * 1024u) //Maximum size of a received message
 
 /**
  * @brief Message content type enumeration
@@ -213,6 +215,50 @@ int vs_msg_return(int fd, const char *str_type, const char *str_value,
  */
 int vs_msg_read(int fd, char *buffer, size_t len, vs_msg_info_t *p_msg_info);
 
+/**
+ * @brief Reads formatted message from the given descriptor into a dynamically
+ * sized buffer.
+ *
+ * Contrary to vs_msg_read, the message is never truncated: the buffer is
+ * (re-)allocated as needed to hold the full message, followed by a null
+ * termination. The buffer can be reused between successive calls and has to
+ * be freed by the caller.
+ *
+ * @param fd I/O descriptor
+ * @param p_buffer Pointer to the read buffer pointer (buffer can be NULL)
+ * @param p_size Pointer to the read buffer size, updated if the buffer is
+ * re-allocated
+ * @param p_msg_info Pointer to a vs_msg_info_t struct. The function will
+ * populate the structure with information from the message header.
+ * @return Returns message total length if successful or -1 if an error
+ * occurred (including if the message is longer than VS_MSG_MAX_READ_SIZE).
+ */
+int vs_msg_read_alloc(int fd, char **p_buffer, size_t *p_size,
+    vs_msg_info_t *p_msg_info);
+
+/**
+ * @brief Reads formatted message from the given descriptor into a dynamically
+ * sized buffer, unless a stop is requested
+ *
+ * Same as vs_msg_read_alloc, but the function also waits on a wake-up
+ * descriptor (e.g. the read end of a pipe) between successive reads. Each time
+ * it is readable, it is drained and the stop request flag is checked, so that
+ * a thread blocked on a partially received message can be stopped.
+ *
+ * @param fd I/O descriptor
+ * @param p_buffer Pointer to the read buffer pointer (buffer can be NULL)
+ * @param p_size Pointer to the read buffer size, updated if the buffer is
+ * re-allocated
+ * @param p_msg_info Pointer to a vs_msg_info_t struct. The function will
+ * populate the structure with information from the message header.
+ * @param fd_wake Wake-up descriptor (if < 0, same as vs_msg_read_alloc)
+ * @param p_stop Pointer to the stop request flag (atomic access)
+ * @return Returns message total length if successful or -1 if an error
+ * occurred or if a stop has been requested.
+ */
+int vs_msg_read_alloc_wake(int fd, char **p_buffer, size_t *p_size,
+    vs_msg_info_t *p_msg_info, int fd_wake, const int *p_stop);
+
 #ifdef __cplusplus
 }
 #endif
@@ -61,6 +61,22 @@ double vs_utils_time_to_double(s_vpi_time time, const char *time_unit);
  */
 s_vpi_time vs_utils_double_to_time(double time_value, const char *time_unit);
 
+/**
+ * @brief Convert real (double) value to a VPI time struct, rounded to the
+ * nearest simulator precision step
+ *
+ * Unlike vs_utils_double_to_time(), which truncates, e.g. 0.3 us cannot
+ * become 299999 ps because of the floating point representation.
+ *
+ * @param time_value Real time value.
+ * @param time_unit Time unit associated with the provided real time value
+ * (should be "s", "ms", "us", "ns", "ps" or "fs", case sensitive). If NULL or
+ * "", the value is considered as being defined in seconds ("s").
+ * @return s_vpi_time struct with vpiSimTime type
+ */
+s_vpi_time vs_utils_double_to_time_nearest(double time_value,
+    const char *time_unit);
+
 /**
  * @brief Get the Verisocks interface format of choice to represent the value
  * for a given object.
@@ -101,6 +117,20 @@ PLI_INT32 vs_utils_compare_values(s_vpi_value val1, s_vpi_value val2);
  */
 PLI_INT32 vs_utils_set_value(vpiHandle h_obj, double value);
 
+/**
+ * @brief Put value from a VPI handle and a value, with an optional delay
+ *
+ * @param h_obj VPI object handle
+ * @param value Value
+ * @param p_delay Pointer to delay time struct (can be NULL if flags is
+ * vpiNoDelay)
+ * @param flags Delay mode flags, as for vpi_put_value (e.g. vpiNoDelay,
+ * vpiTransportDelay)
+ * @return 0 if successful, -1 in case of error
+ */
+PLI_INT32 vs_utils_put_value(vpiHandle h_obj, double value,
+    p_vpi_time p_delay, PLI_INT32 flags);
+
 /**
  * @brief Add value to cJSON message object
  *
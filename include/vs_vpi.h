@@ -33,6 +33,8 @@ SOFTWARE.
 
 #include "vpi_config.h"
 #include "vs_msg.h"
+#include "vs_index.h"
+#include "vs_io.h"
 #include "cJSON.h"
 #include <stdint.h>
 
@@ -54,6 +56,88 @@ typedef enum {
     VS_VPI_STATE_ENUM_LEN
 } vs_vpi_state_t;
 
+/**
+ * @brief Structure type to hold the state of a periodic sampling run
+ *
+ * The sampled values are stored column-wise, i.e. all the samples for the
+ * object at index i are found from p_values[i * num_samples].
+ */
+typedef struct vs_vpi_sampler {
+    int num_paths;          ///Number of sampled objects
+    char **str_paths;       ///Paths to the sampled objects
+    vpiHandle *h_objs;      ///Handles to the sampled objects
+    size_t num_samples;     ///Number of samples to be taken
+    size_t index;           ///Index of the next sample
+    s_vpi_time period;      ///Sampling period
+    double *p_time;         ///Sampling times buffer (in seconds)
+    double *p_values;       ///Sampled values buffer (column-wise)
+} vs_vpi_sampler_t;
+
+/**
+ * @brief Maximum number of values (number of samples times number of
+ * objects) acquired by a sampling run
+ */
+#define VS_VPI_SAMPLER_MAX_VALUES (1u << 24)
+
+/**
+ * @brief Enum type for the run(until_change) trigger conditions
+ */
+typedef enum {
+    VS_VPI_TRIG_EQ,         ///Value equal to the expected value
+    VS_VPI_TRIG_NE,         ///Value not equal to the expected value
+    VS_VPI_TRIG_LT,         ///Value lower than the expected value
+    VS_VPI_TRIG_LE,         ///Value lower than or equal to the expected value
+    VS_VPI_TRIG_GT,         ///Value greater than the expected value
+    VS_VPI_TRIG_GE,         ///Value greater than or equal to the expected value
+    VS_VPI_TRIG_RISING,     ///Value going from zero to non-zero
+    VS_VPI_TRIG_FALLING,    ///Value going from non-zero to zero
+    VS_VPI_TRIG_ANY,        ///Any change of the value
+    VS_VPI_TRIG_ENUM_LEN
+} vs_vpi_trig_cond_t;
+
+/**
+ * @brief Structure type to hold the state of a run(until_change) trigger
+ *
+ * For integer objects, the mask (if not 0) is applied to the object's value
+ * before it is evaluated against the trigger condition.
+ */
+typedef struct vs_vpi_trigger {
+    vs_vpi_trig_cond_t cond; ///Trigger condition
+    int is_event;           ///Set if the object is a named event
+    PLI_UINT32 mask;        ///Bit mask for integer values (0 if not used)
+    double expected;        ///Expected value (for comparisons)
+    double last;            ///Previous value (for edges)
+    int count;              ///Number of occurrences remaining before stopping
+} vs_vpi_trigger_t;
+
+/**
+ * @brief Maximum number of persistent value change callbacks
+ *
+ * When the pool is full, the oldest watch is removed to make room for a new
+ * one.
+ */
+#define VS_VPI_WATCH_MAX 64
+
+struct vs_vpi_data;
+
+/**
+ * @brief Structure type for a persistent value change callback
+ *
+ * A watch keeps its value change callback registered between successive
+ * run(until_change) commands on the same object. While it is not armed, the
+ * callback returns immediately. The callback is registered with
+ * vpiSuppressVal, so that the value is only read when the watch is armed.
+ */
+typedef struct vs_vpi_watch {
+    char *str_path;         ///Path to the watched object
+    vpiHandle h_obj;        ///Cached handle to the watched object
+    vpiHandle h_cb;         ///Value change callback handle
+    PLI_INT32 format;       ///Value format used by the trigger
+    int is_event;           ///Set if the object is a named event
+    int armed;              ///Set while a run(until_change) waits on the object
+    struct vs_vpi_data *p_data; ///Pointer to VPI instance-specific data
+} vs_vpi_watch_t;
+
 /**
  * @brief Structure type to hold VPI user data
  */
@@ -65,8 +149,13 @@ typedef struct vs_vpi_data {
     int fd_client_socket;   ///File descriptor for currently open connection
     cJSON *p_cmd;           ///Pointer to current/latest command
     vpiHandle h_cb;         ///Callback handle (used for value change callback)
-    s_vpi_value value;      ///Value (used for value change callback)
+    vs_vpi_trigger_t trigger; ///Trigger (used for value change callback)
     vs_uuid_t uuid;         ///Current transaction UUID
+    vs_vpi_sampler_t *p_sampler; ///Ongoing sampling run (NULL if none)
+    vs_index_t *p_index;    ///Hierarchy index (NULL until first used)
+    vs_vpi_watch_t **p_watches; ///Pool of persistent value change callbacks
+    int num_watches;        ///Number of watches in the pool
+    vs_io_t *p_io;          ///Client socket I/O thread (NULL if not connected)
 } vs_vpi_data_t;
 
 /**
@@ -89,8 +178,118 @@ int vs_vpi_process_command(vs_vpi_data_t *p_data);
 int vs_vpi_return(int fd, const char *str_type, const char *str_value,
     const vs_uuid_t *p_uuid);
 
+/**
+ * @brief Evaluate a run(until_change) trigger on a value change
+ *
+ * @param p_trigger Pointer to trigger struct
+ * @param p_value Pointer to the object's new value (NULL for named events)
+ * @return Returns 1 if the trigger condition has been met for the requested
+ * number of occurrences, 0 if not (yet) and -1 in case of error
+ */
+int vs_vpi_trigger_check(vs_vpi_trigger_t *p_trigger, p_vpi_value p_value);
+
+/**
+ * @brief Get the watch for an object from the pool of persistent value change
+ * callbacks
+ *
+ * If the object is not yet watched, its handle is resolved and a new value
+ * change callback is registered. The returned watch is not armed.
+ *
+ * @param p_data Pointer to a VPI instance-specific data
+ * @param str_path Path to the object
+ * @return Pointer to the watch, NULL in case of error
+ */
+vs_vpi_watch_t* vs_vpi_watch_get(vs_vpi_data_t *p_data, const char *str_path);
+
+/**
+ * @brief Remove all the persistent value change callbacks and free the pool
+ *
+ * @param p_data Pointer to a VPI instance-specific data
+ */
+void vs_vpi_watch_free_all(vs_vpi_data_t *p_data);
+
+/**
+ * @brief Write a message to the client.
+ *
+ * If a background I/O thread is running for the client socket, the message is
+ * queued to be sent by this thread. Otherwise, it is directly written to the
+ * socket.
+ *
+ * @param fd I/O descriptor (client)
+ * @param str_msg Message to be written
+ * @param p_msg_info Message information, as updated by vs_msg_create_message
+ * @return Returns 0 if successful, -1 if an error occurred
+ */
+int vs_vpi_write(int fd, const char *str_msg,
+    const vs_msg_info_t *p_msg_info);
+
+/**
+ * @brief Take a sample for all the objects of an ongoing sampling run
+ *
+ * @param p_sampler Pointer to sampler struct
+ * @return Number of samples remaining to be taken, -1 in case of error
+ */
+int vs_vpi_sampler_sample(vs_vpi_sampler_t *p_sampler);
+
+/**
+ * @brief Register the callback for the next sample of a sampling run
+ *
+ * @param p_data Pointer to a VPI instance-specific data
+ * @return Returns 0 if successful, -1 in case of error
+ */
+int vs_vpi_sampler_arm(vs_vpi_data_t *p_data);
+
+/**
+ * @brief Return the time series acquired by a sampling run to the client
+ *
+ * @param p_data Pointer to a VPI instance-specific data
+ * @return Returns 0 if successful, -1 in case of error
+ */
+int vs_vpi_sampler_return(vs_vpi_data_t *p_data);
+
+/**
+ * @brief Free a sampler struct and all its buffers
+ *
+ * @param p_sampler Pointer to sampler struct (can be NULL)
+ */
+void vs_vpi_sampler_free(vs_vpi_sampler_t *p_sampler);
+
+/**
+ * @brief Process a for_time, until_time or to_next callback
+ *
+ * The callback function itself (verisocks_cb) only has to give control back
+ * to the Verisocks main loop if requested.
+ *
+ * @param p_data Pointer to a VPI instance-specific data
+ * @return 1 if the acknowledgement has been returned and the Verisocks main
+ * loop has to take over, -1 in case of error (the simulation has to be
+ * aborted)
+ */
+int vs_vpi_cb_process(vs_vpi_data_t *p_data);
+
+/**
+ * @brief Process a value change callback of a watch (until_change)
+ *
+ * @param p_watch Pointer to the watch
+ * @return 1 if the trigger condition is met, the acknowledgement has been
+ * returned and the Verisocks main loop has to take over, 0 if the simulation
+ * continues, -1 in case of error (the simulation has to be aborted)
+ */
+int vs_vpi_cb_value_change_process(vs_vpi_watch_t *p_watch);
+
+/**
+ * @brief Process a sampling run callback (sample)
+ *
+ * @param p_data Pointer to a VPI instance-specific data
+ * @return 1 if the time series has been returned and the Verisocks main loop
+ * has to take over, 0 if the simulation continues until the next sample, -1
+ * in case of error (the simulation has to be aborted)
+ */
+int vs_vpi_cb_sample_process(vs_vpi_data_t *p_data);
+
 extern PLI_INT32 verisocks_cb(p_cb_data cb_data);
 extern PLI_INT32 verisocks_cb_value_change(p_cb_data cb_data);
+extern PLI_INT32 verisocks_cb_sample(p_cb_data cb_data);
 
 /**
  * @brief Type for a command handler function pointer
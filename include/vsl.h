@@ -36,5 +36,15 @@ SOFTWARE.
 #include "vsl/vsl_integ_cmd_get.hpp"
 #include "vsl/vsl_integ_cmd_set.hpp"
 #include "vsl/vsl_integ_cmd_run.hpp"
+#include "vsl/vsl_integ_cmd_trace.hpp"
+#include "vsl/vsl_integ_cmd_checkpoint.hpp"
+#include "vsl/vsl_integ_cmd_fork.hpp"
+#include "vsl/vsl_integ_cmd_restart.hpp"
+#include "vsl/vsl_integ_cmd_play.hpp"
+#include "vsl/vsl_integ_cmd_plugin.hpp"
+#include "vsl/vsl_integ_edge_sampler.hpp"
+#include "vsl/vsl_plugin_spi.hpp"
+#include "vsl/vsl_ensemble.hpp"
+#include "vsl/vsl_server.hpp"
 
 #endif
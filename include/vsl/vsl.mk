@@ -38,25 +38,43 @@ VL_FLAGS += $(VL_USER_FLAGS)
 VS_SRCS = \
 	cJSON.c \
 	vs_msg.c \
-	vs_server.c
+	vs_server.c \
+	vs_index.c \
+	vs_io.c
 
 VSL_SRCS = \
 	vsl_utils.cpp \
 	vsl_types.cpp \
-	vsl_clocks.cpp
+	vsl_clocks.cpp \
+	vsl_trigger.cpp
 
 VSL_SRCS += $(TB_CPP_SRCS)
 
 VSL_HEADERS = \
     $(VSL_DIR)/include/vsl.h \
+    $(VSL_DIR)/include/vs_index.h \
+    $(VSL_DIR)/include/vs_io.h \
     $(VSL_DIR)/include/vsl/vsl_integ.hpp \
     $(VSL_DIR)/include/vsl/vsl_integ_cmd.hpp \
     $(VSL_DIR)/include/vsl/vsl_integ_cmd_get.hpp \
     $(VSL_DIR)/include/vsl/vsl_integ_cmd_set.hpp \
     $(VSL_DIR)/include/vsl/vsl_integ_cmd_run.hpp \
+    $(VSL_DIR)/include/vsl/vsl_integ_cmd_trace.hpp \
+    $(VSL_DIR)/include/vsl/vsl_integ_cmd_checkpoint.hpp \
+    $(VSL_DIR)/include/vsl/vsl_integ_cmd_fork.hpp \
+    $(VSL_DIR)/include/vsl/vsl_integ_cmd_restart.hpp \
+    $(VSL_DIR)/include/vsl/vsl_integ_cmd_play.hpp \
+    $(VSL_DIR)/include/vsl/vsl_integ_cmd_plugin.hpp \
+    $(VSL_DIR)/include/vsl/vsl_integ_edge_sampler.hpp \
+    $(VSL_DIR)/include/vsl/vsl_ensemble.hpp \
+    $(VSL_DIR)/include/vsl/vsl_server.hpp \
     $(VSL_DIR)/include/vsl/vsl_utils.hpp \
     $(VSL_DIR)/include/vsl/vsl_types.hpp \
-    $(VSL_DIR)/include/vsl/vsl_clocks.hpp
+    $(VSL_DIR)/include/vsl/vsl_clocks.hpp \
+    $(VSL_DIR)/include/vsl/vsl_trigger.hpp \
+    $(VSL_DIR)/include/vsl/vsl_checkpoint.hpp \
+    $(VSL_DIR)/include/vsl/vsl_plugin.hpp \
+    $(VSL_DIR)/include/vsl/vsl_plugin_spi.hpp
 
 VSL_INCDIRS = \
 	$(VSL_DIR)/include \
@@ -0,0 +1,198 @@
+/***************************************************************************//**
+ @file vsl_checkpoint.hpp
+ @brief Checkpoint helpers for the Verilator integration
+
+ Verilated models verilated with the --savable option can be serialized with
+ Verilator's VerilatedSerialize and VerilatedDeserialize classes. Verilator
+ provides VerilatedSave and VerilatedRestore in order to save to and restore
+ from a file; the classes defined here do the same with an in-memory buffer,
+ so that a checkpoint can be restored many times without any file access.
+ Contrary to VerilatedRestore, VslBufferRestore can also be discarded without
+ any error if its content has been found to be invalid.
+
+ @author Jérémie Chabloz
+ @copyright Copyright (c) 2026 Jérémie Chabloz Distributed under the MIT
+ License. See file for details.
+*******************************************************************************/
+/*
+Copyright (c) 2026 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef VSL_CHECKPOINT_HPP
+#define VSL_CHECKPOINT_HPP
+
+#include "verilated.h"
+#include "verilated_save.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace vsl {
+
+/**
+ * @brief Checks if a Verilated model class can be serialized
+ *
+ * The serialization operators are only generated by Verilator for models
+ * verilated with the --savable option.
+ *
+ * @tparam M Model class
+ */
+template<typename M, typename = void>
+struct vsl_is_savable : std::false_type {};
+
+template<typename M>
+struct vsl_is_savable<M, std::void_t<decltype(
+    std::declval<VerilatedSerialize&>() << std::declval<M&>())>> :
+    std::true_type {};
+
+/**
+ * @class VslBufferSave
+ * @brief Serializes into an in-memory buffer
+ *
+ * The buffer content is the same as the one of a file written with
+ * VerilatedSave. The class is a template so that it is only compiled (and
+ * Verilator's save functions only linked) if it is actually used.
+ *
+ * @tparam B Buffer type (contiguous container of bytes)
+ */
+template<typename B = std::vector<uint8_t>>
+class VslBufferSave final : public VerilatedSerialize {
+public:
+    explicit VslBufferSave(B& buffer) : buffer {buffer} {};
+    ~VslBufferSave() override {close();};
+
+    /**
+     * @brief Clears the buffer and writes the header
+     */
+    void open() {
+        if (isOpen()) return;
+        buffer.clear();
+        m_isOpen = true;
+        m_cp = m_bufp;
+        header();
+    };
+
+    void close() override {
+        if (!isOpen()) return;
+        trailer();
+        flush();
+        m_isOpen = false;
+    };
+
+    void flush() override {
+        buffer.insert(buffer.end(), m_bufp, m_cp);
+        m_cp = m_bufp;
+    };
+
+private:
+    B& buffer;
+};
+
+/**
+ * @class VslBufferRestore
+ * @brief Deserializes from an in-memory buffer
+ *
+ * The buffer is not modified, so that it can be restored several times.
+ *
+ * @tparam B Buffer type (contiguous container of bytes)
+ */
+template<typename B = std::vector<uint8_t>>
+class VslBufferRestore final : public VerilatedDeserialize {
+public:
+    explicit VslBufferRestore(const B& buffer) : buffer {buffer} {};
+    ~VslBufferRestore() override {close();};
+
+    /**
+     * @brief Reads the first buffer block and checks the header
+     */
+    void open() {
+        if (isOpen()) return;
+        m_isOpen = true;
+        m_cp = m_bufp;
+        m_endp = m_bufp;
+        read_pos = 0;
+        fill();
+        header();
+    };
+
+    void close() override {
+        if (!isOpen()) return;
+        trailer();
+        flush();
+        m_isOpen = false;
+    };
+
+    /**
+     * @brief Closes without checking the trailer, e.g. if the content has
+     * been found to be invalid by the integration state check. The buffer
+     * shall however have been checked with vsl_serialize_frame() beforehand,
+     * since Verilator aborts the simulation for invalid model content.
+     */
+    void discard() {m_isOpen = false;};
+
+private:
+    const B& buffer;
+    size_t read_pos {0};
+
+    /* Moves the remaining bytes to the start of the buffer block and fills
+    it with the next bytes */
+    void fill() override {
+        size_t remaining = static_cast<size_t>(m_endp - m_cp);
+        std::memmove(m_bufp, m_cp, remaining);
+        m_cp = m_bufp;
+        m_endp = m_bufp + remaining;
+        size_t num = std::min(bufferSize() - remaining,
+            buffer.size() - read_pos);
+        std::memcpy(m_endp, buffer.data() + read_pos, num);
+        m_endp += num;
+        read_pos += num;
+    };
+};
+
+/**
+ * @brief Returns the bytes written by Verilator before and after the
+ * serialized content
+ *
+ * Verilator aborts the simulation if they do not match when deserializing,
+ * so that they have to be checked beforehand for a buffer which may be
+ * invalid.
+ *
+ * @tparam B Buffer type (contiguous container of bytes)
+ * @return Pair of header and trailer bytes
+ */
+template<typename B = std::vector<uint8_t>>
+std::pair<B, B> vsl_serialize_frame() {
+    B buffer;
+    VslBufferSave<B> os {buffer};
+    os.open();
+    os.flush();
+    B header {buffer};
+    os.close();
+    B trailer(buffer.begin() + header.size(), buffer.end());
+    return {header, trailer};
+}
+
+} // namespace vsl
+#endif //VSL_CHECKPOINT_HPP
+// EOF
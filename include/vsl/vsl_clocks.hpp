@@ -31,8 +31,10 @@ SOFTWARE.
 #define VSL_CLOCKS_HPP
 
 #include "vsl/vsl_types.hpp"
+#include <functional>
 #include <string>
-#include <list>
+#include <unordered_map>
+#include <vector>
 
 namespace vsl {
 
@@ -56,6 +58,24 @@ class VslClock : public VslVar {
 
 public:
 
+    /**
+     * @brief Scheduling state of a clock (e.g. for checkpoints)
+     *
+     * The clock level itself is not part of it, since it is the value of the
+     * Verilator variable.
+     */
+    struct State {
+        bool b_is_enabled;
+        bool b_wait_dis;
+        uint32_t cycles_counter;
+        vsl_time_t prev_event_time;
+        vsl_time_t next_event_time;
+        double duty_cycle;
+        vsl_time_t period;
+        vsl_time_t period_low;
+        vsl_time_t period_high;
+    };
+
     VslClock() = default;
 
     /**
@@ -190,6 +210,20 @@ public:
      */
     inline vsl_time_t get_next_event() const {return next_event_time;};
 
+    /**
+     * @brief Get the clock scheduling state
+     *
+     * @return Clock state
+     */
+    State get_state() const;
+
+    /**
+     * @brief Set the clock scheduling state, as returned by get_state()
+     *
+     * @param state Clock state
+     */
+    void set_state(const State& state);
+
     // Define < operator to allow using sorting algorithms
     bool operator<(const VslClock& other) const {
         if (!b_is_enabled) return false; // Disabled clocks at the back
@@ -250,6 +284,43 @@ public:
         const char* unit, const double duty_cycle,
         VerilatedContext* const p_context);
 
+    /**
+     * @brief Enable a registered clock
+     *
+     * @param name Name of the clock
+     * @param p_context Pointer to the current simulation context
+     * @return 0 No errors
+     * @return -1 Clock not found
+     */
+    int enable_clock(const std::string& name,
+        VerilatedContext* const p_context);
+
+    /**
+     * @brief Disable a registered clock
+     *
+     * If the clock is high, it is disabled after its next falling edge.
+     *
+     * @param name Name of the clock
+     * @return 0 No errors
+     * @return -1 Clock not found
+     */
+    int disable_clock(const std::string& name);
+
+    /**
+     * @brief Set the period and duty cycle of a registered clock
+     *
+     * @param name Name of the clock
+     * @param period Period of the clock
+     * @param unit Time unit used for the clock period parameter
+     * @param duty_cycle Clock duty cycle (has to be > 0 and < 1)
+     * @param p_context Pointer to Verilator simulation context
+     * @return 0 No errors
+     * @return -1 Clock not found or invalid period
+     */
+    int set_clock_period(const std::string& name, const double period,
+        const char* unit, const double duty_cycle,
+        VerilatedContext* const p_context);
+
     /**
      * @brief Checks if any of the registered clock is enabled
      * 
@@ -269,6 +340,9 @@ public:
     /**
      * @brief Evaluate all clocks at a given simulation time
      *
+     * Only the clocks scheduled for the given time are evaluated, each edge
+     * costing O(log n) for n enabled clocks.
+     *
      * @param time Simulation time
      * @return Total count of evaluated clocks
      */
@@ -290,7 +364,7 @@ public:
      * @return true No clock registered
      * @return false Clocks registered
      */
-    inline const bool empty() const {return clock_list.empty();}
+    inline const bool empty() const {return clocks.empty();}
 
     /**
      * @brief Checks if a clock by a given name exists in the clocks list
@@ -298,22 +372,83 @@ public:
      * @param name Name of the clock to search for
      * @return bool true if the clock by the given name has been found
      */
-    const bool has_clock(const std::string name);
+    const bool has_clock(const std::string name) const;
 
     /**
      * @brief Get a registered clock by its name.
      *
      * It is recommended to use the function has_clock first in order to verify
-     * that the clock exists.
+     * that the clock exists. The clock can only be modified through the
+     * VslClockMap methods, so that its scheduling remains up to date.
      * 
      * @param name Name of the clock
      * @return Clock
      */
-    VslClock& get_clock(const std::string name);
+    const VslClock& get_clock(const std::string name) const;
+
+    /**
+     * @brief Get the scheduling state of all the clocks
+     *
+     * @return Clocks states, by registration order
+     */
+    std::vector<VslClock::State> get_states() const;
+
+    /**
+     * @brief Set the scheduling state of all the clocks
+     *
+     * The clocks are re-scheduled accordingly.
+     *
+     * @param states Clocks states, by registration order, as returned by
+     * get_states()
+     * @return 0 No errors
+     * @return -1 Number of states not matching the number of clocks
+     */
+    int set_states(const std::vector<VslClock::State>& states);
+
+    /**
+     * @brief Get the levels of all the clocks
+     *
+     * @return Clocks levels, by registration order
+     */
+    std::vector<double> get_levels();
+
+    /**
+     * @brief Set the levels of all the clocks, as returned by get_levels()
+     *
+     * @param levels Clocks levels
+     * @return 0 No errors
+     * @return -1 Number of levels not matching the number of clocks
+     */
+    int set_levels(const std::vector<double>& levels);
+
+    /**
+     * @brief Re-binds all the clocks to their Verilator variables, e.g. once
+     * the model has been reconstructed
+     *
+     * @param fn Function returning the new pointer of a clock variable from
+     * its current one
+     */
+    void rebind(const std::function<void*(void*)>& fn);
 
 private:
 
-    std::list<VslClock> clock_list;
+    /* Scheduled event of an enabled clock */
+    struct VslClockEvent {
+        vsl_time_t time;    // Time of the next event
+        size_t index;       // Index of the clock
+    };
+
+    std::vector<VslClock> clocks;   // Clocks, by registration order
+    std::unordered_map<std::string, size_t> clock_index;
+    std::vector<VslClockEvent> heap;    // Min-heap of the enabled clocks
+    std::vector<size_t> heap_pos;   // Position of each clock in the heap
+
+    void insert_clock(size_t index, const VslClock& clock);
+    void schedule(size_t index);
+    void heap_swap(size_t pos_a, size_t pos_b);
+    void sift_up(size_t pos);
+    void sift_down(size_t pos);
+    void heap_remove(size_t pos);
 };
 
 } // namespace vsl
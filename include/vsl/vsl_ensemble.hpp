@@ -0,0 +1,1024 @@
+/***************************************************************************//**
+ @file vsl_ensemble.hpp
+ @brief Verisocks integration of an ensemble of Verilated model instances.
+
+ This header defines the `vsl::VslEnsemble` template class, which owns K
+ instances of a Verilated model, each with its own Verilator context and its
+ own `vsl::VslInteg` object (registered variables and clocks), and controls
+ them all through a single Verisocks server socket. A single client can thus
+ drive K simulations (e.g. Monte-Carlo runs or parameter sweeps) with a
+ single round trip per step:
+ - run: the instances are simulated in parallel, on a pool of threads, up to
+   the same callback time.
+ - set: the same value is set for all the instances, or each instance gets
+   its own value from a vector of values.
+ - get: the values are returned as one array per path, with one element per
+   instance.
+
+ Usage:
+ - Instantiate `VslEnsemble<T>` with your Verilated model type and the number
+   of instances.
+ - Register the variables and clocks of each instance with `instance(k)` and
+   `model(k)`, or with `auto_register()`.
+ - Call `run()` to start the FSM and handle remote commands.
+
+ @author Jérémie Chabloz
+ @copyright Copyright (c) 2026 Jérémie Chabloz Distributed under the MIT
+ License. See file for details.
+*******************************************************************************/
+/*
+Copyright (c) 2026 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VSL_ENSEMBLE_HPP
+#define VSL_ENSEMBLE_HPP
+
+#include "cJSON.h"
+#include "vs_server.h"
+#include "vs_logging.h"
+#include "vs_msg.h"
+#include "vs_index.h"
+#include "verilated.h"
+#include "vsl/vsl_integ.hpp"
+#include "vsl/vsl_utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+/**
+ * @brief Helper macro to declare an ensemble command handler function
+ * prototype
+ *
+ * As part of all ensemble command handler function prototypes, a
+ * `vsl::VslEnsemble` object is passed by reference.
+ *
+ * @param cmd Command short name
+ */
+#define VSL_ENS_CMD_HANDLER(cmd) VSL_ENS_ ## cmd ## _cmd_handler(VslEnsemble& ex)
+
+/**
+ * @brief Helper macro that is replaced by an ensemble command handler function
+ * name
+ * @param cmd Command short name
+ */
+#define VSL_ENS_CMD_HANDLER_NAME(cmd) VSL_ENS_ ## cmd ## _cmd_handler
+
+
+namespace vsl{
+
+/**
+ * @class VslEnsemble
+ * @brief Top-level class to use for driving an ensemble of Verilated model
+ * instances with Verisocks
+ *
+ * This class is a template which takes as parameter the verilated model class.
+ * Each instance has its own Verilator context, model and `vsl::VslInteg`
+ * object, the latter being only used for its registered variables and clocks
+ * and for its simulation loop (its own FSM is not used).
+ *
+ * @tparam T Model class
+ */
+template<typename T>
+class VslEnsemble {
+
+public:
+
+    /**
+     * @brief Construct a new VslEnsemble object
+     *
+     * @param num_instances Number of model instances (K)
+     * @param port The port number to be used. Default is 5100.
+     * @param timeout The timeout duration in seconds. Default is 120.
+     * @param num_threads Number of threads used to simulate the instances,
+     * including the one calling run(). Default is 0, for as many threads as
+     * there are instances, within the number of available CPUs.
+     */
+    VslEnsemble(const size_t num_instances, const int port=5100,
+        const int timeout=120, const size_t num_threads=0);
+    ~VslEnsemble();
+
+    /**
+     * @brief Returns the number of instances
+     */
+    inline size_t size() const {return models.size();}
+
+    /**
+     * @brief Returns a pointer to the model of an instance
+     * @param index Instance index
+     */
+    inline T* model(const size_t index) {return models.at(index).get();}
+
+    /**
+     * @brief Returns a pointer to the Verilator context of an instance
+     * @param index Instance index
+     */
+    inline VerilatedContext* context(const size_t index) {
+        return contexts.at(index).get();
+    }
+
+    /**
+     * @brief Returns the VslInteg object of an instance
+     *
+     * Variables and clocks of the instance shall be registered with the
+     * returned object, e.g.
+     * `ens.instance(k).register_scalar("count", &ens.model(k)->count, ...)`.
+     *
+     * @param index Instance index
+     */
+    inline VslInteg<T>& instance(const size_t index) {
+        return *members.at(index);
+    }
+
+    /**
+     * @brief Register all the public variables of all the instances
+     *
+     * See VslInteg::auto_register().
+     *
+     * @return Number of registered variables per instance, -1 in case of
+     * error
+     */
+    int auto_register();
+
+    /**
+     * @brief Run Verisocks FSM
+     *
+     * Same as VslInteg::run(), for all the instances of the ensemble.
+     */
+    int run();
+
+private:
+    VslState _state {VSL_STATE_INIT}; //Verisocks state
+    cJSON* p_cmd {nullptr}; //Pointer to current/latest command
+
+    /* Command handler functions map */
+    std::unordered_map<std::string, std::function<void(VslEnsemble&)>>
+    cmd_handlers_map {};
+
+    /* Instances (contexts are destroyed after the models) */
+    std::vector<std::unique_ptr<VerilatedContext>> contexts {};
+    std::vector<std::unique_ptr<T>> models {};
+    std::vector<std::unique_ptr<VslInteg<T>>> members {};
+    std::vector<uint8_t> finished {};    //Instance has reached $finish
+    std::vector<uint8_t> finalized {};   //Instance final() already called
+
+    int num_port {5100};           //Port number
+    int num_timeout_sec {120};     //Timeout, in seconds
+    int fd_server_socket {-1};     //File descriptor, server socket
+    int fd_client_socket {-1};     //File descriptor, connected client socket
+    vs_uuid_t uuid {0u, VS_UUID_NULL};  //Transaction UUID
+    char* p_read_buffer {nullptr};
+    size_t read_buffer_size {0};
+
+    /* Thread pool. Workers wait for a new job generation and then take the
+    instances one by one until all of them have been processed. The thread
+    calling run() takes part as well. */
+    size_t num_threads {1};
+    std::vector<std::thread> workers {};
+    std::mutex pool_mutex {};
+    std::condition_variable pool_cv_start {};
+    std::condition_variable pool_cv_done {};
+    const std::function<void(size_t)>* p_pool_job {nullptr};
+    std::atomic<size_t> pool_next {0};
+    size_t pool_generation {0};
+    size_t pool_active {0};
+    bool pool_stop {false};
+
+    void pool_start();
+    void pool_join();
+    void pool_work();
+    void pool_worker();
+    void parallel_for(const std::function<void(size_t)>& job);
+
+    /* State machine functions */
+    void main_init();
+    void main_connect();
+    void main_wait();
+    void main_process();
+    void main_sim_finish();
+    void close_sockets();
+    void final_all();
+
+    /* Returns true if all the instances have reached $finish */
+    bool all_finished() const {
+        return std::all_of(finished.begin(), finished.end(),
+            [](uint8_t b) {return 0u != b;});
+    }
+    int run_until(const std::vector<vsl_time_t>& t_end);
+    int add_values(cJSON* p_item_path, cJSON* p_msg, bool hex);
+    int write_message(cJSON* p_msg);
+
+    /* Declaration of command handlers functions (see VslInteg) */
+    static void VSL_ENS_CMD_HANDLER(info);
+    static void VSL_ENS_CMD_HANDLER(get);
+    static void VSL_ENS_CMD_HANDLER(set);
+    static void VSL_ENS_CMD_HANDLER(run);
+    static void VSL_ENS_CMD_HANDLER(finish);
+    static void VSL_ENS_CMD_HANDLER(stop);
+    static void VSL_ENS_CMD_HANDLER(exit);
+    static void VSL_ENS_CMD_HANDLER(not_supported);
+};
+
+/******************************************************************************
+Constructor
+******************************************************************************/
+template<typename T>
+VslEnsemble<T>::VslEnsemble(const size_t num_instances, const int port,
+    const int timeout, const size_t num_threads) {
+    vs_log_mod_debug("vsl", "Constructor called (%s)", __FILE__);
+
+    /* Check that the type parameter corresponds to a verilated model */
+    static_assert(std::is_base_of<VerilatedModel,T>::value,
+        "Error, expecting a derived class of VerilatedModel");
+
+    size_t num = std::max<size_t>(num_instances, 1u);
+    for (size_t k = 0; k < num; k++) {
+        contexts.emplace_back(new VerilatedContext);
+        models.emplace_back(new T{contexts.back().get()});
+        members.emplace_back(new VslInteg<T>{models.back().get()});
+    }
+    finished.assign(num, 0u);
+    finalized.assign(num, 0u);
+
+    num_port = port;
+    num_timeout_sec = timeout;
+    size_t num_cpus = std::max<size_t>(std::thread::hardware_concurrency(), 1u);
+    this->num_threads = std::min(num,
+        (0 == num_threads) ? num_cpus : num_threads);
+
+    // Add commands handler functions to the relevant maps
+    cmd_handlers_map["info"]   = VSL_ENS_CMD_HANDLER_NAME(info);
+    cmd_handlers_map["get"]    = VSL_ENS_CMD_HANDLER_NAME(get);
+    cmd_handlers_map["set"]    = VSL_ENS_CMD_HANDLER_NAME(set);
+    cmd_handlers_map["run"]    = VSL_ENS_CMD_HANDLER_NAME(run);
+    cmd_handlers_map["finish"] = VSL_ENS_CMD_HANDLER_NAME(finish);
+    cmd_handlers_map["stop"]   = VSL_ENS_CMD_HANDLER_NAME(stop);
+    cmd_handlers_map["exit"]   = VSL_ENS_CMD_HANDLER_NAME(exit);
+    return;
+}
+
+/******************************************************************************
+Destructor
+******************************************************************************/
+template<typename T>
+VslEnsemble<T>::~VslEnsemble() {
+    vs_log_mod_debug("vsl", "Destructor called (%s)", __FILE__);
+    pool_join();
+    close_sockets();
+    if (nullptr != p_cmd) cJSON_Delete(p_cmd);
+    free(p_read_buffer);
+    /* Members refer to the models, which refer to the contexts */
+    members.clear();
+    models.clear();
+    return;
+}
+
+template<typename T>
+int VslEnsemble<T>::auto_register() {
+    int num_vars = 0;
+    for (auto& p_member : members) {
+        num_vars = p_member->auto_register();
+        if (0 > num_vars) return -1;
+    }
+    return num_vars;
+}
+
+/******************************************************************************
+Thread pool
+******************************************************************************/
+template<typename T>
+void VslEnsemble<T>::pool_start() {
+    pool_stop = false;
+    for (size_t i = 1; i < num_threads; i++) {
+        workers.emplace_back(&VslEnsemble<T>::pool_worker, this);
+    }
+}
+
+template<typename T>
+void VslEnsemble<T>::pool_join() {
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        pool_stop = true;
+    }
+    pool_cv_start.notify_all();
+    for (auto& worker : workers) worker.join();
+    workers.clear();
+}
+
+template<typename T>
+void VslEnsemble<T>::pool_work() {
+    size_t index;
+    while ((index = pool_next.fetch_add(1)) < members.size()) {
+        (*p_pool_job)(index);
+    }
+}
+
+template<typename T>
+void VslEnsemble<T>::pool_worker() {
+    size_t generation = 0;
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    while (true) {
+        pool_cv_start.wait(lock, [&]() {
+            return pool_stop || (generation != pool_generation);
+        });
+        if (pool_stop) return;
+        generation = pool_generation;
+        lock.unlock();
+        pool_work();
+        lock.lock();
+        if (0 == --pool_active) pool_cv_done.notify_one();
+    }
+}
+
+/* Calls job(k) for each instance index k, on all the threads of the pool, and
+returns once all of them have been processed */
+template<typename T>
+void VslEnsemble<T>::parallel_for(const std::function<void(size_t)>& job) {
+    if (workers.empty()) {
+        for (size_t k = 0; k < members.size(); k++) job(k);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        p_pool_job = &job;
+        pool_next.store(0);
+        pool_active = workers.size();
+        pool_generation++;
+    }
+    pool_cv_start.notify_all();
+    pool_work();
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    pool_cv_done.wait(lock, [this]() {return 0 == pool_active;});
+    p_pool_job = nullptr;
+}
+
+/******************************************************************************
+Finite state-machine
+******************************************************************************/
+template<typename T>
+int VslEnsemble<T>::run() {
+    vs_log_mod_info("vsl", "Verisocks ensemble of %zu instances (%zu \
+threads)", members.size(), num_threads);
+    pool_start();
+
+    while(true) {
+        switch (_state) {
+        case VSL_STATE_INIT:
+            main_init();
+            break;
+        case VSL_STATE_CONNECT:
+            main_connect();
+            break;
+        case VSL_STATE_WAITING:
+            main_wait();
+            break;
+        case VSL_STATE_PROCESSING:
+            main_process();
+            if (_state == VSL_STATE_PROCESSING) {
+                _state = VSL_STATE_WAITING;
+            }
+            break;
+        case VSL_STATE_SIM_FINISH:
+            main_sim_finish();
+            break;
+        case VSL_STATE_EXIT:
+            pool_join();
+            close_sockets();
+            return 0;
+        case VSL_STATE_SIM_RUNNING: //Instances are run by the run handler
+        case VSL_STATE_ERROR:
+        default:
+            vs_log_mod_error("vsl",
+                "Exiting Verisocks main loop (error state)");
+            pool_join();
+            close_sockets();
+            return 1;
+        } //switch (_state)
+    }
+    return 2;
+}
+
+template<typename T>
+void VslEnsemble<T>::close_sockets() {
+    if (0 <= fd_client_socket) {
+        vs_server_close_socket(fd_client_socket);
+        fd_client_socket = -1;
+    }
+    if (0 <= fd_server_socket) {
+        vs_server_close_socket(fd_server_socket);
+        fd_server_socket = -1;
+    }
+}
+
+template<typename T>
+void VslEnsemble<T>::main_init() {
+    fd_server_socket = vs_server_make_socket(num_port);
+    if (0 > fd_server_socket) {
+        vs_log_mod_error("vsl", "Issue making socket at port %d", num_port);
+        _state = VSL_STATE_ERROR;
+        return;
+    }
+    vs_sock_addr_t socket_address = vs_server_get_address(fd_server_socket);
+    vs_log_mod_info("vsl", "Port: %d", socket_address.port);
+    _state = VSL_STATE_CONNECT;
+    return;
+}
+
+template<typename T>
+void VslEnsemble<T>::main_connect() {
+    char hostname_buffer[128];
+    struct timeval timeout;
+    timeout.tv_sec = num_timeout_sec;
+    timeout.tv_usec = 0;
+
+    vs_log_mod_info(
+        "vsl",
+        "Waiting for a client to connect (%ds timeout) ...",
+        (int) timeout.tv_sec);
+    fd_client_socket = vs_server_accept(
+        fd_server_socket, hostname_buffer, sizeof(hostname_buffer), &timeout);
+    if (0 > fd_client_socket) {
+        vs_log_mod_error("vsl", "Failed to connect");
+        _state = VSL_STATE_ERROR;
+        return;
+    }
+    vs_log_mod_info("vsl", "Connected to %s", hostname_buffer);
+    _state = VSL_STATE_WAITING;
+    return;
+}
+
+/* Same as VslInteg::main_wait(), with a read buffer re-allocated as needed
+since per-instance values make for longer messages */
+template<typename T>
+void VslEnsemble<T>::main_wait() {
+    vs_msg_info_t msg_info = VS_MSG_INFO_INIT_UNDEF;
+    int msg_len = vs_msg_read_alloc(fd_client_socket, &p_read_buffer,
+        &read_buffer_size, &msg_info);
+    if (0 > msg_len) {
+        vs_server_close_socket(fd_client_socket);
+        fd_client_socket = -1;
+        vs_log_mod_info(
+            "vsl",
+            "Lost connection. Waiting for a client to (re-)connect ..."
+        );
+        _state = VSL_STATE_CONNECT;
+        return;
+    }
+    uuid.valid = msg_info.uuid.valid;
+    if (uuid.valid) {
+        memcpy(uuid.value, msg_info.uuid.value, VS_UUID_LEN);
+    }
+    if (nullptr != p_cmd) {
+        cJSON_Delete(p_cmd);
+    }
+    p_cmd = vs_msg_read_json(p_read_buffer, &msg_info);
+    if (nullptr != p_cmd) {
+        _state = VSL_STATE_PROCESSING;
+        return;
+    }
+    vs_log_mod_warning(
+        "vsl",
+        "Received message content cannot be interpreted as a valid JSON \
+content. Discarding it."
+    );
+    vsl_msg_return(fd_client_socket, "error",
+        "Invalid message content - Discarding", &uuid);
+    return;
+}
+
+template<typename T>
+void VslEnsemble<T>::main_process() {
+    char *c_str_cmd = cJSON_GetStringValue(
+        cJSON_GetObjectItem(p_cmd, "command"));
+    if ((nullptr == c_str_cmd) || std::string(c_str_cmd).empty()) {
+        vs_log_mod_error("vsl", "Command field invalid/not found");
+        vsl_msg_return(fd_client_socket, "error",
+            "Error processing command. Discarding.", &uuid);
+        _state = VSL_STATE_WAITING;
+        return;
+    }
+    vs_log_mod_debug("vsl", "Processing command %s", c_str_cmd);
+
+    /* Look up and execute command handler */
+    auto search = cmd_handlers_map.find(c_str_cmd);
+    if (search != cmd_handlers_map.end()) {
+        search->second(*this);
+        return;
+    }
+    VSL_ENS_CMD_HANDLER_NAME(not_supported)(*this);
+    return;
+}
+
+template<typename T>
+void VslEnsemble<T>::final_all() {
+    for (size_t k = 0; k < members.size(); k++) {
+        if (finalized[k]) continue;
+        models[k]->final();
+        finalized[k] = 1u;
+    }
+}
+
+template<typename T>
+void VslEnsemble<T>::main_sim_finish() {
+    for (size_t k = 0; k < members.size(); k++) {
+        if (finalized[k]) continue;
+        members[k]->eval();
+        models[k]->final();
+        finalized[k] = 1u;
+        contexts[k]->statsPrintSummary();
+    }
+    _state = VSL_STATE_EXIT;
+    return;
+}
+
+/******************************************************************************
+Utility functions
+******************************************************************************/
+/* Simulates all the instances which have not finished yet, in parallel, up to
+their respective end time. Returns the number of instances still running. */
+template<typename T>
+int VslEnsemble<T>::run_until(const std::vector<vsl_time_t>& t_end) {
+    for (auto& p_member : members) p_member->num_sim_evals = 0ull;
+    auto t_start = std::chrono::steady_clock::now();
+    parallel_for([&](size_t k) {
+        if (finished[k]) return;
+        if (!members[k]->sim_until(t_end[k])) finished[k] = 1u;
+    });
+    std::chrono::duration<double> t_elapsed =
+        std::chrono::steady_clock::now() - t_start;
+
+    uint64_t num_evals = 0ull;
+    int num_running = 0;
+    for (size_t k = 0; k < members.size(); k++) {
+        num_evals += members[k]->num_sim_evals;
+        if (!finished[k]) num_running++;
+    }
+    double rate = (t_elapsed.count() > 0.0) ?
+        static_cast<double>(num_evals)/t_elapsed.count() : 0.0;
+    vs_log_mod_info("vsl", "Simulated %llu time slots (%d instances running) \
+in %.3f ms - %.0f time slots/s", (unsigned long long) num_evals, num_running,
+        1.0e3*t_elapsed.count(), rate);
+    return num_running;
+}
+
+/* Adds the values of a path (or of a list of paths and/or glob patterns) for
+all the instances, as one array per path */
+template<typename T>
+int VslEnsemble<T>::add_values(cJSON* p_item_path, cJSON* p_msg, bool hex) {
+    bool bulk = cJSON_IsArray(p_item_path) ||
+        vs_index_is_pattern(cJSON_GetStringValue(p_item_path));
+    cJSON* p_values = nullptr;
+    if (bulk) {
+        p_values = cJSON_AddObjectToObject(p_msg, "value");
+    } else {
+        p_values = cJSON_AddArrayToObject(p_msg, "value");
+        char* cstr_path = cJSON_GetStringValue(p_item_path);
+        if ((nullptr == cstr_path) || std::string(cstr_path).empty()) {
+            vs_log_mod_error("vsl", "Command field \"path\" NULL or empty");
+            return -1;
+        }
+    }
+    if (nullptr == p_values) {
+        vs_log_mod_error("vsl", "Could not add item to object");
+        return -1;
+    }
+
+    std::vector<cJSON*> arrays;  //Result arrays, in the first instance order
+    for (auto& p_member : members) {
+        cJSON* p_tmp = cJSON_CreateObject();
+        if (nullptr == p_tmp) return -1;
+        int retval = 0;
+        if (!bulk) {
+            retval = p_member->add_var_value(
+                cJSON_GetStringValue(p_item_path), p_tmp, "value", hex);
+        } else if (cJSON_IsArray(p_item_path)) {
+            bool check_dup = (cJSON_GetArraySize(p_item_path) > 1);
+            cJSON* p_item;
+            cJSON_ArrayForEach(p_item, p_item_path) {
+                retval = p_member->add_bulk_values(
+                    cJSON_GetStringValue(p_item), p_tmp, check_dup, hex);
+                if (0 > retval) break;
+            }
+        } else {
+            retval = p_member->add_bulk_values(
+                cJSON_GetStringValue(p_item_path), p_tmp, false, hex);
+        }
+        if (0 > retval) {
+            cJSON_Delete(p_tmp);
+            return -1;
+        }
+
+        /* Move each value to the array of its path */
+        size_t index = 0;
+        while (nullptr != p_tmp->child) {
+            cJSON* p_item = cJSON_DetachItemViaPointer(p_tmp, p_tmp->child);
+            cJSON* p_array = nullptr;
+            if (!bulk) {
+                p_array = p_values;
+            } else if ((index < arrays.size()) &&
+                (0 == strcmp(arrays[index]->string, p_item->string))) {
+                p_array = arrays[index];
+            } else {
+                p_array = cJSON_GetObjectItemCaseSensitive(p_values,
+                    p_item->string);
+                if (nullptr == p_array) {
+                    p_array = cJSON_AddArrayToObject(p_values, p_item->string);
+                    if (nullptr != p_array) arrays.push_back(p_array);
+                }
+            }
+            if ((nullptr == p_array) ||
+                !cJSON_AddItemToArray(p_array, p_item)) {
+                cJSON_Delete(p_item);
+                cJSON_Delete(p_tmp);
+                return -1;
+            }
+            index++;
+        }
+        cJSON_Delete(p_tmp);
+    }
+    return 0;
+}
+
+template<typename T>
+int VslEnsemble<T>::write_message(cJSON* p_msg) {
+    vs_msg_info_t msg_info = VS_MSG_INFO_INIT_JSON;
+    vs_msg_copy_uuid(&msg_info, &uuid);
+    char* str_msg = vs_msg_create_message(p_msg, &msg_info);
+    if (nullptr == str_msg) {
+        vs_log_mod_error("vsl", "Could not create return message");
+        return -1;
+    }
+    int retval = vsl_msg_write(fd_client_socket, str_msg, &msg_info);
+    if (0 > retval) vs_log_mod_error("vsl", "Error writing return message");
+    cJSON_free(str_msg);
+    return retval;
+}
+
+/******************************************************************************
+Info, stop, exit and finish command handlers
+******************************************************************************/
+template<typename T>
+void VslEnsemble<T>::VSL_ENS_CMD_HANDLER(info) {
+    vs_log_mod_info("vsl", "Command \"info\" received");
+    char* str_val = cJSON_GetStringValue(cJSON_GetObjectItem(ex.p_cmd, "value"));
+    if ((nullptr == str_val) || std::string(str_val).empty()) {
+        vs_log_mod_error("vsl", "Command field \"value\" invalid/not found");
+        vsl_msg_return(ex.fd_client_socket, "error",
+            "Error processing command info - Discarding", &ex.uuid);
+        ex._state = VSL_STATE_WAITING;
+        return;
+    }
+    vs_log_info("%s", str_val);
+    vsl_msg_return(ex.fd_client_socket, "ack", "command info received",
+        &ex.uuid);
+    ex._state = VSL_STATE_WAITING;
+    return;
+}
+
+template<typename T>
+void VslEnsemble<T>::VSL_ENS_CMD_HANDLER(stop) {
+    vs_log_mod_info("vsl", "Command \"stop\" received");
+    vsl_msg_return(ex.fd_client_socket, "ack",
+        "Processing stop command - Simulation stopped/paused", &ex.uuid);
+    ex._state = VSL_STATE_WAITING;
+    return;
+}
+
+template<typename T>
+void VslEnsemble<T>::VSL_ENS_CMD_HANDLER(exit) {
+    vs_log_mod_info(
+        "vsl", "Command \"exit\" received. Quitting Verisocks ...");
+    vsl_msg_return(ex.fd_client_socket, "ack",
+        "Processing exit command - Quitting Verisocks.", &ex.uuid);
+
+    /* Simulate all the instances until $finish */
+    ex.parallel_for([&ex](size_t k) {
+        T* p_model = ex.models[k].get();
+        VerilatedContext* p_context = ex.contexts[k].get();
+        while (!ex.finished[k] && !p_context->gotFinish()) {
+            p_model->eval();
+            if (!p_model->eventsPending()) break;
+            p_context->time(p_model->nextTimeSlot());
+        }
+        ex.finished[k] = 1u;
+    });
+    ex.final_all();
+    ex._state = VSL_STATE_EXIT;
+    return;
+}
+
+template<typename T>
+void VslEnsemble<T>::VSL_ENS_CMD_HANDLER(finish) {
+    vs_log_mod_info(
+        "vsl", "Command \"finish\" received. Terminating simulation...");
+    vsl_msg_return(ex.fd_client_socket, "ack",
+        "Processing finish command - Terminating simulation.", &ex.uuid);
+    for (auto& p_context : ex.contexts) p_context->gotFinish(true);
+    ex.final_all();
+    ex._state = VSL_STATE_EXIT;
+    return;
+}
+
+template<typename T>
+void VslEnsemble<T>::VSL_ENS_CMD_HANDLER(not_supported) {
+    vs_log_mod_error("vsl", "Command not supported in ensemble mode");
+    vsl_msg_return(ex.fd_client_socket, "error",
+        "Command not supported in ensemble mode - Discarding", &ex.uuid);
+    ex._state = VSL_STATE_WAITING;
+    return;
+}
+
+/******************************************************************************
+Run command handler
+******************************************************************************/
+template<typename T>
+void VslEnsemble<T>::VSL_ENS_CMD_HANDLER(run) {
+
+    /* Error handler lambda function */
+    auto handle_error = [&]() {
+        vsl_msg_return(ex.fd_client_socket, "error",
+            "Error processing command run - Discarding", &ex.uuid);
+        ex._state = VSL_STATE_WAITING;
+    };
+
+    /* Only time-based callbacks are supported, since all the instances have
+    to get back to the main loop at the same time */
+    char* cstr_cb = cJSON_GetStringValue(cJSON_GetObjectItem(ex.p_cmd, "cb"));
+    std::string str_cb(nullptr == cstr_cb ? "" : cstr_cb);
+    if ((str_cb != "for_time") && (str_cb != "until_time")) {
+        vs_log_mod_error("vsl", "Command field \"cb\" should be \"for_time\" \
+or \"until_time\" in ensemble mode");
+        handle_error();
+        return;
+    }
+
+    cJSON* p_item_time = cJSON_GetObjectItem(ex.p_cmd, "time");
+    if (!cJSON_IsNumber(p_item_time)) {
+        vs_log_mod_error("vsl", "Command field \"time\" invalid/not found");
+        handle_error();
+        return;
+    }
+    double time_value = cJSON_GetNumberValue(p_item_time);
+    char* str_time_unit = cJSON_GetStringValue(
+        cJSON_GetObjectItem(ex.p_cmd, "time_unit"));
+    if ((nullptr == str_time_unit) ||
+        !check_time_unit(std::string(str_time_unit))) {
+        vs_log_mod_error("vsl", "Command field \"time_unit\" invalid/not \
+found");
+        handle_error();
+        return;
+    }
+    vs_log_mod_info("vsl", "Command \"run(cb=%s, time=%f %s)\" received.",
+        str_cb.c_str(), time_value, str_time_unit);
+
+    /* Callback time of each instance, all checked before running any */
+    std::vector<vsl_time_t> t_end(ex.members.size(), 0ull);
+    for (size_t k = 0; k < ex.members.size(); k++) {
+        if (ex.finished[k]) continue;
+        VerilatedContext* p_context = ex.contexts[k].get();
+        t_end[k] = double_to_time(time_value, str_time_unit, p_context);
+        if (str_cb == "for_time") t_end[k] += p_context->time();
+        if (t_end[k] <= p_context->time()) {
+            vs_log_mod_error("vsl", "Time value is not in the future for \
+instance %zu - Discarding", k);
+            handle_error();
+            return;
+        }
+    }
+
+    if (0 == ex.run_until(t_end)) {
+        vsl_msg_return(ex.fd_client_socket, "error",
+            "Exiting Verisocks due to end of simulation", &ex.uuid);
+        ex._state = VSL_STATE_SIM_FINISH;
+        return;
+    }
+
+    /* Acknowledgement, with the instances which have reached $finish */
+    cJSON* p_msg = cJSON_CreateObject();
+    cJSON* p_finished = nullptr;
+    if ((nullptr == p_msg) ||
+        (nullptr == cJSON_AddStringToObject(p_msg, "type", "ack")) ||
+        (nullptr == cJSON_AddStringToObject(p_msg, "value",
+            "Reached callback - Getting back to Verisocks main loop")) ||
+        (nullptr == (p_finished = cJSON_AddArrayToObject(p_msg, "finished"))))
+    {
+        vs_log_mod_error("vsl", "Could not create return message");
+        cJSON_Delete(p_msg);
+        handle_error();
+        return;
+    }
+    for (uint8_t b_finished : ex.finished) {
+        cJSON_AddItemToArray(p_finished, cJSON_CreateBool(b_finished));
+    }
+    ex.write_message(p_msg);
+    cJSON_Delete(p_msg);
+    ex._state = VSL_STATE_WAITING;
+    return;
+}
+
+/******************************************************************************
+Set command handler
+******************************************************************************/
+template<typename T>
+void VslEnsemble<T>::VSL_ENS_CMD_HANDLER(set) {
+
+    /* Error handler lambda function */
+    auto handle_error = [&]() {
+        vsl_msg_return(ex.fd_client_socket, "error",
+            "Error processing command set - Discarding", &ex.uuid);
+        ex._state = VSL_STATE_WAITING;
+    };
+
+    cJSON* p_item_sel = cJSON_GetObjectItem(ex.p_cmd, "sel");
+    char* cstr_sel = cJSON_GetStringValue(p_item_sel);
+    if ((nullptr != p_item_sel) &&
+        ((nullptr == cstr_sel) || (std::string(cstr_sel) != "value"))) {
+        vs_log_mod_error("vsl", "Only set(sel=value) is supported in \
+ensemble mode");
+        handle_error();
+        return;
+    }
+
+    char* cstr_path = cJSON_GetStringValue(
+        cJSON_GetObjectItem(ex.p_cmd, "path"));
+    if ((nullptr == cstr_path) || std::string(cstr_path).empty()) {
+        vs_log_mod_error("vsl", "Command field \"path\" invalid/not found");
+        handle_error();
+        return;
+    }
+    vs_log_mod_info("vsl", "Command \"set(path=%s)\" received.", cstr_path);
+
+    /* Either the same value for all instances, or one value per instance */
+    cJSON* p_item_values = cJSON_GetObjectItem(ex.p_cmd, "values");
+    if ((nullptr != p_item_values) && (!cJSON_IsArray(p_item_values) ||
+        (ex.members.size() !=
+            static_cast<size_t>(cJSON_GetArraySize(p_item_values)))))
+    {
+        vs_log_mod_error("vsl", "Command field \"values\" should be an array \
+with %zu values", ex.members.size());
+        handle_error();
+        return;
+    }
+    cJSON* p_item_value = cJSON_GetObjectItem(ex.p_cmd, "value");
+    auto item_val = [&](size_t k) {
+        return (nullptr == p_item_values) ? p_item_value :
+            cJSON_GetArrayItem(p_item_values, static_cast<int>(k));
+    };
+
+    /* All the values are checked before any instance is modified */
+    for (size_t k = 0; k < ex.members.size(); k++) {
+        if (0 > ex.members[k]->check_var_value(cstr_path, item_val(k))) {
+            vs_log_mod_error("vsl", "Could not set %s for instance %zu",
+                cstr_path, k);
+            handle_error();
+            return;
+        }
+    }
+    for (size_t k = 0; k < ex.members.size(); k++) {
+        if (0 > ex.members[k]->set_var_value(cstr_path, item_val(k))) {
+            handle_error();
+            return;
+        }
+    }
+
+    vsl_msg_return(ex.fd_client_socket, "ack",
+        "Processed command \"set\"", &ex.uuid);
+    ex._state = VSL_STATE_WAITING;
+    return;
+}
+
+/******************************************************************************
+Get command handler
+******************************************************************************/
+template<typename T>
+void VslEnsemble<T>::VSL_ENS_CMD_HANDLER(get) {
+    cJSON* p_msg = nullptr;
+
+    /* Error handler lambda function */
+    auto handle_error = [&]() {
+        if (nullptr != p_msg) cJSON_Delete(p_msg);
+        vsl_msg_return(ex.fd_client_socket, "error",
+            "Error processing command get - Discarding", &ex.uuid);
+        ex._state = VSL_STATE_WAITING;
+    };
+
+    char* cstr_sel = cJSON_GetStringValue(cJSON_GetObjectItem(ex.p_cmd, "sel"));
+    std::string str_sel(nullptr == cstr_sel ? "" : cstr_sel);
+    vs_log_mod_info("vsl", "Command \"get(sel=%s)\" received.",
+        str_sel.c_str());
+
+    p_msg = cJSON_CreateObject();
+    if ((nullptr == p_msg) ||
+        (nullptr == cJSON_AddStringToObject(p_msg, "type", "result"))) {
+        vs_log_mod_error("vsl", "Could not create return message");
+        handle_error();
+        return;
+    }
+
+    if (str_sel == "sim_info") {
+        T* p_model = ex.models[0].get();
+        VerilatedContext* p_context = ex.contexts[0].get();
+        if ((nullptr == cJSON_AddStringToObject(p_msg, "product",
+                Verilated::productName())) ||
+            (nullptr == cJSON_AddStringToObject(p_msg, "version",
+                Verilated::productVersion())) ||
+            (nullptr == cJSON_AddStringToObject(p_msg, "model_name",
+                p_model->modelName())) ||
+            (nullptr == cJSON_AddStringToObject(p_msg, "model_hier_name",
+                p_model->hierName())) ||
+            (nullptr == cJSON_AddStringToObject(p_msg, "time_unit",
+                p_context->timeunitString())) ||
+            (nullptr == cJSON_AddStringToObject(p_msg, "time_precision",
+                p_context->timeprecisionString())) ||
+            (nullptr == cJSON_AddNumberToObject(p_msg, "instances",
+                ex.members.size())) ||
+            (nullptr == cJSON_AddNumberToObject(p_msg, "threads",
+                ex.num_threads)))
+        {
+            vs_log_mod_error("vsl", "Could not add item to object");
+            handle_error();
+            return;
+        }
+    } else if (str_sel == "sim_time") {
+        cJSON* p_times = cJSON_AddArrayToObject(p_msg, "time");
+        if (nullptr == p_times) {
+            vs_log_mod_error("vsl", "Could not add array to object");
+            handle_error();
+            return;
+        }
+        for (auto& p_context : ex.contexts) {
+            cJSON_AddItemToArray(p_times, cJSON_CreateNumber(
+                p_context->time() *
+                std::pow(10.0, p_context->timeprecision())));
+        }
+    } else if (str_sel == "value") {
+        cJSON* p_item_path = cJSON_GetObjectItem(ex.p_cmd, "path");
+        if (nullptr == p_item_path) {
+            vs_log_mod_error("vsl", "Command field \"path\" invalid/not \
+found");
+            handle_error();
+            return;
+        }
+        char* cstr_format = cJSON_GetStringValue(
+            cJSON_GetObjectItem(ex.p_cmd, "format"));
+        std::string str_format(nullptr == cstr_format ? "number" : cstr_format);
+        if ((str_format != "hex") && (str_format != "number")) {
+            vs_log_mod_error("vsl",
+                "Command field \"format\" should be \"number\" or \"hex\"");
+            handle_error();
+            return;
+        }
+        if (0 > ex.add_values(p_item_path, p_msg, str_format == "hex")) {
+            handle_error();
+            return;
+        }
+    } else {
+        vs_log_mod_error("vsl", "Only get(sel=sim_info|sim_time|value) is \
+supported in ensemble mode");
+        handle_error();
+        return;
+    }
+
+    if (0 > ex.write_message(p_msg)) {
+        handle_error();
+        return;
+    }
+    cJSON_Delete(p_msg);
+    ex._state = VSL_STATE_WAITING;
+    return;
+}
+
+} //namespace vsl
+
+#endif //VSL_ENSEMBLE_HPP
+//EOF
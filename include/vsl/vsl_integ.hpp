@@ -13,9 +13,26 @@
  - Registration and access of Verilated variables (scalars, arrays,
    parameters, events).
  - Callback management for simulation time and value changes.
+ - Runtime-controlled trace windows (VCD or FST), if the model has been
+   verilated with tracing enabled.
+ - Checkpoints of the model and integration state (to a file or in memory),
+   if the model has been verilated with the --savable option.
+ - Forking of the simulation process, each branch being controlled through its
+   own server socket.
+ - Optional background socket I/O thread (message framing and JSON parsing),
+   with configurable CPU affinities.
+ - Playback of input vectors from a memory-mapped file, one row per clock edge
+   or time step.
+ - Plugins (e.g. bus-functional models) called on clock edges, with their own
+   commands.
  - Main FSM for simulation lifecycle: initialization, connection, command
    processing, simulation running, and graceful shutdown.
 
+ The member functions of the individual features (trace windows, checkpoints,
+ fork, restart, clock edge sampler and flight recorder, playback, plugins)
+ are defined in their own headers, next to the corresponding command
+ handlers. All of them are included by vsl.h.
+
  Usage:
  - Instantiate `VslInteg<T>` with your Verilated model type.
  - Register variables and events to expose them to Verisocks commands.
@@ -56,16 +73,44 @@ SOFTWARE.
 #include "vs_server.h"
 #include "vs_logging.h"
 #include "vs_msg.h"
+#include "vs_index.h"
+#include "vs_io.h"
 #include "verilated.h"
 #include "verilated_syms.h"
 #include "vsl/vsl_types.hpp"
 #include "vsl/vsl_clocks.hpp"
-
+#include "vsl/vsl_trigger.hpp"
+#include "vsl/vsl_checkpoint.hpp"
+#include "vsl/vsl_plugin.hpp"
+
+/* Trace formats available, as defined by Verilator's generated makefiles
+(--trace and/or --trace-fst verilator options) */
+#if defined(VM_TRACE_FST) && VM_TRACE_FST
+#include "verilated_fst_c.h"
+#define VSL_TRACE_FST
+#endif
+#if (defined(VM_TRACE_VCD) && VM_TRACE_VCD) || \
+    (defined(VM_TRACE) && VM_TRACE && !defined(VSL_TRACE_FST))
+#include "verilated_vcd_c.h"
+#define VSL_TRACE_VCD
+#endif
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <functional>
+#include <limits>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/types.h>
 
 
 /**
@@ -87,6 +132,134 @@ SOFTWARE.
 
 namespace vsl{
 
+/**
+ * @brief Writes a message to a client socket, through its I/O thread if any
+ *
+ * @param fd Client socket descriptor
+ * @param str_msg Message to be sent (e.g. as created by vs_msg_create_message)
+ * @param p_msg_info Message information, as updated by vs_msg_create_message
+ * @return Returns 0 if successful, -1 in case of error
+ */
+static inline int vsl_msg_write(int fd, const char* str_msg,
+    const vs_msg_info_t* p_msg_info)
+{
+    vs_io_t* p_io = vs_io_find(fd);
+    if (nullptr != p_io) {
+        return vs_io_write(p_io, str_msg,
+            vs_msg_read_header_length(str_msg) + p_msg_info->len + 2);
+    }
+    return vs_msg_write(fd, str_msg);
+}
+
+/**
+ * @brief Returns a message with type and value fields to a client socket,
+ * through its I/O thread if any (same as vs_msg_return otherwise)
+ *
+ * @param fd Client socket descriptor
+ * @param str_type Message type (e.g. "ack")
+ * @param str_value Message value
+ * @param p_uuid Pointer to transaction UUID
+ * @return Returns 0 if successful, -1 in case of error
+ */
+static inline int vsl_msg_return(int fd, const char* str_type,
+    const char* str_value, const vs_uuid_t* p_uuid)
+{
+    if (nullptr == vs_io_find(fd)) {
+        return vs_msg_return(fd, str_type, str_value, p_uuid);
+    }
+    vs_msg_info_t msg_info = VS_MSG_INFO_INIT_JSON;
+    vs_msg_copy_uuid(&msg_info, p_uuid);
+    cJSON* p_msg = cJSON_CreateObject();
+    char* str_msg = nullptr;
+    int retval = -1;
+    if ((nullptr != p_msg) &&
+        (nullptr != cJSON_AddStringToObject(p_msg, "type", str_type)) &&
+        (nullptr != cJSON_AddStringToObject(p_msg, "value", str_value)))
+    {
+        str_msg = vs_msg_create_message(p_msg, &msg_info);
+    }
+    if (nullptr != str_msg) {
+        retval = vsl_msg_write(fd, str_msg, &msg_info);
+        cJSON_free(str_msg);
+    }
+    if (0 > retval) vs_log_mod_error("vsl", "Error writing return message");
+    cJSON_Delete(p_msg);
+    return retval;
+}
+
+/**
+ * @brief Returns an acknowledgement message with additional fields to a
+ * client socket, through its I/O thread if any
+ *
+ * The message contains the "type" ("ack") and "value" fields, followed by the
+ * fields of the p_fields object. If the message cannot be created, an error
+ * message is returned instead.
+ *
+ * @param fd Client socket descriptor
+ * @param str_value Message value
+ * @param p_fields Object with the additional fields, deleted by the function
+ * @param p_uuid Pointer to transaction UUID
+ * @return Returns 0 if successful, -1 in case of error
+ */
+static inline int vsl_msg_return_ack(int fd, const char* str_value,
+    cJSON* p_fields, const vs_uuid_t* p_uuid)
+{
+    cJSON* p_msg = cJSON_CreateObject();
+    bool b_created = (nullptr != p_fields) && (nullptr != p_msg) &&
+        (nullptr != cJSON_AddStringToObject(p_msg, "type", "ack")) &&
+        (nullptr != cJSON_AddStringToObject(p_msg, "value", str_value));
+    while (b_created && (nullptr != p_fields->child)) {
+        cJSON* p_item = cJSON_DetachItemViaPointer(p_fields, p_fields->child);
+        b_created = cJSON_AddItemToObject(p_msg, p_item->string, p_item);
+        if (!b_created) cJSON_Delete(p_item);
+    }
+    cJSON_Delete(p_fields);
+    if (!b_created) {
+        vs_log_mod_error("vsl", "Could not create return message");
+        cJSON_Delete(p_msg);
+        vsl_msg_return(fd, "error", "Could not create return message",
+            p_uuid);
+        return -1;
+    }
+    vs_msg_info_t msg_info = VS_MSG_INFO_INIT_JSON;
+    vs_msg_copy_uuid(&msg_info, p_uuid);
+    char* str_msg = vs_msg_create_message(p_msg, &msg_info);
+    cJSON_Delete(p_msg);
+    int retval = -1;
+    if (nullptr != str_msg) {
+        retval = vsl_msg_write(fd, str_msg, &msg_info);
+        cJSON_free(str_msg);
+    }
+    if (0 > retval) vs_log_mod_error("vsl", "Error writing return message");
+    return retval;
+}
+
+/**
+ * @brief Returns a binary message to a client socket, through its I/O thread
+ * if any
+ *
+ * @param fd Client socket descriptor
+ * @param p_data Pointer to the message content
+ * @param len Message content length, in bytes (at least 1)
+ * @param p_uuid Pointer to transaction UUID
+ * @return Returns 0 if successful, -1 in case of error
+ */
+static inline int vsl_msg_return_bin(int fd, const void* p_data,
+    const size_t len, const vs_uuid_t* p_uuid)
+{
+    vs_msg_info_t msg_info = VS_MSG_INFO_INIT_BIN;
+    vs_msg_copy_uuid(&msg_info, p_uuid);
+    msg_info.len = len;
+    char* str_msg = vs_msg_create_message(p_data, &msg_info);
+    int retval = -1;
+    if (nullptr != str_msg) {
+        retval = vsl_msg_write(fd, str_msg, &msg_info);
+        cJSON_free(str_msg);
+    }
+    if (0 > retval) vs_log_mod_error("vsl", "Error writing return message");
+    return retval;
+}
+
 /**
  * @enum VslState
  * @brief Internal state values for the VSL finite-state machine
@@ -102,6 +275,9 @@ enum VslState {
     VSL_STATE_ERROR        ///<Error state (e.g. timed out while waiting for a connection)
 };
 
+template<typename T> class VslEnsemble;
+template<typename T> class VslServer;
+
 /**
  * @class VslInteg
  * @brief Top-level class to use for using Verisocks with Verilator
@@ -146,6 +322,29 @@ public:
      */
     void set_finish_time(const double time, const char* unit);
 
+    /**
+     * @brief Enable or disable the background socket I/O thread
+     *
+     * With the I/O thread enabled, reading and framing the received messages,
+     * parsing them as JSON and writing the returned messages are done by a
+     * separate thread, which exchanges them with the simulation thread
+     * through lock-free queues. Commands sent in advance by the client are
+     * thus already decoded when needed, and returned messages are sent while
+     * the model is being evaluated. This function shall be called before
+     * run().
+     *
+     * @param enable Use the I/O thread if true
+     * @param io_cpu CPU index to which the I/O thread is pinned (-1 for none)
+     * @param eval_cpu CPU index to which the thread calling run(), which
+     * evaluates the model, is pinned (-1 for none)
+     */
+    void set_io_thread(const bool enable, const int io_cpu=-1,
+        const int eval_cpu=-1) {
+            b_io_thread = enable;
+            num_io_cpu = io_cpu;
+            num_eval_cpu = eval_cpu;
+    }
+
     /**
      * @brief Run Verisocks FSM
      *
@@ -229,6 +428,31 @@ public:
                 namep, datap, vltype, VSL_TYPE_ARRAY, width, depth);
     }
 
+    /**
+     * @brief Register a multi-dimensional array variable
+     *
+     * This function shall be used from the top-level C++ testbench code in
+     * order to register an array variable with several unpacked dimensions
+     * to be accessible with Verisocks commands. The array storage is
+     * expected to be contiguous and row-major, as for Verilator's nested
+     * VlUnpacked arrays.
+     *
+     * @param namep Name of the array variable as registered by Verisocks and
+     * how it will be used within Verisocks commands
+     * @param datap Pointer to the first element of the array variable in the
+     * verilated C++ code
+     * @param vltype Variable verilated type
+     * @param width Variable width (should be consistent with vltype)
+     * @param shape Number of elements of each unpacked dimension, from the
+     * outermost one (e.g. {4, 16} for mem[0:3][0:15])
+     */
+    inline void register_mdarray(const char* namep, std::any datap,
+        VerilatedVarType vltype, size_t width,
+        const std::vector<size_t>& shape) {
+            var_map.add_var(namep, datap, vltype, VSL_TYPE_MDARRAY,
+                shape.size() + 1, width, 0u, shape);
+    }
+
     /**
      * @brief Register an event variable
      *
@@ -244,7 +468,44 @@ public:
         register_variable(namep, eventp, VLVT_UINT8, VSL_TYPE_EVENT, 1u);
     }
 
+    /**
+     * @brief Register all the public variables of the Verilated model
+     *
+     * This function walks once through all the scopes of the Verilator
+     * context and registers each public variable which has not already been
+     * registered, with its type, width and depth as described by Verilator.
+     * The variables are registered with their path relative to the model
+     * hierarchical name, e.g. "main.count". Parameters are registered as
+     * parameters, 1-dimensional unpacked arrays as arrays, unpacked arrays
+     * with more dimensions as multi-dimensional arrays and the others
+     * (including wide variables) as scalars. Variables with unsupported
+     * Verilator types (e.g. strings) are skipped.
+     *
+     * It shall be called after the explicit registrations, if any, and before
+     * run(). The time spent indexing the design is logged.
+     *
+     * @return Number of registered variables, -1 in case of error
+     */
+    int auto_register();
+
+    /**
+     * @brief Register a plugin
+     *
+     * This function shall be used from the top-level C++ testbench code in
+     * order to register a plugin (see vsl::VslPlugin), once the variables it
+     * uses and its clock have been registered. The plugin is then called on
+     * the edges of its clock and its commands, named "<name>.<command>", are
+     * accessible with Verisocks.
+     *
+     * @param p_plugin Plugin, owned by the VslInteg object
+     * @return 0 if successful, -1 otherwise
+     */
+    int register_plugin(std::unique_ptr<VslPlugin> p_plugin);
+
 private:
+    friend class VslEnsemble<T>;
+    friend class VslServer<T>;
+
     VslState _state {VSL_STATE_INIT}; //Verisocks state
     cJSON* p_cmd {nullptr}; //Pointer to current/latest command
 
@@ -266,6 +527,11 @@ private:
     int fd_server_socket {-1};     //File descriptor, server socket
     int fd_client_socket {-1};     //File descriptor, connected client socket
     bool _is_connected {false};    //Socket connection status
+    bool b_io_thread {false};      //Use a background socket I/O thread
+    int num_io_cpu {-1};           //I/O thread CPU affinity (-1 for none)
+    int num_eval_cpu {-1};         //Simulation thread CPU affinity
+    vs_io_t* p_io {nullptr};       //Background socket I/O thread, if any
+    bool b_session {false};        //Single client session (VslServer)
     vs_uuid_t uuid {0u, VS_UUID_NULL};  //Transaction UUID
 
     /* Callbacks management */
@@ -273,14 +539,123 @@ private:
     bool b_has_value_callback {false};
     vsl_time_t cb_time {0ull};
     std::string cb_value_path;
+    VslVar* p_cb_value_var {nullptr};   //Resolved once at registration
     double cb_value {0.0};
+    VslTrigger trigger {};              //Trigger expression (run until_expr)
+
+    /* Periodic sampling (run with cb=sample) */
+    bool b_has_sampler {false};
+    vsl_time_t sample_period {0ull};
+    size_t sample_count {0};
+    std::vector<std::string> sample_paths {};
+    std::vector<VslVar*> sample_vars {};
+    std::vector<double> sample_times {};
+    std::vector<double> sample_values {};  //Column-wise storage
+
+    /* Clock edge sampling (set with sel=sampler). Each variable value is
+    appended to a preallocated column buffer with its native size. */
+    struct EdgeColumn {
+        std::string path;
+        VslVar* p_var;
+        size_t size;                   //Bytes per value
+        std::vector<uint8_t> data;
+    };
+    bool b_has_edge_sampler {false};
+    std::string edge_clock {};
+    const CData* p_edge_clock {nullptr};
+    CData edge_level {1};              //Clock level after the sampled edge
+    size_t edge_capacity {0};
+    size_t edge_count {0};
+    uint64_t edge_dropped {0ull};      //Edges missed while full
+    std::vector<EdgeColumn> edge_columns {};
+
+    /* Flight recorder (set with sel=recorder). The values are recorded on
+    each clock edge in ring buffers, which are frozen once a given number of
+    samples has been recorded after the trigger. */
+    bool b_has_recorder {false};
+    std::string rec_clock {};
+    const CData* p_rec_clock {nullptr};
+    CData rec_level {1};
+    size_t rec_depth {0};
+    size_t rec_pos {0};                //Next position in the ring buffers
+    size_t rec_count {0};              //Number of recorded samples
+    size_t rec_post {0};               //Samples to record after the trigger
+    size_t rec_post_count {0};         //Samples recorded after the trigger
+    bool b_rec_trigger_pending {false};  //Trigger on the next edge
+    bool b_rec_triggered {false};
+    bool b_rec_frozen {false};
+    VslTrigger rec_trigger {};         //Trigger condition, if any
+    std::vector<EdgeColumn> rec_columns {};
+
+    /* Stimulus playback (play command). The rows of a memory-mapped vector
+    file are applied one by one, on each clock edge or time step. */
+    bool b_has_player {false};
+    bool b_play_done {false};          //All the rows have been applied
+    const uint8_t* p_play_map {nullptr};
+    size_t play_map_size {0};
+    const uint8_t* p_play_row {nullptr};  //Next row to be applied
+    size_t play_num_rows {0};
+    size_t play_pos {0};               //Number of applied rows
+    vsl_time_t play_period {0ull};     //Time step, 0 for clock edges
+    const CData* p_play_clock {nullptr};  //Clock, only for clock edges
+    CData play_level {1};
+    std::vector<EdgeColumn> play_columns {};
+
+    /* Plugins, each one with the clock (or 1-bit variable) on which edges it
+    is called and the clock level as seen after the previous evaluation */
+    struct PluginSlot {
+        std::unique_ptr<VslPlugin> p_plugin;
+        const CData* p_clock;
+        CData level;
+    };
+    std::vector<PluginSlot> plugins {};
+    VslPlugin* p_plugin_active {nullptr};  //Plugin running a transaction
+    std::string plugin_cmd {};             //Command of the transaction
+
+    /* Hierarchy index (built on first use) */
+    vs_index_t* p_index {nullptr};
 
     /* Simulation (optional) finish time */
     bool b_has_finish_time {false};
     vsl_time_t finish_time {0};
 
+    /* Trace windows (trace command). The model is attached to a single trace
+    object, created with the first window; values are only dumped while a
+    window is active. */
+    #ifdef VSL_TRACE_VCD
+    std::unique_ptr<VerilatedVcdC> p_trace_vcd {nullptr};
+    #endif
+    #ifdef VSL_TRACE_FST
+    std::unique_ptr<VerilatedFstC> p_trace_fst {nullptr};
+    #endif
+    bool b_trace_active {false};
+    bool b_trace_dumped {false};     //Dumped at least once in current window
+    vsl_time_t trace_last_time {0};  //Time of the latest dump
+    std::string trace_format {};     //Format of the trace object, if any
+    int trace_depth {0};             //Depth of the trace object, if any
+    std::string trace_path {};       //File path of the current window
+
+    /* In-memory checkpoints, by name (checkpoint command) */
+    std::unordered_map<std::string, std::vector<uint8_t>> checkpoints {};
+
+    /* Forked simulation processes (fork command), reaped once terminated */
+    std::vector<pid_t> fork_children {};
+
+    /* Clocks scheduling states and levels at the start of the simulation
+    (restart command) */
+    std::vector<VslClock::State> clock_states_init {};
+    std::vector<double> clock_levels_init {};
+
     /* State machine functions */
+    int main_loop();
+    int run_session(const int fd_client);
     void main_init();
+    void main_wait_io();
+    int io_start();
+    void io_stop() {
+        vs_io_stop(p_io);
+        p_io = nullptr;
+    }
     void main_connect();
     void main_wait();
     void main_process();
@@ -304,21 +679,101 @@ private:
 
     /* Callback functions*/
     int register_value_callback(const char* path, const double value);
+    int register_trigger(const std::string& expr);
     int register_time_callback(const vsl_time_t time);
+    int register_sampler(const vsl_time_t period, const size_t count,
+        const std::vector<std::string>& paths);
     void clear_callbacks() {
         b_has_time_callback = false;
         b_has_value_callback = false;
+        b_has_sampler = false;
+        trigger.clear();
+        if (b_has_player) clear_player();
+        if (nullptr != p_plugin_active) {
+            if (p_plugin_active->busy()) p_plugin_active->abort();
+            p_plugin_active = nullptr;
+        }
     }
+    void callback_return(const char* str_msg, bool b_triggered);
 
     inline const bool has_callback() {
-        return (b_has_value_callback || b_has_time_callback);
+        return (b_has_value_callback || b_has_time_callback || b_has_player ||
+            (nullptr != p_plugin_active));
     }
     inline const bool has_value_callback() {return b_has_value_callback;}
     inline const bool has_time_callback() {return b_has_time_callback;}
+    inline const bool has_sampler() {return b_has_sampler;}
     const bool check_value_callback();
+    const bool sampler_step();
+    void sampler_return();
+
+    /* Clock edge sampling and flight recorder functions */
+    int edge_columns_init(const std::vector<std::string>& paths,
+        const size_t capacity, std::vector<EdgeColumn>& columns);
+    int register_edge_sampler(const std::string& clock, const bool rising,
+        const std::vector<std::string>& paths, const size_t capacity);
+    void clear_edge_sampler();
+    inline void edge_sampler_step();
+    std::vector<uint8_t> edge_samples();
+    int register_recorder(const std::string& clock, const bool rising,
+        const std::vector<std::string>& paths, const size_t depth,
+        const size_t post, const std::string& expr);
+    void clear_recorder();
+    void reset_recorder();
+    inline void recorder_step();
+    std::vector<uint8_t> recorder_window();
+    int edge_columns_return(const std::vector<EdgeColumn>& columns,
+        const char* str_value);
+
+    /* Stimulus playback functions */
+    int register_player(const std::string& path, const std::string& clock,
+        const bool rising, const vsl_time_t period);
+    void clear_player();
+    inline const bool has_player() {return b_has_player;}
+    inline void play_row();
+    inline const bool play_step();
+    void play_return(const bool b_triggered);
+
+    /* Plugin functions */
+    VslPlugin* get_plugin(const std::string& name);
+    const CData* get_plugin_clock(const std::string& path);
+    void plugins_rebind();
+    inline const bool has_plugin_run() {return nullptr != p_plugin_active;}
+    inline void plugins_step();
+    void plugin_return(VslPlugin* p_plugin);
+
+    /* Trace windows functions */
+    int trace_start(const std::string& path, const std::string& format,
+        int depth);
+    int trace_stop();
+    int trace_flush();
+    void trace_dump();
+    const std::string trace_default_format() const;
+
+    /* Checkpoint functions */
+    int checkpoint_save(const std::string& path, const std::string& name);
+    int checkpoint_restore(const std::string& path, const std::string& name);
+    template<typename S> void save_state(S& os);
+    template<typename D> int restore_state(D& is);
+    int checkpoint_check(const std::vector<uint8_t>& buffer);
+
+    /* Fork functions */
+    pid_t fork_sim(const int port, int& fork_port);
+    void fork_reap();
+
+    /* Restart function */
+    int restart_model();
 
     /* Simulation control wrappers functions */
     void eval();
+    inline void advance_time(const vsl_time_t time) {
+        if (b_trace_active) trace_dump();
+        p_context->time(time);
+    }
+    template<bool CHECK_VALUE> bool sim_loop(const vsl_time_t t_end);
+    void main_sim_run();
+    bool sim_until(const vsl_time_t t_end);
+    uint64_t num_sim_evals {0ull};  //Number of evaluated time slots
     const bool has_events_pending() const;
     const vsl_time_t next_event_time() const;
 
@@ -329,6 +784,18 @@ private:
 
     /* Get a pointer for a given public variable */
     VerilatedVar* get_var(std::string str_path);
+    bool get_relative_scope(const char* scope_name, std::string& str_scope);
+
+    /* Hierarchy index and value query functions */
+    vs_index_t* get_index();
+    int add_var_value(std::string str_path, cJSON* p_obj, const char* key,
+        bool hex = false);
+    int add_bulk_values(const char* cstr_path, cJSON* p_values,
+        bool check_dup, bool hex = false);
+    int set_var_value(std::string str_path, cJSON* p_item_val);
+    int check_var_value(std::string str_path, cJSON* p_item_val);
+    int get_edge_args(std::string& str_clock, bool& b_rising,
+        std::vector<std::string>& paths);
 
     /* Declaration of command handlers functions */
     /*
@@ -346,6 +813,9 @@ private:
     static void VSL_CMD_HANDLER(get_sim_info);
     static void VSL_CMD_HANDLER(get_sim_time);
     static void VSL_CMD_HANDLER(get_value);
+    static void VSL_CMD_HANDLER(get_list);
+    static void VSL_CMD_HANDLER(get_samples);
+    static void VSL_CMD_HANDLER(get_recorder);
     static void VSL_CMD_HANDLER(finish);
     static void VSL_CMD_HANDLER(stop);
     static void VSL_CMD_HANDLER(exit);
@@ -354,10 +824,25 @@ private:
     static void VSL_CMD_HANDLER(run_until_time);
     static void VSL_CMD_HANDLER(run_until_change);
     static void VSL_CMD_HANDLER(run_to_next);
+    static void VSL_CMD_HANDLER(run_sample);
+    static void VSL_CMD_HANDLER(run_until_expr);
     static void VSL_CMD_HANDLER(set);
     static void VSL_CMD_HANDLER(set_value);
     static void VSL_CMD_HANDLER(set_clk_en);
     static void VSL_CMD_HANDLER(set_clk_cfg);
+    static void VSL_CMD_HANDLER(set_sampler);
+    static void VSL_CMD_HANDLER(set_recorder);
+    static void VSL_CMD_HANDLER(set_recorder_trigger);
+    static void VSL_CMD_HANDLER(trace);
+    static void VSL_CMD_HANDLER(trace_start);
+    static void VSL_CMD_HANDLER(trace_stop);
+    static void VSL_CMD_HANDLER(trace_flush);
+    static void VSL_CMD_HANDLER(checkpoint);
+    static void VSL_CMD_HANDLER(restore);
+    static void VSL_CMD_HANDLER(fork);
+    static void VSL_CMD_HANDLER(restart);
+    static void VSL_CMD_HANDLER(play);
+    static void VSL_CMD_HANDLER(plugin);
     static void VSL_CMD_HANDLER(not_supported);
 };
 
@@ -385,19 +870,38 @@ VslInteg<T>::VslInteg(T* p_model, const int port, const int timeout) {
     cmd_handlers_map["finish"] = VSL_CMD_HANDLER_NAME(finish);
     cmd_handlers_map["stop"]   = VSL_CMD_HANDLER_NAME(stop);
     cmd_handlers_map["exit"]   = VSL_CMD_HANDLER_NAME(exit);
+    cmd_handlers_map["schedule"] = VSL_CMD_HANDLER_NAME(not_supported);
+    cmd_handlers_map["trace"]  = VSL_CMD_HANDLER_NAME(trace);
+    cmd_handlers_map["checkpoint"] = VSL_CMD_HANDLER_NAME(checkpoint);
+    cmd_handlers_map["restore"] = VSL_CMD_HANDLER_NAME(restore);
+    cmd_handlers_map["fork"]   = VSL_CMD_HANDLER_NAME(fork);
+    cmd_handlers_map["restart"] = VSL_CMD_HANDLER_NAME(restart);
+    cmd_handlers_map["play"]   = VSL_CMD_HANDLER_NAME(play);
 
     // Add sub-commands handler functions to the relevant maps
     sub_cmd_handlers_map["get_sim_info"]     = VSL_CMD_HANDLER_NAME(get_sim_info);
     sub_cmd_handlers_map["get_sim_time"]     = VSL_CMD_HANDLER_NAME(get_sim_time);
     sub_cmd_handlers_map["get_type"]         = VSL_CMD_HANDLER_NAME(not_supported);
     sub_cmd_handlers_map["get_value"]        = VSL_CMD_HANDLER_NAME(get_value);
+    sub_cmd_handlers_map["get_list"]         = VSL_CMD_HANDLER_NAME(get_list);
+    sub_cmd_handlers_map["get_samples"]      = VSL_CMD_HANDLER_NAME(get_samples);
+    sub_cmd_handlers_map["get_recorder"]     = VSL_CMD_HANDLER_NAME(get_recorder);
     sub_cmd_handlers_map["set_value"]        = VSL_CMD_HANDLER_NAME(set_value);
     sub_cmd_handlers_map["set_clk_en"]       = VSL_CMD_HANDLER_NAME(set_clk_en);
     sub_cmd_handlers_map["set_clk_cfg"]      = VSL_CMD_HANDLER_NAME(set_clk_cfg);
+    sub_cmd_handlers_map["set_sampler"]      = VSL_CMD_HANDLER_NAME(set_sampler);
+    sub_cmd_handlers_map["set_recorder"]     = VSL_CMD_HANDLER_NAME(set_recorder);
+    sub_cmd_handlers_map["set_recorder_trigger"] =
+        VSL_CMD_HANDLER_NAME(set_recorder_trigger);
     sub_cmd_handlers_map["run_for_time"]     = VSL_CMD_HANDLER_NAME(run_for_time);
     sub_cmd_handlers_map["run_to_next"]      = VSL_CMD_HANDLER_NAME(run_to_next);
     sub_cmd_handlers_map["run_until_time"]   = VSL_CMD_HANDLER_NAME(run_until_time);
     sub_cmd_handlers_map["run_until_change"] = VSL_CMD_HANDLER_NAME(run_until_change);
+    sub_cmd_handlers_map["run_sample"]       = VSL_CMD_HANDLER_NAME(run_sample);
+    sub_cmd_handlers_map["run_until_expr"]   = VSL_CMD_HANDLER_NAME(run_until_expr);
+    sub_cmd_handlers_map["trace_start"]      = VSL_CMD_HANDLER_NAME(trace_start);
+    sub_cmd_handlers_map["trace_stop"]       = VSL_CMD_HANDLER_NAME(trace_stop);
+    sub_cmd_handlers_map["trace_flush"]      = VSL_CMD_HANDLER_NAME(trace_flush);
     return;
 }
 
@@ -407,8 +911,12 @@ Destructor
 template<typename T>
 VslInteg<T>::~VslInteg() {
     vs_log_mod_debug("vsl", "Destructor called (%s)", __FILE__);
+    io_stop();
     if (0 < fd_server_socket) vs_server_close_socket(fd_server_socket);
     if (nullptr != p_cmd) cJSON_Delete(p_cmd);
+    if (nullptr != p_index) vs_index_free(p_index);
+    if (b_trace_active) trace_stop();
+    fork_reap();
     return;
 }
 
@@ -433,12 +941,54 @@ int VslInteg<T>::run() {
     vs_log_mod_info("vsl", "Verilated without timing extension");
     #endif
 
+    /* Simulation thread CPU affinity (I/O thread option) */
+    if (b_io_thread && (0 <= num_eval_cpu)) {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(num_eval_cpu, &cpu_set);
+        if (0 != pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t),
+            &cpu_set))
+        {
+            vs_log_mod_warning("vsl", "Could not pin simulation thread to \
+CPU %d", num_eval_cpu);
+        }
+    }
+    return main_loop();
+}
+
+/* Runs the FSM for a single client, already connected (VslServer session).
+The session ends when the client disconnects or once the simulation has
+finished, and the client socket is then closed. */
+template<typename T>
+int VslInteg<T>::run_session(const int fd_client) {
+    b_session = true;
+    fd_client_socket = fd_client;
+    _is_connected = true;
+    _state = (0 > io_start()) ? VSL_STATE_ERROR : VSL_STATE_WAITING;
+    int retval = main_loop();
+    if (0 <= fd_client_socket) {
+        vs_server_close_socket(fd_client_socket);
+        fd_client_socket = -1;
+        _is_connected = false;
+    }
+    return retval;
+}
+
+template<typename T>
+int VslInteg<T>::main_loop() {
+    clock_states_init = clock_map.get_states();
+    clock_levels_init = clock_map.get_levels();
     while(true) {
         switch (_state) {
         case VSL_STATE_INIT:
             main_init();
             break;
         case VSL_STATE_CONNECT:
+            /* A session does not wait for another client */
+            if (b_session) {
+                io_stop();
+                return 0;
+            }
             main_connect();
             break;
         case VSL_STATE_WAITING:
@@ -457,6 +1007,8 @@ int VslInteg<T>::run() {
             main_sim_finish();
             break;
         case VSL_STATE_EXIT:
+            /* Stopping the I/O thread sends the pending messages */
+            io_stop();
             if (0 <= fd_server_socket) {
                 vs_server_close_socket(fd_server_socket);
                 fd_server_socket = -1;
@@ -467,6 +1019,7 @@ int VslInteg<T>::run() {
         default:
             vs_log_mod_error("vsl",
                 "Exiting Verisocks main loop (error state)");
+            io_stop();
             if (0 <= fd_server_socket) {
                 vs_server_close_socket(fd_server_socket);
                 fd_server_socket = -1;
@@ -541,10 +1094,31 @@ void VslInteg<T>::main_connect() {
         return;
     }
     vs_log_mod_info("vsl", "Connected to %s", hostname_buffer);
+    if (0 > io_start()) {
+        _state = VSL_STATE_ERROR;
+        return;
+    }
     _state = VSL_STATE_WAITING;
     return;
 }
 
+/* Socket reads, message framing and JSON parsing are done by a background
+thread (optional) so that the next command is already parsed when needed */
+template<typename T>
+int VslInteg<T>::io_start() {
+    if (!b_io_thread) return 0;
+    p_io = vs_io_start(fd_client_socket);
+    if (nullptr == p_io) {
+        vs_log_mod_error("vsl", "Failed to start socket I/O thread");
+        return -1;
+    }
+    if ((0 <= num_io_cpu) && (0 > vs_io_set_affinity(p_io, num_io_cpu))) {
+        vs_log_mod_warning("vsl", "Could not pin I/O thread to CPU %d",
+            num_io_cpu);
+    }
+    return 0;
+}
+
 /******************************************************************************
 Main finite state-machine - Waiting for command
 ******************************************************************************/
@@ -554,15 +1128,21 @@ void VslInteg<T>::main_wait() {
     int msg_len;
     vs_msg_info_t msg_info = VS_MSG_INFO_INIT_UNDEF;
 
+    /* Forked processes which have terminated since the last command */
+    fork_reap();
+
+    if (nullptr != p_io) {
+        main_wait_io();
+        return;
+    }
+
     msg_len = vs_msg_read(
         fd_client_socket, read_buffer, sizeof(read_buffer), &msg_info);
     if (0 > msg_len) {
         vs_server_close_socket(fd_client_socket);
         fd_client_socket = -1;
-        vs_log_mod_info(
-            "vsl",
-            "Lost connection. Waiting for a client to (re-)connect ..."
-        );
+        vs_log_mod_info("vsl", "Lost connection%s", b_session ? "" :
+            ". Waiting for a client to (re-)connect ...");
         _state = VSL_STATE_CONNECT;
         return;
     }
@@ -576,7 +1156,7 @@ void VslInteg<T>::main_wait() {
             "vsl",
             "Received message longer than RX buffer, discarding it"
         );
-        vs_msg_return(fd_client_socket, "error",
+        vsl_msg_return(fd_client_socket, "error",
             "Message too long - Discarding", &uuid);
         return;
     }
@@ -597,7 +1177,48 @@ void VslInteg<T>::main_wait() {
         "Received message content cannot be interpreted as a valid JSON \
 content. Discarding it."
     );
-    vs_msg_return(fd_client_socket, "error",
+    vsl_msg_return(fd_client_socket, "error",
+        "Invalid message content - Discarding", &uuid);
+    return;
+}
+
+/* Gets the next command, as already received and parsed by the I/O thread */
+template<typename T>
+void VslInteg<T>::main_wait_io() {
+    vs_io_msg_t msg;
+    if (0 > vs_io_read(p_io, &msg)) {
+        _state = VSL_STATE_ERROR;
+        return;
+    }
+
+    if (VS_IO_MSG_CLOSED == msg.type) {
+        io_stop();
+        vs_server_close_socket(fd_client_socket);
+        fd_client_socket = -1;
+        vs_log_mod_info("vsl", "Lost connection%s", b_session ? "" :
+            ". Waiting for a client to (re-)connect ...");
+        _state = VSL_STATE_CONNECT;
+        return;
+    }
+
+    uuid.valid = msg.uuid.valid;
+    if (uuid.valid) {
+        memcpy(uuid.value, msg.uuid.value, VS_UUID_LEN);
+    }
+    if (nullptr != p_cmd) {
+        cJSON_Delete(p_cmd);
+    }
+    p_cmd = msg.p_cmd;
+    if (VS_IO_MSG_CMD == msg.type) {
+        _state = VSL_STATE_PROCESSING;
+        return;
+    }
+    vs_log_mod_warning(
+        "vsl",
+        "Received message content cannot be interpreted as a valid JSON \
+content. Discarding it."
+    );
+    vsl_msg_return(fd_client_socket, "error",
         "Invalid message content - Discarding", &uuid);
     return;
 }
@@ -615,7 +1236,7 @@ void VslInteg<T>::main_process() {
     p_item_cmd = cJSON_GetObjectItem(p_cmd, "command");
     if (nullptr == p_item_cmd) {
         vs_log_mod_error("vsl", "Command field invalid/not found");
-        vs_msg_return(fd_client_socket, "error",
+        vsl_msg_return(fd_client_socket, "error",
             "Error processing command. Discarding.", &uuid);
         _state = VSL_STATE_WAITING;
         return;
@@ -625,7 +1246,7 @@ void VslInteg<T>::main_process() {
     c_str_cmd = cJSON_GetStringValue(p_item_cmd);
     if (nullptr == c_str_cmd) {
         vs_log_mod_error("vsl", "Command field invalid");
-        vs_msg_return(fd_client_socket, "error",
+        vsl_msg_return(fd_client_socket, "error",
             "Error processing command. Discarding.", &uuid);
         _state = VSL_STATE_WAITING;
         return;
@@ -634,7 +1255,7 @@ void VslInteg<T>::main_process() {
     str_cmd = std::string(c_str_cmd);
     if (str_cmd.empty() == true) {
         vs_log_mod_error("vsl", "Command field empty/null");
-        vs_msg_return(fd_client_socket, "error",
+        vsl_msg_return(fd_client_socket, "error",
             "Error processing command. Discarding.", &uuid);
         _state = VSL_STATE_WAITING;
         return;
@@ -648,10 +1269,16 @@ void VslInteg<T>::main_process() {
         return;
     }
 
+    /* Plugin commands are named "<plugin>.<command>" */
+    if (std::string::npos != str_cmd.find('.')) {
+        VSL_CMD_HANDLER_NAME(plugin)(*this);
+        return;
+    }
+
     /* Handle case for which the command handler is not found */
     vs_log_mod_error("vsl", "Handler for command %s not found",
         str_cmd.c_str());
-    vs_msg_return(fd_client_socket, "error",
+    vsl_msg_return(fd_client_socket, "error",
         "Could not find handler for command. Discarding.", &uuid);
     _state = VSL_STATE_WAITING;
     return;
@@ -664,22 +1291,72 @@ template<typename T>
 void VslInteg<T>::main_sim() {
     vs_log_mod_info("vsl", "Simulation ongoing");
 
-    while (!p_context->gotFinish()) {
-        /* Evaluate model */
+    num_sim_evals = 0ull;
+    vsl_time_t sim_time_start = p_context->time();
+    auto t_start = std::chrono::steady_clock::now();
+    main_sim_run();
+    std::chrono::duration<double> t_elapsed =
+        std::chrono::steady_clock::now() - t_start;
+
+    double rate = (t_elapsed.count() > 0.0) ?
+        static_cast<double>(num_sim_evals)/t_elapsed.count() : 0.0;
+    vs_log_mod_info("vsl", "Simulated %llu time slots (%llu time steps) in \
+%.3f ms - %.0f time slots/s", (unsigned long long) num_sim_evals,
+        (unsigned long long) (p_context->time() - sim_time_start),
+        1.0e3*t_elapsed.count(), rate);
+}
+
+/* Evaluates the model until a value callback is reached (only checked if
+CHECK_VALUE is true), until no more events are pending or until the next
+event is at or after t_end. Clock edges up to t_end are thus evaluated without
+getting back to main_sim_run(). Returns true if the value callback has been
+reached. */
+template<typename T>
+template<bool CHECK_VALUE>
+bool VslInteg<T>::sim_loop(const vsl_time_t t_end) {
+    while (true) {
         eval();
+        num_sim_evals++;
 
         /* An extra evaluation of gotFinish is necessary from Verilator 5.046
         as the relationship between $finish and the simulation time has been
         modified (see https://github.com/verilator/verilator/issues/7095)
         */
+        if (p_context->gotFinish()) return false;
+        if constexpr (CHECK_VALUE) {
+            if (check_value_callback()) return true;
+        }
+        if (!has_events_pending()) return false;
+        vsl_time_t t_next = next_event_time();
+        if (t_next >= t_end) return false;
+        advance_time(t_next);
+    }
+}
+
+template<typename T>
+void VslInteg<T>::main_sim_run() {
+    while (!p_context->gotFinish()) {
+        /* Evaluate model up to the next callback, if any. Value callbacks are
+        only checked if one is armed. */
+        vsl_time_t t_end = has_time_callback() ? cb_time :
+            std::numeric_limits<vsl_time_t>::max();
+        bool b_value_reached =
+            (has_value_callback() || has_player() || has_plugin_run()) ?
+            sim_loop<true>(t_end) : sim_loop<false>(t_end);
         if (p_context->gotFinish()) break;
 
         /* Check if value-based callback has been reached */
-        if (check_value_callback()) {
+        if (b_value_reached) {
+            if (has_plugin_run()) {
+                plugin_return(p_plugin_active);
+            } else if (has_player()) {
+                play_return(!b_play_done);
+            } else {
+                callback_return(
+                    "Reached callback - Getting back to Verisocks main loop",
+                    true);
+            }
             clear_callbacks();
-            vs_msg_return(fd_client_socket, "ack",
-                "Reached callback - Getting back to Verisocks main loop",
-                &uuid);
             _state = VSL_STATE_WAITING;
             return;
         }
@@ -687,12 +1364,23 @@ void VslInteg<T>::main_sim() {
         /* If no more pending events remaining ... finish simulation */
         if (!has_events_pending()) {
             if (has_time_callback()) {
-                p_context->time(cb_time);
+                advance_time(cb_time);
+                if (has_sampler()) {
+                    if (sampler_step()) continue;
+                    clear_callbacks();
+                    _state = VSL_STATE_WAITING;
+                    return;
+                }
+                if (has_player()) {
+                    if (play_step()) continue;
+                    play_return(false);
+                    clear_callbacks();
+                    _state = VSL_STATE_WAITING;
+                    return;
+                }
+                callback_return(
+                    "Reached callback without other events pending", false);
                 clear_callbacks();
-                vs_msg_return(fd_client_socket, "ack",
-                    "Reached callback without other events pending",
-                    &uuid
-                );
                 _state = VSL_STATE_WAITING;
                 return;
             }
@@ -703,28 +1391,59 @@ void VslInteg<T>::main_sim() {
 
         /* If there is a time-based callback */
         if (has_time_callback() && (next_event_time() >= cb_time)) {
-            p_context->time(cb_time);
-            clear_callbacks();
-            vs_msg_return(fd_client_socket, "ack",
+            advance_time(cb_time);
+            /* Sampling run - Take sample and continue until the last one */
+            if (has_sampler()) {
+                if (sampler_step()) continue;
+                clear_callbacks();
+                _state = VSL_STATE_WAITING;
+                return;
+            }
+            /* Playback with time steps - Apply the next row, if any */
+            if (has_player()) {
+                if (play_step()) continue;
+                play_return(false);
+                clear_callbacks();
+                _state = VSL_STATE_WAITING;
+                return;
+            }
+            callback_return(
                 "Reached callback - Getting back to Verisocks main loop",
-                &uuid);
+                false);
+            clear_callbacks();
             _state = VSL_STATE_WAITING;
             return;
         }
 
         /* Advance time to the next time to be evaluated */
-        p_context->time(next_event_time());
+        advance_time(next_event_time());
     }
     /* If there is a callback hanging, it means that the Verisocks client is
     expecting a return message... in this case, an error is returned */
     if (has_callback()) {
-        vs_msg_return(fd_client_socket, "error",
+        vsl_msg_return(fd_client_socket, "error",
             "Exiting Verisocks due to end of simulation", &uuid);
     }
     _state = VSL_STATE_SIM_FINISH;
     return;
 }
 
+/* Evaluates the model up to t_end, without any callback nor return message
+(as used by VslEnsemble). Returns false if the simulation has finished. */
+template<typename T>
+bool VslInteg<T>::sim_until(const vsl_time_t t_end) {
+    while (!p_context->gotFinish()) {
+        sim_loop<false>(t_end);
+        if (p_context->gotFinish()) break;
+        if (!has_events_pending() || (next_event_time() >= t_end)) {
+            advance_time(t_end);
+            return true;
+        }
+        advance_time(next_event_time());
+    }
+    return false;
+}
+
 /******************************************************************************
 Main finite state-machine - Simulation finishing
 ******************************************************************************/
@@ -732,6 +1451,7 @@ template<typename T>
 void VslInteg<T>::main_sim_finish() {
     eval();
     p_model->final();
+    if (b_trace_active) trace_stop();
     p_context->statsPrintSummary();
     _state = VSL_STATE_EXIT;
     return;
@@ -742,8 +1462,36 @@ Wrapper simulation management functions
 ******************************************************************************/
 template<typename T>
 void VslInteg<T>::eval() {
-    clock_map.eval(p_context->time());
+    bool b_play_edge {false};
+    if (b_has_edge_sampler || b_has_recorder || (nullptr != p_play_clock)) {
+        /* The values are sampled once the clock has toggled and before the
+        model is evaluated, i.e. as seen by the design on this edge */
+        CData edge_prev = b_has_edge_sampler ? *p_edge_clock : 0;
+        CData rec_prev = b_has_recorder ? *p_rec_clock : 0;
+        CData play_prev = (nullptr != p_play_clock) ? *p_play_clock : 0;
+        if (0 < clock_map.eval(p_context->time())) {
+            if (b_has_edge_sampler && (edge_prev != *p_edge_clock) &&
+                (edge_level == *p_edge_clock)) {
+                edge_sampler_step();
+            }
+            if (b_has_recorder && (rec_prev != *p_rec_clock) &&
+                (rec_level == *p_rec_clock)) {
+                recorder_step();
+            }
+            b_play_edge = (nullptr != p_play_clock) &&
+                (play_prev != *p_play_clock) && (play_level == *p_play_clock);
+        }
+    } else {
+        clock_map.eval(p_context->time());
+    }
     p_model->eval();
+
+    /* The next row is applied once the edge has been evaluated, as a
+    testbench would drive it from this edge */
+    if (b_play_edge) play_step();
+
+    /* Plugins are also called once the edge has been evaluated */
+    if (!plugins.empty()) plugins_step();
 }
 
 template<typename T>
@@ -781,7 +1529,8 @@ another callback is already registered - Discarding");
         return -1;
     }
     cb_value_path = std::string(path);
-    if (nullptr == get_registered_variable(cb_value_path)) {
+    p_cb_value_var = get_registered_variable(cb_value_path);
+    if (nullptr == p_cb_value_var) {
         vs_log_mod_error("vsl", "Could not register new value callback - Path \
 not found in registered variables - Discarding");
         return -1;
@@ -791,6 +1540,38 @@ not found in registered variables - Discarding");
     return 0;
 }
 
+template<typename T>
+int VslInteg<T>::register_trigger(const std::string& expr)
+{
+    /* A time callback can be registered beforehand, as a deadline */
+    if (has_value_callback() || has_sampler()) {
+        vs_log_mod_error("vsl", "Could not register trigger as another value \
+callback or a sampler is already registered - Discarding");
+        return -1;
+    }
+    if (0 > trigger.compile(expr, var_map)) {
+        vs_log_mod_error("vsl", "Could not compile trigger expression - \
+Discarding");
+        return -1;
+    }
+    b_has_value_callback = true;
+    return 0;
+}
+
+template<typename T>
+void VslInteg<T>::callback_return(const char* str_msg, bool b_triggered) {
+    if (!trigger.is_armed()) {
+        vsl_msg_return(fd_client_socket, "ack", str_msg, &uuid);
+        return;
+    }
+
+    /* With a trigger expression, whether it has been met or not (deadline)
+    is returned as well */
+    cJSON* p_fields = cJSON_CreateObject();
+    cJSON_AddBoolToObject(p_fields, "triggered", b_triggered);
+    vsl_msg_return_ack(fd_client_socket, str_msg, p_fields, &uuid);
+}
+
 template<typename T>
 int VslInteg<T>::register_time_callback(vsl_time_t time)
 {
@@ -811,10 +1592,152 @@ Time value is not in the future - Discarding");
     return 0;
 }
 
+template<typename T>
+int VslInteg<T>::register_sampler(const vsl_time_t period, const size_t count,
+    const std::vector<std::string>& paths)
+{
+    if (!has_time_callback() || has_sampler()) {
+        vs_log_mod_error("vsl", "Could not register sampler - Inconsistent \
+callbacks state - Discarding");
+        return -1;
+    }
+    if ((0ull == period) || (0 == count) || paths.empty()) {
+        vs_log_mod_error("vsl", "Could not register sampler - Invalid \
+arguments - Discarding");
+        return -1;
+    }
+    if (count > VSL_SAMPLES_MAX_VALUES / paths.size()) {
+        vs_log_mod_error("vsl", "Could not register sampler - Too many \
+values to be sampled (maximum %zu) - Discarding", VSL_SAMPLES_MAX_VALUES);
+        return -1;
+    }
+
+    /* Resolve all variables once, before starting the sampling */
+    sample_vars.clear();
+    for (auto& path : paths) {
+        VslVar* p_var = get_registered_variable(path);
+        if (nullptr == p_var) {
+            vs_log_mod_error("vsl", "Could not register sampler - Path %s not \
+found in registered variables - Discarding", path.c_str());
+            return -1;
+        }
+        switch (p_var->get_type()) {
+            case VSL_TYPE_SCALAR:
+            case VSL_TYPE_PARAM:
+            case VSL_TYPE_EVENT:
+                break;
+            default:
+                vs_log_mod_error("vsl", "Could not register sampler - \
+Variable %s cannot be sampled - Discarding", path.c_str());
+                return -1;
+        }
+        sample_vars.push_back(p_var);
+    }
+    sample_paths = paths;
+    sample_period = period;
+    sample_count = count;
+    sample_times.clear();
+    sample_times.reserve(count);
+    sample_values.assign(count * paths.size(), 0.0);
+    b_has_sampler = true;
+    return 0;
+}
+
+template<typename T>
+const bool VslInteg<T>::sampler_step() {
+    size_t index = sample_times.size();
+    double time_factor = std::pow(10.0, p_context->timeprecision());
+    sample_times.push_back(p_context->time() * time_factor);
+    for (size_t i = 0; i < sample_vars.size(); i++) {
+        sample_values[i * sample_count + index] = sample_vars[i]->get_value();
+    }
+    if (sample_times.size() < sample_count) {
+        cb_time += sample_period;
+        return true;
+    }
+    sampler_return();
+    return false;
+}
+
+template<typename T>
+void VslInteg<T>::sampler_return() {
+    cJSON *p_msg;
+    cJSON *p_obj;
+    cJSON *p_array;
+    char *str_msg = nullptr;
+    int num_samples = static_cast<int>(sample_times.size());
+    vs_msg_info_t msg_info = VS_MSG_INFO_INIT_JSON;
+    vs_msg_copy_uuid(&msg_info, &uuid);
+
+    /* Lambda function - error handler */
+    auto handle_error = [&](){
+        if (nullptr != p_msg) cJSON_Delete(p_msg);
+        if (nullptr != str_msg) cJSON_free(str_msg);
+        vsl_msg_return(fd_client_socket, "error",
+            "Error processing command run(sample) - Discarding", &uuid);
+    };
+
+    /* Create return message object */
+    p_msg = cJSON_CreateObject();
+    if (nullptr == p_msg) {
+        vs_log_mod_error("vsl", "Could not create cJSON object");
+        handle_error();
+        return;
+    }
+    if (nullptr == cJSON_AddStringToObject(p_msg, "type", "result")) {
+        vs_log_mod_error("vsl", "Could not add string to object");
+        handle_error();
+        return;
+    }
+    p_array = cJSON_CreateDoubleArray(sample_times.data(), num_samples);
+    if (nullptr == p_array) {
+        vs_log_mod_error("vsl", "Could not create cJSON array");
+        handle_error();
+        return;
+    }
+    cJSON_AddItemToObject(p_msg, "time", p_array);
+    p_obj = cJSON_AddObjectToObject(p_msg, "value");
+    if (nullptr == p_obj) {
+        vs_log_mod_error("vsl", "Could not add object to object");
+        handle_error();
+        return;
+    }
+    for (size_t i = 0; i < sample_paths.size(); i++) {
+        p_array = cJSON_CreateDoubleArray(
+            &sample_values[i * sample_count], num_samples);
+        if (nullptr == p_array) {
+            vs_log_mod_error("vsl", "Could not create cJSON array");
+            handle_error();
+            return;
+        }
+        cJSON_AddItemToObject(p_obj, sample_paths[i].c_str(), p_array);
+    }
+
+    str_msg = vs_msg_create_message(p_msg, &msg_info);
+    if (nullptr == str_msg) {
+        vs_log_mod_error("vsl", "NULL pointer");
+        handle_error();
+        return;
+    }
+    if (0 > vsl_msg_write(fd_client_socket, str_msg, &msg_info)) {
+        vs_log_mod_error("vsl", "Error writing return message");
+        handle_error();
+        return;
+    }
+
+    /* Normal exit */
+    if (nullptr != p_msg) cJSON_Delete(p_msg);
+    if (nullptr != str_msg) cJSON_free(str_msg);
+    return;
+}
+
 template<typename T>
 const bool VslInteg<T>::check_value_callback() {
+    if (b_play_done) return true;
+    if (nullptr != p_plugin_active) return !p_plugin_active->busy();
     if (has_value_callback()) {
-        auto p_var = get_registered_variable(cb_value_path);
+        if (trigger.is_armed()) return trigger.eval();
+        auto p_var = p_cb_value_var;
         switch (p_var->get_type()) {
             case VSL_TYPE_SCALAR:
                 if (p_var->get_value() == cb_value) return true;
@@ -878,6 +1801,180 @@ VerilatedVar* VslInteg<T>::get_var(std::string str_path) {
     return p_xvar;
 }
 
+/**
+ * @brief Get the hierarchy index, building it on first use
+ *
+ * The index contains all the public variables found in the Verilator scopes,
+ * with paths relative to the model hierarchical name, as well as all the
+ * registered variables. Public variables which are not registered are added
+ * with the VSL_TYPE_UNKNOWN type.
+ *
+ * @return (vs_index_t*) Pointer to the index, nullptr in case of error
+ */
+template<typename T>
+vs_index_t* VslInteg<T>::get_index() {
+    if (nullptr != p_index) return p_index;
+
+    p_index = vs_index_create();
+    if (nullptr == p_index) return nullptr;
+
+    /* Public variables from the Verilator scopes */
+    const VerilatedScopeNameMap* p_scope_map = p_context->scopeNameMap();
+    if (nullptr != p_scope_map) {
+        for (const auto& scope : *p_scope_map) {
+            std::string str_scope;
+            if (!get_relative_scope(scope.first, str_scope)) continue;
+            VerilatedVarNameMap* p_vars = scope.second->varsp();
+            if (nullptr == p_vars) continue;
+            for (const auto& var : *p_vars) {
+                std::string str_path(str_scope);
+                if (!str_path.empty()) str_path += ".";
+                str_path += var.first;
+                if (0 > vs_index_add(
+                        p_index, str_path.c_str(), VSL_TYPE_UNKNOWN)) {
+                    vs_log_mod_warning("vsl",
+                        "Could not add %s to hierarchy index",
+                        str_path.c_str());
+                }
+            }
+        }
+    }
+
+    /* Registered variables */
+    for (const auto& name : var_map.get_names()) {
+        VslVar* p_var = var_map.get_var(name);
+        if (0 > vs_index_add(p_index, name.c_str(), p_var->get_type())) {
+            vs_log_mod_warning("vsl",
+                "Could not add %s to hierarchy index", name.c_str());
+        }
+    }
+    vs_log_mod_debug("vsl", "Hierarchy index built with %zu objects",
+        vs_index_size(p_index));
+    return p_index;
+}
+
+/**
+ * @brief Get the scope path relative to the model hierarchical name
+ *
+ * @param scope_name Verilator scope name
+ * @param str_scope Relative scope path (empty for the top scope)
+ * @return True if the scope belongs to the model, false otherwise
+ */
+template<typename T>
+bool VslInteg<T>::get_relative_scope(const char* scope_name,
+    std::string& str_scope)
+{
+    std::string str_top(p_model->hierName());
+    str_scope = std::string(scope_name);
+    if (str_scope == str_top) {
+        str_scope.clear();
+        return true;
+    }
+    if (str_scope.rfind(str_top + ".", 0) == 0) {
+        str_scope.erase(0, str_top.size() + 1);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Convert a Verilator variable data pointer to a typed pointer
+ *
+ * @param datap Verilator variable data pointer
+ * @param vltype Variable verilated type
+ * @return Typed pointer, empty if the type is not supported
+ */
+static inline std::any get_typed_datap(void* datap, VerilatedVarType vltype)
+{
+    switch (vltype) {
+        case VLVT_UINT8: return static_cast<CData*>(datap);
+        case VLVT_UINT16: return static_cast<SData*>(datap);
+        case VLVT_UINT32: return static_cast<IData*>(datap);
+        case VLVT_UINT64: return static_cast<QData*>(datap);
+        case VLVT_WDATA: return static_cast<EData*>(datap);
+        case VLVT_REAL: return static_cast<double*>(datap);
+        default: return std::any {};
+    }
+}
+
+template<typename T>
+int VslInteg<T>::auto_register() {
+    const VerilatedScopeNameMap* p_scope_map = p_context->scopeNameMap();
+    if (nullptr == p_scope_map) {
+        vs_log_mod_error("vsl", "Could not get Verilator scopes");
+        return -1;
+    }
+
+    auto t_start = std::chrono::steady_clock::now();
+    size_t num_scopes = 0;
+    size_t num_registered = 0;
+    size_t num_skipped = 0;
+    for (const auto& scope : *p_scope_map) {
+        std::string str_scope;
+        if (!get_relative_scope(scope.first, str_scope)) continue;
+        VerilatedVarNameMap* p_vars = scope.second->varsp();
+        if (nullptr == p_vars) continue;
+        num_scopes++;
+        for (const auto& var : *p_vars) {
+            std::string str_path(str_scope);
+            if (!str_path.empty()) str_path += ".";
+            str_path += var.first;
+
+            /* Explicit registrations take precedence */
+            if (var_map.has_var(str_path) || clock_map.has_clock(str_path)) {
+                continue;
+            }
+
+            const VerilatedVar& xvar = var.second;
+            VerilatedVarType vltype = xvar.vltype();
+            std::any datap = get_typed_datap(xvar.datap(), vltype);
+            if (!datap.has_value()) {
+                vs_log_mod_debug("vsl",
+                    "Variable %s not supported for registration - Skipping",
+                    str_path.c_str());
+                num_skipped++;
+                continue;
+            }
+            size_t width = (VLVT_REAL == vltype) ? 64u :
+                static_cast<size_t>(xvar.packed().elements());
+
+            if (xvar.udims() > 1) {
+                /* Unpacked dimensions are numbered from 1 (as for DPI) */
+                std::vector<size_t> shape;
+                for (int dim = 1; dim <= xvar.udims(); dim++) {
+                    shape.push_back(static_cast<size_t>(xvar.elements(dim)));
+                }
+                register_mdarray(str_path.c_str(), datap, vltype, width,
+                    shape);
+            } else if (xvar.udims() == 1) {
+                register_variable(str_path.c_str(), datap, vltype,
+                    VSL_TYPE_ARRAY, width,
+                    static_cast<size_t>(xvar.unpacked().elements()));
+            } else if (xvar.isParam()) {
+                register_variable(str_path.c_str(), datap, vltype,
+                    VSL_TYPE_PARAM, width);
+            } else {
+                register_variable(str_path.c_str(), datap, vltype,
+                    VSL_TYPE_SCALAR, width);
+            }
+            num_registered++;
+        }
+    }
+    std::chrono::duration<double, std::milli> t_elapsed =
+        std::chrono::steady_clock::now() - t_start;
+
+    /* The hierarchy index, if already built, has to be rebuilt */
+    if (nullptr != p_index) {
+        vs_index_free(p_index);
+        p_index = nullptr;
+    }
+
+    vs_log_mod_info("vsl", "Registered %zu variables from %zu scopes in \
+%.3f ms (%zu skipped)", num_registered, num_scopes, t_elapsed.count(),
+        num_skipped);
+    return static_cast<int>(num_registered);
+}
+
 } //namespace vsl
 
 #endif //VSL_INTEG_HPP
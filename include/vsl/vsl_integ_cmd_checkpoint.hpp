@@ -0,0 +1,379 @@
+/*****************************************************************************
+ @file vsl_integ_cmd_checkpoint.hpp
+ @brief Command handlers implementations for the "checkpoint" and "restore"
+ commands in the vsl::VslInteg class template.
+
+ A checkpoint contains the state of the Verilated model (for models verilated
+ with the --savable option), as well as the integration state: simulation
+ time, clocks scheduling and finish time. It is saved either to a file or to
+ an in-memory buffer identified by a name, and it can be restored any number
+ of times, e.g. in order to start several tests right after a common boot
+ sequence.
+
+ Main handlers:
+ - VSL_CMD_HANDLER(checkpoint): Saves a checkpoint.
+ - VSL_CMD_HANDLER(restore): Restores a checkpoint.
+
+ This header also defines the serialization of the integration state and the
+ checks applied to a checkpoint before it is restored.
+
+ @author Jérémie Chabloz
+ @copyright Copyright (c) 2026 Jérémie Chabloz Distributed under the MIT
+ License. See file for details.
+*******************************************************************************/
+/*
+Copyright (c) 2026 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VSL_INTEG_CMD_CHECKPOINT_HPP
+#define VSL_INTEG_CMD_CHECKPOINT_HPP
+
+#include "cJSON.h"
+#include "vs_logging.h"
+#include "vs_msg.h"
+#include "vsl/vsl_integ.hpp"
+#include "verilated.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace vsl{
+
+/* Gets the checkpoint target from the command, either a file path ("path")
+or the name of an in-memory checkpoint ("name"). Returns -1 if none or both
+are provided. */
+static inline int get_checkpoint_target(cJSON* p_cmd, std::string& path,
+    std::string& name)
+{
+    char* cstr_path = cJSON_GetStringValue(cJSON_GetObjectItem(p_cmd, "path"));
+    char* cstr_name = cJSON_GetStringValue(cJSON_GetObjectItem(p_cmd, "name"));
+    path = (nullptr != cstr_path) ? std::string(cstr_path) : std::string();
+    name = (nullptr != cstr_name) ? std::string(cstr_name) : std::string();
+    if (path.empty() == name.empty()) {
+        vs_log_mod_error("vsl",
+            "Either command field \"path\" or \"name\" shall be provided");
+        return -1;
+    }
+    return 0;
+}
+
+/******************************************************************************
+Checkpoint command handler
+******************************************************************************/
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(checkpoint) {
+
+    /* Error handler lambda function */
+    auto handle_error = [&]() {
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command checkpoint - Discarding", &vx.uuid);
+        vx._state = VSL_STATE_WAITING;
+    };
+
+    std::string str_path, str_name;
+    if (0 > get_checkpoint_target(vx.p_cmd, str_path, str_name)) {
+        handle_error();
+        return;
+    }
+    vs_log_mod_info("vsl", "Command \"checkpoint(%s)\" received.",
+        str_path.empty() ? str_name.c_str() : str_path.c_str());
+
+    auto t_start = std::chrono::steady_clock::now();
+    if (0 > vx.checkpoint_save(str_path, str_name)) {
+        handle_error();
+        return;
+    }
+    std::chrono::duration<double> t_elapsed =
+        std::chrono::steady_clock::now() - t_start;
+    vs_log_mod_info("vsl", "Checkpoint saved in %.3f ms",
+        1.0e3*t_elapsed.count());
+
+    vsl_msg_return(vx.fd_client_socket, "ack", "Checkpoint saved", &vx.uuid);
+    vx._state = VSL_STATE_WAITING;
+    return;
+}
+
+/******************************************************************************
+Restore command handler
+******************************************************************************/
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(restore) {
+
+    /* Error handler lambda function */
+    auto handle_error = [&]() {
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command restore - Discarding", &vx.uuid);
+        vx._state = VSL_STATE_WAITING;
+    };
+
+    std::string str_path, str_name;
+    if (0 > get_checkpoint_target(vx.p_cmd, str_path, str_name)) {
+        handle_error();
+        return;
+    }
+    vs_log_mod_info("vsl", "Command \"restore(%s)\" received.",
+        str_path.empty() ? str_name.c_str() : str_path.c_str());
+
+    auto t_start = std::chrono::steady_clock::now();
+    if (0 > vx.checkpoint_restore(str_path, str_name)) {
+        handle_error();
+        return;
+    }
+    std::chrono::duration<double> t_elapsed =
+        std::chrono::steady_clock::now() - t_start;
+    vs_log_mod_info("vsl", "Checkpoint restored in %.3f ms",
+        1.0e3*t_elapsed.count());
+
+    vsl_msg_return(vx.fd_client_socket, "ack", "Checkpoint restored",
+        &vx.uuid);
+    vx._state = VSL_STATE_WAITING;
+    return;
+}
+
+/******************************************************************************
+Checkpoints
+******************************************************************************/
+/* Identifies the integration state at the start of a checkpoint, after the
+Verilator header */
+static const char VSL_CHECKPOINT_HEADER[] = "vslcheckpoint002";
+
+/* Writes the integration state followed by the model state. The integration
+state starts with the checkpoint size (set by checkpoint_save() once the
+model state is serialized) and the model name. Callbacks are always cleared
+when a run command returns, so that there is none pending between two
+commands and none is saved. */
+template<typename T>
+template<typename S>
+void VslInteg<T>::save_state(S& os) {
+    os.write(VSL_CHECKPOINT_HEADER, sizeof(VSL_CHECKPOINT_HEADER));
+    uint64_t size = 0u;
+    os.write(&size, sizeof(size));
+    std::string model_name {p_model->modelName()};
+    uint64_t name_len = model_name.size();
+    os.write(&name_len, sizeof(name_len));
+    os.write(model_name.data(), name_len);
+    uint64_t time = p_context->time();
+    os.write(&time, sizeof(time));
+    os.write(&b_has_finish_time, sizeof(b_has_finish_time));
+    os.write(&finish_time, sizeof(finish_time));
+    std::vector<VslClock::State> clock_states = clock_map.get_states();
+    uint64_t num_clocks = clock_states.size();
+    os.write(&num_clocks, sizeof(num_clocks));
+    os.write(clock_states.data(), num_clocks*sizeof(VslClock::State));
+    os << *p_model;
+}
+
+/* Reads a checkpoint written by save_state() and checked by
+checkpoint_check(). The integration state is checked before the model state
+is restored, so that a checkpoint of another model or testbench is rejected
+without modifying anything. */
+template<typename T>
+template<typename D>
+int VslInteg<T>::restore_state(D& is) {
+    char header[sizeof(VSL_CHECKPOINT_HEADER)];
+    is.read(header, sizeof(header));
+    if (0 != std::memcmp(header, VSL_CHECKPOINT_HEADER, sizeof(header))) {
+        vs_log_mod_error("vsl", "Invalid checkpoint content");
+        return -1;
+    }
+    uint64_t size;
+    uint64_t name_len;
+    is.read(&size, sizeof(size));
+    is.read(&name_len, sizeof(name_len));
+    std::string model_name {p_model->modelName()};
+    if (name_len != model_name.size()) {
+        vs_log_mod_error("vsl", "Checkpoint of another model");
+        return -1;
+    }
+    std::string name(name_len, '\0');
+    is.read(name.data(), name_len);
+    if (name != model_name) {
+        vs_log_mod_error("vsl", "Checkpoint of model %s instead of %s",
+            name.c_str(), model_name.c_str());
+        return -1;
+    }
+    uint64_t time;
+    bool has_finish_time;
+    vsl_time_t time_finish;
+    uint64_t num_clocks;
+    is.read(&time, sizeof(time));
+    is.read(&has_finish_time, sizeof(has_finish_time));
+    is.read(&time_finish, sizeof(time_finish));
+    is.read(&num_clocks, sizeof(num_clocks));
+    std::vector<VslClock::State> clock_states = clock_map.get_states();
+    if (num_clocks != clock_states.size()) {
+        vs_log_mod_error("vsl", "Checkpoint with %llu clocks instead of %llu",
+            (unsigned long long) num_clocks,
+            (unsigned long long) clock_states.size());
+        return -1;
+    }
+    is.read(clock_states.data(), num_clocks*sizeof(VslClock::State));
+    is >> *p_model;
+
+    p_context->time(time);
+    b_has_finish_time = has_finish_time;
+    finish_time = time_finish;
+    clock_map.set_states(clock_states);
+    clear_callbacks();
+    plugins_rebind();
+    return 0;
+}
+
+/* Checks the Verilator header and trailer, the integration state header and
+the size of a checkpoint buffer, since Verilator would abort the simulation
+when deserializing an invalid or truncated checkpoint. A checkpoint of
+another build of the same model cannot be detected here and would still
+abort the simulation. */
+template<typename T>
+int VslInteg<T>::checkpoint_check(const std::vector<uint8_t>& buffer) {
+    static const auto frame = vsl_serialize_frame<>();
+    const std::vector<uint8_t>& vl_header = frame.first;
+    const std::vector<uint8_t>& vl_trailer = frame.second;
+    const size_t size_pos = vl_header.size() + sizeof(VSL_CHECKPOINT_HEADER);
+    uint64_t size;
+    if ((buffer.size() < size_pos + sizeof(size) + vl_trailer.size()) ||
+        (0 != std::memcmp(buffer.data(), vl_header.data(), vl_header.size())) ||
+        (0 != std::memcmp(buffer.data() + vl_header.size(),
+            VSL_CHECKPOINT_HEADER, sizeof(VSL_CHECKPOINT_HEADER))))
+    {
+        vs_log_mod_error("vsl", "Invalid checkpoint content");
+        return -1;
+    }
+    std::memcpy(&size, buffer.data() + size_pos, sizeof(size));
+    if (size != buffer.size()) {
+        vs_log_mod_error("vsl", "Checkpoint size is %llu instead of %llu \
+bytes", (unsigned long long) buffer.size(), (unsigned long long) size);
+        return -1;
+    }
+    if (0 != std::memcmp(buffer.data() + buffer.size() - vl_trailer.size(),
+        vl_trailer.data(), vl_trailer.size()))
+    {
+        vs_log_mod_error("vsl", "Invalid checkpoint content");
+        return -1;
+    }
+    return 0;
+}
+
+template<typename T>
+int VslInteg<T>::checkpoint_save(const std::string& path,
+    const std::string& name)
+{
+    if constexpr (vsl_is_savable<T>::value) {
+        if (has_callback() || has_sampler()) {
+            vs_log_mod_error("vsl", "Cannot save checkpoint with a pending \
+callback");
+            return -1;
+        }
+        /* The checkpoint is always serialized in memory first, so that its
+        size can be set in the integration state */
+        std::vector<uint8_t> file_buffer;
+        std::vector<uint8_t>& buffer =
+            path.empty() ? checkpoints[name] : file_buffer;
+        VslBufferSave<> os {buffer};
+        os.open();
+        os.flush();
+        const size_t size_pos = buffer.size() + sizeof(VSL_CHECKPOINT_HEADER);
+        save_state(os);
+        os.close();
+        uint64_t size = buffer.size();
+        std::memcpy(buffer.data() + size_pos, &size, sizeof(size));
+        if (!path.empty()) {
+            std::FILE* p_file = std::fopen(path.c_str(), "wb");
+            if (nullptr == p_file) {
+                vs_log_mod_error("vsl", "Could not open checkpoint file %s",
+                    path.c_str());
+                return -1;
+            }
+            size_t num = std::fwrite(buffer.data(), 1, buffer.size(), p_file);
+            if ((0 != std::fclose(p_file)) || (num != buffer.size())) {
+                vs_log_mod_error("vsl", "Could not write checkpoint file %s",
+                    path.c_str());
+                return -1;
+            }
+        }
+        return 0;
+    } else {
+        vs_log_mod_error("vsl", "Checkpoints not available - The model shall \
+be verilated with the --savable option");
+        return -1;
+    }
+}
+
+template<typename T>
+int VslInteg<T>::checkpoint_restore(const std::string& path,
+    const std::string& name)
+{
+    if constexpr (vsl_is_savable<T>::value) {
+        if (b_trace_active) {
+            vs_log_mod_error("vsl", "Cannot restore checkpoint while a trace \
+window is active");
+            return -1;
+        }
+        /* A checkpoint file is entirely read first, so that it can be
+        checked and discarded if invalid or truncated (Verilator would abort
+        the simulation) */
+        std::vector<uint8_t> file_buffer;
+        const std::vector<uint8_t>* p_buffer;
+        if (!path.empty()) {
+            std::FILE* p_file = std::fopen(path.c_str(), "rb");
+            if (nullptr == p_file) {
+                vs_log_mod_error("vsl", "Could not open checkpoint file %s",
+                    path.c_str());
+                return -1;
+            }
+            uint8_t block[65536];
+            size_t num;
+            while (0 < (num = std::fread(block, 1, sizeof(block), p_file))) {
+                file_buffer.insert(file_buffer.end(), block, block + num);
+            }
+            std::fclose(p_file);
+            p_buffer = &file_buffer;
+        } else {
+            auto search = checkpoints.find(name);
+            if (search == checkpoints.end()) {
+                vs_log_mod_error("vsl", "Checkpoint %s not found",
+                    name.c_str());
+                return -1;
+            }
+            p_buffer = &search->second;
+        }
+        if (0 > checkpoint_check(*p_buffer)) return -1;
+        VslBufferRestore<> is {*p_buffer};
+        is.open();
+        if (0 > restore_state(is)) {
+            is.discard();
+            return -1;
+        }
+        is.close();
+        return 0;
+    } else {
+        vs_log_mod_error("vsl", "Checkpoints not available - The model shall \
+be verilated with the --savable option");
+        return -1;
+    }
+}
+
+} //namespace vsl
+
+#endif //VSL_INTEG_CMD_CHECKPOINT_HPP
+//EOF
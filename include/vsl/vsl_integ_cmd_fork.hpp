@@ -0,0 +1,205 @@
+/*****************************************************************************
+ @file vsl_integ_cmd_fork.hpp
+ @brief Command handler implementation for the "fork" command in the
+ vsl::VslInteg class template.
+
+ The fork command forks the simulation process at the current simulation
+ time. The child process is a copy-on-write image of the paused simulation,
+ which is controlled through its own server socket, while the parent process
+ keeps waiting for commands from its current client. Several branches can thus
+ be explored in parallel from a common state without re-simulating it.
+
+ Main handlers:
+ - VSL_CMD_HANDLER(fork): Forks the simulation process.
+
+ The forking of the process and the reaping of the terminated children are
+ implemented here as well.
+
+ @author Jérémie Chabloz
+ @copyright Copyright (c) 2026 Jérémie Chabloz Distributed under the MIT
+ License. See file for details.
+*******************************************************************************/
+/*
+Copyright (c) 2026 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VSL_INTEG_CMD_FORK_HPP
+#define VSL_INTEG_CMD_FORK_HPP
+
+#include "cJSON.h"
+#include "vs_logging.h"
+#include "vs_msg.h"
+#include "vsl/vsl_integ.hpp"
+
+#include <cmath>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace vsl{
+
+/******************************************************************************
+Fork command handler
+******************************************************************************/
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(fork) {
+
+    /* Error handler lambda function */
+    auto handle_error = [&]() {
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command fork - Discarding", &vx.uuid);
+        vx._state = VSL_STATE_WAITING;
+    };
+
+    /* Get the (optional) port number for the child process, 0 to let the
+    system choose a free port */
+    int port = 0;
+    cJSON* p_item_port = cJSON_GetObjectItem(vx.p_cmd, "port");
+    if (nullptr != p_item_port) {
+        double port_value = cJSON_GetNumberValue(p_item_port);
+        if (std::isnan(port_value) || (port_value < 0.0) ||
+            (port_value > 65535.0))
+        {
+            vs_log_mod_error("vsl", "Command field \"port\" invalid");
+            handle_error();
+            return;
+        }
+        port = static_cast<int>(port_value);
+    }
+    vs_log_mod_info("vsl", "Command \"fork\" received.");
+
+    int fork_port = 0;
+    pid_t pid = vx.fork_sim(port, fork_port);
+    if (0 > pid) {
+        handle_error();
+        return;
+    }
+
+    /* Child process: waits for its own client */
+    if (0 == pid) {
+        vs_log_mod_info("vsl", "Forked simulation process %d - Port: %d",
+            static_cast<int>(getpid()), fork_port);
+        vx._state = VSL_STATE_CONNECT;
+        return;
+    }
+
+    /* Parent process: returns the child process PID and port number */
+    cJSON* p_fields = cJSON_CreateObject();
+    cJSON_AddNumberToObject(p_fields, "pid", pid);
+    cJSON_AddNumberToObject(p_fields, "port", fork_port);
+    vsl_msg_return_ack(vx.fd_client_socket, "Simulation forked", p_fields,
+        &vx.uuid);
+    vx._state = VSL_STATE_WAITING;
+    return;
+}
+
+/******************************************************************************
+Fork
+******************************************************************************/
+/*
+Forks the simulation process. The server socket of the child process is
+created beforehand by the parent process, so that its port number is known
+(and the socket already listening) when the parent acknowledges the command.
+The child process inherits a copy-on-write image of the parent process, thus
+of the model and integration states, but closes the parent's sockets and
+waits for its own client to connect. Returns the PID of the child process in
+the parent process, 0 in the child process and -1 in case of error.
+*/
+template<typename T>
+pid_t VslInteg<T>::fork_sim(const int port, int& fork_port) {
+
+    /* A trace file cannot be shared between processes, and Verilator worker
+    threads would not exist in the child process */
+    if (b_trace_active) {
+        vs_log_mod_error("vsl", "Could not fork while a trace window is \
+active");
+        return -1;
+    }
+    if (1u < p_context->threads()) {
+        vs_log_mod_error("vsl", "Could not fork a multi-threaded model \
+(%u threads)", p_context->threads());
+        return -1;
+    }
+    /* Other sessions would be running in the same process */
+    if (b_session) {
+        vs_log_mod_error("vsl", "Could not fork a multi-client server \
+session");
+        return -1;
+    }
+    fork_reap();
+
+    int fd_fork_socket = vs_server_make_socket(port);
+    if (0 > fd_fork_socket) {
+        vs_log_mod_error("vsl", "Issue making socket at port %d", port);
+        return -1;
+    }
+    fork_port = vs_server_get_address(fd_fork_socket).port;
+
+    /* Avoids duplicated buffered outputs */
+    std::fflush(stdout);
+    std::fflush(stderr);
+
+    pid_t pid = ::fork();
+    if (0 > pid) {
+        vs_log_mod_perror("vsl", "Could not fork simulation process");
+        vs_server_close_socket(fd_fork_socket);
+        return -1;
+    }
+
+    if (0 == pid) {
+        /* Child process (the I/O thread, if any, only exists in the parent
+        process) */
+        vs_io_release_forked(p_io);
+        p_io = nullptr;
+        vs_server_close_socket(fd_client_socket);
+        vs_server_close_socket(fd_server_socket);
+        fd_client_socket = -1;
+        fd_server_socket = fd_fork_socket;
+        num_port = fork_port;
+        fork_children.clear();
+        return 0;
+    }
+
+    /* Parent process */
+    vs_server_close_socket(fd_fork_socket);
+    fork_children.push_back(pid);
+    return pid;
+}
+
+/* Reaps the terminated forked processes, without waiting for the others.
+Called before waiting for each command and before each fork, so that the
+terminated processes do not accumulate. */
+template<typename T>
+void VslInteg<T>::fork_reap() {
+    for (auto it = fork_children.begin(); it != fork_children.end();) {
+        if (0 != waitpid(*it, nullptr, WNOHANG)) {
+            it = fork_children.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+} //namespace vsl
+
+#endif //VSL_INTEG_CMD_FORK_HPP
+//EOF
@@ -18,7 +18,14 @@
  - VSL_CMD_HANDLER(get_sim_time): Returns the current simulation time in
    seconds.
  - VSL_CMD_HANDLER(get_value): Returns the value of a requested variable or
-   array, supporting optional range selection for arrays.
+   array, supporting optional range selection for arrays. A list of paths
+   and/or glob patterns can also be used to get several values at once.
+ - VSL_CMD_HANDLER(get_list): Returns the list of variables paths matching a
+   glob pattern, as found in the hierarchy index.
+ - VSL_CMD_HANDLER(get_samples): Returns the values sampled on clock edges
+   as a binary message and resets the sampler buffers.
+ - VSL_CMD_HANDLER(get_recorder): Returns the window recorded by the flight
+   recorder as a binary message.
 
  Error handling is performed via lambda functions that send error messages to
  the client and reset the simulation state as needed.
@@ -57,6 +64,7 @@ SOFTWARE.
 #include "cJSON.h"
 #include "vs_logging.h"
 #include "vs_msg.h"
+#include "vs_index.h"
 #include "vsl/vsl_integ.hpp"
 #include "vsl/vsl_types.hpp"
 #include "vsl/vsl_utils.hpp"
@@ -66,6 +74,7 @@ SOFTWARE.
 #include <cstdio>
 #include <string>
 #include <cmath>
+#include <vector>
 
 
 namespace vsl{
@@ -78,7 +87,7 @@ void VslInteg<T>::VSL_CMD_HANDLER(get) {
     char *str_sel;
 
     auto handle_error = [&vx]() {
-        vs_msg_return(vx.fd_client_socket, "error",
+        vsl_msg_return(vx.fd_client_socket, "error",
             "Error processing command get - Discarding", &vx.uuid);
         vx._state = VSL_STATE_WAITING;
     };
@@ -112,7 +121,7 @@ void VslInteg<T>::VSL_CMD_HANDLER(get) {
     /* Error case - sub-command handler function not found */
     vs_log_mod_error("vsl", "Handler for sub-command %s not found",
         sel_key.c_str());
-    vs_msg_return(vx.fd_client_socket, "error",
+    vsl_msg_return(vx.fd_client_socket, "error",
         "Could not find handler for sub-command. Discarding.", &vx.uuid);
     vx._state = VSL_STATE_WAITING;
     return;
@@ -133,7 +142,7 @@ void VslInteg<T>::VSL_CMD_HANDLER(get_sim_info) {
         if (nullptr != p_msg) cJSON_Delete(p_msg);
         if (nullptr != str_msg) cJSON_free(str_msg);
         vx._state = VSL_STATE_WAITING;
-        vs_msg_return(vx.fd_client_socket, "error",
+        vsl_msg_return(vx.fd_client_socket, "error",
             "Error processing command get(sel=sim_info) - Discarding",
 			&vx.uuid);
     };
@@ -193,7 +202,7 @@ void VslInteg<T>::VSL_CMD_HANDLER(get_sim_info) {
         handle_error();
         return;
     }
-    if (0 > vs_msg_write(vx.fd_client_socket, str_msg)) {
+    if (0 > vsl_msg_write(vx.fd_client_socket, str_msg, &msg_info)) {
         vs_log_mod_error("vsl", "Error writing return message");
         handle_error();
         return;
@@ -221,7 +230,7 @@ void VslInteg<T>::VSL_CMD_HANDLER(get_sim_time) {
         if (nullptr != p_msg) cJSON_Delete(p_msg);
         if (nullptr != str_msg) cJSON_free(str_msg);
         vx._state = VSL_STATE_WAITING;
-        vs_msg_return(vx.fd_client_socket, "error",
+        vsl_msg_return(vx.fd_client_socket, "error",
             "Error processing command get(sel=sim_time) - Discarding",
 			&vx.uuid);
     };
@@ -259,7 +268,7 @@ void VslInteg<T>::VSL_CMD_HANDLER(get_sim_time) {
         handle_error();
         return;
     }
-    if (0 > vs_msg_write(vx.fd_client_socket, str_msg)) {
+    if (0 > vsl_msg_write(vx.fd_client_socket, str_msg, &msg_info)) {
         vs_log_mod_error("vsl", "Error writing return message");
         handle_error();
         return;
@@ -273,94 +282,54 @@ void VslInteg<T>::VSL_CMD_HANDLER(get_sim_time) {
 }
 
 /******************************************************************************
-Get value sub-command handler
+Add the value of a registered variable to a message
 ******************************************************************************/
 template<typename T>
-void VslInteg<T>::VSL_CMD_HANDLER(get_value) {
-
-    cJSON *p_msg;
-    cJSON *p_item_path;
-    char *str_msg = nullptr;
-    vs_msg_info_t msg_info = VS_MSG_INFO_INIT_JSON;
-    vs_msg_copy_uuid(&msg_info, &vx.uuid);
-
-    /* Lambda function - error handler */
-    auto handle_error = [&](){
-        if (nullptr != p_msg) cJSON_Delete(p_msg);
-        if (nullptr != str_msg) cJSON_free(str_msg);
-        vx._state = VSL_STATE_WAITING;
-        vs_msg_return(vx.fd_client_socket, "error",
-            "Error processing command get(sel=value) - Discarding", &vx.uuid);
-    };
-
-    /* Create return message object */
-    p_msg = cJSON_CreateObject();
-    if (nullptr == p_msg) {
-        vs_log_mod_error("vsl", "Could not create cJSON object");
-        handle_error();
-        return;
-    }
-    if (nullptr == cJSON_AddStringToObject(p_msg, "type", "result")) {
-        vs_log_mod_error("vsl", "Could not add string to object");
-        handle_error();
-        return;
-    }
-
-    /* Get the object path from the JSON message content */
-    p_item_path = cJSON_GetObjectItem(vx.p_cmd, "path");
-    if (nullptr == p_item_path) {
-        vs_log_mod_error("vsl", "Command field \"path\" invalid/not found");
-        handle_error();
-        return;
-    }
-    char* cstr_path = cJSON_GetStringValue(p_item_path);
-    if (nullptr == cstr_path) {
-        vs_log_mod_error("vsl", "Command field \"path\" NULL");
-        handle_error();
-        return;
-    }
-    std::string str_path(cstr_path);
-    if (str_path.empty()) {
-        vs_log_mod_error("vsl", "Command field \"path\" empty");
-        handle_error();
-        return;
-    }
+int VslInteg<T>::add_var_value(std::string str_path, cJSON* p_obj,
+    const char* key, bool hex) {
 
     /* Check if the provided path contains the [ ] range selection operator*/
     bool path_has_range = has_range(str_path);
+    VslArrayRanges path_ranges;
     VslArrayRange path_range;
     VslVar* p_var;
     if (path_has_range) {
-        path_range = get_range(str_path);
-        vs_log_mod_debug("vsl", "Range found (left: %d, right %d, incr %d)",
-            (int) path_range.left, (int) path_range.right,
-            (int) path_range.incr);
-        p_var = vx.get_registered_variable(path_range.array_name);
+        path_ranges = get_ranges(str_path);
+        for (const auto& range : path_ranges.ranges) {
+            vs_log_mod_debug("vsl",
+                "Range found (left: %d, right %d, incr %d)",
+                (int) range.left, (int) range.right, (int) range.incr);
+        }
+        if (!path_ranges.ranges.empty()) path_range = path_ranges.ranges[0];
+        p_var = get_registered_variable(path_ranges.array_name);
     } else {
-        p_var = vx.get_registered_variable(str_path);
+        p_var = get_registered_variable(str_path);
     }
 
     /* Attempt to get a pointer to the variable */
     if (nullptr == p_var) {
         vs_log_mod_error(
             "vsl", "Variable %s not found in context", str_path.c_str());
-        handle_error();
-        return;
+        return -1;
     }
 
     /* Consistency checks on range */
-    if (path_has_range) {
+    if (path_has_range && (p_var->get_type() != VSL_TYPE_MDARRAY)) {
         if (p_var->get_type() != VSL_TYPE_ARRAY) {
             vs_log_mod_error(
                 "vsl", "Range operator [] only supported for array type");
-            handle_error();
-            return;
+            return -1;
+        }
+        if (1 != path_ranges.ranges.size()) {
+            vs_log_mod_error("vsl",
+                "Array %s has a single dimension - Only one range operator \
+[] supported", path_ranges.array_name.c_str());
+            return -1;
         }
         if ((path_range.left >= p_var->get_depth()) ||
             (path_range.right >= p_var->get_depth())) {
             vs_log_mod_error("vsl", "Range overflow");
-            handle_error();
-            return;
+            return -1;
         }
     }
 
@@ -370,12 +339,11 @@ void VslInteg<T>::VSL_CMD_HANDLER(get_value) {
         case VSL_TYPE_SCALAR:
         case VSL_TYPE_PARAM:
         case VSL_TYPE_EVENT:
-            if (0 > p_var->add_value_to_msg(p_msg, "value")) {
+            if (0 > p_var->add_value_to_msg(p_obj, key, hex)) {
                 vs_log_mod_error(
                     "vsl", "Error getting value for variable %s",
                     str_path.c_str());
-                handle_error();
-                return;
+                return -1;
             }
             break;
         case VSL_TYPE_ARRAY:
@@ -386,21 +354,188 @@ void VslInteg<T>::VSL_CMD_HANDLER(get_value) {
             vs_log_mod_debug("vsl",
                 "Array depth: %d", (int) p_var->get_depth());
             ack = path_has_range ?
-                p_var->add_array_to_msg(p_msg, "value", path_range) :
-                p_var->add_array_to_msg(p_msg, "value");
+                p_var->add_array_to_msg(p_obj, key, path_range, hex) :
+                p_var->add_array_to_msg(p_obj, key, hex);
+            if (0 > ack) {
+                vs_log_mod_error("vsl",
+                    "Error getting array values for variable %s",
+                    str_path.c_str());
+                return -1;
+            }
+            break;
+        case VSL_TYPE_MDARRAY:
+            vs_log_mod_debug("vsl",
+                "Variable %s detected to be a multi-dimensional array",
+                str_path.c_str());
+            ack = p_var->add_slice_to_msg(
+                p_obj, key, path_ranges.ranges, hex);
             if (0 > ack) {
                 vs_log_mod_error("vsl",
                     "Error getting array values for variable %s",
                     str_path.c_str());
-                handle_error();
-                return;
+                return -1;
             }
             break;
         default:
             vs_log_mod_error(
                 "vsl", "Type not supported (yet) for getting value");
+            return -1;
+    }
+    return 0;
+}
+
+/******************************************************************************
+Add the values for a variable path or glob pattern to a bulk get result
+******************************************************************************/
+template<typename T>
+int VslInteg<T>::add_bulk_values(const char* cstr_path, cJSON* p_values,
+    bool check_dup, bool hex) {
+
+    if ((nullptr == cstr_path) || std::string(cstr_path).empty()) {
+        vs_log_mod_error("vsl", "Command field \"path\" NULL or empty");
+        return -1;
+    }
+    if (!vs_index_is_pattern(cstr_path)) {
+        if (check_dup && cJSON_HasObjectItem(p_values, cstr_path)) return 0;
+        return add_var_value(cstr_path, p_values, cstr_path, hex);
+    }
+
+    vs_index_t* p_idx = get_index();
+    if (nullptr == p_idx) return -1;
+
+    /* Context passed to the index visitor function */
+    struct bulk_ctx {
+        VslInteg<T>* p_vx;
+        cJSON* p_values;
+        bool check_dup;
+        bool hex;
+        bool error;
+    } ctx {this, p_values, check_dup, hex, false};
+
+    auto visitor = [](const char* str_path, int type, void* p_user) -> int {
+        bulk_ctx* p_ctx = static_cast<bulk_ctx*>(p_user);
+        /* Public variables which are not registered cannot be accessed */
+        if (VSL_TYPE_UNKNOWN == type) {
+            vs_log_mod_debug("vsl",
+                "Variable %s not registered, skipped", str_path);
+            return 0;
+        }
+        if (p_ctx->check_dup &&
+            cJSON_HasObjectItem(p_ctx->p_values, str_path)) {
+            return 0;
+        }
+        if (0 > p_ctx->p_vx->add_var_value(
+                str_path, p_ctx->p_values, str_path, p_ctx->hex)) {
+            p_ctx->error = true;
+            return 1;
+        }
+        return 0;
+    };
+    if ((0 > vs_index_match(p_idx, cstr_path, visitor, &ctx)) || ctx.error) {
+        return -1;
+    }
+    return 0;
+}
+
+
+/******************************************************************************
+Get value sub-command handler
+******************************************************************************/
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(get_value) {
+
+    cJSON *p_msg;
+    cJSON *p_item_path;
+    char *str_msg = nullptr;
+    vs_msg_info_t msg_info = VS_MSG_INFO_INIT_JSON;
+    vs_msg_copy_uuid(&msg_info, &vx.uuid);
+
+    /* Lambda function - error handler */
+    auto handle_error = [&](){
+        if (nullptr != p_msg) cJSON_Delete(p_msg);
+        if (nullptr != str_msg) cJSON_free(str_msg);
+        vx._state = VSL_STATE_WAITING;
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command get(sel=value) - Discarding", &vx.uuid);
+    };
+
+    /* Create return message object */
+    p_msg = cJSON_CreateObject();
+    if (nullptr == p_msg) {
+        vs_log_mod_error("vsl", "Could not create cJSON object");
+        handle_error();
+        return;
+    }
+    if (nullptr == cJSON_AddStringToObject(p_msg, "type", "result")) {
+        vs_log_mod_error("vsl", "Could not add string to object");
+        handle_error();
+        return;
+    }
+
+    /* Get the object path from the JSON message content */
+    p_item_path = cJSON_GetObjectItem(vx.p_cmd, "path");
+    if (nullptr == p_item_path) {
+        vs_log_mod_error("vsl", "Command field \"path\" invalid/not found");
+        handle_error();
+        return;
+    }
+
+    /* Get the (optional) value format */
+    bool hex = false;
+    cJSON *p_item_format = cJSON_GetObjectItem(vx.p_cmd, "format");
+    if (nullptr != p_item_format) {
+        char* cstr_format = cJSON_GetStringValue(p_item_format);
+        std::string str_format(nullptr == cstr_format ? "" : cstr_format);
+        if ((str_format != "hex") && (str_format != "number")) {
+            vs_log_mod_error("vsl",
+                "Command field \"format\" should be \"number\" or \"hex\"");
             handle_error();
             return;
+        }
+        hex = (str_format == "hex");
+    }
+
+    /* Bulk query: list of paths and/or glob pattern(s) */
+    if (cJSON_IsArray(p_item_path) ||
+        vs_index_is_pattern(cJSON_GetStringValue(p_item_path))) {
+        cJSON* p_values = cJSON_AddObjectToObject(p_msg, "value");
+        if (nullptr == p_values) {
+            vs_log_mod_error("vsl", "Could not add object to object");
+            handle_error();
+            return;
+        }
+        bool check_dup = (cJSON_GetArraySize(p_item_path) > 1);
+        if (cJSON_IsArray(p_item_path)) {
+            cJSON* p_item;
+            cJSON_ArrayForEach(p_item, p_item_path) {
+                if (0 > vx.add_bulk_values(cJSON_GetStringValue(p_item),
+                                           p_values, check_dup, hex)) {
+                    handle_error();
+                    return;
+                }
+            }
+        } else if (0 > vx.add_bulk_values(cJSON_GetStringValue(p_item_path),
+                                          p_values, check_dup, hex)) {
+            handle_error();
+            return;
+        }
+    } else {
+        char* cstr_path = cJSON_GetStringValue(p_item_path);
+        if (nullptr == cstr_path) {
+            vs_log_mod_error("vsl", "Command field \"path\" NULL");
+            handle_error();
+            return;
+        }
+        std::string str_path(cstr_path);
+        if (str_path.empty()) {
+            vs_log_mod_error("vsl", "Command field \"path\" empty");
+            handle_error();
+            return;
+        }
+        if (0 > vx.add_var_value(str_path, p_msg, "value", hex)) {
+            handle_error();
+            return;
+        }
     }
 
     str_msg = vs_msg_create_message(p_msg, &msg_info);
@@ -410,7 +545,7 @@ void VslInteg<T>::VSL_CMD_HANDLER(get_value) {
         handle_error();
         return;
     }
-    if (0 > vs_msg_write(vx.fd_client_socket, str_msg)) {
+    if (0 > vsl_msg_write(vx.fd_client_socket, str_msg, &msg_info)) {
         vs_log_mod_error("vsl", "Error writing return message");
         handle_error();
         return;
@@ -423,6 +558,144 @@ void VslInteg<T>::VSL_CMD_HANDLER(get_value) {
     return;
 }
 
+/******************************************************************************
+Get list sub-command handler
+******************************************************************************/
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(get_list) {
+
+    cJSON *p_msg;
+    cJSON *p_array;
+    char *str_msg = nullptr;
+    const char *str_pattern = "**";
+    vs_msg_info_t msg_info = VS_MSG_INFO_INIT_JSON;
+    vs_msg_copy_uuid(&msg_info, &vx.uuid);
+
+    /* Lambda function - error handler */
+    auto handle_error = [&](){
+        if (nullptr != p_msg) cJSON_Delete(p_msg);
+        if (nullptr != str_msg) cJSON_free(str_msg);
+        vx._state = VSL_STATE_WAITING;
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command get(sel=list) - Discarding", &vx.uuid);
+    };
+
+    /* Create return message object */
+    p_msg = cJSON_CreateObject();
+    if (nullptr == p_msg) {
+        vs_log_mod_error("vsl", "Could not create cJSON object");
+        handle_error();
+        return;
+    }
+    if (nullptr == cJSON_AddStringToObject(p_msg, "type", "result")) {
+        vs_log_mod_error("vsl", "Could not add string to object");
+        handle_error();
+        return;
+    }
+
+    /* Get the optional pattern from the JSON message content */
+    cJSON *p_item_pattern = cJSON_GetObjectItem(vx.p_cmd, "pattern");
+    if (nullptr != p_item_pattern) {
+        str_pattern = cJSON_GetStringValue(p_item_pattern);
+        if ((nullptr == str_pattern) || std::string(str_pattern).empty()) {
+            vs_log_mod_error("vsl", "Command field \"pattern\" NULL or empty");
+            handle_error();
+            return;
+        }
+    }
+
+    vs_index_t* p_idx = vx.get_index();
+    if (nullptr == p_idx) {
+        handle_error();
+        return;
+    }
+    p_array = cJSON_AddArrayToObject(p_msg, "value");
+    if (nullptr == p_array) {
+        vs_log_mod_error("vsl", "Could not create cJSON array");
+        handle_error();
+        return;
+    }
+    auto visitor = [](const char* str_path, int type, void* p_user) -> int {
+        (void) type;
+        cJSON* p_item = cJSON_CreateString(str_path);
+        if (nullptr == p_item) return 1;
+        cJSON_AddItemToArray(static_cast<cJSON*>(p_user), p_item);
+        return 0;
+    };
+    if (0 > vs_index_match(p_idx, str_pattern, visitor, p_array)) {
+        handle_error();
+        return;
+    }
+
+    str_msg = vs_msg_create_message(p_msg, &msg_info);
+    if (nullptr == str_msg) {
+        vs_log_mod_error("vsl", "NULL pointer");
+        handle_error();
+        return;
+    }
+    if (0 > vsl_msg_write(vx.fd_client_socket, str_msg, &msg_info)) {
+        vs_log_mod_error("vsl", "Error writing return message");
+        handle_error();
+        return;
+    }
+
+    /* Normal exit */
+    if (nullptr != p_msg) cJSON_Delete(p_msg);
+    if (nullptr != str_msg) cJSON_free(str_msg);
+    vx._state = VSL_STATE_WAITING;
+    return;
+}
+
+/******************************************************************************
+Get samples sub-command handler
+******************************************************************************/
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(get_samples) {
+    if (!vx.b_has_edge_sampler) {
+        vs_log_mod_error("vsl", "No sampler armed");
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command get(sel=samples) - Discarding",
+            &vx.uuid);
+        vx._state = VSL_STATE_WAITING;
+        return;
+    }
+
+    std::vector<uint8_t> buffer = vx.edge_samples();
+    if (0 > vsl_msg_return_bin(vx.fd_client_socket, buffer.data(),
+        buffer.size(), &vx.uuid)) {
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command get(sel=samples) - Discarding",
+            &vx.uuid);
+    }
+    vx._state = VSL_STATE_WAITING;
+    return;
+}
+
+/******************************************************************************
+Get recorder sub-command handler
+******************************************************************************/
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(get_recorder) {
+    if (!vx.b_has_recorder) {
+        vs_log_mod_error("vsl", "No recorder armed");
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command get(sel=recorder) - Discarding",
+            &vx.uuid);
+        vx._state = VSL_STATE_WAITING;
+        return;
+    }
+
+    std::vector<uint8_t> buffer = vx.recorder_window();
+    if (0 > vsl_msg_return_bin(vx.fd_client_socket, buffer.data(),
+        buffer.size(), &vx.uuid)) {
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command get(sel=recorder) - Discarding",
+            &vx.uuid);
+    }
+    vx._state = VSL_STATE_WAITING;
+    return;
+}
+
 } //namespace vsl
 
 #endif //VSL_INTEG_CMD_GET_HPP
@@ -0,0 +1,364 @@
+/*****************************************************************************
+ @file vsl_integ_cmd_play.hpp
+ @brief Command handler implementation for the "play" command in the
+ vsl::VslInteg class template.
+
+ The play command applies precomputed input vectors from a memory-mapped
+ binary file to registered variables, one row per clock edge or per time
+ step, without any socket traffic until the file is exhausted or an optional
+ trigger expression is met.
+
+ Main handlers:
+ - VSL_CMD_HANDLER(play): Plays a vector file.
+
+ The mapping of the vector file and the application of its rows are
+ implemented here as well.
+
+ @author Jérémie Chabloz
+ @copyright Copyright (c) 2026 Jérémie Chabloz Distributed under the MIT
+ License. See file for details.
+*******************************************************************************/
+/*
+Copyright (c) 2026 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VSL_INTEG_CMD_PLAY_HPP
+#define VSL_INTEG_CMD_PLAY_HPP
+
+#include "cJSON.h"
+#include "vs_logging.h"
+#include "vs_msg.h"
+#include "vsl/vsl_integ.hpp"
+#include "vsl/vsl_utils.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace vsl{
+
+/******************************************************************************
+Play command handler
+******************************************************************************/
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(play) {
+
+    /* Error handler lambda function */
+    auto handle_error = [&]() {
+        vx.clear_callbacks();
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command play - Discarding", &vx.uuid);
+        vx._state = VSL_STATE_WAITING;
+    };
+
+    /* Get the vector file path from the JSON message content */
+    char* str_path = cJSON_GetStringValue(
+        cJSON_GetObjectItem(vx.p_cmd, "path"));
+    if ((nullptr == str_path) || std::string(str_path).empty()) {
+        vs_log_mod_error("vsl", "Command field \"path\" invalid/not found");
+        handle_error();
+        return;
+    }
+
+    /* Either a clock (one row per edge) or a period (one row per time step)
+    shall be provided */
+    cJSON* p_item_clock = cJSON_GetObjectItem(vx.p_cmd, "clock");
+    cJSON* p_item_period = cJSON_GetObjectItem(vx.p_cmd, "period");
+    if ((nullptr == p_item_clock) == (nullptr == p_item_period)) {
+        vs_log_mod_error("vsl",
+            "Either command field \"clock\" or \"period\" shall be provided");
+        handle_error();
+        return;
+    }
+
+    std::string str_clock;
+    bool b_rising {true};
+    vsl_time_t period {0ull};
+    if (nullptr != p_item_clock) {
+        char* cstr_clock = cJSON_GetStringValue(p_item_clock);
+        if ((nullptr == cstr_clock) || std::string(cstr_clock).empty()) {
+            vs_log_mod_error("vsl", "Command field \"clock\" NULL or empty");
+            handle_error();
+            return;
+        }
+        str_clock = cstr_clock;
+        cJSON* p_item_edge = cJSON_GetObjectItem(vx.p_cmd, "edge");
+        if (nullptr != p_item_edge) {
+            char* cstr_edge = cJSON_GetStringValue(p_item_edge);
+            if ((nullptr != cstr_edge) && (0 == strcmp(cstr_edge, "falling")))
+            {
+                b_rising = false;
+            } else if ((nullptr == cstr_edge) ||
+                (0 != strcmp(cstr_edge, "rising"))) {
+                vs_log_mod_error("vsl", "Command field \"edge\" invalid");
+                handle_error();
+                return;
+            }
+        }
+        vs_log_mod_info("vsl", "Command \"play(path=%s, clock=%s)\" \
+received.", str_path, cstr_clock);
+    } else {
+        double period_value = cJSON_GetNumberValue(p_item_period);
+        if (std::isnan(period_value) || (period_value <= 0.0)) {
+            vs_log_mod_error("vsl",
+                "Command field \"period\" invalid or <= 0.0");
+            handle_error();
+            return;
+        }
+        char* str_time_unit = cJSON_GetStringValue(
+            cJSON_GetObjectItem(vx.p_cmd, "time_unit"));
+        if ((nullptr == str_time_unit) ||
+            !check_time_unit(std::string(str_time_unit)))
+        {
+            vs_log_mod_error(
+                "vsl", "Command field \"time_unit\" invalid/not found");
+            handle_error();
+            return;
+        }
+        period = double_to_time(period_value, str_time_unit, vx.p_context);
+        if (0ull == period) {
+            vs_log_mod_error("vsl", "Period shorter than the time precision");
+            handle_error();
+            return;
+        }
+        vs_log_mod_info("vsl", "Command \"play(path=%s, period=%f %s)\" \
+received.", str_path, period_value, str_time_unit);
+    }
+
+    /* Map the vector file */
+    if (0 > vx.register_player(str_path, str_clock, b_rising, period)) {
+        handle_error();
+        return;
+    }
+
+    /* Optional stop condition */
+    cJSON* p_item_expr = cJSON_GetObjectItem(vx.p_cmd, "expr");
+    if (nullptr != p_item_expr) {
+        char* str_expr = cJSON_GetStringValue(p_item_expr);
+        if ((nullptr == str_expr) || std::string(str_expr).empty()) {
+            vs_log_mod_error("vsl", "Command field \"expr\" NULL or empty");
+            handle_error();
+            return;
+        }
+        if (0 > vx.register_trigger(std::string(str_expr))) {
+            handle_error();
+            return;
+        }
+    }
+
+    /* The first row is applied right away, the next ones on each edge or
+    time step */
+    vx.play_row();
+
+    /* Return control to simulation loop */
+    vx._state = VSL_STATE_SIM_RUNNING;
+    return;
+}
+
+/******************************************************************************
+Stimulus playback
+******************************************************************************/
+template<typename T>
+inline void VslInteg<T>::play_row() {
+    const uint8_t* p_src = p_play_row;
+    for (auto& column : play_columns) {
+        memcpy(column.p_var->get_datap(), p_src, column.size);
+        p_src += column.size;
+    }
+    p_play_row = p_src;
+    play_pos++;
+}
+
+template<typename T>
+inline const bool VslInteg<T>::play_step() {
+    if (play_pos == play_num_rows) {
+        b_play_done = true;
+        return false;
+    }
+    play_row();
+    if (0ull != play_period) cb_time += play_period;
+    return true;
+}
+
+/* Maps the vector file and resolves its columns. The file starts with the
+"VSLV" magic number and the length of a JSON header (32-bit unsigned integer,
+little-endian), followed by the header and by the packed rows. The header
+lists the columns, each one with the path of a registered scalar variable and,
+optionally, its size in bytes. */
+template<typename T>
+int VslInteg<T>::register_player(const std::string& path,
+    const std::string& clock, const bool rising, const vsl_time_t period)
+{
+    if (has_callback()) {
+        vs_log_mod_error("vsl", "Could not register player as another \
+callback is already registered - Discarding");
+        return -1;
+    }
+    if ((0ull == period) && !clock_map.has_clock(clock)) {
+        vs_log_mod_error("vsl", "Could not register player - Clock %s not \
+found - Discarding", clock.c_str());
+        return -1;
+    }
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (0 > fd) {
+        vs_log_mod_perror("vsl", "Could not open vector file");
+        return -1;
+    }
+    struct stat file_stat;
+    if ((0 > fstat(fd, &file_stat)) || (8 > file_stat.st_size)) {
+        vs_log_mod_error("vsl", "Vector file %s invalid", path.c_str());
+        close(fd);
+        return -1;
+    }
+    play_map_size = static_cast<size_t>(file_stat.st_size);
+    void* p_map = mmap(nullptr, play_map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == p_map) {
+        vs_log_mod_perror("vsl", "Could not map vector file");
+        return -1;
+    }
+    madvise(p_map, play_map_size, MADV_SEQUENTIAL);
+    p_play_map = static_cast<const uint8_t*>(p_map);
+
+    /* Header */
+    const size_t header_len = static_cast<size_t>(p_play_map[4]) |
+        (static_cast<size_t>(p_play_map[5]) << 8) |
+        (static_cast<size_t>(p_play_map[6]) << 16) |
+        (static_cast<size_t>(p_play_map[7]) << 24);
+    if ((0 != memcmp(p_play_map, "VSLV", 4)) ||
+        (play_map_size - 8 < header_len)) {
+        vs_log_mod_error("vsl", "Vector file %s header invalid", path.c_str());
+        clear_player();
+        return -1;
+    }
+    cJSON* p_header = cJSON_ParseWithLength(
+        reinterpret_cast<const char*>(p_play_map + 8), header_len);
+    cJSON* p_columns = cJSON_GetObjectItem(p_header, "columns");
+    std::vector<std::string> paths;
+    std::vector<double> sizes;
+    cJSON* iterator;
+    cJSON_ArrayForEach(iterator, p_columns) {
+        char* str_path = cJSON_GetStringValue(
+            cJSON_GetObjectItem(iterator, "path"));
+        if (nullptr == str_path) break;
+        paths.emplace_back(str_path);
+        cJSON* p_size = cJSON_GetObjectItem(iterator, "size");
+        sizes.push_back((nullptr != p_size) ? cJSON_GetNumberValue(p_size) :
+            0.0);
+    }
+    bool b_valid = cJSON_IsArray(p_columns) && !paths.empty() &&
+        (static_cast<int>(paths.size()) == cJSON_GetArraySize(p_columns));
+    cJSON_Delete(p_header);
+    if (!b_valid) {
+        vs_log_mod_error("vsl", "Vector file %s header invalid", path.c_str());
+        clear_player();
+        return -1;
+    }
+
+    /* Columns, with their native sizes */
+    if (0 > edge_columns_init(paths, 0, play_columns)) {
+        clear_player();
+        return -1;
+    }
+    size_t row_size {0};
+    for (size_t i = 0; i < play_columns.size(); i++) {
+        auto& column = play_columns[i];
+        if (VSL_TYPE_SCALAR != column.p_var->get_type()) {
+            vs_log_mod_error("vsl", "Variable %s cannot be played - \
+Discarding", column.path.c_str());
+            clear_player();
+            return -1;
+        }
+        if ((0.0 != sizes[i]) &&
+            (static_cast<double>(column.size) != sizes[i])) {
+            vs_log_mod_error("vsl", "Size of column %s inconsistent with \
+variable (%zu bytes) - Discarding", column.path.c_str(), column.size);
+            clear_player();
+            return -1;
+        }
+        row_size += column.size;
+    }
+    const size_t data_size = play_map_size - 8 - header_len;
+    if ((0 == data_size) || (0 != data_size % row_size)) {
+        vs_log_mod_error("vsl", "Vector file %s size inconsistent with its \
+rows size (%zu bytes) - Discarding", path.c_str(), row_size);
+        clear_player();
+        return -1;
+    }
+    play_num_rows = data_size / row_size;
+    p_play_row = p_play_map + 8 + header_len;
+    play_pos = 0;
+    b_play_done = false;
+    play_period = period;
+
+    if (0ull != period) {
+        if (0 > register_time_callback(p_context->time() + period)) {
+            clear_player();
+            return -1;
+        }
+    } else {
+        p_play_clock = static_cast<const CData*>(
+            clock_map.get_clock(clock).get_datap());
+        play_level = rising ? 1 : 0;
+    }
+    b_has_player = true;
+    vs_log_mod_info("vsl", "Playing %zu rows of %zu bytes from %s",
+        play_num_rows, row_size, path.c_str());
+    return 0;
+}
+
+template<typename T>
+void VslInteg<T>::clear_player() {
+    if (nullptr != p_play_map) {
+        munmap(const_cast<uint8_t*>(p_play_map), play_map_size);
+    }
+    b_has_player = false;
+    b_play_done = false;
+    p_play_map = nullptr;
+    play_map_size = 0;
+    p_play_row = nullptr;
+    play_num_rows = 0;
+    play_period = 0ull;
+    p_play_clock = nullptr;
+    play_columns.clear();
+}
+
+template<typename T>
+void VslInteg<T>::play_return(const bool b_triggered) {
+    vs_log_mod_info("vsl", "Played %zu rows out of %zu", play_pos,
+        play_num_rows);
+    cJSON* p_fields = cJSON_CreateObject();
+    cJSON_AddNumberToObject(p_fields, "rows", play_pos);
+    cJSON_AddBoolToObject(p_fields, "triggered", b_triggered);
+    vsl_msg_return_ack(fd_client_socket, "Processed command \"play\"",
+        p_fields, &uuid);
+}
+
+} //namespace vsl
+
+#endif //VSL_INTEG_CMD_PLAY_HPP
+//EOF
@@ -0,0 +1,209 @@
+/*****************************************************************************
+ @file vsl_integ_cmd_plugin.hpp
+ @brief Command handler implementation for the plugin commands in the
+ vsl::VslInteg class template.
+
+ Plugin commands are named "<plugin>.<command>" (e.g. "spi.write") and are
+ forwarded to the registered plugin with the corresponding name. If the
+ plugin starts a transaction, the simulation runs until it is done and the
+ result is returned with the acknowledgement.
+
+ Main handlers:
+ - VSL_CMD_HANDLER(plugin): Forwards a command to a plugin.
+
+ The registration of the plugins and their calls on clock edges are
+ implemented here as well.
+
+ @author Jérémie Chabloz
+ @copyright Copyright (c) 2026 Jérémie Chabloz Distributed under the MIT
+ License. See file for details.
+*******************************************************************************/
+/*
+Copyright (c) 2026 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VSL_INTEG_CMD_PLUGIN_HPP
+#define VSL_INTEG_CMD_PLUGIN_HPP
+
+#include "cJSON.h"
+#include "vs_logging.h"
+#include "vs_msg.h"
+#include "vsl/vsl_integ.hpp"
+#include "vsl/vsl_plugin.hpp"
+#include "vsl/vsl_utils.hpp"
+
+#include <string>
+
+namespace vsl{
+
+/******************************************************************************
+Plugin command handler
+******************************************************************************/
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(plugin) {
+
+    /* Error handler lambda function */
+    auto handle_error = [&]() {
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing plugin command - Discarding", &vx.uuid);
+        vx._state = VSL_STATE_WAITING;
+    };
+
+    /* Split the command into the plugin name and the plugin command */
+    std::string str_cmd {cJSON_GetStringValue(
+        cJSON_GetObjectItem(vx.p_cmd, "command"))};
+    size_t pos = str_cmd.find('.');
+    std::string str_name = str_cmd.substr(0, pos);
+    std::string str_plugin_cmd = str_cmd.substr(pos + 1);
+    vs_log_mod_info("vsl", "Command \"%s\" received.", str_cmd.c_str());
+
+    VslPlugin* p_plugin = vx.get_plugin(str_name);
+    if (nullptr == p_plugin) {
+        vs_log_mod_error("vsl", "Plugin %s not found", str_name.c_str());
+        handle_error();
+        return;
+    }
+
+    int retval = p_plugin->command(str_plugin_cmd, vx.p_cmd);
+    vx.plugin_cmd = str_cmd;
+    switch (retval) {
+        case VSL_PLUGIN_DONE:
+            vx.plugin_return(p_plugin);
+            vx._state = VSL_STATE_WAITING;
+            return;
+        case VSL_PLUGIN_BUSY:
+            /* Return control to simulation loop until the transaction is
+            done */
+            vx.p_plugin_active = p_plugin;
+            vx._state = VSL_STATE_SIM_RUNNING;
+            return;
+        default:
+            vs_log_mod_error("vsl", "Command %s could not be processed",
+                str_cmd.c_str());
+            handle_error();
+            return;
+    }
+}
+
+/******************************************************************************
+Plugins
+******************************************************************************/
+template<typename T>
+inline void VslInteg<T>::plugins_step() {
+    for (auto& slot : plugins) {
+        const CData level = *slot.p_clock;
+        if (level == slot.level) continue;
+        slot.level = level;
+        switch (slot.p_plugin->get_edge()) {
+            case VSL_PLUGIN_RISING:
+                if (level) slot.p_plugin->on_edge(true);
+                break;
+            case VSL_PLUGIN_FALLING:
+                if (!level) slot.p_plugin->on_edge(false);
+                break;
+            default:
+                slot.p_plugin->on_edge(0 != level);
+                break;
+        }
+    }
+}
+
+template<typename T>
+int VslInteg<T>::register_plugin(std::unique_ptr<VslPlugin> p_plugin) {
+    if (nullptr == p_plugin) return -1;
+    const std::string& name = p_plugin->get_name();
+    if (name.empty() || (std::string::npos != name.find('.')) ||
+        (nullptr != get_plugin(name))) {
+        vs_log_mod_error("vsl", "Could not register plugin - Name %s invalid \
+or already used", name.c_str());
+        return -1;
+    }
+    const CData* p_clock = get_plugin_clock(p_plugin->get_clock());
+    if (nullptr == p_clock) {
+        vs_log_mod_error("vsl", "Could not register plugin %s - Clock %s not \
+found", name.c_str(), p_plugin->get_clock().c_str());
+        return -1;
+    }
+    if (0 > p_plugin->bind(var_map)) {
+        vs_log_mod_error("vsl", "Could not register plugin %s - Variables not \
+found", name.c_str());
+        return -1;
+    }
+    vs_log_mod_info("vsl", "Registered plugin %s (clock %s)", name.c_str(),
+        p_plugin->get_clock().c_str());
+    plugins.push_back(PluginSlot {std::move(p_plugin), p_clock, *p_clock});
+    return 0;
+}
+
+template<typename T>
+VslPlugin* VslInteg<T>::get_plugin(const std::string& name) {
+    for (auto& slot : plugins) {
+        if (name == slot.p_plugin->get_name()) return slot.p_plugin.get();
+    }
+    return nullptr;
+}
+
+/* A plugin is called on the edges of a registered clock or of a registered
+1-bit scalar variable (e.g. the clock of a bus driven by the design or by
+another plugin) */
+template<typename T>
+const CData* VslInteg<T>::get_plugin_clock(const std::string& path) {
+    if (clock_map.has_clock(path)) {
+        return static_cast<const CData*>(
+            clock_map.get_clock(path).get_datap());
+    }
+    if (!var_map.has_var(path)) return nullptr;
+    VslVar* p_var = var_map.get_var(path);
+    if ((VSL_TYPE_SCALAR != p_var->get_type()) ||
+        (VLVT_UINT8 != p_var->get_vltype())) {
+        return nullptr;
+    }
+    return static_cast<const CData*>(p_var->get_datap());
+}
+
+/* Resolves the clocks again (after a restart) and takes their current levels
+as reference for the next edges */
+template<typename T>
+void VslInteg<T>::plugins_rebind() {
+    for (auto& slot : plugins) {
+        slot.p_clock = get_plugin_clock(slot.p_plugin->get_clock());
+        slot.level = *slot.p_clock;
+    }
+}
+
+template<typename T>
+void VslInteg<T>::plugin_return(VslPlugin* p_plugin) {
+    std::string str_value = "Processed command \"" + plugin_cmd + "\"";
+    cJSON* p_fields = cJSON_CreateObject();
+    if ((nullptr == p_fields) || (0 > p_plugin->result(p_fields))) {
+        vs_log_mod_error("vsl", "Could not create return message");
+        cJSON_Delete(p_fields);
+        vsl_msg_return(fd_client_socket, "error",
+            "Error processing plugin command result", &uuid);
+        return;
+    }
+    vsl_msg_return_ack(fd_client_socket, str_value.c_str(), p_fields, &uuid);
+}
+
+} //namespace vsl
+
+#endif //VSL_INTEG_CMD_PLUGIN_HPP
+//EOF
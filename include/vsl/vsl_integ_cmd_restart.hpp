@@ -0,0 +1,222 @@
+/*****************************************************************************
+ @file vsl_integ_cmd_restart.hpp
+ @brief Command handler implementation for the "restart" command in the
+ vsl::VslInteg class template.
+
+ The restart command restarts the simulation from time 0 within the same
+ process, while the client stays connected. The model is reconstructed in
+ place, so that back-to-back tests can be run without relaunching the
+ simulation executable.
+
+ Main handlers:
+ - VSL_CMD_HANDLER(restart): Restarts the simulation.
+
+ The reconstruction of the model is implemented here as well.
+
+ @author Jérémie Chabloz
+ @copyright Copyright (c) 2026 Jérémie Chabloz Distributed under the MIT
+ License. See file for details.
+*******************************************************************************/
+/*
+Copyright (c) 2026 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VSL_INTEG_CMD_RESTART_HPP
+#define VSL_INTEG_CMD_RESTART_HPP
+
+#include "cJSON.h"
+#include "vs_logging.h"
+#include "vs_msg.h"
+#include "vsl/vsl_integ.hpp"
+
+#include <chrono>
+#include <new>
+#include <string>
+
+namespace vsl{
+
+/******************************************************************************
+Restart command handler
+******************************************************************************/
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(restart) {
+
+    vs_log_mod_info("vsl", "Command \"restart\" received.");
+    if (0 > vx.restart_model()) {
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command restart - Discarding", &vx.uuid);
+        /* Error state if the model has been reconstructed but the registered
+        variables could not be resolved again */
+        if (VSL_STATE_ERROR != vx._state) vx._state = VSL_STATE_WAITING;
+        return;
+    }
+    vsl_msg_return(vx.fd_client_socket, "ack", "Simulation restarted",
+        &vx.uuid);
+    vx._state = VSL_STATE_WAITING;
+    return;
+}
+
+/******************************************************************************
+Restart
+******************************************************************************/
+/*
+Restarts the simulation from time 0 without relaunching the process. The model
+is finalized, destroyed and constructed again in place, so that its address is
+unchanged, with the same Verilator context and hierarchical name; its initial
+blocks are thus run again with the next evaluation. The registered variables
+either belong to the model object itself, which is at the same address, or to
+its symbol table, which is allocated again by the model constructor. The
+latter are identified by their Verilator scope and variable names before the
+model is destroyed and resolved again by name afterwards, as for
+auto_register(); the restart is refused if one of them is not a public
+variable of the model. Clocks are rescheduled as at the start of the
+simulation and callbacks are cleared. The clock edge sampler and flight
+recorder, if any, remain armed but their samples are discarded and the
+plugins are reset. The trace object, attached to the former model, is closed
+and deleted. If a variable cannot be resolved again once the model has been
+reconstructed, the simulation cannot go on and the state is set to error.
+*/
+template<typename T>
+int VslInteg<T>::restart_model() {
+    if (has_callback() || has_sampler()) {
+        vs_log_mod_error("vsl", "Cannot restart with a pending callback");
+        return -1;
+    }
+    auto t_start = std::chrono::steady_clock::now();
+
+    /* Verilator scope and variable names, by data pointer, of the registered
+    variables which are not members of the model object */
+    const uintptr_t model_start = reinterpret_cast<uintptr_t>(p_model);
+    const uintptr_t model_end = model_start + sizeof(T);
+    auto is_member = [&](void* datap) {
+        uintptr_t addr = reinterpret_cast<uintptr_t>(datap);
+        return (nullptr == datap) ||
+            ((addr >= model_start) && (addr < model_end));
+    };
+    std::unordered_map<void*, std::pair<std::string, std::string>> var_names;
+    const VerilatedScopeNameMap* p_scope_map = p_context->scopeNameMap();
+    if (nullptr != p_scope_map) {
+        for (const auto& scope : *p_scope_map) {
+            std::string str_scope;
+            if (!get_relative_scope(scope.first, str_scope)) continue;
+            VerilatedVarNameMap* p_vars = scope.second->varsp();
+            if (nullptr == p_vars) continue;
+            for (const auto& var : *p_vars) {
+                var_names.try_emplace(var.second.datap(), scope.first,
+                    var.first);
+            }
+        }
+    }
+    for (const auto& name : var_map.get_names()) {
+        void* datap = var_map.get_var(name)->get_datap();
+        if (!is_member(datap) && (0 == var_names.count(datap))) {
+            vs_log_mod_error("vsl", "Variable %s is not a public variable of \
+the model - Cannot restart", name.c_str());
+            return -1;
+        }
+    }
+    /* The clocks are only checked, without being modified */
+    bool b_resolved = true;
+    clock_map.rebind([&](void* datap) -> void* {
+        if (!is_member(datap) && (0 == var_names.count(datap))) {
+            b_resolved = false;
+        }
+        return datap;
+    });
+    if (!b_resolved) {
+        vs_log_mod_error("vsl", "Clock variable is not a public variable of \
+the model - Cannot restart");
+        return -1;
+    }
+
+    if (b_trace_active) trace_stop();
+    #ifdef VSL_TRACE_VCD
+    p_trace_vcd.reset();
+    #endif
+    #ifdef VSL_TRACE_FST
+    p_trace_fst.reset();
+    #endif
+    trace_format.clear();
+    trace_depth = 0;
+    trace_last_time = 0;
+
+    /* The hierarchy index refers to the variables and scopes of the model */
+    if (nullptr != p_index) {
+        vs_index_free(p_index);
+        p_index = nullptr;
+    }
+
+    const std::string name {p_model->hierName()};
+    p_model->final();
+    p_model->~T();
+    p_context->time(0);
+    p_context->gotFinish(false);
+    new (p_model) T{p_context, name.c_str()};
+
+    auto fn_rebind = [&](void* datap) -> void* {
+        if (is_member(datap)) return datap;
+        const auto& names = var_names.at(datap);
+        const VerilatedScope* p_scope =
+            p_context->scopeFind(names.first.c_str());
+        const VerilatedVar* p_var = (nullptr == p_scope) ? nullptr :
+            p_scope->varFind(names.second.c_str());
+        if (nullptr == p_var) {
+            vs_log_mod_error("vsl", "Could not resolve %s.%s after restart",
+                names.first.c_str(), names.second.c_str());
+            b_resolved = false;
+            return nullptr;
+        }
+        return p_var->datap();
+    };
+    var_map.rebind(fn_rebind);
+    clock_map.rebind(fn_rebind);
+    if (!b_resolved) {
+        _state = VSL_STATE_ERROR;
+        return -1;
+    }
+    clock_map.set_states(clock_states_init);
+    clock_map.set_levels(clock_levels_init);
+    clear_callbacks();
+    if (b_has_edge_sampler) {
+        p_edge_clock = static_cast<const CData*>(
+            clock_map.get_clock(edge_clock).get_datap());
+        edge_count = 0;
+        edge_dropped = 0ull;
+    }
+    if (b_has_recorder) {
+        p_rec_clock = static_cast<const CData*>(
+            clock_map.get_clock(rec_clock).get_datap());
+        reset_recorder();
+    }
+    for (auto& slot : plugins) slot.p_plugin->reset();
+    plugins_rebind();
+
+    std::chrono::duration<double> t_restart =
+        std::chrono::steady_clock::now() - t_start;
+    vs_log_mod_info("vsl", "Model restarted in %.3f ms",
+        1.0e3*t_restart.count());
+    return 0;
+}
+
+} //namespace vsl
+
+#endif //VSL_INTEG_CMD_RESTART_HPP
+//EOF
@@ -17,6 +17,10 @@ Main handlers:
      absolute simulation time.
    - VSL_CMD_HANDLER(run_until_change): Runs the simulation until a variable or
      event changes to a specified value.
+   - VSL_CMD_HANDLER(run_sample): Runs the simulation while periodically
+     sampling a list of variables and returns the full time series at once.
+   - VSL_CMD_HANDLER(run_until_expr): Runs the simulation until a trigger
+     expression is met, optionally with a time deadline.
 
  Each handler performs input validation, error handling, and registers
  appropriate callbacks to control simulation flow. The handlers interact with
@@ -60,6 +64,7 @@ SOFTWARE.
 #include "verilated.h"
 
 #include <string>
+#include <vector>
 
 namespace vsl{
 
@@ -71,7 +76,7 @@ void VslInteg<T>::VSL_CMD_HANDLER(run) {
 
     /* Error handler lambda function */
     auto handle_error = [&]() {
-        vs_msg_return(vx.fd_client_socket, "error",
+        vsl_msg_return(vx.fd_client_socket, "error",
             "Error processing command run - Discarding", &vx.uuid);
         vx._state = VSL_STATE_WAITING;
     };
@@ -104,7 +109,7 @@ void VslInteg<T>::VSL_CMD_HANDLER(run) {
     /* Error case - sub-command handler function not found */
     vs_log_mod_error("vsl", "Handler for sub-command %s not found",
         cb_key.c_str());
-    vs_msg_return(vx.fd_client_socket, "error",
+    vsl_msg_return(vx.fd_client_socket, "error",
         "Could not find handler for sub-command. Discarding.", &vx.uuid);
     vx._state = VSL_STATE_WAITING;
     return;
@@ -117,7 +122,7 @@ void VslInteg<T>::VSL_CMD_HANDLER(run_for_time) {
     auto handle_error = [&]() {
         vs_log_mod_warning(
             "vsl", "Error processing command run(for_time) - Discarding");
-        vs_msg_return(vx.fd_client_socket, "error",
+        vsl_msg_return(vx.fd_client_socket, "error",
             "Error processing command run(for time) - Discarding", &vx.uuid);
         vx._state = VSL_STATE_WAITING;
     };
@@ -189,7 +194,7 @@ void VslInteg<T>::VSL_CMD_HANDLER(run_to_next) {
     auto handle_error = [&]() {
         vs_log_mod_warning(
             "vsl", "Error processing command run(to_next) - Discarding");
-        vs_msg_return(vx.fd_client_socket, "error",
+        vsl_msg_return(vx.fd_client_socket, "error",
             "Error processing command run(to_next) - Discarding", &vx.uuid);
         vx._state = VSL_STATE_WAITING;
     };
@@ -225,7 +230,7 @@ void VslInteg<T>::VSL_CMD_HANDLER(run_until_time) {
     auto handle_error = [&]() {
         vs_log_mod_warning(
             "vsl", "Error processing command run(until_time) - Discarding");
-        vs_msg_return(vx.fd_client_socket, "error",
+        vsl_msg_return(vx.fd_client_socket, "error",
             "Error processing command run(until_time) - Discarding", &vx.uuid);
         vx._state = VSL_STATE_WAITING;
     };
@@ -290,7 +295,7 @@ void VslInteg<T>::VSL_CMD_HANDLER(run_until_change) {
     auto handle_error = [&]() {
         vs_log_mod_warning(
             "vsl", "Error processing command run(until_change) - Discarding");
-        vs_msg_return(vx.fd_client_socket, "error",
+        vsl_msg_return(vx.fd_client_socket, "error",
             "Error processing command run(until_change) - Discarding", &vx.uuid);
         vx._state = VSL_STATE_WAITING;
     };
@@ -319,6 +324,18 @@ void VslInteg<T>::VSL_CMD_HANDLER(run_until_change) {
         return;
     }
 
+    /* Edge, comparison operator, mask and count trigger options are
+    currently not supported */
+    for (const char* str_key : {"edge", "op", "mask", "count"}) {
+        if (cJSON_HasObjectItem(vx.p_cmd, str_key)) {
+            vs_log_mod_error("vsl",
+                "Command field \"%s\" not supported for run(until_change)",
+                str_key);
+            handle_error();
+            return;
+        }
+    }
+
     /* Get the value from the JSON message content */
     cJSON* p_item_val;
     double value;
@@ -360,6 +377,210 @@ void VslInteg<T>::VSL_CMD_HANDLER(run_until_change) {
     return;
 }
 
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(run_sample) {
+
+    /* Error handler lambda function */
+    auto handle_error = [&]() {
+        vs_log_mod_warning(
+            "vsl", "Error processing command run(sample) - Discarding");
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command run(sample) - Discarding", &vx.uuid);
+        vx.clear_callbacks();
+        vx._state = VSL_STATE_WAITING;
+    };
+
+    /* Get the period field from the JSON message content */
+    cJSON* p_item_period;
+    p_item_period = cJSON_GetObjectItem(vx.p_cmd, "period");
+    if (nullptr == p_item_period) {
+        vs_log_mod_error("vsl", "Command field \"period\" invalid/not found");
+        handle_error();
+        return;
+    }
+    double period_value;
+    period_value = cJSON_GetNumberValue(p_item_period);
+    if (std::isnan(period_value) || (period_value <= 0.0)) {
+        vs_log_mod_error("vsl", "Command field \"period\" invalid or <= 0.0");
+        handle_error();
+        return;
+    }
+
+    /* Get the time unit field from the JSON message content */
+    cJSON* p_item_unit;
+    p_item_unit = cJSON_GetObjectItem(vx.p_cmd, "time_unit");
+    if (nullptr == p_item_unit) {
+        vs_log_mod_error(
+            "vsl", "Command field \"time_unit\" invalid/not found");
+        handle_error();
+        return;
+    }
+    char* str_time_unit;
+    str_time_unit = cJSON_GetStringValue(p_item_unit);
+    if ((nullptr == str_time_unit) || std::string(str_time_unit).empty()) {
+        vs_log_mod_error("vsl", "Command field \"time_unit\" NULL or empty");
+        handle_error();
+        return;
+    }
+    if (!check_time_unit(std::string(str_time_unit))) {
+        vs_log_mod_error("vsl", "Wrong time unit identifier: %s", str_time_unit);
+        handle_error();
+        return;
+    }
+
+    /* Get the number of samples from the JSON message content */
+    cJSON* p_item_count;
+    p_item_count = cJSON_GetObjectItem(vx.p_cmd, "count");
+    if (nullptr == p_item_count) {
+        vs_log_mod_error("vsl", "Command field \"count\" invalid/not found");
+        handle_error();
+        return;
+    }
+    double count_value;
+    count_value = cJSON_GetNumberValue(p_item_count);
+    if (!check_count(count_value) || (count_value < 1.0)) {
+        vs_log_mod_error("vsl", "Command field \"count\" invalid or < 1");
+        handle_error();
+        return;
+    }
+
+    /* Get the list of paths (a single path string is also accepted) */
+    cJSON* p_item_path;
+    p_item_path = cJSON_GetObjectItem(vx.p_cmd, "path");
+    if (nullptr == p_item_path) {
+        vs_log_mod_error("vsl", "Command field \"path\" invalid/not found");
+        handle_error();
+        return;
+    }
+    std::vector<std::string> paths;
+    if (cJSON_IsArray(p_item_path)) {
+        cJSON* iterator;
+        cJSON_ArrayForEach(iterator, p_item_path) {
+            char* str_path = cJSON_GetStringValue(iterator);
+            if ((nullptr == str_path) || std::string(str_path).empty()) {
+                vs_log_mod_error("vsl", "Command field \"path\" NULL or empty");
+                handle_error();
+                return;
+            }
+            paths.emplace_back(str_path);
+        }
+    } else {
+        char* str_path = cJSON_GetStringValue(p_item_path);
+        if ((nullptr == str_path) || std::string(str_path).empty()) {
+            vs_log_mod_error("vsl", "Command field \"path\" NULL or empty");
+            handle_error();
+            return;
+        }
+        paths.emplace_back(str_path);
+    }
+    if (paths.empty()) {
+        vs_log_mod_error("vsl", "Command field \"path\" empty");
+        handle_error();
+        return;
+    }
+    vs_log_mod_info("vsl",
+        "Command \"run(cb=sample, period=%f %s, count=%d, path=[%d])\" \
+received.", period_value, str_time_unit, (int) count_value, (int) paths.size());
+
+    /* Register time callback for the first sample, then the sampler */
+    uint64_t period;
+    period = double_to_time(period_value, str_time_unit, vx.p_context);
+    if (0ull == period) {
+        vs_log_mod_error("vsl", "Sampling period shorter than time precision");
+        handle_error();
+        return;
+    }
+    if (0 > vx.register_time_callback(vx.p_context->time() + period)) {
+        handle_error();
+        return;
+    }
+    if (0 > vx.register_sampler(
+        period, static_cast<size_t>(count_value), paths)) {
+        handle_error();
+        return;
+    }
+
+    /* Return control to simulation loop */
+    vx._state = VSL_STATE_SIM_RUNNING;
+    return;
+}
+
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(run_until_expr) {
+
+    /* Error handler lambda function */
+    auto handle_error = [&]() {
+        vx.clear_callbacks();
+        vs_log_mod_warning(
+            "vsl", "Error processing command run(until_expr) - Discarding");
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command run(until_expr) - Discarding", &vx.uuid);
+        vx._state = VSL_STATE_WAITING;
+    };
+
+    /* Get the trigger expression from the JSON message content */
+    cJSON* p_item_expr;
+    p_item_expr = cJSON_GetObjectItem(vx.p_cmd, "expr");
+    if (nullptr == p_item_expr) {
+        vs_log_mod_error("vsl", "Command field \"expr\" invalid/not found");
+        handle_error();
+        return;
+    }
+    char* str_expr;
+    str_expr = cJSON_GetStringValue(p_item_expr);
+    if ((nullptr == str_expr) || std::string(str_expr).empty()) {
+        vs_log_mod_error("vsl", "Command field \"expr\" NULL or empty");
+        handle_error();
+        return;
+    }
+
+    /* Optional deadline (time relative to the current simulation time) */
+    cJSON* p_item_time;
+    p_item_time = cJSON_GetObjectItem(vx.p_cmd, "time");
+    if (nullptr != p_item_time) {
+        double time_value;
+        time_value = cJSON_GetNumberValue(p_item_time);
+        if (std::isnan(time_value) || (time_value <= 0.0)) {
+            vs_log_mod_error("vsl", "Command field \"time\" invalid or <= 0.0");
+            handle_error();
+            return;
+        }
+        char* str_time_unit;
+        str_time_unit = cJSON_GetStringValue(
+            cJSON_GetObjectItem(vx.p_cmd, "time_unit"));
+        if ((nullptr == str_time_unit) ||
+            !check_time_unit(std::string(str_time_unit)))
+        {
+            vs_log_mod_error(
+                "vsl", "Command field \"time_unit\" invalid/not found");
+            handle_error();
+            return;
+        }
+        vs_log_mod_info("vsl", "Command \"run(cb=until_expr, expr=%s, \
+time=%f %s)\" received.", str_expr, time_value, str_time_unit);
+        uint64_t cb_time;
+        cb_time = double_to_time(time_value, str_time_unit, vx.p_context);
+        cb_time += vx.p_context->time();
+        if (0 > vx.register_time_callback(cb_time)) {
+            handle_error();
+            return;
+        }
+    } else {
+        vs_log_mod_info("vsl",
+            "Command \"run(cb=until_expr, expr=%s)\" received.", str_expr);
+    }
+
+    /* Compile and register trigger */
+    if (0 > vx.register_trigger(std::string(str_expr))) {
+        handle_error();
+        return;
+    }
+
+    /* Return control to simulation loop */
+    vx._state = VSL_STATE_SIM_RUNNING;
+    return;
+}
+
 } //namespace vsl
 
 #endif //VSL_INTEG_CMD_RUN_HPP
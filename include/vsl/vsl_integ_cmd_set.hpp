@@ -30,8 +30,10 @@ SOFTWARE.
 #include "vsl/vsl_utils.hpp"
 #include "verilated.h"
 
+#include <cstring>
 #include <string>
 #include <cmath>
+#include <vector>
 
 namespace vsl{
 
@@ -43,7 +45,7 @@ void VslInteg<T>::VSL_CMD_HANDLER(set) {
 
     /* Error handler lambda function */
     auto handle_error = [&]() {
-        vs_msg_return(vx.fd_client_socket, "error",
+        vsl_msg_return(vx.fd_client_socket, "error",
             "Error processing command set - Discarding", &vx.uuid);
         vx._state = VSL_STATE_WAITING;
     };
@@ -73,7 +75,7 @@ void VslInteg<T>::VSL_CMD_HANDLER(set) {
             /* Error case - sub-command handler function not found */
             vs_log_mod_error("vsl", "Handler for sub-command %s not found",
                 sel_key.c_str());
-            vs_msg_return(vx.fd_client_socket, "error",
+            vsl_msg_return(vx.fd_client_socket, "error",
                 "Could not find handler for sub-command. Discarding.",
                 &vx.uuid);
                 vx._state = VSL_STATE_WAITING;
@@ -87,48 +89,27 @@ void VslInteg<T>::VSL_CMD_HANDLER(set) {
 }
 
 /******************************************************************************
-Set value sub-command handler
+Set the value of a registered variable from a message item
 ******************************************************************************/
 template<typename T>
-void VslInteg<T>::VSL_CMD_HANDLER(set_value) {
-
-    /* Error handler lambda function */
-    auto handle_error = [&]() {
-        vs_msg_return(vx.fd_client_socket, "error",
-            "Error processing command set - Discarding", &vx.uuid);
-        vx._state = VSL_STATE_WAITING;
-    };
-
-    /* Get the object path from the JSON message content */
-    cJSON *p_item_path = cJSON_GetObjectItem(vx.p_cmd, "path");
-    if (nullptr == p_item_path) {
-        vs_log_mod_error("vsl", "Command field \"path\" invalid/not found");
-        handle_error();
-        return;
-    }
-
-    /* Get the path argument as a string */
-    char *cstr_path = cJSON_GetStringValue(p_item_path);
-    std::string str_path(cstr_path);
-    if ((nullptr == cstr_path) || std::string(str_path).empty()) {
-        vs_log_mod_error("vsl", "Command field \"path\" NULL or empty");
-        handle_error();
-        return;
-    }
-    vs_log_mod_info("vsl", "Command \"set(path=%s)\" received.", cstr_path);
+int VslInteg<T>::set_var_value(std::string str_path, cJSON* p_item_val) {
 
     /* Check if the provided path contains the [ ] range selection operator*/
     bool path_has_range = has_range(str_path);
+    VslArrayRanges path_ranges;
     VslArrayRange path_range;
     VslVar* p_var;
     if (path_has_range) {
-        path_range = get_range(str_path);
-        vs_log_mod_debug("vsl", "Range found (left: %d, right %d, incr %d)",
-            (int) path_range.left, (int) path_range.right,
-            (int) path_range.incr);
-        p_var = vx.get_registered_variable(path_range.array_name);
+        path_ranges = get_ranges(str_path);
+        for (const auto& range : path_ranges.ranges) {
+            vs_log_mod_debug("vsl",
+                "Range found (left: %d, right %d, incr %d)",
+                (int) range.left, (int) range.right, (int) range.incr);
+        }
+        if (!path_ranges.ranges.empty()) path_range = path_ranges.ranges[0];
+        p_var = get_registered_variable(path_ranges.array_name);
     } else {
-        p_var = vx.get_registered_variable(str_path);
+        p_var = get_registered_variable(str_path);
     }
 
     /* Attempt to get a pointer to the variable */
@@ -137,66 +118,54 @@ void VslInteg<T>::VSL_CMD_HANDLER(set_value) {
             "vsl", "Variable %s not found registered variable map",
             str_path.c_str()
         );
-        handle_error();
-        return;
+        return -1;
     }
 
     /* Consistency checks on range */
-    if (path_has_range) {
+    if (path_has_range && (p_var->get_type() != VSL_TYPE_MDARRAY)) {
         if (p_var->get_type() != VSL_TYPE_ARRAY) {
             vs_log_mod_error(
                 "vsl", "Range operator [] only supported for array type");
-            handle_error();
-            return;
+            return -1;
+        }
+        if (1 != path_ranges.ranges.size()) {
+            vs_log_mod_error("vsl",
+                "Array %s has a single dimension - Only one range operator \
+[] supported", path_ranges.array_name.c_str());
+            return -1;
         }
         if ((path_range.left >= p_var->get_depth()) ||
             (path_range.right >= p_var->get_depth())) {
             vs_log_mod_error("vsl", "Range overflow");
-            handle_error();
-            return;
+            return -1;
         }
     }
 
-    double value {0.0f};
-    cJSON *p_item_val = cJSON_GetObjectItem(vx.p_cmd, "value");
     /* Scalar variables */
     int ack = 0;
     switch (p_var->get_type()) {
         case VSL_TYPE_SCALAR:
+            /* Numbers or hexadecimal strings (integer-exact) */
+            return (nullptr == p_item_val) ? p_var->set_value(0.0) :
+                p_var->set_json_value(p_item_val);
         case VSL_TYPE_EVENT:
-            if (nullptr != p_item_val) {
-                value = cJSON_GetNumberValue(p_item_val);
-                if (std::isnan(value)) {
-                    vs_log_mod_error(
-                        "vsl", "Command field \"value\" invalid (NaN)");
-                    handle_error();
-                    return;
-                }
-            }
-            if (0 > p_var->set_value(value)) {
-                handle_error();
-                return;
-            }
-            break;
+            return p_var->set_value(1.0);
         case VSL_TYPE_ARRAY:
             if (nullptr == p_item_val) {
                 vs_log_mod_error("vsl",
                     "Command field \"value\" invalid/not found");
-                handle_error();
-                return;
+                return -1;
             }
             if (path_has_range) {
                 if (path_range.left == path_range.right) {
                     /* Range corresponds to a single index */
-                    value = cJSON_GetNumberValue(p_item_val);
-                    ack = p_var->set_array_value(value, path_range.left);
+                    ack = p_var->set_json_value(p_item_val, path_range.left);
                 } else {
                     /* Range corresponds to multiple indexes */
                     cJSON* iterator;
                     size_t mem_index = path_range.right;
                     cJSON_ArrayForEach(iterator, p_item_val) {
-                        value = cJSON_GetNumberValue(iterator);
-                        if (0 > p_var->set_array_value(value, mem_index)) {
+                        if (0 > p_var->set_json_value(iterator, mem_index)) {
                             ack = -1;
                             break;
                         }
@@ -209,20 +178,96 @@ void VslInteg<T>::VSL_CMD_HANDLER(set_value) {
             if (0 > ack) {
                 vs_log_mod_error("vsl",
                     "Error setting array variable value");
-                handle_error();
-                return;
+                return -1;
             }
-            break;
+            return 0;
+        case VSL_TYPE_MDARRAY:
+            if (nullptr == p_item_val) {
+                vs_log_mod_error("vsl",
+                    "Command field \"value\" invalid/not found");
+                return -1;
+            }
+            if (0 > p_var->set_slice_value(p_item_val, path_ranges.ranges)) {
+                vs_log_mod_error("vsl",
+                    "Error setting array variable value");
+                return -1;
+            }
+            return 0;
         default:
             vs_log_mod_error(
                 "vsl", "Variable type not supported"
             );
-            handle_error();
-            return;
+            return -1;
+    }
+}
+
+/******************************************************************************
+Check that a message item can be set to a registered variable, by setting it
+to a scratch copy of the variable (the variable itself is not modified)
+******************************************************************************/
+template<typename T>
+int VslInteg<T>::check_var_value(std::string str_path, cJSON* p_item_val) {
+    VslVar* p_var = get_registered_variable(has_range(str_path) ?
+        get_ranges(str_path).array_name : str_path);
+    if (nullptr == p_var) {
+        vs_log_mod_error(
+            "vsl", "Variable %s not found registered variable map",
+            str_path.c_str()
+        );
+        return -1;
+    }
+    if (VSL_TYPE_EVENT == p_var->get_type()) return 0;
+
+    uint8_t* p_data = static_cast<uint8_t*>(p_var->get_datap());
+    size_t size = p_var->get_size();
+    if ((nullptr == p_data) || (0 == size)) {
+        vs_log_mod_error("vsl", "Variable type not supported");
+        return -1;
+    }
+    std::vector<uint8_t> scratch(p_data, p_data + size);
+    p_var->rebind(scratch.data());
+    int retval = set_var_value(str_path, p_item_val);
+    p_var->rebind(p_data);
+    return retval;
+}
+
+/******************************************************************************
+Set value sub-command handler
+******************************************************************************/
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(set_value) {
+
+    /* Error handler lambda function */
+    auto handle_error = [&]() {
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command set - Discarding", &vx.uuid);
+        vx._state = VSL_STATE_WAITING;
+    };
+
+    /* Get the object path from the JSON message content */
+    cJSON *p_item_path = cJSON_GetObjectItem(vx.p_cmd, "path");
+    if (nullptr == p_item_path) {
+        vs_log_mod_error("vsl", "Command field \"path\" invalid/not found");
+        handle_error();
         return;
     }
 
-    vs_msg_return(vx.fd_client_socket, "ack",
+    /* Get the path argument as a string */
+    char *cstr_path = cJSON_GetStringValue(p_item_path);
+    if ((nullptr == cstr_path) || std::string(cstr_path).empty()) {
+        vs_log_mod_error("vsl", "Command field \"path\" NULL or empty");
+        handle_error();
+        return;
+    }
+    vs_log_mod_info("vsl", "Command \"set(path=%s)\" received.", cstr_path);
+
+    cJSON *p_item_val = cJSON_GetObjectItem(vx.p_cmd, "value");
+    if (0 > vx.set_var_value(cstr_path, p_item_val)) {
+        handle_error();
+        return;
+    }
+
+    vsl_msg_return(vx.fd_client_socket, "ack",
         "Processed command \"set\"", &vx.uuid);
 
     /* Normal exit */
@@ -239,7 +284,7 @@ void VslInteg<T>::VSL_CMD_HANDLER(set_clk_en) {
     /* Lambda function - error handler */
     auto handle_error = [&](){
         vx._state = VSL_STATE_WAITING;
-        vs_msg_return(vx.fd_client_socket, "error",
+        vsl_msg_return(vx.fd_client_socket, "error",
             "Error processing command set(sel=clk_en) - Discarding", &vx.uuid);
     };
 
@@ -287,14 +332,14 @@ void VslInteg<T>::VSL_CMD_HANDLER(set_clk_en) {
     }
 
     if (value > 0) {
-        vx.clock_map.get_clock(str_path).enable(vx.p_context);
+        vx.clock_map.enable_clock(str_path, vx.p_context);
         vs_log_mod_debug("vsl", "Clock with path \"%s\" enabled", cstr_path);
     } else {
-        vx.clock_map.get_clock(str_path).disable();
+        vx.clock_map.disable_clock(str_path);
         vs_log_mod_debug("vsl", "Clock with path \"%s\" disabled", cstr_path);
     }
 
-    vs_msg_return(vx.fd_client_socket, "ack",
+    vsl_msg_return(vx.fd_client_socket, "ack",
         "Processed command \"set(sel=clk_en)\"", &vx.uuid);
 
     /* Normal exit */
@@ -311,7 +356,7 @@ void VslInteg<T>::VSL_CMD_HANDLER(set_clk_cfg) {
     /* Lambda function - error handler */
     auto handle_error = [&](){
         vx._state = VSL_STATE_WAITING;
-        vs_msg_return(vx.fd_client_socket, "error",
+        vsl_msg_return(vx.fd_client_socket, "error",
             "Error processing command set(sel=clk_cfg) - Discarding", &vx.uuid);
     };
 
@@ -381,10 +426,14 @@ void VslInteg<T>::VSL_CMD_HANDLER(set_clk_cfg) {
         return;
     }
 
-    vx.clock_map.get_clock(str_path).set_period(
-        period, cstr_unit, dc, vx.p_context);
+    if (0 > vx.clock_map.set_clock_period(
+        str_path, period, cstr_unit, dc, vx.p_context)) {
+        vs_log_mod_error("vsl", "Invalid clock period or duty cycle");
+        handle_error();
+        return;
+    }
 
-    vs_msg_return(vx.fd_client_socket, "ack",
+    vsl_msg_return(vx.fd_client_socket, "ack",
         "Processed command \"set(sel=clk_cfg)\"", &vx.uuid);
 
     /* Normal exit */
@@ -392,6 +441,237 @@ void VslInteg<T>::VSL_CMD_HANDLER(set_clk_cfg) {
     return;
 }
 
+/******************************************************************************
+Get the clock, edge and variables arguments of the sampler and recorder
+sub-commands
+******************************************************************************/
+template<typename T>
+int VslInteg<T>::get_edge_args(std::string& str_clock, bool& b_rising,
+    std::vector<std::string>& paths)
+{
+    /* Get the clock path from the JSON message content */
+    cJSON *p_item_path = cJSON_GetObjectItem(p_cmd, "path");
+    if (nullptr == p_item_path) {
+        vs_log_mod_error("vsl", "Command field \"path\" invalid/not found");
+        return -1;
+    }
+    char *cstr_path = cJSON_GetStringValue(p_item_path);
+    if ((nullptr == cstr_path) || std::string(cstr_path).empty()) {
+        vs_log_mod_error("vsl", "Command field \"path\" NULL or empty");
+        return -1;
+    }
+    str_clock = cstr_path;
+
+    /* Get the (optional) edge, rising by default */
+    b_rising = true;
+    cJSON *p_item_edge = cJSON_GetObjectItem(p_cmd, "edge");
+    if (nullptr != p_item_edge) {
+        char *cstr_edge = cJSON_GetStringValue(p_item_edge);
+        if ((nullptr != cstr_edge) && (0 == strcmp(cstr_edge, "falling"))) {
+            b_rising = false;
+        } else if ((nullptr == cstr_edge) || (0 != strcmp(cstr_edge, "rising")))
+        {
+            vs_log_mod_error("vsl", "Command field \"edge\" invalid");
+            return -1;
+        }
+    }
+
+    /* Get the list of variables */
+    cJSON *p_item_vars = cJSON_GetObjectItem(p_cmd, "vars");
+    if (!cJSON_IsArray(p_item_vars)) {
+        vs_log_mod_error("vsl", "Command field \"vars\" invalid/not found");
+        return -1;
+    }
+    paths.clear();
+    cJSON *iterator;
+    cJSON_ArrayForEach(iterator, p_item_vars) {
+        char *str_var = cJSON_GetStringValue(iterator);
+        if ((nullptr == str_var) || std::string(str_var).empty()) {
+            vs_log_mod_error("vsl", "Command field \"vars\" NULL or empty");
+            return -1;
+        }
+        paths.emplace_back(str_var);
+    }
+    return 0;
+}
+
+/******************************************************************************
+Set sampler sub-command handler
+******************************************************************************/
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(set_sampler) {
+
+    /* Lambda function - error handler */
+    auto handle_error = [&](){
+        vx._state = VSL_STATE_WAITING;
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command set(sel=sampler) - Discarding",
+            &vx.uuid);
+    };
+
+    /* Get the capacity field from the JSON message content */
+    cJSON *p_item_capacity = cJSON_GetObjectItem(vx.p_cmd, "capacity");
+    if (nullptr == p_item_capacity) {
+        vs_log_mod_error("vsl", "Command field \"capacity\" invalid/not found");
+        handle_error();
+        return;
+    }
+    double capacity = cJSON_GetNumberValue(p_item_capacity);
+    if (!check_count(capacity)) {
+        vs_log_mod_error("vsl", "Command field \"capacity\" invalid");
+        handle_error();
+        return;
+    }
+
+    /* A capacity of 0 disarms the sampler */
+    if (1.0 > capacity) {
+        vs_log_mod_info("vsl", "Command \"set(sel=sampler)\" received. \
+Disarming sampler.");
+        vx.clear_edge_sampler();
+        vsl_msg_return(vx.fd_client_socket, "ack",
+            "Processed command \"set(sel=sampler)\"", &vx.uuid);
+        vx._state = VSL_STATE_WAITING;
+        return;
+    }
+
+    std::string str_clock;
+    bool b_rising {true};
+    std::vector<std::string> paths;
+    if (0 > vx.get_edge_args(str_clock, b_rising, paths)) {
+        handle_error();
+        return;
+    }
+    vs_log_mod_info("vsl", "Command \"set(sel=sampler, path=%s)\" received.",
+        str_clock.c_str());
+
+    if (0 > vx.register_edge_sampler(str_clock, b_rising, paths,
+        static_cast<size_t>(capacity))) {
+        handle_error();
+        return;
+    }
+
+    /* Return the columns layout, as used by get(sel=samples) */
+    vx.edge_columns_return(vx.edge_columns,
+        "Processed command \"set(sel=sampler)\"");
+
+    /* Normal exit */
+    vx._state = VSL_STATE_WAITING;
+    return;
+}
+
+/******************************************************************************
+Set recorder sub-command handler
+******************************************************************************/
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(set_recorder) {
+
+    /* Lambda function - error handler */
+    auto handle_error = [&](){
+        vx._state = VSL_STATE_WAITING;
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command set(sel=recorder) - Discarding",
+            &vx.uuid);
+    };
+
+    /* Get the depth field from the JSON message content */
+    cJSON *p_item_depth = cJSON_GetObjectItem(vx.p_cmd, "depth");
+    if (nullptr == p_item_depth) {
+        vs_log_mod_error("vsl", "Command field \"depth\" invalid/not found");
+        handle_error();
+        return;
+    }
+    double depth = cJSON_GetNumberValue(p_item_depth);
+    if (!check_count(depth)) {
+        vs_log_mod_error("vsl", "Command field \"depth\" invalid");
+        handle_error();
+        return;
+    }
+
+    /* A depth of 0 disarms the recorder */
+    if (1.0 > depth) {
+        vs_log_mod_info("vsl", "Command \"set(sel=recorder)\" received. \
+Disarming recorder.");
+        vx.clear_recorder();
+        vsl_msg_return(vx.fd_client_socket, "ack",
+            "Processed command \"set(sel=recorder)\"", &vx.uuid);
+        vx._state = VSL_STATE_WAITING;
+        return;
+    }
+
+    std::string str_clock;
+    bool b_rising {true};
+    std::vector<std::string> paths;
+    if (0 > vx.get_edge_args(str_clock, b_rising, paths)) {
+        handle_error();
+        return;
+    }
+    vs_log_mod_info("vsl", "Command \"set(sel=recorder, path=%s)\" received.",
+        str_clock.c_str());
+
+    /* Get the (optional) number of samples after the trigger */
+    double post {0.0};
+    cJSON *p_item_post = cJSON_GetObjectItem(vx.p_cmd, "post");
+    if (nullptr != p_item_post) {
+        post = cJSON_GetNumberValue(p_item_post);
+        if (!check_count(post)) {
+            vs_log_mod_error("vsl", "Command field \"post\" invalid");
+            handle_error();
+            return;
+        }
+    }
+
+    /* Get the (optional) trigger expression */
+    std::string str_expr;
+    cJSON *p_item_expr = cJSON_GetObjectItem(vx.p_cmd, "expr");
+    if (nullptr != p_item_expr) {
+        char *cstr_expr = cJSON_GetStringValue(p_item_expr);
+        if ((nullptr == cstr_expr) || std::string(cstr_expr).empty()) {
+            vs_log_mod_error("vsl", "Command field \"expr\" NULL or empty");
+            handle_error();
+            return;
+        }
+        str_expr = cstr_expr;
+    }
+
+    if (0 > vx.register_recorder(str_clock, b_rising, paths,
+        static_cast<size_t>(depth), static_cast<size_t>(post), str_expr)) {
+        handle_error();
+        return;
+    }
+
+    /* Return the columns layout, as used by get(sel=recorder) */
+    vx.edge_columns_return(vx.rec_columns,
+        "Processed command \"set(sel=recorder)\"");
+
+    /* Normal exit */
+    vx._state = VSL_STATE_WAITING;
+    return;
+}
+
+/******************************************************************************
+Set recorder_trigger sub-command handler
+******************************************************************************/
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(set_recorder_trigger) {
+    vs_log_mod_info("vsl", "Command \"set(sel=recorder_trigger)\" received.");
+
+    if (!vx.b_has_recorder) {
+        vs_log_mod_error("vsl", "No recorder armed");
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command set(sel=recorder_trigger) - Discarding",
+            &vx.uuid);
+        vx._state = VSL_STATE_WAITING;
+        return;
+    }
+
+    /* The trigger sample is the one of the next clock edge */
+    if (!vx.b_rec_triggered) vx.b_rec_trigger_pending = true;
+    vsl_msg_return(vx.fd_client_socket, "ack",
+        "Processed command \"set(sel=recorder_trigger)\"", &vx.uuid);
+    vx._state = VSL_STATE_WAITING;
+    return;
+}
+
 } //namespace vsl
 
 #endif //VSL_INTEG_CMD_SET_HPP
@@ -0,0 +1,364 @@
+/*****************************************************************************
+ @file vsl_integ_cmd_trace.hpp
+ @brief Command handlers implementations for "trace" operations in the
+ vsl::VslInteg class template.
+
+ This header defines the implementation of the "trace" command and its
+ sub-commands for the vsl::VslInteg class template. They control trace
+ windows, i.e. time intervals during which the model signals are dumped to a
+ VCD or FST file, so that only a small part of a long simulation needs to be
+ traced. The model needs to be verilated with the --trace or --trace-fst
+ option, without any $dumpvars statement in the testbench.
+
+ Main handlers:
+ - VSL_CMD_HANDLER(trace): Dispatches "trace" commands to the appropriate
+   sub-command handler based on the "sel" field in the JSON message.
+ - VSL_CMD_HANDLER(trace_start): Opens a trace file and starts dumping.
+ - VSL_CMD_HANDLER(trace_stop): Stops dumping and closes the trace file.
+ - VSL_CMD_HANDLER(trace_flush): Flushes the trace file.
+
+ The trace window functions (e.g. trace_start(), trace_dump()) are defined
+ here as well.
+
+ @author Jérémie Chabloz
+ @copyright Copyright (c) 2026 Jérémie Chabloz Distributed under the MIT
+ License. See file for details.
+*******************************************************************************/
+/*
+Copyright (c) 2026 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VSL_INTEG_CMD_TRACE_HPP
+#define VSL_INTEG_CMD_TRACE_HPP
+
+#include "cJSON.h"
+#include "vs_logging.h"
+#include "vs_msg.h"
+#include "vsl/vsl_integ.hpp"
+#include "verilated.h"
+
+#include <cmath>
+#include <memory>
+#include <string>
+
+namespace vsl{
+
+/******************************************************************************
+Trace command handler
+******************************************************************************/
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(trace) {
+
+    /* Error handler lambda function */
+    auto handle_error = [&]() {
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command trace - Discarding", &vx.uuid);
+        vx._state = VSL_STATE_WAITING;
+    };
+
+    /* Get the sel field from the JSON message content */
+    cJSON *p_item_sel = cJSON_GetObjectItem(vx.p_cmd, "sel");
+    if (nullptr == p_item_sel) {
+        vs_log_mod_error("vsl", "Command field \"sel\" invalid/not found");
+        handle_error();
+        return;
+    }
+    char* cstr_sel = cJSON_GetStringValue(p_item_sel);
+    if ((nullptr == cstr_sel) || std::string(cstr_sel).empty()) {
+        vs_log_mod_error("vsl", "Command field \"sel\" NULL or empty");
+        handle_error();
+        return;
+    }
+
+    /* Look up and execute sub-command handler */
+    std::string sel_key = "trace_";
+    sel_key.append(cstr_sel);
+    auto search = vx.sub_cmd_handlers_map.find(sel_key);
+    if (search != vx.sub_cmd_handlers_map.end()) {
+        vx.sub_cmd_handlers_map[sel_key](vx);
+        return;
+    }
+
+    /* Error case - sub-command handler function not found */
+    vs_log_mod_error("vsl", "Handler for sub-command %s not found",
+        sel_key.c_str());
+    vsl_msg_return(vx.fd_client_socket, "error",
+        "Could not find handler for sub-command. Discarding.", &vx.uuid);
+    vx._state = VSL_STATE_WAITING;
+    return;
+}
+
+/******************************************************************************
+Trace start sub-command handler
+******************************************************************************/
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(trace_start) {
+
+    /* Error handler lambda function */
+    auto handle_error = [&]() {
+        vs_log_mod_warning(
+            "vsl", "Error processing command trace(start) - Discarding");
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command trace(start) - Discarding", &vx.uuid);
+        vx._state = VSL_STATE_WAITING;
+    };
+
+    /* Get the trace file path from the JSON message content */
+    char* str_path;
+    str_path = cJSON_GetStringValue(cJSON_GetObjectItem(vx.p_cmd, "path"));
+    if ((nullptr == str_path) || std::string(str_path).empty()) {
+        vs_log_mod_error("vsl", "Command field \"path\" invalid/not found");
+        handle_error();
+        return;
+    }
+
+    /* Get the (optional) trace format, the default depends on how the model
+    has been verilated */
+    std::string str_format = vx.trace_default_format();
+    cJSON* p_item_format = cJSON_GetObjectItem(vx.p_cmd, "format");
+    if (nullptr != p_item_format) {
+        char* cstr_format = cJSON_GetStringValue(p_item_format);
+        if (nullptr == cstr_format) {
+            vs_log_mod_error("vsl", "Command field \"format\" invalid");
+            handle_error();
+            return;
+        }
+        str_format = std::string(cstr_format);
+    }
+    if (str_format.empty()) {
+        vs_log_mod_error("vsl", "Tracing not available - The model shall be \
+verilated with the --trace or --trace-fst option");
+        handle_error();
+        return;
+    }
+
+    /* Get the (optional) trace depth, 0 for the default */
+    int depth = 0;
+    cJSON* p_item_depth = cJSON_GetObjectItem(vx.p_cmd, "depth");
+    if (nullptr != p_item_depth) {
+        double depth_value = cJSON_GetNumberValue(p_item_depth);
+        if (std::isnan(depth_value) || (depth_value < 1.0)) {
+            vs_log_mod_error("vsl", "Command field \"depth\" invalid or < 1");
+            handle_error();
+            return;
+        }
+        depth = static_cast<int>(depth_value);
+    }
+
+    vs_log_mod_info("vsl", "Command \"trace(sel=start, path=%s)\" received.",
+        str_path);
+    if (0 > vx.trace_start(std::string(str_path), str_format, depth)) {
+        handle_error();
+        return;
+    }
+    vsl_msg_return(vx.fd_client_socket, "ack", "Trace window started",
+        &vx.uuid);
+    vx._state = VSL_STATE_WAITING;
+    return;
+}
+
+/******************************************************************************
+Trace stop sub-command handler
+******************************************************************************/
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(trace_stop) {
+    vs_log_mod_info("vsl", "Command \"trace(sel=stop)\" received.");
+    if (0 > vx.trace_stop()) {
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command trace(stop) - Discarding", &vx.uuid);
+        vx._state = VSL_STATE_WAITING;
+        return;
+    }
+    vsl_msg_return(vx.fd_client_socket, "ack", "Trace window stopped",
+        &vx.uuid);
+    vx._state = VSL_STATE_WAITING;
+    return;
+}
+
+/******************************************************************************
+Trace flush sub-command handler
+******************************************************************************/
+template<typename T>
+void VslInteg<T>::VSL_CMD_HANDLER(trace_flush) {
+    vs_log_mod_info("vsl", "Command \"trace(sel=flush)\" received.");
+    if (0 > vx.trace_flush()) {
+        vsl_msg_return(vx.fd_client_socket, "error",
+            "Error processing command trace(flush) - Discarding", &vx.uuid);
+        vx._state = VSL_STATE_WAITING;
+        return;
+    }
+    vsl_msg_return(vx.fd_client_socket, "ack", "Trace file flushed",
+        &vx.uuid);
+    vx._state = VSL_STATE_WAITING;
+    return;
+}
+
+/******************************************************************************
+Trace windows
+******************************************************************************/
+template<typename T>
+const std::string VslInteg<T>::trace_default_format() const {
+    if (!trace_format.empty()) return trace_format;
+    #if defined(VSL_TRACE_VCD)
+    return "vcd";
+    #elif defined(VSL_TRACE_FST)
+    return "fst";
+    #else
+    return "";
+    #endif
+}
+
+template<typename T>
+int VslInteg<T>::trace_start(const std::string& path,
+    const std::string& format, int depth)
+{
+    if (b_trace_active) {
+        vs_log_mod_error("vsl", "Trace window already active (%s) - \
+Discarding", trace_path.c_str());
+        return -1;
+    }
+    if (path.empty()) {
+        vs_log_mod_error("vsl", "Trace file path empty");
+        return -1;
+    }
+
+    /* The model can only be attached once to a trace object, with a given
+    depth, before it is opened for the first time */
+    if (!trace_format.empty()) {
+        if (format != trace_format) {
+            vs_log_mod_error("vsl", "Trace format cannot be changed once \
+tracing has started (%s)", trace_format.c_str());
+            return -1;
+        }
+        if ((depth > 0) && (depth != trace_depth)) {
+            vs_log_mod_error("vsl", "Trace depth cannot be changed once \
+tracing has started (%d)", trace_depth);
+            return -1;
+        }
+    }
+    if (depth <= 0) depth = (trace_depth > 0) ? trace_depth : 99;
+
+    if (format == "vcd") {
+        #ifdef VSL_TRACE_VCD
+        if (nullptr == p_trace_vcd) {
+            p_context->traceEverOn(true);
+            p_trace_vcd = std::make_unique<VerilatedVcdC>();
+            p_model->trace(p_trace_vcd.get(), depth);
+        }
+        p_trace_vcd->open(path.c_str());
+        if (!p_trace_vcd->isOpen()) {
+            vs_log_mod_error("vsl", "Could not open trace file %s",
+                path.c_str());
+            return -1;
+        }
+        #else
+        vs_log_mod_error("vsl", "VCD tracing not available - The model \
+shall be verilated with the --trace option");
+        return -1;
+        #endif
+    } else if (format == "fst") {
+        #ifdef VSL_TRACE_FST
+        if (nullptr == p_trace_fst) {
+            p_context->traceEverOn(true);
+            p_trace_fst = std::make_unique<VerilatedFstC>();
+            p_model->trace(p_trace_fst.get(), depth);
+        }
+        p_trace_fst->open(path.c_str());
+        if (!p_trace_fst->isOpen()) {
+            vs_log_mod_error("vsl", "Could not open trace file %s",
+                path.c_str());
+            return -1;
+        }
+        #else
+        vs_log_mod_error("vsl", "FST tracing not available - The model \
+shall be verilated with the --trace-fst option");
+        return -1;
+        #endif
+    } else {
+        vs_log_mod_error("vsl", "Unknown trace format %s", format.c_str());
+        return -1;
+    }
+
+    trace_format = format;
+    trace_depth = depth;
+    trace_path = path;
+    b_trace_active = true;
+    b_trace_dumped = false;
+    vs_log_mod_info("vsl", "Trace window started (%s, depth %d, %s)",
+        format.c_str(), depth, path.c_str());
+    return 0;
+}
+
+template<typename T>
+int VslInteg<T>::trace_stop() {
+    if (!b_trace_active) {
+        vs_log_mod_error("vsl", "No active trace window");
+        return -1;
+    }
+
+    /* The current time slot has been evaluated but not dumped yet, as values
+    are dumped when leaving a time slot */
+    trace_dump();
+    #ifdef VSL_TRACE_VCD
+    if (nullptr != p_trace_vcd) p_trace_vcd->close();
+    #endif
+    #ifdef VSL_TRACE_FST
+    if (nullptr != p_trace_fst) p_trace_fst->close();
+    #endif
+    b_trace_active = false;
+    vs_log_mod_info("vsl", "Trace window stopped (%s)", trace_path.c_str());
+    return 0;
+}
+
+template<typename T>
+int VslInteg<T>::trace_flush() {
+    if (!b_trace_active) {
+        vs_log_mod_error("vsl", "No active trace window");
+        return -1;
+    }
+    #ifdef VSL_TRACE_VCD
+    if (nullptr != p_trace_vcd) p_trace_vcd->flush();
+    #endif
+    #ifdef VSL_TRACE_FST
+    if (nullptr != p_trace_fst) p_trace_fst->flush();
+    #endif
+    return 0;
+}
+
+/* Dumps the values of the current time slot, once per time slot */
+template<typename T>
+void VslInteg<T>::trace_dump() {
+    vsl_time_t time = p_context->time();
+    if (b_trace_dumped && (time <= trace_last_time)) return;
+    #ifdef VSL_TRACE_VCD
+    if (nullptr != p_trace_vcd) p_trace_vcd->dump(time);
+    #endif
+    #ifdef VSL_TRACE_FST
+    if (nullptr != p_trace_fst) p_trace_fst->dump(time);
+    #endif
+    trace_last_time = time;
+    b_trace_dumped = true;
+}
+
+} //namespace vsl
+
+#endif //VSL_INTEG_CMD_TRACE_HPP
+//EOF
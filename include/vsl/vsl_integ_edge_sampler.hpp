@@ -0,0 +1,321 @@
+/*****************************************************************************
+ @file vsl_integ_edge_sampler.hpp
+ @brief Clock edge sampler and flight recorder implementation for the
+ vsl::VslInteg class template.
+
+ The clock edge sampler and the flight recorder (set command with
+ sel=sampler or sel=recorder) store the values of registered variables on
+ each edge of a clock, in preallocated column buffers with their native
+ sizes. Their samples are returned as binary frames by the get command with
+ sel=samples or sel=recorder.
+
+ @author Jérémie Chabloz
+ @copyright Copyright (c) 2026 Jérémie Chabloz Distributed under the MIT
+ License. See file for details.
+*******************************************************************************/
+/*
+Copyright (c) 2026 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VSL_INTEG_EDGE_SAMPLER_HPP
+#define VSL_INTEG_EDGE_SAMPLER_HPP
+
+#include "cJSON.h"
+#include "vs_logging.h"
+#include "vs_msg.h"
+#include "vsl/vsl_integ.hpp"
+#include "vsl/vsl_utils.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace vsl{
+
+/******************************************************************************
+Clock edge sampling and flight recorder
+******************************************************************************/
+template<typename T>
+inline void VslInteg<T>::edge_sampler_step() {
+    if (edge_count < edge_capacity) {
+        for (auto& column : edge_columns) {
+            memcpy(&column.data[edge_count * column.size],
+                column.p_var->get_datap(), column.size);
+        }
+        edge_count++;
+    } else {
+        edge_dropped++;
+    }
+}
+
+template<typename T>
+inline void VslInteg<T>::recorder_step() {
+    if (b_rec_frozen) return;
+    for (auto& column : rec_columns) {
+        memcpy(&column.data[rec_pos * column.size],
+            column.p_var->get_datap(), column.size);
+    }
+    if (++rec_pos == rec_depth) rec_pos = 0;
+    if (rec_count < rec_depth) rec_count++;
+    if (b_rec_triggered) {
+        rec_post_count++;
+    } else if (b_rec_trigger_pending ||
+        (rec_trigger.is_armed() && rec_trigger.eval())) {
+        b_rec_triggered = true;
+        b_rec_trigger_pending = false;
+    }
+    if (b_rec_triggered && (rec_post_count >= rec_post)) {
+        b_rec_frozen = true;
+    }
+}
+
+/* Resolves the variables and their value sizes once, and allocates their
+column buffers */
+template<typename T>
+int VslInteg<T>::edge_columns_init(const std::vector<std::string>& paths,
+    const size_t capacity, std::vector<EdgeColumn>& columns)
+{
+    columns.clear();
+    for (auto& path : paths) {
+        VslVar* p_var = get_registered_variable(path);
+        if (nullptr == p_var) {
+            vs_log_mod_error("vsl", "Path %s not found in registered \
+variables - Discarding", path.c_str());
+            return -1;
+        }
+        size_t size {0};
+        if ((VSL_TYPE_SCALAR == p_var->get_type()) ||
+            (VSL_TYPE_PARAM == p_var->get_type())) {
+            switch (p_var->get_vltype()) {
+                case VLVT_UINT8: size = sizeof(CData); break;
+                case VLVT_UINT16: size = sizeof(SData); break;
+                case VLVT_UINT32: size = sizeof(IData); break;
+                case VLVT_UINT64: size = sizeof(QData); break;
+                case VLVT_REAL: size = sizeof(double); break;
+                case VLVT_WDATA:
+                    size = p_var->get_num_words()*sizeof(EData);
+                    break;
+                default: break;
+            }
+        }
+        if (0 == size) {
+            vs_log_mod_error("vsl", "Variable %s cannot be sampled - \
+Discarding", path.c_str());
+            return -1;
+        }
+        columns.push_back(EdgeColumn {path, p_var, size, {}});
+    }
+    size_t sample_size {0};
+    for (auto& column : columns) sample_size += column.size;
+    if ((0 < sample_size) &&
+        (capacity > VSL_SAMPLES_MAX_VALUES*sizeof(double) / sample_size))
+    {
+        vs_log_mod_error("vsl", "Too many samples to be stored (maximum %zu \
+bytes) - Discarding", VSL_SAMPLES_MAX_VALUES*sizeof(double));
+        return -1;
+    }
+    for (auto& column : columns) {
+        column.data.assign(capacity * column.size, 0u);
+    }
+    return 0;
+}
+
+template<typename T>
+int VslInteg<T>::register_edge_sampler(const std::string& clock,
+    const bool rising, const std::vector<std::string>& paths,
+    const size_t capacity)
+{
+    if (!clock_map.has_clock(clock)) {
+        vs_log_mod_error("vsl", "Could not register edge sampler - Clock %s \
+not found - Discarding", clock.c_str());
+        return -1;
+    }
+    if ((0 == capacity) || paths.empty()) {
+        vs_log_mod_error("vsl", "Could not register edge sampler - Invalid \
+arguments - Discarding");
+        return -1;
+    }
+
+    std::vector<EdgeColumn> columns;
+    if (0 > edge_columns_init(paths, capacity, columns)) return -1;
+
+    edge_columns = std::move(columns);
+    edge_clock = clock;
+    p_edge_clock = static_cast<const CData*>(
+        clock_map.get_clock(clock).get_datap());
+    edge_level = rising ? 1 : 0;
+    edge_capacity = capacity;
+    edge_count = 0;
+    edge_dropped = 0ull;
+    b_has_edge_sampler = true;
+    return 0;
+}
+
+template<typename T>
+void VslInteg<T>::clear_edge_sampler() {
+    b_has_edge_sampler = false;
+    p_edge_clock = nullptr;
+    edge_capacity = 0;
+    edge_count = 0;
+    edge_dropped = 0ull;
+    edge_columns.clear();
+}
+
+/* Packs the samples taken since the previous call and resets the buffers.
+The number of samples and the number of dropped edges (as 64-bit integers) are
+followed by the columns, in registration order, each with the values of one
+variable. */
+template<typename T>
+std::vector<uint8_t> VslInteg<T>::edge_samples() {
+    const uint64_t header[2] {edge_count, edge_dropped};
+    size_t len = sizeof(header);
+    for (auto& column : edge_columns) len += edge_count * column.size;
+
+    std::vector<uint8_t> buffer(len);
+    memcpy(buffer.data(), header, sizeof(header));
+    size_t offset = sizeof(header);
+    for (auto& column : edge_columns) {
+        memcpy(buffer.data() + offset, column.data.data(),
+            edge_count * column.size);
+        offset += edge_count * column.size;
+    }
+    edge_count = 0;
+    edge_dropped = 0ull;
+    return buffer;
+}
+
+template<typename T>
+int VslInteg<T>::register_recorder(const std::string& clock,
+    const bool rising, const std::vector<std::string>& paths,
+    const size_t depth, const size_t post, const std::string& expr)
+{
+    if (!clock_map.has_clock(clock)) {
+        vs_log_mod_error("vsl", "Could not register recorder - Clock %s not \
+found - Discarding", clock.c_str());
+        return -1;
+    }
+    if ((0 == depth) || (post >= depth) || paths.empty()) {
+        vs_log_mod_error("vsl", "Could not register recorder - Invalid \
+arguments - Discarding");
+        return -1;
+    }
+
+    std::vector<EdgeColumn> columns;
+    if (0 > edge_columns_init(paths, depth, columns)) return -1;
+    VslTrigger trigger_new {};
+    if (!expr.empty() && (0 > trigger_new.compile(expr, var_map))) {
+        vs_log_mod_error("vsl", "Could not compile trigger expression - \
+Discarding");
+        return -1;
+    }
+
+    rec_columns = std::move(columns);
+    rec_trigger = trigger_new;
+    rec_clock = clock;
+    p_rec_clock = static_cast<const CData*>(
+        clock_map.get_clock(clock).get_datap());
+    rec_level = rising ? 1 : 0;
+    rec_depth = depth;
+    rec_post = post;
+    reset_recorder();
+    b_has_recorder = true;
+    return 0;
+}
+
+template<typename T>
+void VslInteg<T>::clear_recorder() {
+    b_has_recorder = false;
+    p_rec_clock = nullptr;
+    rec_depth = 0;
+    rec_trigger.clear();
+    rec_columns.clear();
+    reset_recorder();
+}
+
+/* Discards the recorded samples and re-arms the trigger */
+template<typename T>
+void VslInteg<T>::reset_recorder() {
+    rec_pos = 0;
+    rec_count = 0;
+    rec_post_count = 0;
+    b_rec_trigger_pending = false;
+    b_rec_triggered = false;
+    b_rec_frozen = false;
+}
+
+/* Returns an acknowledgement with the columns layout, as used to decode the
+binary samples */
+template<typename T>
+int VslInteg<T>::edge_columns_return(const std::vector<EdgeColumn>& columns,
+    const char* str_value)
+{
+    cJSON* p_fields = cJSON_CreateObject();
+    cJSON* p_columns = cJSON_AddArrayToObject(p_fields, "columns");
+    for (auto& column : columns) {
+        cJSON* p_column = cJSON_CreateObject();
+        if ((nullptr == p_columns) || (nullptr == p_column)) {
+            cJSON_Delete(p_column);
+            cJSON_Delete(p_fields);
+            p_fields = nullptr;
+            break;
+        }
+        cJSON_AddItemToArray(p_columns, p_column);
+        cJSON_AddStringToObject(p_column, "path", column.path.c_str());
+        cJSON_AddStringToObject(p_column, "dtype",
+            (VLVT_REAL == column.p_var->get_vltype()) ? "real" : "uint");
+        cJSON_AddNumberToObject(p_column, "size", column.size);
+    }
+    return vsl_msg_return_ack(fd_client_socket, str_value, p_fields, &uuid);
+}
+
+/* Packs the recorded window, from the oldest sample. The number of samples,
+the index of the trigger sample (-1 if not triggered) and the frozen flag (as
+64-bit integers) are followed by the columns, in registration order. */
+template<typename T>
+std::vector<uint8_t> VslInteg<T>::recorder_window() {
+    const int64_t trigger_index = b_rec_triggered ?
+        static_cast<int64_t>(rec_count - 1 - rec_post_count) : -1;
+    const uint64_t header[3] {rec_count,
+        static_cast<uint64_t>(trigger_index), b_rec_frozen ? 1ull : 0ull};
+    size_t len = sizeof(header);
+    for (auto& column : rec_columns) len += rec_count * column.size;
+
+    /* The oldest sample is at the next write position once the ring buffers
+    have wrapped around */
+    const size_t first = (rec_count < rec_depth) ? 0 : rec_pos;
+    std::vector<uint8_t> buffer(len);
+    memcpy(buffer.data(), header, sizeof(header));
+    size_t offset = sizeof(header);
+    for (auto& column : rec_columns) {
+        size_t num_first = (rec_count - first) * column.size;
+        memcpy(buffer.data() + offset, column.data.data() + first*column.size,
+            num_first);
+        memcpy(buffer.data() + offset + num_first, column.data.data(),
+            first * column.size);
+        offset += rec_count * column.size;
+    }
+    return buffer;
+}
+
+} //namespace vsl
+
+#endif //VSL_INTEG_EDGE_SAMPLER_HPP
+//EOF
@@ -0,0 +1,183 @@
+/***************************************************************************//**
+ @file vsl_plugin.hpp
+ @brief Plugin interface for transaction-level drivers and monitors in the
+ Verilator integration
+
+ A plugin, e.g. a bus-functional model (BFM), is a C++ object registered with
+ a `vsl::VslInteg` instance. It is called on the edges of a registered clock
+ (or of a registered 1-bit variable) once the model has been evaluated, with
+ direct access to the registered variables, and it exposes its own commands,
+ named "<plugin name>.<command>" (e.g. "spi.write"). A command either returns
+ right away or starts a transaction, in which case the simulation runs until
+ the plugin reports that the transaction is done, without any socket traffic
+ in between.
+
+ @author Jérémie Chabloz
+ @copyright Copyright (c) 2026 Jérémie Chabloz Distributed under the MIT
+ License. See file for details.
+*******************************************************************************/
+/*
+Copyright (c) 2026 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VSL_PLUGIN_HPP
+#define VSL_PLUGIN_HPP
+
+#include "cJSON.h"
+#include "vs_logging.h"
+#include "vsl/vsl_types.hpp"
+
+#include <string>
+
+namespace vsl {
+
+/**
+ * @brief Return values of VslPlugin::command()
+ */
+enum VslPluginStatus {
+    VSL_PLUGIN_ERROR = -1,  ///<Command or arguments invalid
+    VSL_PLUGIN_DONE = 0,    ///<Command processed, result available
+    VSL_PLUGIN_BUSY = 1     ///<Transaction started, run until it is done
+};
+
+/**
+ * @brief Clock edges on which a plugin is called
+ */
+enum VslPluginEdge {
+    VSL_PLUGIN_RISING,      ///<Rising edges only
+    VSL_PLUGIN_FALLING,     ///<Falling edges only
+    VSL_PLUGIN_BOTH         ///<Both edges
+};
+
+/**
+ * @class VslPlugin
+ * @brief Base class for the plugins of the Verilator integration
+ *
+ * Derived classes implement bind(), command() and on_edge(); the other
+ * functions have default implementations for plugins without transactions
+ * nor results.
+ */
+class VslPlugin {
+public:
+
+    /**
+     * @brief Construct a new VslPlugin object
+     *
+     * @param name Plugin name, used as prefix of its commands (shall not
+     * contain any dot)
+     * @param clock Path of the registered clock, or of the registered 1-bit
+     * variable, on which edges the plugin is called
+     * @param edge Edges on which the plugin is called
+     */
+    VslPlugin(const std::string& name, const std::string& clock,
+        const VslPluginEdge edge = VSL_PLUGIN_RISING) :
+        name {name}, clock {clock}, edge {edge} {};
+    virtual ~VslPlugin() = default;
+
+    const std::string& get_name() const {return name;}
+    const std::string& get_clock() const {return clock;}
+    VslPluginEdge get_edge() const {return edge;}
+
+    /**
+     * @brief Resolves the registered variables used by the plugin
+     *
+     * Called once, when the plugin is registered. The variables are not
+     * moved by a restart of the model, so that the resolved pointers remain
+     * valid.
+     *
+     * @param var_map Map of the registered variables
+     * @return 0 if successful, -1 otherwise
+     */
+    virtual int bind(VslVarMap& var_map) = 0;
+
+    /**
+     * @brief Processes a plugin command
+     *
+     * @param cmd Command name, without the plugin name prefix
+     * @param p_cmd Full JSON command
+     * @return VSL_PLUGIN_DONE if the command has been processed,
+     * VSL_PLUGIN_BUSY if a transaction has been started (the simulation then
+     * runs until busy() returns false) or VSL_PLUGIN_ERROR
+     */
+    virtual int command(const std::string& cmd, const cJSON* p_cmd) = 0;
+
+    /**
+     * @brief Edge callback
+     *
+     * Called on each selected edge of the plugin clock, once the model has
+     * been evaluated. The values written to the registered variables are
+     * seen by the design with the next evaluation.
+     *
+     * @param rising True for a rising edge, false for a falling edge
+     */
+    virtual void on_edge(const bool rising) = 0;
+
+    /**
+     * @brief Checks if a transaction is ongoing
+     */
+    virtual bool busy() const {return false;}
+
+    /**
+     * @brief Adds the result of the latest command to its return message
+     *
+     * @param p_msg Return message JSON object
+     * @return 0 if successful, -1 otherwise
+     */
+    virtual int result(cJSON* /*p_msg*/) {return 0;}
+
+    /**
+     * @brief Aborts the ongoing transaction, if any
+     *
+     * Called if the simulation stops before the transaction is done.
+     */
+    virtual void abort() {}
+
+    /**
+     * @brief Resets the plugin state
+     *
+     * Called after the model has been restarted.
+     */
+    virtual void reset() {abort();}
+
+protected:
+
+    /* Resolves a registered 1-bit scalar variable */
+    static VslVar* bind_bit(VslVarMap& var_map, const std::string& path) {
+        VslVar* p_var = var_map.get_var(path);
+        if ((nullptr == p_var) || (VSL_TYPE_SCALAR != p_var->get_type()) ||
+            (VLVT_UINT8 != p_var->get_vltype())) {
+            vs_log_mod_error("vsl", "Variable %s not found or not a 1-bit \
+scalar", path.c_str());
+            return nullptr;
+        }
+        return p_var;
+    }
+
+private:
+    std::string name;
+    std::string clock;
+    VslPluginEdge edge;
+};
+
+} //namespace vsl
+
+#endif //VSL_PLUGIN_HPP
+//EOF
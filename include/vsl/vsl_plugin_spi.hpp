@@ -0,0 +1,373 @@
+/***************************************************************************//**
+ @file vsl_plugin_spi.hpp
+ @brief Reference SPI bus-functional models for the Verilator integration
+
+ This header defines two plugins (see vsl_plugin.hpp) driving and monitoring
+ the pins of a 4-wire SPI bus (mode 0, most-significant bit first):
+ - `vsl::VslSpiMaster` drives chip select, clock and MOSI from the edges of a
+   registered clock, one SPI clock phase per edge, and returns the bytes read
+   on MISO. Command: "<name>.write" with the bytes to transmit.
+ - `vsl::VslSpiSlave` is called on the edges of the SPI clock itself. It
+   samples MOSI on the rising edges and drives MISO on the falling edges.
+   Commands: "<name>.load" with the bytes to transmit and "<name>.read",
+   optionally waiting until a given number of bytes has been received.
+
+ The pins shall be registered as 1-bit scalar variables. In order for the
+ values driven by a model to be seen by the design, they have to be writable
+ from outside of the model (e.g. with the public_flat_rw Verilator
+ configuration).
+
+ @author Jérémie Chabloz
+ @copyright Copyright (c) 2026 Jérémie Chabloz Distributed under the MIT
+ License. See file for details.
+*******************************************************************************/
+/*
+Copyright (c) 2026 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VSL_PLUGIN_SPI_HPP
+#define VSL_PLUGIN_SPI_HPP
+
+#include "cJSON.h"
+#include "vs_logging.h"
+#include "vsl/vsl_plugin.hpp"
+#include "vsl/vsl_types.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace vsl {
+
+/**
+ * @brief Paths of the registered SPI pins variables
+ */
+struct VslSpiPins {
+    std::string cs_b;   ///<Chip select, active low
+    std::string sclk;   ///<Clock
+    std::string mosi;   ///<Master out, slave in
+    std::string miso;   ///<Master in, slave out
+};
+
+/* Gets a list of bytes from a JSON command field */
+inline int vsl_spi_get_bytes(const cJSON* p_cmd, const char* key,
+    std::vector<uint8_t>& bytes)
+{
+    const cJSON* p_item = cJSON_GetObjectItem(p_cmd, key);
+    if (!cJSON_IsArray(p_item)) {
+        vs_log_mod_error("vsl", "Command field \"%s\" invalid/not found", key);
+        return -1;
+    }
+    bytes.clear();
+    const cJSON* iterator;
+    cJSON_ArrayForEach(iterator, p_item) {
+        double value = cJSON_GetNumberValue(iterator);
+        if (std::isnan(value) || (value < 0.0) || (value > 255.0) ||
+            (value != std::floor(value))) {
+            vs_log_mod_error("vsl", "Command field \"%s\" shall only contain \
+bytes", key);
+            return -1;
+        }
+        bytes.push_back(static_cast<uint8_t>(value));
+    }
+    return 0;
+}
+
+/* Adds a list of bytes to a return message */
+inline int vsl_spi_add_bytes(cJSON* p_msg, const char* key,
+    const std::vector<uint8_t>& bytes)
+{
+    cJSON* p_array = cJSON_AddArrayToObject(p_msg, key);
+    if (nullptr == p_array) return -1;
+    for (auto byte : bytes) {
+        cJSON* p_item = cJSON_CreateNumber(byte);
+        if (nullptr == p_item) return -1;
+        cJSON_AddItemToArray(p_array, p_item);
+    }
+    return 0;
+}
+
+/**
+ * @class VslSpiMaster
+ * @brief SPI master bus-functional model
+ *
+ * Each selected edge of the plugin clock is one phase of the SPI clock, i.e.
+ * the SPI clock period is twice the clock period for rising edges only. A
+ * transfer of N bytes thus lasts 16*N+3 edges, including the chip select
+ * setup and hold edges.
+ */
+class VslSpiMaster : public VslPlugin {
+public:
+
+    /**
+     * @brief Construct a new VslSpiMaster object
+     *
+     * @param name Plugin name (e.g. "spi")
+     * @param clock Path of the registered clock
+     * @param pins Paths of the SPI pins variables
+     * @param edge Clock edges to be used
+     */
+    VslSpiMaster(const std::string& name, const std::string& clock,
+        const VslSpiPins& pins, const VslPluginEdge edge = VSL_PLUGIN_RISING) :
+        VslPlugin(name, clock, edge), pins {pins} {};
+
+    int bind(VslVarMap& var_map) override {
+        p_cs_b = bind_bit(var_map, pins.cs_b);
+        p_sclk = bind_bit(var_map, pins.sclk);
+        p_mosi = bind_bit(var_map, pins.mosi);
+        p_miso = bind_bit(var_map, pins.miso);
+        if ((nullptr == p_cs_b) || (nullptr == p_sclk) ||
+            (nullptr == p_mosi) || (nullptr == p_miso)) {
+            return -1;
+        }
+        return 0;
+    }
+
+    int command(const std::string& cmd, const cJSON* p_cmd) override {
+        if ("write" != cmd) {
+            vs_log_mod_error("vsl", "SPI master command %s not supported",
+                cmd.c_str());
+            return VSL_PLUGIN_ERROR;
+        }
+        if ((0 > vsl_spi_get_bytes(p_cmd, "data", tx)) || tx.empty()) {
+            return VSL_PLUGIN_ERROR;
+        }
+        rx.assign(tx.size(), 0u);
+        num_bits = 8*tx.size();
+        bit = 0;
+        state = STATE_SELECT;
+        return VSL_PLUGIN_BUSY;
+    }
+
+    void on_edge(const bool) override {
+        switch (state) {
+            case STATE_IDLE:
+                return;
+            case STATE_SELECT:
+                p_sclk->set_value(0.0);
+                p_cs_b->set_value(0.0);
+                p_mosi->set_value(tx_bit());
+                state = STATE_HIGH;
+                return;
+            case STATE_HIGH:
+                /* MISO is sampled as the clock rises */
+                if (0.0 != p_miso->get_value()) {
+                    rx[bit >> 3] |= static_cast<uint8_t>(0x80u >> (bit & 7));
+                }
+                p_sclk->set_value(1.0);
+                state = STATE_LOW;
+                return;
+            case STATE_LOW:
+                p_sclk->set_value(0.0);
+                if (++bit < num_bits) {
+                    p_mosi->set_value(tx_bit());
+                    state = STATE_HIGH;
+                } else {
+                    state = STATE_DESELECT;
+                }
+                return;
+            case STATE_DESELECT:
+                p_cs_b->set_value(1.0);
+                state = STATE_HOLD;
+                return;
+            case STATE_HOLD:
+                /* The transfer is only done once chip select has been seen
+                high by the design */
+                state = STATE_IDLE;
+                return;
+        }
+    }
+
+    bool busy() const override {return STATE_IDLE != state;}
+
+    int result(cJSON* p_msg) override {
+        return vsl_spi_add_bytes(p_msg, "data", rx);
+    }
+
+    void abort() override {
+        if (STATE_IDLE == state) return;
+        p_sclk->set_value(0.0);
+        p_cs_b->set_value(1.0);
+        state = STATE_IDLE;
+    }
+
+private:
+    enum State {
+        STATE_IDLE,
+        STATE_SELECT,
+        STATE_HIGH,
+        STATE_LOW,
+        STATE_DESELECT,
+        STATE_HOLD
+    };
+
+    VslSpiPins pins;
+    VslVar* p_cs_b {nullptr};
+    VslVar* p_sclk {nullptr};
+    VslVar* p_mosi {nullptr};
+    VslVar* p_miso {nullptr};
+    State state {STATE_IDLE};
+    std::vector<uint8_t> tx {};
+    std::vector<uint8_t> rx {};
+    size_t num_bits {0};
+    size_t bit {0};                //Current bit, from the first byte MSB
+
+    inline double tx_bit() const {
+        return ((tx[bit >> 3] << (bit & 7)) & 0x80u) ? 1.0 : 0.0;
+    }
+};
+
+/**
+ * @class VslSpiSlave
+ * @brief SPI slave bus-functional model
+ *
+ * The received bytes are queued until they are read. The transmitted bytes
+ * are taken from the loaded ones, 0 being transmitted once they have all been
+ * sent. Transfers are expected to be made of whole bytes.
+ */
+class VslSpiSlave : public VslPlugin {
+public:
+
+    /**
+     * @brief Construct a new VslSpiSlave object
+     *
+     * @param name Plugin name (e.g. "spi_slave")
+     * @param pins Paths of the SPI pins variables
+     */
+    VslSpiSlave(const std::string& name, const VslSpiPins& pins) :
+        VslPlugin(name, pins.sclk, VSL_PLUGIN_BOTH), pins {pins} {};
+
+    int bind(VslVarMap& var_map) override {
+        p_cs_b = bind_bit(var_map, pins.cs_b);
+        p_mosi = bind_bit(var_map, pins.mosi);
+        p_miso = bind_bit(var_map, pins.miso);
+        if ((nullptr == p_cs_b) || (nullptr == p_mosi) ||
+            (nullptr == p_miso)) {
+            return -1;
+        }
+        return 0;
+    }
+
+    int command(const std::string& cmd, const cJSON* p_cmd) override {
+        if ("load" == cmd) {
+            std::vector<uint8_t> bytes;
+            if (0 > vsl_spi_get_bytes(p_cmd, "data", bytes)) {
+                return VSL_PLUGIN_ERROR;
+            }
+            bool b_drive = tx.empty();
+            tx.insert(tx.end(), bytes.begin(), bytes.end());
+            if (b_drive) p_miso->set_value(miso_bit());
+            b_read = false;
+            return VSL_PLUGIN_DONE;
+        }
+        if ("read" == cmd) {
+            const cJSON* p_item = cJSON_GetObjectItem(p_cmd, "count");
+            read_count = 0;
+            if (nullptr != p_item) {
+                double value = cJSON_GetNumberValue(p_item);
+                if (std::isnan(value) || (value < 0.0)) {
+                    vs_log_mod_error("vsl",
+                        "Command field \"count\" invalid");
+                    return VSL_PLUGIN_ERROR;
+                }
+                read_count = static_cast<size_t>(value);
+            }
+            b_read = true;
+            if (busy()) return VSL_PLUGIN_BUSY;
+            return VSL_PLUGIN_DONE;
+        }
+        vs_log_mod_error("vsl", "SPI slave command %s not supported",
+            cmd.c_str());
+        return VSL_PLUGIN_ERROR;
+    }
+
+    void on_edge(const bool rising) override {
+        if (0.0 != p_cs_b->get_value()) return;
+        if (rising) {
+            rx_byte = static_cast<uint8_t>(
+                (rx_byte << 1) | ((0.0 != p_mosi->get_value()) ? 1u : 0u));
+            if (8 == ++rx_bit) {
+                rx.push_back(rx_byte);
+                rx_bit = 0;
+            }
+            return;
+        }
+        if (8 == ++tx_bit) {
+            tx_bit = 0;
+            if (!tx.empty()) tx.pop_front();
+        }
+        p_miso->set_value(miso_bit());
+    }
+
+    bool busy() const override {
+        return (0 < read_count) && (rx.size() < read_count);
+    }
+
+    /* The read bytes are removed from the received ones */
+    int result(cJSON* p_msg) override {
+        if (!b_read) return 0;
+        b_read = false;
+        if (0 == read_count) read_count = rx.size();
+        std::vector<uint8_t> bytes(rx.begin(), rx.begin() + read_count);
+        rx.erase(rx.begin(), rx.begin() + read_count);
+        read_count = 0;
+        return vsl_spi_add_bytes(p_msg, "data", bytes);
+    }
+
+    void abort() override {
+        read_count = 0;
+        b_read = false;
+    }
+
+    void reset() override {
+        abort();
+        rx.clear();
+        tx.clear();
+        rx_byte = 0;
+        rx_bit = 0;
+        tx_bit = 0;
+    }
+
+private:
+    VslSpiPins pins;
+    VslVar* p_cs_b {nullptr};
+    VslVar* p_mosi {nullptr};
+    VslVar* p_miso {nullptr};
+    std::deque<uint8_t> rx {};     //Received bytes, not read yet
+    std::deque<uint8_t> tx {};     //Bytes to transmit
+    uint8_t rx_byte {0};
+    unsigned rx_bit {0};
+    unsigned tx_bit {0};           //Current bit of the first byte to transmit
+    size_t read_count {0};         //Number of bytes to read, 0 for all
+    bool b_read {false};           //Latest command is a read
+
+    inline double miso_bit() const {
+        if (tx.empty()) return 0.0;
+        return ((tx.front() << tx_bit) & 0x80u) ? 1.0 : 0.0;
+    }
+};
+
+} //namespace vsl
+
+#endif //VSL_PLUGIN_SPI_HPP
+//EOF
@@ -0,0 +1,319 @@
+/***************************************************************************//**
+ @file vsl_server.hpp
+ @brief Multi-client Verisocks server for Verilator-based simulations.
+
+ This header defines the `vsl::VslServer` template class, which listens once
+ on a server socket and serves many independent clients from a single
+ process. For each incoming connection, a fresh Verilator context, model
+ instance and `vsl::VslInteg` session are created; the session is run by one
+ of a fixed-size pool of worker threads and the model is destroyed as soon as
+ the client disconnects (or once the simulation has finished). Many short
+ tests can thus be run without launching a simulation process for each of
+ them. The setup time of each session (model construction and variables
+ registration) is logged, so that it can be compared with a process launch.
+
+ Usage:
+ - Define a setup function, which registers the variables and clocks of a
+   session's model with its `VslInteg` object.
+ - Instantiate `VslServer<T>` with your Verilated model type, the setup
+   function and the number of worker threads.
+ - Call `run()` to accept and serve clients.
+
+ @author Jérémie Chabloz
+ @copyright Copyright (c) 2026 Jérémie Chabloz Distributed under the MIT
+ License. See file for details.
+*******************************************************************************/
+/*
+Copyright (c) 2026 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VSL_SERVER_HPP
+#define VSL_SERVER_HPP
+
+#include "vs_server.h"
+#include "vs_logging.h"
+#include "verilated.h"
+#include "vsl/vsl_integ.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <sys/select.h>
+#include <sys/socket.h>
+
+
+namespace vsl{
+
+/**
+ * @class VslServer
+ * @brief Top-level class to use for serving many clients with Verisocks from
+ * a single Verilator simulation process
+ *
+ * This class is a template which takes as parameter the verilated model class.
+ *
+ * @tparam T Model class
+ */
+template<typename T>
+class VslServer {
+
+public:
+
+    /**
+     * @brief Session setup function type
+     *
+     * The function is called for each new session, with the session's
+     * `VslInteg` object and model, in order to register its variables and
+     * clocks. It is called from the worker thread running the session.
+     */
+    typedef std::function<void(VslInteg<T>&, T*)> setup_t;
+
+    /**
+     * @brief Construct a new VslServer object
+     *
+     * @param setup Session setup function
+     * @param port The port number to be used. Default is 5100.
+     * @param timeout The timeout duration in seconds. The server exits once
+     * no client has connected during this time while no session was active.
+     * Default is 120.
+     * @param num_workers Number of worker threads, i.e. maximum number of
+     * sessions running concurrently. Default is 0, for the number of
+     * available CPUs.
+     */
+    VslServer(setup_t setup, const int port=5100, const int timeout=120,
+        const size_t num_workers=0);
+    ~VslServer();
+
+    /**
+     * @brief Enable or disable the background socket I/O thread of each
+     * session
+     *
+     * See VslInteg::set_io_thread(). No CPU affinity is used.
+     *
+     * @param enable Use an I/O thread for each session if true
+     */
+    void set_io_thread(const bool enable) {b_io_thread = enable;}
+
+    /**
+     * @brief Accept and serve clients
+     *
+     * Each accepted connection is queued until a worker thread is available
+     * to run its session.
+     *
+     * @return 0 once the server has timed out, 1 in case of error
+     */
+    int run();
+
+private:
+    setup_t setup_fn;
+    int num_port {5100};           //Port number
+    int num_timeout_sec {120};     //Timeout, in seconds
+    size_t num_workers {1};        //Number of worker threads
+    bool b_io_thread {false};      //Use an I/O thread for each session
+    int fd_server_socket {-1};     //File descriptor, server socket
+
+    /* Worker threads and queue of accepted connections */
+    std::vector<std::thread> workers {};
+    std::mutex queue_mutex {};
+    std::condition_variable queue_cv {};
+    std::deque<int> queue {};
+    size_t num_active {0};         //Number of sessions running
+    unsigned num_sessions {0};     //Number of accepted connections
+    bool b_stop {false};
+
+    void worker();
+    void session(const int fd_client, const unsigned id);
+    bool is_idle() {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        return queue.empty() && (0 == num_active);
+    }
+};
+
+/******************************************************************************
+Constructor
+******************************************************************************/
+template<typename T>
+VslServer<T>::VslServer(setup_t setup, const int port, const int timeout,
+    const size_t num_workers) {
+    vs_log_mod_debug("vsl", "Constructor called (%s)", __FILE__);
+
+    /* Check that the type parameter corresponds to a verilated model */
+    static_assert(std::is_base_of<VerilatedModel,T>::value,
+        "Error, expecting a derived class of VerilatedModel");
+
+    setup_fn = setup;
+    num_port = port;
+    num_timeout_sec = timeout;
+    this->num_workers = (0 == num_workers) ?
+        std::max<size_t>(std::thread::hardware_concurrency(), 1u) :
+        num_workers;
+    return;
+}
+
+/******************************************************************************
+Destructor
+******************************************************************************/
+template<typename T>
+VslServer<T>::~VslServer() {
+    vs_log_mod_debug("vsl", "Destructor called (%s)", __FILE__);
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        b_stop = true;
+    }
+    queue_cv.notify_all();
+    for (auto& thread : workers) thread.join();
+    for (int fd : queue) vs_server_close_socket(fd);
+    if (0 <= fd_server_socket) vs_server_close_socket(fd_server_socket);
+    return;
+}
+
+/******************************************************************************
+Accept loop
+******************************************************************************/
+template<typename T>
+int VslServer<T>::run() {
+    fd_server_socket = vs_server_make_socket(num_port);
+    if (0 > fd_server_socket) {
+        vs_log_mod_error("vsl", "Issue making socket at port %d", num_port);
+        return 1;
+    }
+    /* Allow more pending connections than for a single client, so that
+    clients connecting simultaneously are not delayed */
+    if (0 > listen(fd_server_socket, SOMAXCONN)) {
+        vs_log_mod_perror("vsl", "Error listening to socket");
+    }
+    vs_log_mod_info("vsl", "Multi-client server - Port: %d, %zu workers",
+        vs_server_get_address(fd_server_socket).port, num_workers);
+    for (size_t i = 0; i < num_workers; i++) {
+        workers.emplace_back(&VslServer<T>::worker, this);
+    }
+
+    int retval = 0;
+    while (true) {
+        /* vs_server_accept() closes the server socket when it times out, so
+        that waiting for a connection is done here */
+        fd_set set;
+        FD_ZERO(&set);
+        FD_SET(fd_server_socket, &set);
+        struct timeval timeout {num_timeout_sec, 0};
+        int selval = select(fd_server_socket + 1, &set, nullptr, nullptr,
+            &timeout);
+        if ((0 > selval) && (EINTR == errno)) continue;
+        if (0 > selval) {
+            vs_log_mod_perror("vsl", "Error waiting for a connection");
+            retval = 1;
+            break;
+        }
+        if (0 == selval) {
+            if (!is_idle()) continue;
+            vs_log_mod_info("vsl", "No connection for %ds - Exiting server",
+                num_timeout_sec);
+            break;
+        }
+
+        char hostname_buffer[128];
+        struct timeval no_wait {0, 0};
+        int fd_client = vs_server_accept(fd_server_socket, hostname_buffer,
+            sizeof(hostname_buffer), &no_wait);
+        if (0 > fd_client) {
+            /* The server socket has been closed */
+            fd_server_socket = -1;
+            retval = 1;
+            break;
+        }
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            queue.push_back(fd_client);
+            vs_log_mod_debug("vsl", "Connection queued (%zu pending)",
+                queue.size());
+        }
+        queue_cv.notify_one();
+    }
+
+    /* Let the running and queued sessions terminate */
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        b_stop = true;
+    }
+    queue_cv.notify_all();
+    for (auto& thread : workers) thread.join();
+    workers.clear();
+    if (0 <= fd_server_socket) {
+        vs_server_close_socket(fd_server_socket);
+        fd_server_socket = -1;
+    }
+    vs_log_mod_info("vsl", "Served %u sessions", num_sessions);
+    return retval;
+}
+
+/******************************************************************************
+Worker threads and sessions
+******************************************************************************/
+template<typename T>
+void VslServer<T>::worker() {
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    while (true) {
+        queue_cv.wait(lock, [this]() {return b_stop || !queue.empty();});
+        if (queue.empty()) return;
+        int fd_client = queue.front();
+        queue.pop_front();
+        unsigned id = ++num_sessions;
+        num_active++;
+        lock.unlock();
+        session(fd_client, id);
+        lock.lock();
+        num_active--;
+    }
+}
+
+template<typename T>
+void VslServer<T>::session(const int fd_client, const unsigned id) {
+    auto t_start = std::chrono::steady_clock::now();
+    std::unique_ptr<VerilatedContext> p_context {new VerilatedContext};
+    std::unique_ptr<T> p_model {new T{p_context.get()}};
+    {
+        VslInteg<T> vx {p_model.get(), num_port, num_timeout_sec};
+        vx.set_io_thread(b_io_thread);
+        setup_fn(vx, p_model.get());
+        std::chrono::duration<double> t_setup =
+            std::chrono::steady_clock::now() - t_start;
+        vs_log_mod_info("vsl", "Session %u: set up in %.3f ms", id,
+            1.0e3*t_setup.count());
+
+        vx.run_session(fd_client);
+    }
+    std::chrono::duration<double> t_session =
+        std::chrono::steady_clock::now() - t_start;
+    vs_log_mod_info("vsl", "Session %u: closed after %.3f s", id,
+        t_session.count());
+}
+
+} //namespace vsl
+
+#endif //VSL_SERVER_HPP
+//EOF
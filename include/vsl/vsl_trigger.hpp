@@ -0,0 +1,140 @@
+/***************************************************************************//**
+ @file vsl_trigger.hpp
+ @brief Trigger expressions for the Verisocks Verilator integration
+
+ @author Jérémie Chabloz
+ @copyright Copyright (c) 2026 Jérémie Chabloz Distributed under the MIT
+ License. See file for details.
+*******************************************************************************/
+/*
+Copyright (c) 2026 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef VSL_TRIGGER_HPP
+#define VSL_TRIGGER_HPP
+
+#include "vsl/vsl_types.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vsl {
+
+/**
+ * @class VslTrigger
+ * @brief Trigger condition expression, compiled once and evaluated natively
+ *
+ * A trigger expression combines registered variables and numerical constants,
+ * e.g. "(top.state == 3 && top.valid) || top.timeout_cnt > 100". The
+ * following operators are supported, by increasing precedence:
+ *
+ * - || and && : boolean or/and (all operands are always evaluated)
+ * - ==, !=, <, <=, > and >= : comparisons
+ * - & : bitwise and (mask), on integer values
+ * - ! : boolean not
+ * - rise(...), fall(...) and change(...): true if the value of the enclosed
+ *   expression went from zero to non-zero, from non-zero to zero or changed
+ *   since the previous evaluation
+ *
+ * Variables are referred to by their registered path, with one index per
+ * dimension for array elements, e.g. "top.mem[3]". Wide variables (more than
+ * 64 bits) and events cannot be used as operands. Constants are decimal or
+ * hexadecimal ("0x" prefix) numbers, with an optional leading "-" sign.
+ *
+ * The expression is compiled into a postfix program over pointers to the
+ * registered variables, so that no lookup nor parsing is needed when it is
+ * evaluated, i.e. after each model evaluation.
+ */
+class VslTrigger {
+
+public:
+
+    VslTrigger() = default;
+    virtual ~VslTrigger() = default;
+
+    /**
+     * @brief Compiles a trigger expression and arms the trigger
+     *
+     * The edge detectors (rise, fall, change) are initialized with the current
+     * values of the variables.
+     *
+     * @param expr Trigger expression
+     * @param var_map Registered variables map
+     * @return 0 No errors
+     * @return -1 Syntax error or unknown variable (the trigger is not armed)
+     */
+    int compile(const std::string& expr, VslVarMap& var_map);
+
+    /**
+     * @brief Evaluates the trigger expression
+     *
+     * @return true The trigger condition is met
+     * @return false The trigger condition is not met or the trigger is not
+     * armed
+     */
+    bool eval();
+
+    /**
+     * @brief Checks if the trigger is armed
+     *
+     * @return true A trigger expression has been compiled
+     */
+    inline bool is_armed() const {return !program.empty();}
+
+    /**
+     * @brief Disarms the trigger
+     */
+    void clear();
+
+    /**
+     * @brief Returns the (compiled) trigger expression
+     *
+     * @return Trigger expression
+     */
+    inline const std::string& get_expr() const {return expr;}
+
+private:
+
+    /* Program instruction codes */
+    enum OpCode : uint8_t {
+        OP_CONST, OP_LOAD, OP_LOAD_AT, OP_RISE, OP_FALL, OP_CHANGE,
+        OP_MASK, OP_EQ, OP_NE, OP_LT, OP_LE, OP_GT, OP_GE, OP_NOT, OP_AND,
+        OP_OR
+    };
+
+    /* Program instruction */
+    struct Op {
+        OpCode code;
+        double value;       // Constant, or previous value for edge detectors
+        VslVar* p_var;      // Variable for load instructions
+        size_t index;       // Array index for OP_LOAD_AT
+    };
+
+    std::string expr {};
+    std::vector<Op> program {};
+    std::vector<double> stack {};
+
+    /* Recursive descent parser */
+    struct Parser;
+};
+
+} // namespace vsl
+#endif //VSL_TRIGGER_HPP
+// EOF
@@ -36,7 +36,9 @@ SOFTWARE.
 #include "cJSON.h"
 #include <string>
 #include <any>
+#include <functional>
 #include <unordered_map>
+#include <vector>
 
 namespace vsl {
 
@@ -55,6 +57,30 @@ enum VslType {
     VSL_TYPE_UNKNOWN        ///<Unknown variable type
 };
 
+/**
+ * @struct VslVarOps
+ * @brief Accessors for a variable, specific to its type
+ *
+ * Each accessor takes the typed pointer to the Verilator variable and converts
+ * the value from or to a double. The words accessors read or write the value
+ * as an array of num_words 32-bit words (least significant word first),
+ * without any conversion to a double.
+ */
+struct VslVarOps {
+    double (*get_value)(const void* datap);
+    double (*get_array_value)(const void* datap, size_t index);
+    int (*set_value)(void* datap, double value);
+    int (*set_array_value)(void* datap, double value, size_t index);
+    int (*get_array_values)(const void* datap, double* p_values,
+        size_t index, size_t num);
+    int (*set_array_values)(void* datap, const double* p_values,
+        size_t index, size_t num);
+    int (*get_words)(const void* datap, EData* p_words, size_t num_words,
+        size_t index);
+    int (*set_words)(void* datap, const EData* p_words, size_t num_words,
+        size_t index);
+};
+
 /**
  * @class VslVar
  * @brief Represents a variable in the Verisocks library.
@@ -74,18 +100,23 @@ public:
 
     /**
     * @brief Constructor for class VslVar
-    * 
+    *
+    * The typed pointer to the Verilator variable and the accessors matching
+    * its type are resolved once, here, and not for every access.
+    *
     * @param namep Name of the variable.
     * @param datap Pointer to the corresponding Verilator variable.
     * @param vltype Type of the variable as defined by VerilatedVarType.
     * @param type Type of the variable as defined by VslType.
     * @param dims Number of dimensions of the variable (default is 0).
     * @param depth Depth of the variable (default is 0).
+    * @param shape Number of elements of each unpacked dimension, from the
+    * outermost one, for a multi-dimensional array. In this case, dims and
+    * depth are derived from the shape.
     */
     VslVar(const char* namep, std::any datap, VerilatedVarType vltype,
-        VslType type, size_t dims, size_t width, size_t depth) :
-        namep {namep}, datap {datap}, vltype {vltype}, type {type},
-        dims {dims}, width {width}, depth {depth} {};
+        VslType type, size_t dims, size_t width, size_t depth,
+        const std::vector<size_t>& shape = {});
 
     /**
      * @brief Returns the value of a scalar variable
@@ -99,7 +130,7 @@ public:
      *
      * @return Variable numeric value as a double
      */
-    double get_value();
+    inline double get_value() { return p_ops->get_value(datap); }
 
     /**
      * @brief Returns the value of an array variable at a given index
@@ -112,14 +143,18 @@ public:
      * @param index Index of the value to be returned
      * @return Variable numeric value as a double
      */
-    double get_array_value(size_t index);
+    inline double get_array_value(size_t index) {
+        return p_ops->get_array_value(datap, index);
+    }
 
     /**
      * @brief Sets the value of a scalar variable
      * @param value Value to be set
      * @return Returns 0 in case of success, -1 otherwise
      */
-    int set_value(double value);
+    inline int set_value(double value) {
+        return p_ops->set_value(datap, value);
+    }
 
     /**
      * @brief Sets the value of an array variable at a given index
@@ -129,6 +164,109 @@ public:
      */
     int set_array_value(double value, size_t index);
 
+    /**
+     * @brief Copies a block of consecutive values of an array variable
+     *
+     * @param p_values Destination buffer, with at least num elements
+     * @param index Index of the first value to be copied
+     * @param num Number of values to be copied
+     * @return Returns 0 in case of success, -1 otherwise
+     */
+    int get_array_values(double* p_values, size_t index, size_t num);
+
+    /**
+     * @brief Sets a block of consecutive values of an array variable
+     *
+     * @param p_values Source buffer, with at least num elements
+     * @param index Index of the first value to be set
+     * @param num Number of values to be set
+     * @return Returns 0 in case of success, -1 otherwise
+     */
+    int set_array_values(const double* p_values, size_t index, size_t num);
+
+    /**
+     * @brief Returns the number of 32-bit words needed for a value
+     * @return Number of words
+     */
+    size_t get_num_words() const;
+
+    /**
+     * @brief Returns the size of the variable data, in bytes (all the elements
+     * for an array)
+     * @return Size in bytes, 0 if the variable has no value data (e.g. event)
+     */
+    size_t get_size() const;
+
+    /**
+     * @brief Gets a value as an array of 32-bit words, without conversion
+     *
+     * This is supported for all integer types, including wide variables
+     * (VLVT_WDATA).
+     *
+     * @param p_words Destination buffer, with at least get_num_words() words,
+     * least significant word first
+     * @param index Index of the value for an array variable
+     * @return Returns 0 in case of success, -1 otherwise
+     */
+    int get_words(EData* p_words, size_t index = 0);
+
+    /**
+     * @brief Sets a value from an array of 32-bit words, without conversion
+     *
+     * @param p_words Source buffer, with get_num_words() words, least
+     * significant word first
+     * @param index Index of the value for an array variable
+     * @return Returns 0 in case of success, -1 otherwise (e.g. if the value
+     * exceeds the variable width)
+     */
+    int set_words(const EData* p_words, size_t index = 0);
+
+    /**
+     * @brief Gets a value as an hexadecimal string, e.g. "0x01fa"
+     *
+     * The string has as many digits as needed for the variable width.
+     *
+     * @param str_value Hexadecimal string
+     * @param index Index of the value for an array variable
+     * @return Returns 0 in case of success, -1 otherwise
+     */
+    int get_hex_value(std::string& str_value, size_t index = 0);
+
+    /**
+     * @brief Sets a value from an hexadecimal string
+     *
+     * The "0x" prefix is optional and underscores are ignored.
+     *
+     * @param str_value Hexadecimal string
+     * @param index Index of the value for an array variable
+     * @return Returns 0 in case of success, -1 otherwise
+     */
+    int set_hex_value(const char* str_value, size_t index = 0);
+
+    /**
+     * @brief Creates a cJSON item with a value
+     *
+     * Wide variables values, and integer values if hex is true, are created
+     * as hexadecimal strings. Other values are created as numbers.
+     *
+     * @param index Index of the value for an array variable
+     * @param hex If true, integer values are created as hexadecimal strings
+     * @return Pointer to the new cJSON item, nullptr in case of error
+     */
+    cJSON* create_json_value(size_t index, bool hex);
+
+    /**
+     * @brief Sets a value from a cJSON item
+     *
+     * The cJSON item can either be a number or an hexadecimal string. In the
+     * latter case, the value is set without conversion to a double.
+     *
+     * @param p_item Pointer to cJSON item
+     * @param index Index of the value for an array variable
+     * @return Returns 0 in case of success, -1 otherwise
+     */
+    int set_json_value(const cJSON* p_item, size_t index = 0);
+
     /**
      * @brief Sets a full array from a cJSON array object
      *
@@ -141,17 +279,19 @@ public:
      * @brief Add the value of a scalar variable to a cJSON object
      * @param p_msg Pointer to cJSON message object
      * @param key Key to be used in the cJSON object
+     * @param hex If true, integer values are added as hexadecimal strings
      * @return Returns 0 in case of success, -1 otherwise
      */
-    int add_value_to_msg(cJSON* p_msg, const char* key);
+    int add_value_to_msg(cJSON* p_msg, const char* key, bool hex = false);
 
     /**
      * @brief Add an array variable to a cJSON object
      * @param p_msg Pointer to cJSON message object
      * @param key Key to be used in the cJSON object
+     * @param hex If true, integer values are added as hexadecimal strings
      * @return Returns 0 in case of success, -1 otherwise
      */
-    int add_array_to_msg(cJSON* p_msg, const char* key);
+    int add_array_to_msg(cJSON* p_msg, const char* key, bool hex = false);
 
     /**
      * @brief Add a sub-range of an array variable to a cJSON object
@@ -162,10 +302,43 @@ public:
      * @param p_msg Pointer to cJSON message object
      * @param key Key to be used in the cJSON object
      * @param range Sub-range definition
+     * @param hex If true, integer values are added as hexadecimal strings
      * @return Returns 0 in case of success, -1 otherwise
      */
     int add_array_to_msg(cJSON* p_msg, const char* key,
-        const VslArrayRange& range);
+        const VslArrayRange& range, bool hex = false);
+
+    /**
+     * @brief Add a slice of a multi-dimensional array variable to a cJSON
+     * object
+     *
+     * The slice is added as nested arrays, with one level for each dimension
+     * for which the range length is larger than 1. The dimensions for which
+     * no range is provided are taken in full. The values are copied row by
+     * row (innermost dimension) from the array storage.
+     *
+     * @param p_msg Pointer to cJSON message object
+     * @param key Key to be used in the cJSON object
+     * @param ranges Range definitions, from the outermost dimension
+     * @param hex If true, integer values are added as hexadecimal strings
+     * @return Returns 0 in case of success, -1 otherwise
+     */
+    int add_slice_to_msg(cJSON* p_msg, const char* key,
+        const std::vector<VslArrayRange>& ranges, bool hex = false);
+
+    /**
+     * @brief Sets a slice of a multi-dimensional array variable from a cJSON
+     * item
+     *
+     * The cJSON item is expected to have the same nesting as the one
+     * returned by add_slice_to_msg() for the same ranges.
+     *
+     * @param p_item Pointer to cJSON item
+     * @param ranges Range definitions, from the outermost dimension
+     * @return Returns 0 in case of success, -1 otherwise
+     */
+    int set_slice_value(const cJSON* p_item,
+        const std::vector<VslArrayRange>& ranges);
 
     /**
      * @brief Returns the variable name
@@ -197,11 +370,29 @@ public:
 
     /**
      * @brief Returns the depth of an array variable
-     * @note At the moment, only 2-dimensional arrays are supported
+     *
+     * For a multi-dimensional array, this is the total number of elements.
+     *
      * @return Depth value
      */
     const size_t get_depth() { return depth; }
 
+    /**
+     * @brief Returns the number of elements of each unpacked dimension of a
+     * multi-dimensional array variable, from the outermost one
+     * @return Shape (empty if the variable is not a multi-dimensional array)
+     */
+    const std::vector<size_t>& get_shape() const { return shape; }
+
+    /**
+     * @brief Checks if the variable is an array (with any number of
+     * dimensions)
+     * @return True if the variable is an array
+     */
+    inline bool is_array() const {
+        return (VSL_TYPE_ARRAY == type) || (VSL_TYPE_MDARRAY == type);
+    }
+
     /**
      * @brief Returns the corresponding Verilator variable type
      * @return Verilated variable type
@@ -214,14 +405,42 @@ public:
      */
     const VslType get_type() { return type; }
 
+    /**
+     * @brief Returns the pointer to the Verilator variable
+     * @return Pointer to the variable (nullptr if the variable has no value)
+     */
+    inline void* get_datap() const { return datap; }
+
+    /**
+     * @brief Re-binds the variable to another location of the same Verilator
+     * variable, e.g. once the model has been reconstructed
+     *
+     * The type, width and dimensions of the variable are not modified.
+     *
+     * @param p_data New pointer to the Verilator variable
+     */
+    inline void rebind(void* p_data) { datap = p_data; }
+
+    /**
+     * @brief Accessors used by default, for a variable without any value
+     */
+    static const VslVarOps ops_none;
+
 private:
     const char* namep;
-    std::any datap;
+    void* datap {nullptr};  //Typed pointer, resolved at construction
+    const VslVarOps* p_ops {&ops_none};
     VerilatedVarType vltype {VLVT_UNKNOWN};
     VslType type {VSL_TYPE_UNKNOWN};
     size_t dims {0};
     size_t width {0};
     size_t depth {0};
+    std::vector<size_t> shape {};
+
+    /* Validates slice ranges and completes them with the full ranges of the
+    dimensions not provided */
+    int get_full_ranges(const std::vector<VslArrayRange>& ranges,
+        std::vector<VslArrayRange>& full_ranges);
 };
 
 class VslVarMap {
@@ -254,11 +473,16 @@ public:
      * @param dims The number of dimensions of the variable.
      * @param width The width of the variable.
      * @param depth The depth of the variable.
+     * @param shape The shape of a multi-dimensional array variable.
      */
     void add_var(const char* namep, std::any datap, VerilatedVarType vltype,
-        VslType type, size_t dims, size_t width, size_t depth) {
-        var_map[namep] = VslVar {
-            namep, datap, vltype, type, dims, width, depth};
+        VslType type, size_t dims, size_t width, size_t depth,
+        const std::vector<size_t>& shape = {}) {
+        /* The variable name refers to the map key, so that namep does not
+        need to outlive the map */
+        auto it = var_map.try_emplace(namep).first;
+        it->second = VslVar {
+            it->first.c_str(), datap, vltype, type, dims, width, depth, shape};
     }
 
     /**
@@ -296,6 +520,23 @@ public:
      */
     VslVar* get_var(const std::string& str_path);
 
+    /**
+     * @brief Gets the names of all the variables in the variable map.
+     *
+     * @return std::vector<std::string> Variable names, sorted alphabetically
+     */
+    std::vector<std::string> get_names() const;
+
+    /**
+     * @brief Re-binds all the variables of the variable map
+     *
+     * @param fn Function returning the new pointer of a variable from its
+     * current one
+     */
+    void rebind(const std::function<void*(void*)>& fn) {
+        for (auto& it : var_map) it.second.rebind(fn(it.second.get_datap()));
+    }
+
 private:
     std::unordered_map<std::string, VslVar> var_map;
 };
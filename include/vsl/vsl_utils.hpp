@@ -45,6 +45,7 @@ SOFTWARE.
 #include "verilated.h"
 #include "cJSON.h"
 #include <string>
+#include <vector>
 
 namespace vsl{
 
@@ -56,6 +57,21 @@ namespace vsl{
  */
 bool check_time_unit(std::string time_unit);
 
+/**
+ * @brief Maximum number of values (number of samples times number of
+ * variables) stored by a sampler, clock edge sampler or flight recorder
+ */
+constexpr size_t VSL_SAMPLES_MAX_VALUES {1u << 24};
+
+/**
+ * @brief Checks that a number received in a command is a valid count, i.e.
+ * an integer value between 0 and INT_MAX
+ *
+ * @param value Number value
+ * @return bool If the value is a valid count, returns true, false otherwise
+ */
+bool check_count(double value);
+
 /**
  * @brief Converts a given simulation integer time value to a double
  * representation based on the specified time unit.
@@ -110,6 +126,27 @@ bool has_range(const std::string& path);
  */
 VslArrayRange get_range(const std::string& path);
 
+/**
+ * @brief Struct to support accessing sub-ranges of multi-dimensional arrays
+ */
+struct VslArrayRanges {
+    std::vector<VslArrayRange> ranges; ///<Ranges, from outermost dimension
+    std::string array_name; ///<Array path name without [ ] operators
+};
+
+/**
+ * @brief Parse and extract variable path and range definitions for all the
+ * trailing [] operators of a path
+ *
+ * Each range has the same meaning as for get_range(). The array_name member
+ * of the individual ranges is set to the array path name as well.
+ *
+ * @param path Variable path with range definitions, e.g. mem[3][0:15]
+ * @return (VslArrayRanges) If the path does not contain any range definition,
+ * the returned ranges vector is empty and the array name is "None".
+ */
+VslArrayRanges get_ranges(const std::string& path);
+
 } //namespace vsl
 
 #endif //VSL_SIGNALS_HPP
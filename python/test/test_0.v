@@ -19,6 +19,10 @@ reg clk;
 reg [7:0] count;
 reg [7:0] count_memory [0:15];
 reg [3:0] mem_pointer;
+reg [63:0] long_reg;  //Used only for tests
+reg [63:0] long_memory [0:1];  //Used only for tests
+reg [99:0] wide_reg;  //Used only for tests
+reg [7:0] tile_memory [0:3][0:7];  //Used only for tests
 event counter_end;
 
 /* Note: Cannot use always @* otherwise Verilator bugs out */
@@ -60,6 +64,8 @@ initial begin
     enable = 1'b0;
     count = 8'd0;
     mem_pointer = 4'd0;
+    long_reg = 64'hfedc_ba98_7654_3210;
+    wide_reg = 100'h1_2345_6789_abcd_ef01_2345_6789;
 
 	#0.1 enable = 1'b1;
 
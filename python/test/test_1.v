@@ -0,0 +1,23 @@
+`timescale 1us/1ps
+
+/* Design without timing constructs, so that it can be verilated with the
+ * --savable option (checkpoint tests). The clock is driven by the Verilator
+ * integration. */
+module main (
+	input  wire clk,			// Clock
+	input  wire arst_b,			// Active-low, asynchronous reset
+	output reg  [7:0] count,	// Counter value
+	output reg  [31:0] acc		// Sum of the past counter values
+);
+
+always @(posedge clk, negedge arst_b) begin
+	if (!arst_b) begin
+		count <= 8'd0;
+		acc <= 32'd0;
+	end else begin
+		count <= count + 1;
+		acc <= acc + {24'd0, count};
+	end
+end
+
+endmodule
@@ -139,6 +139,21 @@ def test_get_value(vs):
     assert answer["type"] == "result"
     assert answer["value"] == 99
 
+    # Get several values at once, with a list of paths or a glob pattern
+    answer = vs.get(sel="value", path=["main.clk", "main.count"])
+    assert answer["type"] == "result"
+    assert answer["value"] == {"main.clk": 1, "main.count": 101}
+
+    answer = vs.get(sel="value", path="main.count*")
+    assert answer["type"] == "result"
+    assert answer["value"]["main.count"] == 101
+    assert answer["value"]["main.count_memory"][3] == 99
+
+    # Error case: wrong path
+    with pytest.raises(VerisocksError):
+        answer = vs.get(sel="value", path=["main.clk", "wrong_path"])
+        assert answer["type"] == "error"
+
     # Error case: wrong path
     with pytest.raises(VerisocksError):
         answer = vs.get(sel="value", path="wrong_path")
@@ -179,6 +194,34 @@ def test_get_type(vs):
         assert answer["type"] == "error"
 
 
+def test_get_list(vs):
+    """Tests Verisocks get(sel="list") function"""
+
+    answer = vs.get(sel="list", pattern="main.*")
+    assert answer["type"] == "result"
+    assert set(answer["value"]) >= {
+        "main.clk", "main.count", "main.count_memory", "main.fclk",
+        "main.int_param", "main.counter_end"}
+
+    answer = vs.get(sel="list", pattern="main.count_*")
+    assert answer["type"] == "result"
+    assert answer["value"] == ["main.count_memory"]
+
+    answer = vs.get(sel="list", pattern="**.c?k")
+    assert answer["type"] == "result"
+    assert answer["value"] == ["main.clk"]
+
+    # Without pattern, all objects are listed
+    answer = vs.get(sel="list")
+    assert answer["type"] == "result"
+    assert "main.count" in answer["value"]
+
+    # No matching object
+    answer = vs.get(sel="list", pattern="main.not_a_signal*")
+    assert answer["type"] == "result"
+    assert answer["value"] == []
+
+
 def test_run_for_time(vs):
     """Tests Verisocks run(cb="for_time") function"""
 
@@ -298,6 +341,102 @@ def test_run_until_change(vs):
     assert answer["type"] == "result"
     assert answer["value"] == 255
 
+    # Any change, 3 occurrences (255 -> 0 -> 1 -> 2)
+    answer = vs.run(cb="until_change", path="main.count", edge="any", count=3)
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="value", path="main.count")
+    assert answer["value"] == 2
+
+    # Inequality
+    answer = vs.run(cb="until_change", path="main.count", op="ge", value=200)
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="value", path="main.count")
+    assert answer["value"] == 200
+
+    # Falling edge of the MSB (255 -> 0)
+    answer = vs.run(cb="until_change", path="main.count", edge="falling",
+                    mask=0x80)
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="value", path="main.count")
+    assert answer["value"] == 0
+
+    # Masked value (bit 3 set)
+    answer = vs.run(cb="until_change", path="main.count", mask=0x08, value=8)
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="value", path="main.count")
+    assert answer["value"] == 8
+
+    # Counting rising edges
+    answer = vs.get(sel="sim_time")
+    start_time = answer["time"]
+    answer = vs.run(cb="until_change", path="main.clk", edge="rising",
+                    count=10)
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="sim_time")
+    assert answer["time"] - start_time == pytest.approx(10e-6/1.01, rel=1e-3)
+    answer = vs.get(sel="value", path="main.clk")
+    assert answer["value"] == 1
+
+    # Repeated waits on the same objects (callbacks are kept registered)
+    for _ in range(100):
+        answer = vs.run(cb="until_change", path="main.clk", edge="rising")
+        assert answer["type"] == "ack"
+    answer = vs.set(path="main.count", value=10)
+    assert answer["type"] == "ack"
+    answer = vs.run(cb="until_change", path="main.count", value=12)
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="value", path="main.count")
+    assert answer["value"] == 12
+
+    # Errors: wrong condition, edge or operator, wrong mask or count
+    for kwargs in [{"edge": "up"}, {"op": "rising", "value": 1},
+                   {"mask": 0, "value": 1}, {"count": 0, "value": 1},
+                   {"count": 1.5, "value": 1}]:
+        with pytest.raises(VerisocksError):
+            vs.run(cb="until_change", path="main.count", **kwargs)
+
+
+def test_run_sample(vs):
+    """Tests Verisocks run(cb="sample") function"""
+
+    answer = vs.get(sel="sim_time")
+    assert answer["type"] == "result"
+    start_time = answer["time"]
+
+    answer = vs.run(cb="sample", period=1, time_unit="us", count=200,
+                    path=["main.count", "main.clk"])
+    assert answer["type"] == "result"
+    assert len(answer["time"]) == 200
+    assert answer["time"][0] == pytest.approx(start_time + 1e-6)
+    assert answer["time"][-1] == pytest.approx(start_time + 200e-6)
+    assert len(answer["value"]["main.count"]) == 200
+    assert len(answer["value"]["main.clk"]) == 200
+    counts = answer["value"]["main.count"]
+    assert all(b >= a for a, b in zip(counts, counts[1:]))
+    assert counts[-1] > counts[0]
+
+    # Last sample matches the current value
+    answer = vs.get(sel="value", path="main.count")
+    assert answer["value"] == counts[-1]
+
+    # Single path provided as a string
+    answer = vs.run(cb="sample", period=10, time_unit="ns", count=3,
+                    path="main.count")
+    assert answer["type"] == "result"
+    assert len(answer["value"]["main.count"]) == 3
+
+    # Error: invalid path
+    with pytest.raises(VerisocksError):
+        answer = vs.run(cb="sample", period=1, time_unit="us", count=10,
+                        path=["main.count", "main.not_a_signal"])
+        assert answer["type"] == "error"
+
+    # Errors: invalid or too large count
+    for count in [2.5, 2**61, 2**24]:
+        with pytest.raises(VerisocksError):
+            vs.run(cb="sample", period=1, time_unit="us", count=count,
+                   path=["main.count", "main.clk"])
+
 
 def test_set(vs):
     """Tests Verisocks set() function"""
@@ -328,6 +467,49 @@ def test_set(vs):
     assert answer["type"] == "ack"
 
 
+def test_schedule(vs):
+    """Tests Verisocks schedule() function"""
+    t0 = 10.0
+    answer = vs.run(cb="until_time", time=t0, time_unit="us")
+    assert answer["type"] == "ack"
+
+    # Stop the counter, then replay a 1 ns-step ramp on main.count. The events
+    # are sent in reverse order, sorting is done by the server.
+    events = [(t0 + 1 + 0.001*i, "main.count", i % 256) for i in range(2000)]
+    events.append((t0 + 0.5, "main.enable", 0))
+    events.reverse()
+    answer = vs.schedule(events, time_unit="us")
+    assert answer["type"] == "ack"
+
+    answer = vs.run(cb="until_time", time=t0 + 1.5005, time_unit="us")
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="value", path=["main.enable", "main.count"])
+    assert answer["type"] == "result"
+    assert answer["value"] == {"main.enable": 0, "main.count": 500 % 256}
+
+    answer = vs.run(cb="until_time", time=t0 + 5, time_unit="us")
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="value", path="main.count")
+    assert answer["value"] == 1999 % 256
+
+    # Events with the same time are applied in the list order
+    answer = vs.schedule([(t0 + 6, "main.count", 3), (t0 + 6, "main.count", 4)],
+                         time_unit="us")
+    assert answer["type"] == "ack"
+    answer = vs.run(cb="until_time", time=t0 + 7, time_unit="us")
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="value", path="main.count")
+    assert answer["value"] == 4
+
+    # Error cases: event in the past, wrong path, named event
+    with pytest.raises(VerisocksError):
+        vs.schedule([(t0, "main.count", 1)], time_unit="us")
+    with pytest.raises(VerisocksError):
+        vs.schedule([(t0 + 8, "main.not_a_signal", 1)], time_unit="us")
+    with pytest.raises(VerisocksError):
+        vs.schedule([(t0 + 8, "main.counter_end", 1)], time_unit="us")
+
+
 def test_read_not_expected(vs):
     """Tests what happens when a read function is requested while there are no
     messages expected.
@@ -26,12 +26,13 @@ cwd = os.path.dirname(__file__)
 
 
 def setup_test(port, timeout, capture_output=True,
-               capture_logfile=None):
+               capture_logfile=None, io_thread=False):
     elab_cmd = ["make", "-C", cwd]
     sim_cmd = [
         os.path.join(cwd, "Vmain"),
         f"{port}",
-        f"{timeout}"
+        f"{timeout}",
+        f"{int(io_thread)}"
     ]
     pop = setup_sim_run(
         elab_cmd,
@@ -42,12 +43,16 @@ def setup_test(port, timeout, capture_output=True,
     return pop
 
 
-@pytest.fixture(params=[True, False])
+# Parameters (use_uuid, io_thread) - The test bench runs without background
+# socket I/O thread by default
+@pytest.fixture(params=[(True, False), (False, False), (True, True)],
+                ids=["uuid", "no_uuid", "io_thread"])
 def vs(request):
     # Setup
+    use_uuid, io_thread = request.param
     port = find_free_port()
-    pop = setup_test(port, VS_TIMEOUT)
-    _vs = Verisocks(HOST, port, use_uuid=request.param)
+    pop = setup_test(port, VS_TIMEOUT, io_thread=io_thread)
+    _vs = Verisocks(HOST, port, use_uuid=use_uuid)
     _vs.connect()
     yield _vs
     # Teardown
@@ -153,6 +158,21 @@ def test_get_value(vs):
     assert answer["type"] == "result"
     assert answer["value"] == [86, 85, 100, 99]
 
+    # Get several values at once, with a list of paths or a glob pattern
+    answer = vs.get(sel="value", path=["main.clk", "main.count"])
+    assert answer["type"] == "result"
+    assert answer["value"] == {"main.clk": 1, "main.count": 101}
+
+    answer = vs.get(sel="value", path="main.count*")
+    assert answer["type"] == "result"
+    assert answer["value"]["main.count"] == 101
+    assert answer["value"]["main.count_memory"][3] == 99
+
+    # Error case: wrong path
+    with pytest.raises(VerisocksError):
+        answer = vs.get(sel="value", path=["main.clk", "wrong_path"])
+        assert answer["type"] == "error"
+
     # Error case: wrong path
     with pytest.raises(VerisocksError):
         answer = vs.get(sel="value", path="wrong_path")
@@ -170,6 +190,166 @@ def test_get_type(vs):
     logging.info(repr(answer))
 
 
+def test_get_list(vs):
+    """Tests Verisocks get(sel="list") function"""
+
+    answer = vs.get(sel="list", pattern="main.*")
+    assert answer["type"] == "result"
+    assert set(answer["value"]) >= {
+        "main.clk", "main.count", "main.count_memory", "main.fclk",
+        "main.int_param", "main.counter_end"}
+
+    answer = vs.get(sel="list", pattern="main.count_*")
+    assert answer["type"] == "result"
+    assert answer["value"] == ["main.count_memory"]
+
+    answer = vs.get(sel="list", pattern="**.c?k")
+    assert answer["type"] == "result"
+    assert answer["value"] == ["main.clk"]
+
+    # Without pattern, all objects are listed
+    answer = vs.get(sel="list")
+    assert answer["type"] == "result"
+    assert "main.count" in answer["value"]
+
+    # No matching object
+    answer = vs.get(sel="list", pattern="main.not_a_signal*")
+    assert answer["type"] == "result"
+    assert answer["value"] == []
+
+
+def test_auto_register(vs):
+    """Tests access to public variables which have not been explicitly
+    registered (registered with auto_register)"""
+
+    answer = vs.run("for_time", time=100, time_unit="us")
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="value",
+                    path=["main.count", "main.mem_pointer", "main.enable"])
+    assert answer["type"] == "result"
+    assert answer["value"] == {
+        "main.count": 101, "main.mem_pointer": 5, "main.enable": 1}
+
+    # Explicit registrations are kept
+    answer = vs.get(sel="value", path="main.count_memory[3]")
+    assert answer["type"] == "result"
+    assert answer["value"] == 99
+
+    answer = vs.set(path="main.enable", value=0)
+    assert answer["type"] == "ack"
+    answer = vs.run("for_time", time=10, time_unit="us")
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="value", path="main.mem_pointer")
+    assert answer["type"] == "result"
+    assert answer["value"] == 5
+
+
+def test_wide_values(vs):
+    """Tests integer-exact access to 64-bit and wide (> 64 bits) variables
+    using hexadecimal strings"""
+
+    answer = vs.run("for_time", time=1, time_unit="us")
+    assert answer["type"] == "ack"
+
+    # Wide variables values are always returned as hexadecimal strings
+    answer = vs.get(sel="value", path="main.wide_reg")
+    assert answer["type"] == "result"
+    assert answer["value"] == "0x123456789abcdef0123456789"
+
+    # 64-bit value above 2^53, exact only with format="hex"
+    answer = vs.get(sel="value", path="main.long_reg", format="hex")
+    assert answer["type"] == "result"
+    assert answer["value"] == "0xfedcba9876543210"
+
+    answer = vs.get(sel="value", path=["main.count", "main.long_reg"],
+                    format="hex")
+    assert answer["type"] == "result"
+    assert answer["value"]["main.count"] == "0x01"
+
+    answer = vs.get(sel="value", path="main.count_memory[1:0]",
+                    format="hex")
+    assert answer["type"] == "result"
+    assert answer["value"] == ["0x00", "0x00"]
+
+    # Set values from hexadecimal strings or numbers
+    answer = vs.set(path="main.wide_reg",
+                    value="0xf_0000_0000_0000_0000_0000_0001")
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="value", path="main.wide_reg")
+    assert answer["value"] == "0x" + f"{0xf << 96 | 1:025x}"
+
+    answer = vs.set(path="main.wide_reg", value=42)
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="value", path="main.wide_reg")
+    assert answer["value"] == "0x" + f"{42:025x}"
+
+    answer = vs.set(path="main.long_reg", value="0x8000000000000001")
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="value", path="main.long_reg", format="hex")
+    assert answer["value"] == "0x8000000000000001"
+
+    # Array mixing hexadecimal strings and numbers, exact above 2^53
+    answer = vs.set(path="main.long_memory", value=["0xffffffffffffffff", 1])
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="value", path="main.long_memory", format="hex")
+    assert answer["value"] == ["0xffffffffffffffff", "0x0000000000000001"]
+
+    # Error cases: value exceeding the variable width, invalid format
+    with pytest.raises(VerisocksError):
+        vs.set(path="main.wide_reg", value="0x10000000000000000000000000")
+    with pytest.raises(VerisocksError):
+        vs.set(path="main.count", value="0xzz")
+    with pytest.raises(VerisocksError):
+        vs.set(path="main.long_memory", value=[True, "0x1"])
+    with pytest.raises(VerisocksError):
+        vs.get(sel="value", path="main.count", format="binary")
+
+
+def test_mdarray_values(vs):
+    """Tests access to a multi-dimensional array, as a whole or with one range
+    per dimension"""
+
+    # Full array, set and get as nested arrays
+    tiles = [[16*i + j for j in range(8)] for i in range(4)]
+    answer = vs.set(path="main.tile_memory", value=tiles)
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="value", path="main.tile_memory")
+    assert answer["type"] == "result"
+    assert answer["value"] == tiles
+
+    # Row, sub-range of a row, single element and block of rows
+    answer = vs.get(sel="value", path="main.tile_memory[2]")
+    assert answer["value"] == tiles[2]
+    answer = vs.get(sel="value", path="main.tile_memory[1][5:2]")
+    assert answer["value"] == [18, 19, 20, 21]
+    answer = vs.get(sel="value", path="main.tile_memory[1][2:5]")
+    assert answer["value"] == [21, 20, 19, 18]
+    answer = vs.get(sel="value", path="main.tile_memory[3][7]")
+    assert answer["value"] == 55
+    answer = vs.get(sel="value", path="main.tile_memory[2:1][1:0]")
+    assert answer["value"] == [[16, 17], [32, 33]]
+    answer = vs.get(sel="value", path="main.tile_memory[0][0:1]",
+                    format="hex")
+    assert answer["value"] == ["0x01", "0x00"]
+
+    # Set a sub-block
+    answer = vs.set(path="main.tile_memory[1:0][4:3]",
+                    value=[[1, 2], [3, "0x0a"]])
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="value", path="main.tile_memory[1:0][4:3]")
+    assert answer["value"] == [[1, 2], [3, 10]]
+
+    # Error cases: index overflow, too many ranges, wrong value shape
+    with pytest.raises(VerisocksError):
+        vs.get(sel="value", path="main.tile_memory[4]")
+    with pytest.raises(VerisocksError):
+        vs.get(sel="value", path="main.tile_memory[0][0][0]")
+    with pytest.raises(VerisocksError):
+        vs.get(sel="value", path="main.count_memory[0][0]")
+    with pytest.raises(VerisocksError):
+        vs.set(path="main.tile_memory[1:0][4:3]", value=[[1, 2], [3]])
+
+
 def test_run_for_time(vs):
     """Tests Verisocks run(cb="for_time") function"""
 
@@ -289,6 +469,253 @@ def test_run_until_change(vs):
     assert answer["type"] == "result"
     assert answer["value"] == 255
 
+    # Edge and masked value triggers are not supported
+    with pytest.raises(VerisocksError):
+        vs.run(cb="until_change", path="main.count", edge="any", count=3)
+
+
+def test_run_sample(vs):
+    """Tests Verisocks run(cb="sample") function"""
+
+    answer = vs.get(sel="sim_time")
+    assert answer["type"] == "result"
+    start_time = answer["time"]
+
+    answer = vs.run(cb="sample", period=1, time_unit="us", count=200,
+                    path=["main.count", "main.clk"])
+    assert answer["type"] == "result"
+    assert len(answer["time"]) == 200
+    assert answer["time"][0] == pytest.approx(start_time + 1e-6)
+    assert answer["time"][-1] == pytest.approx(start_time + 200e-6)
+    assert len(answer["value"]["main.count"]) == 200
+    assert len(answer["value"]["main.clk"]) == 200
+    counts = answer["value"]["main.count"]
+    assert all(b >= a for a, b in zip(counts, counts[1:]))
+    assert counts[-1] > counts[0]
+
+    # Last sample matches the current value
+    answer = vs.get(sel="value", path="main.count")
+    assert answer["value"] == counts[-1]
+
+    # Single path provided as a string
+    answer = vs.run(cb="sample", period=10, time_unit="ns", count=3,
+                    path="main.count")
+    assert answer["type"] == "result"
+    assert len(answer["value"]["main.count"]) == 3
+
+    # Error: invalid path
+    with pytest.raises(VerisocksError):
+        answer = vs.run(cb="sample", period=1, time_unit="us", count=10,
+                        path=["main.count", "main.not_a_signal"])
+        assert answer["type"] == "error"
+
+    # Errors: invalid or too large count
+    for count in [2.5, 2**61, 2**24]:
+        with pytest.raises(VerisocksError):
+            vs.run(cb="sample", period=1, time_unit="us", count=count,
+                   path=["main.count", "main.clk"])
+
+
+def test_run_until_expr(vs):
+    """Tests Verisocks run(cb="until_expr") function"""
+
+    answer = vs.run(cb="until_expr", expr="main.count == 5 && main.enable")
+    assert answer["type"] == "ack"
+    assert answer["triggered"] is True
+    answer = vs.get(sel="value", path="main.count")
+    assert answer["value"] == 5
+
+    # Masked value and edge detection
+    answer = vs.run(cb="until_expr",
+                    expr="(main.count & 0x0f) == 0x0c || main.count > 250")
+    assert answer["triggered"] is True
+    answer = vs.get(sel="value", path="main.count")
+    assert answer["value"] == 12
+
+    answer = vs.run(cb="until_expr", expr="rise(main.clk)")
+    assert answer["triggered"] is True
+    answer = vs.get(sel="value", path="main.clk")
+    assert answer["value"] == 1
+    answer = vs.run(cb="until_expr", expr="fall(main.clk)")
+    assert answer["triggered"] is True
+    answer = vs.get(sel="value", path="main.clk")
+    assert answer["value"] == 0
+
+    # Array element
+    answer = vs.run(cb="until_expr", expr="main.count_memory[3] != 0")
+    assert answer["triggered"] is True
+
+    # Negative constant
+    answer = vs.run(cb="until_expr", expr="main.count > -1")
+    assert answer["triggered"] is True
+
+    # Deadline reached before the expression is met
+    answer = vs.get(sel="sim_time")
+    start_time = answer["time"]
+    answer = vs.run(cb="until_expr", expr="main.count == 0", time=5,
+                    time_unit="us")
+    assert answer["type"] == "ack"
+    assert answer["triggered"] is False
+    answer = vs.get(sel="sim_time")
+    assert answer["time"] == pytest.approx(start_time + 5e-6)
+
+    # Errors: syntax error, unknown variable, wide variable, event, missing
+    # deadline unit
+    with pytest.raises(VerisocksError):
+        vs.run(cb="until_expr", expr="main.count ==")
+    with pytest.raises(VerisocksError):
+        vs.run(cb="until_expr", expr="main.not_a_signal == 1")
+    with pytest.raises(VerisocksError):
+        vs.run(cb="until_expr", expr="main.wide_reg == 1")
+    with pytest.raises(VerisocksError):
+        vs.run(cb="until_expr", expr="main.counter_end")
+    with pytest.raises(VerisocksError):
+        vs.run(cb="until_expr", expr="main.count == 1", time=5)
+
+
+def read_vcd_times(vcd_file):
+    with open(vcd_file, "r") as f:
+        content = f.read()
+    assert "$enddefinitions" in content
+    return [int(t) for t in re.findall(r"^#([0-9]+)$", content, re.M)]
+
+
+def test_trace(vs, tmp_path):
+    """Tests Verisocks trace command (trace windows)"""
+
+    # Nothing to be done without an active trace window
+    with pytest.raises(VerisocksError):
+        vs.trace_stop()
+    with pytest.raises(VerisocksError):
+        vs.trace_flush()
+
+    vs.run(cb="for_time", time=10, time_unit="us")
+    vcd_file_1 = str(tmp_path / "window_1.vcd")
+    answer = vs.trace_start(vcd_file_1)
+    assert answer["type"] == "ack"
+    # Only one trace window at once
+    with pytest.raises(VerisocksError):
+        vs.trace_start(str(tmp_path / "other.vcd"))
+    vs.run(cb="for_time", time=2, time_unit="us")
+    answer = vs.trace_flush()
+    assert answer["type"] == "ack"
+    answer = vs.trace_stop()
+    assert answer["type"] == "ack"
+
+    # Dumped times (ps) are restricted to the trace window
+    times = read_vcd_times(vcd_file_1)
+    assert len(times) > 2
+    assert times[0] == pytest.approx(10e6)
+    assert times[-1] == pytest.approx(12e6)
+
+    # Second trace window, in another file
+    vs.run(cb="for_time", time=20, time_unit="us")
+    vcd_file_2 = str(tmp_path / "window_2.vcd")
+    answer = vs.trace_start(vcd_file_2, format="vcd")
+    assert answer["type"] == "ack"
+    vs.run(cb="for_time", time=1, time_unit="us")
+    answer = vs.trace_stop()
+    assert answer["type"] == "ack"
+    times = read_vcd_times(vcd_file_2)
+    assert times[0] == pytest.approx(32e6)
+    assert times[-1] == pytest.approx(33e6)
+
+    # Errors: format not verilated, depth changed, missing path
+    with pytest.raises(VerisocksError):
+        vs.trace_start(str(tmp_path / "window.fst"), format="fst")
+    with pytest.raises(VerisocksError):
+        vs.trace_start(str(tmp_path / "window_3.vcd"), depth=1)
+    with pytest.raises(VerisocksError):
+        vs.send(command="trace", sel="start")
+
+
+def test_checkpoint_not_savable(vs):
+    """Tests Verisocks checkpoint and restore commands with a model which is
+    not verilated with the --savable option"""
+
+    with pytest.raises(VerisocksError):
+        vs.checkpoint(name="boot")
+    with pytest.raises(VerisocksError):
+        vs.restore(name="boot")
+    with pytest.raises(ValueError):
+        vs.checkpoint()
+
+    # Simulation can go on
+    answer = vs.run(cb="for_time", time=1, time_unit="us")
+    assert answer["type"] == "ack"
+
+
+def test_fork(vs):
+    """Tests Verisocks fork command"""
+
+    answer = vs.run("until_time", time=10, time_unit="us")
+    assert answer["type"] == "ack"
+
+    # Two branches forked from the same state
+    answers = [vs.fork(), vs.fork()]
+    for answer in answers:
+        assert answer["type"] == "ack"
+        assert answer["pid"] > 0
+        assert answer["port"] > 0
+    assert answers[0]["port"] != answers[1]["port"]
+
+    with Verisocks(HOST, answers[0]["port"]) as vs_branch_0, \
+            Verisocks(HOST, answers[1]["port"]) as vs_branch_1:
+        vs_branch_0.run("for_time", time=5, time_unit="us")
+        vs_branch_1.run("for_time", time=2, time_unit="us")
+        assert vs_branch_0.get("sim_time")["time"] == 15e-6
+        assert vs_branch_1.get("sim_time")["time"] == 12e-6
+
+        # The parent simulation has not moved
+        assert vs.get("sim_time")["time"] == 10e-6
+        vs.run("for_time", time=1, time_unit="us")
+        assert vs.get("sim_time")["time"] == 11e-6
+
+        for vs_branch in (vs_branch_0, vs_branch_1):
+            answer = vs_branch.finish()
+            assert answer["type"] == "ack"
+
+    # Invalid port number
+    with pytest.raises(VerisocksError):
+        vs.fork(port=-1)
+
+
+def test_restart(vs):
+    """Tests Verisocks restart command"""
+
+    answer = vs.run("for_time", time=100, time_unit="us")
+    assert answer["type"] == "ack"
+    answer = vs.set(path="main.count_memory[3]", value=12)
+    assert answer["type"] == "ack"
+
+    answer = vs.restart()
+    assert answer["type"] == "ack"
+    assert answer["value"] == "Simulation restarted"
+
+    # Back to the initial state, with the same registered variables
+    answer = vs.get(sel="sim_time")
+    assert answer["type"] == "result"
+    assert answer["time"] == 0.0
+    answer = vs.get(sel="value", path="main.count_memory[3]")
+    assert answer["type"] == "result"
+    assert answer["value"] == 0
+
+    # Same simulation as right after the launch
+    answer = vs.run("for_time", time=100, time_unit="us")
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="value", path=["main.clk", "main.count"])
+    assert answer["type"] == "result"
+    assert answer["value"] == {"main.clk": 1, "main.count": 101}
+
+    # Several restarts in a row
+    for _ in range(3):
+        answer = vs.restart()
+        assert answer["type"] == "ack"
+    answer = vs.run("for_time", time=100, time_unit="us")
+    assert answer["type"] == "ack"
+    answer = vs.get(sel="value", path="main.count")
+    assert answer["value"] == 101
+
 
 def test_set(vs):
     """Tests Verisocks set() function"""
@@ -332,6 +759,17 @@ def test_set(vs):
     assert answer["type"] == "ack"
 
 
+def test_schedule(vs):
+    """Tests Verisocks schedule() function
+
+    Note: With Verilator integration, this command is currently not supported.
+    A warning message is thus expected.
+    """
+    answer = vs.schedule([(1, "main.count", 3)], time_unit="us")
+    assert answer['type'] == "warning"
+    logging.info(repr(answer))
+
+
 def test_read_not_expected(vs):
     """Tests what happens when a read function is requested while there are no
     messages expected.
@@ -0,0 +1,158 @@
+from verisocks.verisocks import Verisocks, VerisocksError
+from verisocks.utils import setup_sim_run, find_free_port
+import os.path
+import pytest
+import logging
+import socket
+import struct
+
+# Note
+# The checkpoint and restore commands require a model verilated with the
+# --savable option. Suspended timing processes are not part of a saved model
+# state, so this test bench uses a design without timing constructs (no
+# --timing option), with a clock driven by the Verilator integration.
+
+
+# Parameters
+HOST = socket.gethostbyname("localhost")
+VS_TIMEOUT = 10
+VSL_CHECKPOINT_HEADER = b"vslcheckpoint002\x00"
+
+
+cwd = os.path.dirname(__file__)
+
+
+def setup_test(port, timeout, capture_output=True,
+               capture_logfile=None):
+    elab_cmd = ["make", "-C", cwd]
+    sim_cmd = [
+        os.path.join(cwd, "Vmain"),
+        f"{port}",
+        f"{timeout}"
+    ]
+    pop = setup_sim_run(
+        elab_cmd,
+        sim_cmd,
+        capture_output=capture_output,
+        capture_logfile=capture_logfile
+    )
+    return pop
+
+
+@pytest.fixture
+def vs():
+    # Setup
+    port = find_free_port()
+    pop = setup_test(port, VS_TIMEOUT)
+    _vs = Verisocks(HOST, port)
+    _vs.connect()
+    answer = _vs.set(path="arst_b", value=1)
+    assert answer["type"] == "ack"
+    yield _vs
+    # Teardown
+    try:
+        _vs.finish()
+    except ConnectionError:
+        logging.warning("Connection error - Cannot send finish command")
+    _vs.close()
+    pop.communicate(timeout=10)
+
+
+def get_state(vs):
+    """Returns the simulation time, the clock level and the counter values"""
+    time = vs.get(sel="sim_time")["time"]
+    answer = vs.get(sel="value", path=["clk", "count", "acc"])
+    assert answer["type"] == "result"
+    return (time, answer["value"]["clk"], answer["value"]["count"],
+            answer["value"]["acc"])
+
+
+def run_and_get_state(vs):
+    """Runs the simulation for a while, then up to the next rising clock edge
+    (which depends on the clock phase) and returns the state at both times"""
+    answer = vs.run(cb="for_time", time=5, time_unit="us")
+    assert answer["type"] == "ack"
+    state_1 = get_state(vs)
+    answer = vs.run(cb="until_expr", expr="rise(clk)")
+    assert answer["type"] == "ack"
+    return state_1, get_state(vs)
+
+
+def checkpoint_round_trip(vs, **target):
+    answer = vs.run(cb="until_time", time=10.3, time_unit="us")
+    assert answer["type"] == "ack"
+    state_0 = get_state(vs)
+    assert state_0[0] == pytest.approx(10.3e-6)
+    assert state_0[2] > 0
+
+    answer = vs.checkpoint(**target)
+    assert answer["type"] == "ack"
+    states = run_and_get_state(vs)
+
+    # The same checkpoint can be restored several times
+    for _ in range(2):
+        answer = vs.restore(**target)
+        assert answer["type"] == "ack"
+        assert get_state(vs) == state_0
+        assert run_and_get_state(vs) == states
+
+
+def test_checkpoint_memory(vs):
+    """Tests Verisocks checkpoint and restore commands with an in-memory
+    checkpoint"""
+    checkpoint_round_trip(vs, name="boot")
+
+    # Unknown checkpoint name
+    with pytest.raises(VerisocksError):
+        vs.restore(name="unknown")
+
+
+def test_checkpoint_file(vs, tmp_path):
+    """Tests Verisocks checkpoint and restore commands with a checkpoint
+    file"""
+    checkpoint_round_trip(vs, path=str(tmp_path / "boot.ckpt"))
+
+    # Missing checkpoint file
+    with pytest.raises(VerisocksError):
+        vs.restore(path=str(tmp_path / "missing.ckpt"))
+
+
+def test_checkpoint_rejected(vs, tmp_path):
+    """Tests that truncated or foreign checkpoint files are rejected without
+    modifying the simulation state"""
+    answer = vs.run(cb="until_time", time=10.3, time_unit="us")
+    assert answer["type"] == "ack"
+    ckpt_file = tmp_path / "boot.ckpt"
+    answer = vs.checkpoint(path=str(ckpt_file))
+    assert answer["type"] == "ack"
+    answer = vs.run(cb="for_time", time=5, time_unit="us")
+    assert answer["type"] == "ack"
+    state = get_state(vs)
+    data = ckpt_file.read_bytes()
+
+    # Model name replaced in the integration state (same size)
+    pos = data.index(VSL_CHECKPOINT_HEADER) + len(VSL_CHECKPOINT_HEADER) + 8
+    name_len, = struct.unpack_from("<Q", data, pos)
+    pos += 8
+    foreign = data[:pos] + b"X"*name_len + data[pos + name_len:]
+
+    bad_files = {
+        "truncated_half.ckpt": data[:len(data)//2],
+        "truncated_end.ckpt": data[:-1],
+        "foreign_model.ckpt": foreign,
+        "foreign_file.ckpt": b"This is not a checkpoint\n"*64,
+        "empty.ckpt": b"",
+    }
+    for file_name, content in bad_files.items():
+        bad_file = tmp_path / file_name
+        bad_file.write_bytes(content)
+        with pytest.raises(VerisocksError):
+            vs.restore(path=str(bad_file))
+        assert get_state(vs) == state
+
+    # The simulation can go on, and the valid checkpoint be restored
+    answer = vs.run(cb="for_time", time=1, time_unit="us")
+    assert answer["type"] == "ack"
+    answer = vs.restore(path=str(ckpt_file))
+    assert answer["type"] == "ack"
+    assert get_state(vs)[0] == pytest.approx(10.3e-6)
@@ -13,7 +13,10 @@ args = "
 	verilator_root = '/usr/local/share/verilator',
 	use_tracing = False,
 	use_fst = True,
+	trace_windows = False,
+	savable = False,
 	use_timing = True,
+	auto_register = False,
 	log_level = 'info'
 "
 />\
@@ -40,7 +43,30 @@ VL_USER_FLAGS += --timing
 CPP_USER_FLAGS += -DVSL_TIMING
 % endif
 
-% if use_tracing:
+% if auto_register:
+# All the variables are public, for automatic registration
+VL_USER_FLAGS += --public-flat-rw
+
+% endif
+% if savable:
+# Savable model, for checkpoint and restore commands
+VL_USER_FLAGS += --savable
+
+% endif
+% if use_tracing and trace_windows:
+# Setup traceing - trace windows controlled with the trace command
+% if use_fst:
+
+# Using FST traceing (slower due to compression)
+VL_USER_FLAGS += --trace-fst
+USER_LDLIBS = -lz
+% else:
+
+# Using VCD traceing
+VL_USER_FLAGS += --trace
+% endif
+
+% elif use_tracing:
 # Setup traceing - use $dump() in testbench
 CPP_USER_FLAGS += -DDUMP_FILE
 % if use_fst:
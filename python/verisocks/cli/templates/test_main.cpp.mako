@@ -1,10 +1,11 @@
-<%page args = "prefix, variables, log_level"/>\
+<%page args = "prefix, variables, log_level, auto_register=False, io_thread=False, server_workers=0"/>\
 <%
 VLVT_TYPES = {
     "uint8":  "VLVT_UINT8",
     "uint16": "VLVT_UINT16",
     "uint32": "VLVT_UINT32",
     "uint64": "VLVT_UINT64",
+    "wide":   "VLVT_WDATA",
     "real":   "VLVT_REAL"
 }
 LOG_LEVELS = {
@@ -48,18 +49,27 @@ SOFTWARE.
 #include <memory>
 
 //======================
+% if server_workers:
+
+// Register the public variables of a session's model
+static void setup(vsl::VslInteg<${prefix}>& vslx, ${prefix}* topp) {
+% else:
 
 int main(int argc, char** argv, char**) {
 
-    //Get arguments for port number and timeout
+    //Get arguments for port number, timeout and background socket I/O thread
     int port_number {5100};
     int timeout {5};
+    bool io_thread {${"true" if io_thread else "false"}};
     if (argc > 1) {
         port_number = std::atoi(argv[1]);
     }
     if (argc > 2) {
         timeout = std::atoi(argv[2]);
     }
+    if (argc > 3) {
+        io_thread = (0 != std::atoi(argv[3]));
+    }
 
     // Setup context, defaults, and parse command line
     Verilated::debug(0);
@@ -82,6 +92,7 @@ int main(int argc, char** argv, char**) {
     // Create top VSL instance
     vsl::VslInteg<${prefix}> vslx{topp.get(), port_number, timeout};
 
+% endif
     // Register public variables
     % if variables:
     % if 'clocks' in variables:
@@ -96,17 +107,41 @@ int main(int argc, char** argv, char**) {
     % if 'scalars' in variables:
     // Scalar variables
 	% for var in variables['scalars']:
+    % if var['type'] == "wide":
+    vslx.register_scalar("${var['path']}",
+        topp->${var['path'].replace(".", "->")}.data(),
+        ${VLVT_TYPES[var['type']]}, ${var['width']}u);
+    % else:
     vslx.register_scalar("${var['path']}",
         &topp->${var['path'].replace(".", "->")},
         ${VLVT_TYPES[var['type']]}, ${var['width']}u);
+    % endif
     % endfor
     % endif
     % if 'arrays' in variables:
     // Array variables
     % for var in variables['arrays']:
+    % if isinstance(var['depth'], list):
+<%
+    num_dims = len(var['depth'])
+    if var['type'] == "wide":
+        storage = ".m_storage[0]" * num_dims + ".data()"
+    else:
+        storage = ".m_storage[0]" * (num_dims - 1) + ".m_storage"
+    shape = ", ".join(f"{d}u" for d in var['depth'])
+%>\
+    vslx.register_mdarray("${var['path']}",
+        topp->${var['path'].replace(".", "->")}${storage},
+        ${VLVT_TYPES[var['type']]}, ${var['width']}u, {${shape}});
+    % elif var['type'] == "wide":
+    vslx.register_array("${var['path']}",
+        topp->${var['path'].replace(".", "->")}.m_storage[0].data(),
+        ${VLVT_TYPES[var['type']]}, ${var['width']}u, ${var['depth']}u);
+    % else:
     vslx.register_array("${var['path']}",
         topp->${var['path'].replace(".", "->")}.m_storage,
         ${VLVT_TYPES[var['type']]}, ${var['width']}u, ${var['depth']}u);
+    % endif
     % endfor
     % endif
     % if 'params' in variables:
@@ -125,9 +160,58 @@ int main(int argc, char** argv, char**) {
     % endfor
     % endif
     % endif
+    % if auto_register:
+
+    // Register all the other public variables
+    vslx.auto_register();
+    % endif
+% if server_workers:
+}
+
+int main(int argc, char** argv, char**) {
+
+    //Get arguments for port number, timeout and background socket I/O thread
+    int port_number {5100};
+    int timeout {5};
+    bool io_thread {${"true" if io_thread else "false"}};
+    if (argc > 1) {
+        port_number = std::atoi(argv[1]);
+    }
+    if (argc > 2) {
+        timeout = std::atoi(argv[2]);
+    }
+    if (argc > 3) {
+        io_thread = (0 != std::atoi(argv[3]));
+    }
+
+    // Setup defaults - Each session has its own context and model
+    Verilated::debug(0);
+
+    // Setup traceing
+    #ifdef DUMP_FILE
+    Verilated::traceEverOn(true);
+    #endif
+
+    // Create multi-client VSL server
+    vsl::VslServer<${prefix}> server{
+        setup, port_number, timeout, ${server_workers}u};
+
+    // Use a background socket I/O thread for each session (optional)
+    server.set_io_thread(io_thread);
+
+    // Serve clients
+    int retval = server.run();
+
+    return retval;
+}
+% else:
+
+    // Use a background socket I/O thread (optional)
+    vslx.set_io_thread(io_thread);
 
     // Run simulation
     int retval = vslx.run();
 
     return retval;
 }
+% endif
@@ -25,6 +25,8 @@ import os.path
 import shutil
 import socket
 import logging
+import json
+import struct
 
 
 def find_free_port():
@@ -196,3 +198,40 @@ def setup_sim(vpi_libpath, *src_files, cwd=".", vvp_filepath=None,
 
     pop = setup_sim_run(ivl_cmd, vvp_cmd, capture_output, capture_logfile)
     return pop
+
+
+def write_vectors(path, columns, rows):
+    """Write a binary vector file, to be played with the Verisocks
+    :keyword:`play <sec_tcp_cmd_play>` command (only with Verilator).
+
+    Each column is bound to a registered scalar variable and its values are
+    stored with the native size of the variable in the Verilated model, i.e.
+    1, 2, 4 or 8 bytes for variables up to 8, 16, 32 or 64 bits and a
+    multiple of 4 bytes for wider variables. The columns returned by
+    :py:meth:`Verisocks.configure_sampler()
+    <verisocks.verisocks.Verisocks.configure_sampler>` can be used as is.
+
+    Args:
+        path (str): Path to the vector file
+        columns (list): One dictionary per column, with the keys ``"path"``
+            (path to the registered variable), ``"size"`` (number of bytes per
+            value) and, optionally, ``"dtype"`` (``"uint"`` by default or
+            ``"real"`` for double-precision values)
+        rows (iterable): Rows of values, each one with one value per column
+    """
+    header = json.dumps({"columns": [
+        {"path": column["path"], "size": column["size"]}
+        for column in columns]}).encode("utf-8")
+    data = bytearray(b"VSLV")
+    data += struct.pack("<I", len(header))
+    data += header
+    for row in rows:
+        if len(row) != len(columns):
+            raise ValueError("Each row shall have one value per column")
+        for column, value in zip(columns, row):
+            if column.get("dtype", "uint") == "real":
+                data += struct.pack("<d", value)
+            else:
+                data += int(value).to_bytes(column["size"], "little")
+    with open(path, "wb") as f:
+        f.write(data)
@@ -114,6 +114,11 @@ class Verisocks:
         self._tx_buffer = b""
         self._tx_msg_len = []
 
+        # Columns of the clock edge sampler and of the flight recorder, as
+        # returned when configured
+        self._sampler_columns = []
+        self._recorder_columns = []
+
     def connect(self, trials=None, delay=None):
         """Connect to server socket.
 
@@ -382,7 +387,11 @@ class Verisocks:
 Still {self._rx_expected} messages expected.")
                     return True
                 self._read(timeout)
-                trials += 1
+                # Long message contents (e.g. time series returned by a
+                # sampling run) may span many reads, which are not counted as
+                # additional trials
+                if (self._rx_state is not VsRxState.RX_HDR):
+                    trials += 1
             self._rx_state = VsRxState.ERROR
             logging.error("Read procedure unsuccessful")
             return False
@@ -422,7 +431,8 @@ Still {self._rx_expected} messages expected.")
                 If None (default), the class instance default value is used.
 
         Returns:
-            JSON object: Content of returned message.
+            JSON object: Content of returned message (bytes for a binary
+            message).
         """
 
         if "timeout" in cmd:
@@ -438,6 +448,8 @@ Still {self._rx_expected} messages expected.")
         self.write()
 
         if (self.read(10, timeout)):
+            if isinstance(self.rx_content, bytes):
+                return self.rx_content
             if self.rx_content["type"] == "error":
                 raise VerisocksError(self.rx_content["value"])
             return self.rx_content
@@ -485,6 +497,10 @@ Still {self._rx_expected} messages expected.")
             * ``"until_time"``: run until a specified time
             * ``"until_change"``: run until a specific value changes
             * ``"to_next"``: run until the beginning of the next time step
+            * ``"sample"``: run while periodically sampling a list of verilog
+              objects
+            * ``"until_expr"``: run until a trigger expression is met (only
+              with Verilator)
 
             If `cb` is ``"for_time"`` or ``"until_time"``, the following
             keyword arguments are further expected:
@@ -500,9 +516,57 @@ Still {self._rx_expected} messages expected.")
             * **path** (str): Path to verilog object used for the callback
             * **value** (number): Condition on the verilog object's
               value for the callback to be executed. This argument is not
-              required if the path corresponds to a named event.
+              required if the path corresponds to a named event or if an
+              edge is specified.
+
+            The following optional keyword arguments can also be used with
+            ``"until_change"`` (only with VPI):
+
+            * **edge** (str): Edge condition instead of a value condition,
+              either ``"rising"`` (value going from zero to non-zero),
+              ``"falling"`` (value going from non-zero to zero) or ``"any"``
+              (any change of the value)
+            * **op** (str): Comparison operator used with the value, either
+              ``"eq"`` (default), ``"ne"``, ``"lt"``, ``"le"``, ``"gt"`` or
+              ``"ge"``
+            * **mask** (int): Bit mask applied to the verilog object's value
+              before the condition is evaluated (integer objects only)
+            * **count** (int): Number of times the condition has to be met
+              before the callback is executed (default 1)
 
             If `cb` is ``"to_next"``, no further keyword argument is required.
+
+            If `cb` is ``"sample"``, the following keyword arguments are
+            further expected:
+
+            * **period** (float): Sampling period
+            * **time_unit** (str): Time unit for the sampling period
+            * **count** (int): Number of samples
+            * **path** (str, list): Path or list of paths to the verilog
+              objects to be sampled
+
+            In this case, the returned message contains the full time series
+            with the keys :code:`"time"` (list of sampling times, in seconds)
+            and :code:`"value"` (dictionary with one list of sampled values per
+            path).
+
+            If `cb` is ``"until_expr"``, the following keyword argument is
+            further expected:
+
+            * **expr** (str): Trigger expression, e.g.
+              :code:`"rise(main.clk) && main.count == 5"`. See the
+              :keyword:`run <sec_tcp_cmd_run>` command description for the
+              supported operators.
+
+            The following optional keyword arguments can also be used with
+            ``"until_expr"``:
+
+            * **time** (float): Deadline, as a time difference
+            * **time_unit** (str): Time unit for the deadline
+
+            In this case, the returned message contains the key
+            :code:`"triggered"`, which is :code:`False` if the simulation
+            stopped before the expression was met.
         """
 
         return self.send(command="run", cb=cb, **kwargs)
@@ -522,6 +586,9 @@ Still {self._rx_expected} messages expected.")
                 verilog named event, this argument is not required. If the path
                 corresponds to a verilog memory array, this argument needs to
                 be provided as a list of the same length.
+            values (list): With an ensemble of model instances (Verilator
+                integration only), list of values with one value per instance,
+                to be used instead of `value`.
             timeout (float): Socket timeout configuration value in seconds.
                 If None (default), the class instance default value is used.
 
@@ -530,6 +597,34 @@ Still {self._rx_expected} messages expected.")
         """
         return self.send(command="set", path=path, **kwargs)
 
+    def schedule(self, events, time_unit, **kwargs):
+        """Sends a :keyword:`schedule <sec_tcp_cmd_schedule>` command request
+        to the Verisocks server (only with VPI).
+
+        Equivalent to :code:`send_cmd("schedule", events=events,
+        time_unit=time_unit, **kwargs)`. This command hands over a complete
+        list of stimulus events to the simulator at once. The events are
+        sorted by the server and applied by the simulator itself while it
+        runs, e.g. with a subsequent :code:`run(cb="until_time", ...)`.
+
+        Args:
+            events (list): List of :code:`(time, path, value)` events. The
+                times are absolute simulation times and cannot be earlier than
+                the current simulation time. Events with the same time are
+                applied in the list order.
+            time_unit (str): Time unit used for the events times (``"s"``,
+                ``"ms"``, ``"us"``, ``"ns"``, ``"ps"`` or ``"fs"``).
+
+        Keyword Arguments:
+            timeout (float): Socket timeout configuration value in seconds.
+                If None (default), the class instance default value is used.
+
+        Returns:
+            JSON object: Content of returned message
+        """
+        return self.send(command="schedule", events=[list(e) for e in events],
+                         time_unit=time_unit, **kwargs)
+
     def enable_clock(self, path):
         """Enable a clock signal (only with Verilator)
 
@@ -580,6 +675,321 @@ Still {self._rx_expected} messages expected.")
         return self.send(command="set", sel="clk_cfg",
                          path=path, period=period, unit=unit, dc=duty_cycle)
 
+    def configure_sampler(self, path, vars, capacity, edge="rising"):
+        """Configure the clock edge sampler (only with Verilator)
+
+        This function sends the command :keyword:`set <sec_tcp_cmd_set>` with
+        ``sel="sampler"`` argument. On each selected edge of the clock, the
+        values of the variables are stored by the simulation, up to
+        `capacity` samples, until they are read with :py:meth:`get_samples`.
+
+        Args:
+            path (str): Path to the clock signal
+            vars (list): Paths to the registered variables to be sampled
+            capacity (int): Maximum number of samples stored between two calls
+                to :py:meth:`get_samples`. A capacity of 0 disarms the sampler.
+            edge (str): Clock edge, ``"rising"`` (default) or ``"falling"``
+
+        Returns:
+            JSON object: Content of the returned message
+        """
+        if capacity == 0:
+            self._sampler_columns = []
+            return self.send(command="set", sel="sampler", capacity=0)
+        answer = self.send(command="set", sel="sampler", path=path,
+                           vars=list(vars), capacity=capacity, edge=edge)
+        self._sampler_columns = answer["columns"]
+        return answer
+
+    def get_samples(self):
+        """Get the values stored by the clock edge sampler (only with
+        Verilator)
+
+        This function sends the command :keyword:`get <sec_tcp_cmd_get>` with
+        ``sel="samples"`` argument and decodes the returned binary columns.
+        The sampler buffers are reset.
+
+        Returns:
+            dict: Dictionary with the keys ``"count"`` (number of samples),
+            ``"dropped"`` (number of edges not sampled as the buffers were
+            full) and ``"value"`` (dictionary with one list of sampled values
+            per variable path).
+        """
+        data = self.send(command="get", sel="samples")
+        count, dropped = struct.unpack_from("<QQ", data, 0)
+        values = self._decode_columns(self._sampler_columns, data, 16, count)
+        return {"count": count, "dropped": dropped, "value": values}
+
+    def configure_recorder(self, path, vars, depth, post=0, expr=None,
+                           edge="rising"):
+        """Configure the flight recorder (only with Verilator)
+
+        This function sends the command :keyword:`set <sec_tcp_cmd_set>` with
+        ``sel="recorder"`` argument. On each selected edge of the clock, the
+        values of the variables are stored by the simulation in a circular
+        buffer holding the last `depth` samples. Once triggered, either when
+        the trigger expression becomes true or with
+        :py:meth:`trigger_recorder`, `post` more samples are recorded and the
+        buffer is frozen, until it is read with :py:meth:`get_recorder`.
+
+        Args:
+            path (str): Path to the clock signal
+            vars (list): Paths to the registered variables to be recorded
+            depth (int): Number of samples kept. A depth of 0 disarms the
+                recorder.
+            post (int): Number of samples recorded after the trigger, lower
+                than `depth` (default: 0)
+            expr (str): Trigger expression, with the same syntax as for the
+                :keyword:`run <sec_tcp_cmd_run>` command with
+                ``cb="until_expr"`` (default: none, manual trigger only)
+            edge (str): Clock edge, ``"rising"`` (default) or ``"falling"``
+
+        Returns:
+            JSON object: Content of the returned message
+        """
+        if depth == 0:
+            self._recorder_columns = []
+            return self.send(command="set", sel="recorder", depth=0)
+        kwargs = {}
+        if expr:
+            kwargs["expr"] = expr
+        answer = self.send(command="set", sel="recorder", path=path,
+                           vars=list(vars), depth=depth, post=post,
+                           edge=edge, **kwargs)
+        self._recorder_columns = answer["columns"]
+        return answer
+
+    def trigger_recorder(self):
+        """Trigger the flight recorder manually (only with Verilator)
+
+        This function sends the command :keyword:`set <sec_tcp_cmd_set>` with
+        ``sel="recorder_trigger"`` argument. The trigger is taken on the next
+        recorded clock edge.
+
+        Returns:
+            JSON object: Content of the returned message
+        """
+        return self.send(command="set", sel="recorder_trigger")
+
+    def get_recorder(self):
+        """Get the window stored by the flight recorder (only with Verilator)
+
+        This function sends the command :keyword:`get <sec_tcp_cmd_get>` with
+        ``sel="recorder"`` argument and decodes the returned binary columns,
+        from the oldest to the newest sample. The recorder buffers are kept.
+
+        Returns:
+            dict: Dictionary with the keys ``"count"`` (number of samples),
+            ``"trigger"`` (index of the trigger sample, or -1 if not
+            triggered), ``"frozen"`` (True once the post-trigger samples have
+            been recorded) and ``"value"`` (dictionary with one list of
+            recorded values per variable path).
+        """
+        data = self.send(command="get", sel="recorder")
+        count, trigger, frozen = struct.unpack_from("<QqQ", data, 0)
+        values = self._decode_columns(self._recorder_columns, data, 24, count)
+        return {"count": count, "trigger": trigger, "frozen": bool(frozen),
+                "value": values}
+
+    @staticmethod
+    def _decode_columns(columns, data, offset, count):
+        values = {}
+        for column in columns:
+            size = column["size"]
+            if column["dtype"] == "real":
+                values[column["path"]] = list(
+                    struct.unpack_from(f"<{count}d", data, offset))
+            else:
+                values[column["path"]] = [
+                    int.from_bytes(data[i:i + size], "little")
+                    for i in range(offset, offset + count*size, size)]
+            offset += count*size
+        return values
+
+    def trace_start(self, path, format=None, depth=None):
+        """Start a trace window (only with Verilator)
+
+        This function sends the command :keyword:`trace <sec_tcp_cmd_trace>`
+        with ``sel="start"`` argument. The model signals are dumped to the
+        trace file until the trace window is stopped. The model needs to be
+        verilated with tracing enabled.
+
+        Args:
+            path (str): Path to the trace file
+            format (str): Trace format, ``"vcd"`` or ``"fst"`` (default:
+                format enabled when verilating the model)
+            depth (int): Hierarchy depth to be traced (default: all levels)
+
+        Returns:
+            JSON object: Content of the returned message
+        """
+        kwargs = {}
+        if format:
+            kwargs["format"] = format
+        if depth:
+            kwargs["depth"] = depth
+        return self.send(command="trace", sel="start", path=path, **kwargs)
+
+    def trace_stop(self):
+        """Stop the current trace window (only with Verilator)
+
+        This function sends the command :keyword:`trace <sec_tcp_cmd_trace>`
+        with ``sel="stop"`` argument. The trace file is closed.
+
+        Returns:
+            JSON object: Content of the returned message
+        """
+        return self.send(command="trace", sel="stop")
+
+    def trace_flush(self):
+        """Flush the trace file of the current trace window (only with
+        Verilator)
+
+        This function sends the command :keyword:`trace <sec_tcp_cmd_trace>`
+        with ``sel="flush"`` argument.
+
+        Returns:
+            JSON object: Content of the returned message
+        """
+        return self.send(command="trace", sel="flush")
+
+    def checkpoint(self, path=None, name=None):
+        """Sends a :keyword:`checkpoint <sec_tcp_cmd_checkpoint>` command to
+        the Verisocks server (only with Verilator).
+
+        Saves the simulation state, either to a file or to an in-memory
+        checkpoint, so that it can later be restored with :py:meth:`restore`.
+        The model needs to be verilated with the ``--savable`` option.
+
+        Args:
+            path (str): Path to the checkpoint file
+            name (str): Name of the in-memory checkpoint, to be used instead
+                of a file path
+
+        Returns:
+            JSON object: Content of the returned message
+        """
+        return self.send(command="checkpoint",
+                         **self._checkpoint_target(path, name))
+
+    def restore(self, path=None, name=None):
+        """Sends a :keyword:`restore <sec_tcp_cmd_restore>` command to the
+        Verisocks server (only with Verilator).
+
+        Restores a simulation state saved with :py:meth:`checkpoint`.
+
+        Args:
+            path (str): Path to the checkpoint file
+            name (str): Name of the in-memory checkpoint, to be used instead
+                of a file path
+
+        Returns:
+            JSON object: Content of the returned message
+        """
+        return self.send(command="restore",
+                         **self._checkpoint_target(path, name))
+
+    def fork(self, port=None):
+        """Sends a :keyword:`fork <sec_tcp_cmd_fork>` command to the Verisocks
+        server (only with Verilator).
+
+        Forks the simulation process at the current simulation time. The
+        forked simulation is controlled through its own server socket, e.g.
+        with another :py:class:`Verisocks` instance, while the current
+        simulation keeps being controlled by this instance.
+
+        Args:
+            port (int): Port number for the forked simulation server socket.
+                If None, a free port number is chosen.
+
+        Returns:
+            JSON object: Content of the returned message, including the fork
+            process ID (``pid``) and port number (``port``)
+        """
+        if port is None:
+            return self.send(command="fork")
+        return self.send(command="fork", port=port)
+
+    def restart(self):
+        """Sends a :keyword:`restart <sec_tcp_cmd_restart>` command to the
+        Verisocks server (only with Verilator).
+
+        Restarts the simulation from time 0 within the same simulation
+        process, e.g. in order to run several tests back-to-back without
+        launching a new simulation for each of them. The connection is kept.
+
+        Returns:
+            JSON object: Content of the returned message
+        """
+        return self.send(command="restart")
+
+    def play(self, path, clock=None, edge="rising", period=None,
+             time_unit=None, expr=None, timeout=None):
+        """Sends a :keyword:`play <sec_tcp_cmd_play>` command to the Verisocks
+        server (only with Verilator).
+
+        The rows of a vector file, e.g. as written with
+        :py:meth:`verisocks.utils.write_vectors`, are applied to the registered
+        variables by the simulation, either on each edge of a clock or with a
+        fixed time step, until the file is exhausted or the optional trigger
+        expression is met. Either `clock` or `period` shall be provided.
+
+        Args:
+            path (str): Path to the vector file, as seen by the simulation
+            clock (str): Path to the clock signal
+            edge (str): Clock edge, ``"rising"`` (default) or ``"falling"``
+            period (float): Time step
+            time_unit (str): Time unit for the time step
+            expr (str): Trigger expression, with the same syntax as for
+                :py:meth:`run` with ``cb="until_expr"`` (default: none)
+            timeout (float): Socket timeout, in seconds (default: class
+                instance default value)
+
+        Returns:
+            JSON object: Content of the returned message, with the number of
+            applied rows (``"rows"``) and whether the expression has been met
+            (``"triggered"``)
+        """
+        if (clock is None) == (period is None):
+            raise ValueError("Either clock or period shall be provided")
+        kwargs = {}
+        if clock is not None:
+            kwargs.update(clock=clock, edge=edge)
+        else:
+            kwargs.update(period=period, time_unit=time_unit)
+        if expr:
+            kwargs["expr"] = expr
+        return self.send(command="play", path=path, timeout=timeout, **kwargs)
+
+    def plugin(self, name, command, timeout=None, **kwargs):
+        """Sends a :keyword:`plugin command <sec_tcp_cmd_plugin>` to the
+        Verisocks server (only with Verilator).
+
+        The command is named ``"<name>.<command>"`` (e.g. ``"spi.write"``) and
+        is processed by the plugin registered with this name in the
+        simulation. If the plugin starts a transaction, the simulation runs
+        until it is done before returning.
+
+        Args:
+            name (str): Plugin name (e.g. ``"spi"``)
+            command (str): Plugin command (e.g. ``"write"``)
+            timeout (float): Socket timeout, in seconds (default: class
+                instance default value)
+            **kwargs: Plugin command arguments (e.g. ``data=[1, 2]``)
+
+        Returns:
+            JSON object: Content of the returned message, including the
+            plugin command results
+        """
+        return self.send(command=f"{name}.{command}", timeout=timeout,
+                         **kwargs)
+
+    @staticmethod
+    def _checkpoint_target(path, name):
+        if (path is None) == (name is None):
+            raise ValueError("Either path or name shall be provided")
+        return {"path": path} if path is not None else {"name": name}
+
     def info(self, value):
         """Sends an :keyword:`info <sec_tcp_cmd_info>` command to the Verisocks
         server.
@@ -597,7 +1007,7 @@ Still {self._rx_expected} messages expected.")
         """
         return self.send(command="info", value=value)
 
-    def get(self, sel, path=None):
+    def get(self, sel, path=None, pattern=None, format=None):
         """Sends a :keyword:`get <sec_tcp_cmd_get>` command request to the
         Verisocks server.
 
@@ -607,9 +1017,16 @@ Still {self._rx_expected} messages expected.")
 
         Args:
             sel (str): Selects which is the returned information.
-            path (str): If `sel` is ``"value"`` or ``"type"``, path to the
-                desired verilog object for which the value or type is to be
-                returned.
+            path (str or list): If `sel` is ``"value"`` or ``"type"``, path to
+                the desired verilog object for which the value or type is to
+                be returned. If `sel` is ``"value"``, a glob pattern or a list
+                of paths and/or glob patterns can also be used, in which case
+                the values are returned as a dictionary indexed by path.
+            pattern (str): If `sel` is ``"list"``, glob pattern selecting the
+                returned object paths (all objects if omitted).
+            format (str): If `sel` is ``"value"``, ``"hex"`` returns integer
+                values as exact hexadecimal strings instead of numbers
+                (Verilator integration only, default ``"number"``).
 
         Note:
             The argument `sel` can take the following values:
@@ -621,13 +1038,29 @@ Still {self._rx_expected} messages expected.")
               with the keywords :code:`"time"`, in seconds.
             * ``"value"``: Gets the value for a verilog object.
             * ``"type"``: Gets the VPI type value for a verilog object.
+            * ``"list"``: Gets the list of object paths matching a glob
+              pattern, e.g. ``"tb.dut.*.state"``. Within a path segment,
+              ``*`` matches any sequence of characters and ``?`` any single
+              character, while a ``**`` segment matches any number of
+              hierarchy levels.
+            * ``"samples"``: Gets the values stored by the clock edge sampler
+              as binary data (Verilator integration only, see
+              :py:meth:`get_samples`).
+            * ``"recorder"``: Gets the window stored by the flight recorder
+              as binary data (Verilator integration only, see
+              :py:meth:`get_recorder`).
 
         Returns:
             JSON object: Content of returned message
         """
+        kwargs = {}
         if path:
-            return self.send(command="get", sel=sel, path=path)
-        return self.send(command="get", sel=sel)
+            kwargs["path"] = path
+        if pattern:
+            kwargs["pattern"] = pattern
+        if format:
+            kwargs["format"] = format
+        return self.send(command="get", sel=sel, **kwargs)
 
     def finish(self, timeout=None):
         """Sends a :keyword:`finish <sec_tcp_cmd_finish>` command to the
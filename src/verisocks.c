@@ -40,7 +40,6 @@ SOFTWARE.
 #include "vs_msg.h"
 #include "vs_vpi.h"
 
-#define READ_BUFFER_SIZE 4096
 
 /* Prototypes for some static functions */
 static PLI_INT32 verisocks_main(vs_vpi_data_t *p_vpi_data);
@@ -197,9 +196,6 @@ PLI_INT32 verisocks_init_calltf(PLI_BYTE8 *user_data)
     }
 
     /* Initialize instance-specific user data */
-    s_vpi_value default_value;
-    default_value.format = vpiIntVal;
-    default_value.value.integer = 0;
     p_vpi_data->state = VS_VPI_STATE_START;
     p_vpi_data->h_systf = h_systf;
     p_vpi_data->timeout_sec = (int) num_timeout_sec;
@@ -207,9 +203,14 @@ PLI_INT32 verisocks_init_calltf(PLI_BYTE8 *user_data)
     p_vpi_data->fd_client_socket = -1;
     p_vpi_data->p_cmd = NULL;
     p_vpi_data->h_cb = 0;
-    p_vpi_data->value = default_value;
+    memset(&p_vpi_data->trigger, 0, sizeof(vs_vpi_trigger_t));
     p_vpi_data->uuid.valid = 0u;
     memcpy(&p_vpi_data->uuid.value, null_uuid_value, VS_UUID_LEN);
+    p_vpi_data->p_sampler = NULL;
+    p_vpi_data->p_index = NULL;
+    p_vpi_data->p_watches = NULL;
+    p_vpi_data->num_watches = 0;
+    p_vpi_data->p_io = NULL;
     vpi_put_userdata(h_systf, (void*) p_vpi_data);
 
     /* Create and bind server socket */
@@ -282,45 +283,26 @@ PLI_INT32 verisocks_init_calltf(PLI_BYTE8 *user_data)
 }
 
 /**
- * @brief Callback function - Used for for_time and until_time
+ * @brief Gives control back to the Verisocks main loop after a callback, if
+ * requested, or aborts the simulation in case of error
  *
- * @param cb_data Pointer to s_cb_data struct
+ * @param p_vpi_data Pointer to VPI instance-specific data (can be NULL)
+ * @param retval Value returned by the callback processing function
  * @return Returns 0 if successful, -1 in case of error
  */
-PLI_INT32 verisocks_cb(p_cb_data cb_data)
+static PLI_INT32 verisocks_cb_resume(vs_vpi_data_t *p_vpi_data, int retval)
 {
-    /* Retrieve stored user data */
-    vs_vpi_data_t *p_vpi_data = NULL;
-    p_vpi_data = (vs_vpi_data_t*) cb_data->user_data;
-    if (NULL == p_vpi_data) {
-        vs_vpi_log_error("Could not get stored data - Aborting callback");
-        goto error;
-    }
-
-    /* Check state */
-    if (p_vpi_data->state != VS_VPI_STATE_SIM_RUNNING) {
-        vs_vpi_log_error("Inconsistent state");
-        goto error;
+    if (0 == retval) {
+        return 0;
     }
 
-    /* Signalling that the callback function has been reached */
-    vs_vpi_log_info("Reached callback - Verisocks taking over and waiting \
-for command ...");
-    vs_vpi_return(p_vpi_data->fd_client_socket, "ack",
-        "Reached callback - Getting back to Verisocks main loop",
-        &(p_vpi_data->uuid)
-    );
-
     /* Call verisocks main loop */
-    p_vpi_data->state = VS_VPI_STATE_WAITING;
-    if (0 > verisocks_main(p_vpi_data)) {
-        goto error;
+    if ((0 < retval) && (0 <= verisocks_main(p_vpi_data))) {
+        vs_vpi_log_info("Returning control to simulator");
+        return 0;
     }
-    vs_vpi_log_info("Returning control to simulator");
-    return 0;
 
     /* Error management */
-    error:
     if (NULL != p_vpi_data) {
         p_vpi_data->state = VS_VPI_STATE_ERROR;
         if (0 <= p_vpi_data->fd_server_socket) {
@@ -334,68 +316,51 @@ for command ...");
     return -1;
 }
 
+/**
+ * @brief Callback function - Used for for_time and until_time
+ *
+ * @param cb_data Pointer to s_cb_data struct
+ * @return Returns 0 if successful, -1 in case of error
+ */
+PLI_INT32 verisocks_cb(p_cb_data cb_data)
+{
+    vs_vpi_data_t *p_vpi_data = (vs_vpi_data_t*) cb_data->user_data;
+    return verisocks_cb_resume(p_vpi_data, vs_vpi_cb_process(p_vpi_data));
+}
+
 /**
  * @brief Callback function - Used for for_until_change
  *
+ * The callback stays registered between successive run(until_change) commands
+ * on the same object (see vs_vpi_watch_get) and returns immediately while its
+ * watch is not armed.
+ *
  * @param cb_data Pointer to s_cb_data struct
  * @return Returns 0 if successful, -1 in case of error
  */
 PLI_INT32 verisocks_cb_value_change(p_cb_data cb_data)
 {
-    /* Retrieve stored user data */
-    vs_vpi_data_t *p_vpi_data = NULL;
-    p_vpi_data = (vs_vpi_data_t*) cb_data->user_data;
-    if (NULL == p_vpi_data) {
-        vs_vpi_log_error("Could not get stored data - Aborting callback");
-        goto error;
-    }
-
-    /* Check state */
-    if (p_vpi_data->state != VS_VPI_STATE_SIM_RUNNING) {
-        vs_vpi_log_error("Inconsistent state - Aborting callback");
-        goto error;
-    }
-
-    /* If the value is not the same, get back to sim until next time */
-    if (vpi_get(vpiType, cb_data->obj) != vpiNamedEvent) {
-        if (vs_utils_compare_values(
-            p_vpi_data->value, *(cb_data->value)) != 0) {
-            return 0;
-        }
-    }
-
-    /* Remove callback */
-    vpi_remove_cb(p_vpi_data->h_cb);
-
-    /* Signalling that the callback function has been reached */
-    vs_vpi_log_info("Reached callback - Verisocks taking over and waiting \
-for command ...");
-    vs_vpi_return(p_vpi_data->fd_client_socket, "ack",
-        "Reached callback - Getting back to Verisocks main loop",
-        &(p_vpi_data->uuid)
-    );
-
-    /* Call verisocks main loop */
-    p_vpi_data->state = VS_VPI_STATE_WAITING;
-    if (0 > verisocks_main(p_vpi_data)) {
-        goto error;
-    }
-    vs_vpi_log_info("Returning control to simulator");
-    return 0;
+    vs_vpi_watch_t *p_watch = (vs_vpi_watch_t*) cb_data->user_data;
+    return verisocks_cb_resume(
+        (NULL != p_watch) ? p_watch->p_data : NULL,
+        vs_vpi_cb_value_change_process(p_watch));
+}
 
-    /* Error management */
-    error:
-    if (NULL != p_vpi_data) {
-        p_vpi_data->state = VS_VPI_STATE_ERROR;
-        if (0 <= p_vpi_data->fd_server_socket) {
-            close(p_vpi_data->fd_server_socket);
-            p_vpi_data->fd_server_socket = -1;
-        }
-        //free(p_vpi_data);  //Will be freed in exit callback handler
-    }
-    vs_vpi_log_info("Aborting simulation");
-    vpi_control(vpiFinish, 1);
-    return -1;
+/**
+ * @brief Callback function - Used for sample
+ *
+ * Takes a sample and re-registers itself until the requested number of samples
+ * has been reached. The full time series is then returned to the client at
+ * once.
+ *
+ * @param cb_data Pointer to s_cb_data struct
+ * @return Returns 0 if successful, -1 in case of error
+ */
+PLI_INT32 verisocks_cb_sample(p_cb_data cb_data)
+{
+    vs_vpi_data_t *p_vpi_data = (vs_vpi_data_t*) cb_data->user_data;
+    return verisocks_cb_resume(p_vpi_data,
+        vs_vpi_cb_sample_process(p_vpi_data));
 }
 
 PLI_INT32 verisocks_cb_exit(p_cb_data cb_data)
@@ -419,7 +384,9 @@ PLI_INT32 verisocks_cb_exit(p_cb_data cb_data)
         );
     }
 
-    /* Clean-up and exit */
+    /* Clean-up and exit (stopping the I/O thread sends the pending messages) */
+    vs_io_stop(p_vpi_data->p_io);
+    p_vpi_data->p_io = NULL;
     if (0 <= p_vpi_data->fd_server_socket) {
         close(p_vpi_data->fd_server_socket);
         p_vpi_data->fd_server_socket = -1;
@@ -429,6 +396,15 @@ PLI_INT32 verisocks_cb_exit(p_cb_data cb_data)
         p_vpi_data->p_cmd = NULL;
         //free(p_vpi_data);  //Will be freed in exit callback handler
     }
+    if (NULL != p_vpi_data->p_sampler) {
+        vs_vpi_sampler_free(p_vpi_data->p_sampler);
+        p_vpi_data->p_sampler = NULL;
+    }
+    if (NULL != p_vpi_data->p_index) {
+        vs_index_free(p_vpi_data->p_index);
+        p_vpi_data->p_index = NULL;
+    }
+    vs_vpi_watch_free_all(p_vpi_data);
     return 0;
 }
 
@@ -476,6 +452,8 @@ static PLI_INT32 verisocks_main(vs_vpi_data_t *p_vpi_data)
             to VS_VPI_STATE_WAITING.*/
             return 0;
         case VS_VPI_STATE_EXIT:
+            vs_io_stop(p_vpi_data->p_io);
+            p_vpi_data->p_io = NULL;
             if (0 <= p_vpi_data->fd_server_socket) {
                 close(p_vpi_data->fd_server_socket);
                 p_vpi_data->fd_server_socket = -1;
@@ -489,6 +467,8 @@ static PLI_INT32 verisocks_main(vs_vpi_data_t *p_vpi_data)
         case VS_VPI_STATE_ERROR:
         default:
             vs_vpi_log_error("Exiting main loop (error state)");
+            vs_io_stop(p_vpi_data->p_io);
+            p_vpi_data->p_io = NULL;
             if (0 <= p_vpi_data->fd_server_socket) {
                 close(p_vpi_data->fd_server_socket);
                 p_vpi_data->fd_server_socket = -1;
@@ -528,6 +508,15 @@ static PLI_INT32 verisocks_main_connect(vs_vpi_data_t *p_vpi_data)
         return -1;
     }
     vs_vpi_log_info("Connected to %s", hostname_buffer);
+
+    /* Socket reads, message framing and JSON parsing are done by a background
+    thread so that the next command is already parsed when needed */
+    p_vpi_data->p_io = vs_io_start(p_vpi_data->fd_client_socket);
+    if (NULL == p_vpi_data->p_io) {
+        vs_vpi_log_error("Failed to start socket I/O thread");
+        p_vpi_data->state = VS_VPI_STATE_ERROR;
+        return -1;
+    }
     p_vpi_data->state = VS_VPI_STATE_WAITING;
     return 0;
 }
@@ -540,16 +529,18 @@ static PLI_INT32 verisocks_main_connect(vs_vpi_data_t *p_vpi_data)
  */
 static PLI_INT32 verisocks_main_waiting(vs_vpi_data_t *p_vpi_data)
 {
-    char read_buffer[READ_BUFFER_SIZE];
-    int msg_len;
-    vs_msg_info_t msg_info = VS_MSG_INFO_INIT_UNDEF;
+    vs_io_msg_t msg;
 
-    msg_len = vs_msg_read(p_vpi_data->fd_client_socket,
-                          read_buffer,
-                          sizeof(read_buffer),
-                          &msg_info);
+    /* Get the next command, as already received and parsed by the I/O
+    thread */
+    if (0 > vs_io_read(p_vpi_data->p_io, &msg)) {
+        p_vpi_data->state = VS_VPI_STATE_ERROR;
+        return -1;
+    }
 
-    if (0 > msg_len) {
+    if (VS_IO_MSG_CLOSED == msg.type) {
+        vs_io_stop(p_vpi_data->p_io);
+        p_vpi_data->p_io = NULL;
         close(p_vpi_data->fd_client_socket);
         vs_vpi_log_debug(
             "Lost connection. Waiting for a client to (re-)connect ..."
@@ -559,30 +550,15 @@ static PLI_INT32 verisocks_main_waiting(vs_vpi_data_t *p_vpi_data)
     }
 
     /* Update VPI data with transaction UUID if present */
-    p_vpi_data->uuid.valid = msg_info.uuid.valid;
-    if (msg_info.uuid.valid > 0) {
+    p_vpi_data->uuid.valid = msg.uuid.valid;
+    if (msg.uuid.valid > 0) {
         vs_vpi_log_debug("Valid UUID present in header");
-        memcpy(p_vpi_data->uuid.value, msg_info.uuid.value, VS_UUID_LEN);
+        memcpy(p_vpi_data->uuid.value, msg.uuid.value, VS_UUID_LEN);
     }
 
-    if (msg_len >= (int) sizeof(read_buffer)) {
-        read_buffer[sizeof(read_buffer) - 1] = '\0';
-        vs_vpi_log_warning(
-            "Received message longer than RX buffer, discarding it"
-        );
-        vs_vpi_return(p_vpi_data->fd_client_socket, "error",
-            "Message too long - Discarding",
-            &(p_vpi_data->uuid)
-        );
-        return -1;
-    }
-    else {
-        read_buffer[msg_len] = '\0';
-    }
-    vs_vpi_log_debug("Message: %s", &read_buffer[2]);
     if (NULL != p_vpi_data->p_cmd) cJSON_Delete(p_vpi_data->p_cmd);
-    p_vpi_data->p_cmd = vs_msg_read_json(read_buffer, &msg_info);
-    if (NULL != p_vpi_data->p_cmd) {
+    p_vpi_data->p_cmd = msg.p_cmd;
+    if (VS_IO_MSG_CMD == msg.type) {
         p_vpi_data->state = VS_VPI_STATE_PROCESSING;
         return 0;
     }
@@ -0,0 +1,508 @@
+/**************************************************************************//**
+@file vs_index.c
+@author jchabloz
+@brief Verisocks hierarchy index
+@date 2026-10-18
+******************************************************************************/
+/*
+MIT License
+
+Copyright (c) 2022-2025 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "vs_logging.h"
+#include "vs_index.h"
+
+#define VS_INDEX_INIT_CAPACITY 64u
+
+/**
+ * @brief Trie node
+ *
+ * Children of a node are chained through the next_sibling field, in
+ * insertion order. Node 0 is the (unnamed) root node.
+ */
+typedef struct vs_index_node {
+    const char *name;       ///Interned segment name
+    int32_t parent;         ///Index of parent node, -1 for root
+    int32_t first_child;    ///Index of first child node, -1 if none
+    int32_t last_child;     ///Index of last child node, -1 if none
+    int32_t next_sibling;   ///Index of next sibling node, -1 if none
+    int type;               ///Object type, VS_INDEX_SCOPE for scopes
+    uint32_t mark;          ///Query epoch, used to report objects only once
+} vs_index_node_t;
+
+struct vs_index {
+    vs_index_node_t *p_nodes;   ///Nodes array
+    size_t num_nodes;           ///Number of nodes in use
+    size_t cap_nodes;           ///Allocated number of nodes
+    size_t num_objects;         ///Number of nodes with a type >= 0
+    char **p_names;             ///Interned names hash set
+    size_t num_names;           ///Number of interned names
+    size_t cap_names;           ///Interned names hash set capacity
+    int32_t *p_edges;           ///(parent, name) -> child node hash table
+    size_t cap_edges;           ///Edges hash table capacity
+    uint32_t epoch;             ///Current query epoch
+    char *str_buf;              ///Path reconstruction buffer
+    size_t buf_size;            ///Path reconstruction buffer size
+};
+
+/* FNV-1a hash of the first len characters of a string */
+static size_t hash_str(const char *str, size_t len)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (unsigned char) str[i];
+        hash *= 1099511628211ull;
+    }
+    return (size_t) hash;
+}
+
+static size_t hash_edge(int32_t parent, const char *name)
+{
+    uint64_t hash = (uint64_t) (uintptr_t) name;
+    hash ^= (uint64_t) (uint32_t) parent * 0x9e3779b97f4a7c15ull;
+    hash ^= hash >> 29;
+    return (size_t) hash;
+}
+
+/* Find a name in the interned names set, returns NULL if not found */
+static const char* find_name(const vs_index_t *p_index, const char *str,
+    size_t len)
+{
+    size_t mask = p_index->cap_names - 1;
+    size_t i = hash_str(str, len) & mask;
+    while (NULL != p_index->p_names[i]) {
+        if ((strncmp(p_index->p_names[i], str, len) == 0) &&
+            (p_index->p_names[i][len] == '\0')) {
+            return p_index->p_names[i];
+        }
+        i = (i + 1) & mask;
+    }
+    return NULL;
+}
+
+static int grow_names(vs_index_t *p_index)
+{
+    size_t cap = p_index->cap_names * 2;
+    char **p_names = (char**) calloc(cap, sizeof(char*));
+    if (NULL == p_names) {
+        vs_log_mod_error("vs_index", "Could not allocate memory");
+        return -1;
+    }
+    for (size_t i = 0; i < p_index->cap_names; i++) {
+        char *name = p_index->p_names[i];
+        if (NULL == name) continue;
+        size_t j = hash_str(name, strlen(name)) & (cap - 1);
+        while (NULL != p_names[j]) j = (j + 1) & (cap - 1);
+        p_names[j] = name;
+    }
+    free(p_index->p_names);
+    p_index->p_names = p_names;
+    p_index->cap_names = cap;
+    return 0;
+}
+
+/* Intern a name, returns the interned copy or NULL in case of error */
+static const char* intern_name(vs_index_t *p_index, const char *str,
+    size_t len)
+{
+    const char *name = find_name(p_index, str, len);
+    if (NULL != name) return name;
+
+    if (4 * (p_index->num_names + 1) > 3 * p_index->cap_names) {
+        if (0 > grow_names(p_index)) return NULL;
+    }
+    char *new_name = (char*) malloc(len + 1);
+    if (NULL == new_name) {
+        vs_log_mod_error("vs_index", "Could not allocate memory");
+        return NULL;
+    }
+    memcpy(new_name, str, len);
+    new_name[len] = '\0';
+
+    size_t mask = p_index->cap_names - 1;
+    size_t i = hash_str(new_name, len) & mask;
+    while (NULL != p_index->p_names[i]) i = (i + 1) & mask;
+    p_index->p_names[i] = new_name;
+    p_index->num_names++;
+    return new_name;
+}
+
+/* Find the child of a node with a given interned name, -1 if not found */
+static int32_t find_child(const vs_index_t *p_index, int32_t parent,
+    const char *name)
+{
+    size_t mask = p_index->cap_edges - 1;
+    size_t i = hash_edge(parent, name) & mask;
+    int32_t node;
+    while (0 <= (node = p_index->p_edges[i])) {
+        if ((p_index->p_nodes[node].parent == parent) &&
+            (p_index->p_nodes[node].name == name)) {
+            return node;
+        }
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+static void insert_edge(vs_index_t *p_index, int32_t node)
+{
+    size_t mask = p_index->cap_edges - 1;
+    size_t i = hash_edge(p_index->p_nodes[node].parent,
+        p_index->p_nodes[node].name) & mask;
+    while (0 <= p_index->p_edges[i]) i = (i + 1) & mask;
+    p_index->p_edges[i] = node;
+}
+
+static int grow_edges(vs_index_t *p_index)
+{
+    size_t cap = p_index->cap_edges * 2;
+    int32_t *p_edges = (int32_t*) malloc(cap * sizeof(int32_t));
+    if (NULL == p_edges) {
+        vs_log_mod_error("vs_index", "Could not allocate memory");
+        return -1;
+    }
+    for (size_t i = 0; i < cap; i++) p_edges[i] = -1;
+    free(p_index->p_edges);
+    p_index->p_edges = p_edges;
+    p_index->cap_edges = cap;
+    /* Node 0 (root) is not a child and has no edge */
+    for (size_t node = 1; node < p_index->num_nodes; node++) {
+        insert_edge(p_index, (int32_t) node);
+    }
+    return 0;
+}
+
+/* Append a new child node, returns its index or -1 in case of error */
+static int32_t add_child(vs_index_t *p_index, int32_t parent,
+    const char *name)
+{
+    if (p_index->num_nodes >= p_index->cap_nodes) {
+        size_t cap = p_index->cap_nodes * 2;
+        vs_index_node_t *p_nodes = (vs_index_node_t*) realloc(
+            p_index->p_nodes, cap * sizeof(vs_index_node_t));
+        if (NULL == p_nodes) {
+            vs_log_mod_error("vs_index", "Could not allocate memory");
+            return -1;
+        }
+        p_index->p_nodes = p_nodes;
+        p_index->cap_nodes = cap;
+    }
+    if (4 * (p_index->num_nodes + 1) > 3 * p_index->cap_edges) {
+        if (0 > grow_edges(p_index)) return -1;
+    }
+
+    int32_t node = (int32_t) p_index->num_nodes++;
+    vs_index_node_t *p_node = &p_index->p_nodes[node];
+    p_node->name = name;
+    p_node->parent = parent;
+    p_node->first_child = -1;
+    p_node->last_child = -1;
+    p_node->next_sibling = -1;
+    p_node->type = VS_INDEX_SCOPE;
+    p_node->mark = 0u;
+
+    vs_index_node_t *p_parent = &p_index->p_nodes[parent];
+    if (0 > p_parent->last_child) {
+        p_parent->first_child = node;
+    } else {
+        p_index->p_nodes[p_parent->last_child].next_sibling = node;
+    }
+    p_parent->last_child = node;
+    insert_edge(p_index, node);
+    return node;
+}
+
+vs_index_t* vs_index_create(void)
+{
+    vs_index_t *p_index = (vs_index_t*) calloc(1, sizeof(vs_index_t));
+    if (NULL == p_index) goto error;
+
+    p_index->cap_nodes = VS_INDEX_INIT_CAPACITY;
+    p_index->p_nodes = (vs_index_node_t*) malloc(
+        p_index->cap_nodes * sizeof(vs_index_node_t));
+    p_index->cap_names = VS_INDEX_INIT_CAPACITY;
+    p_index->p_names = (char**) calloc(p_index->cap_names, sizeof(char*));
+    p_index->cap_edges = VS_INDEX_INIT_CAPACITY;
+    p_index->p_edges = (int32_t*) malloc(
+        p_index->cap_edges * sizeof(int32_t));
+    if ((NULL == p_index->p_nodes) || (NULL == p_index->p_names) ||
+        (NULL == p_index->p_edges)) {
+        goto error;
+    }
+    for (size_t i = 0; i < p_index->cap_edges; i++) p_index->p_edges[i] = -1;
+
+    /* Root node */
+    p_index->p_nodes[0].name = "";
+    p_index->p_nodes[0].parent = -1;
+    p_index->p_nodes[0].first_child = -1;
+    p_index->p_nodes[0].last_child = -1;
+    p_index->p_nodes[0].next_sibling = -1;
+    p_index->p_nodes[0].type = VS_INDEX_SCOPE;
+    p_index->p_nodes[0].mark = 0u;
+    p_index->num_nodes = 1;
+    return p_index;
+
+    error:
+    vs_log_mod_error("vs_index", "Could not allocate memory");
+    vs_index_free(p_index);
+    return NULL;
+}
+
+void vs_index_free(vs_index_t *p_index)
+{
+    if (NULL == p_index) return;
+    if (NULL != p_index->p_names) {
+        for (size_t i = 0; i < p_index->cap_names; i++) {
+            free(p_index->p_names[i]);
+        }
+        free(p_index->p_names);
+    }
+    free(p_index->p_nodes);
+    free(p_index->p_edges);
+    free(p_index->str_buf);
+    free(p_index);
+}
+
+int vs_index_add(vs_index_t *p_index, const char *str_path, int type)
+{
+    if ((NULL == p_index) || (NULL == str_path) || (0 > type)) {
+        vs_log_mod_error("vs_index", "Invalid argument");
+        return -1;
+    }
+
+    int32_t node = 0;
+    const char *str_seg = str_path;
+    for (;;) {
+        size_t len = strcspn(str_seg, ".");
+        if (0 == len) {
+            vs_log_mod_error("vs_index", "Empty segment in path %s",
+                str_path);
+            return -1;
+        }
+        const char *name = intern_name(p_index, str_seg, len);
+        if (NULL == name) return -1;
+        int32_t child = find_child(p_index, node, name);
+        if (0 > child) {
+            child = add_child(p_index, node, name);
+            if (0 > child) return -1;
+        }
+        node = child;
+        if ('\0' == str_seg[len]) break;
+        str_seg += len + 1;
+    }
+
+    if (VS_INDEX_SCOPE == p_index->p_nodes[node].type) {
+        p_index->num_objects++;
+    }
+    p_index->p_nodes[node].type = type;
+    return 0;
+}
+
+size_t vs_index_size(const vs_index_t *p_index)
+{
+    if (NULL == p_index) return 0;
+    return p_index->num_objects;
+}
+
+int vs_index_is_pattern(const char *str)
+{
+    if (NULL == str) return 0;
+    return (NULL != strpbrk(str, "*?")) ? 1 : 0;
+}
+
+/* Match a string against a single segment glob pattern ("*" and "?" only) */
+static int glob_match(const char *str_pattern, const char *str)
+{
+    const char *p_star = NULL;
+    const char *p_resume = NULL;
+    while ('\0' != *str) {
+        if (('?' == *str_pattern) || (*str_pattern == *str)) {
+            str_pattern++;
+            str++;
+        } else if ('*' == *str_pattern) {
+            p_star = str_pattern++;
+            p_resume = str;
+        } else if (NULL != p_star) {
+            str_pattern = p_star + 1;
+            str = ++p_resume;
+        } else {
+            return 0;
+        }
+    }
+    while ('*' == *str_pattern) str_pattern++;
+    return ('\0' == *str_pattern);
+}
+
+/* Write the full path of a node to the index buffer */
+static const char* node_path(vs_index_t *p_index, int32_t node)
+{
+    size_t len = 0;
+    for (int32_t n = node; n > 0; n = p_index->p_nodes[n].parent) {
+        len += strlen(p_index->p_nodes[n].name) + 1;
+    }
+    if (len > p_index->buf_size) {
+        char *str_buf = (char*) realloc(p_index->str_buf, len);
+        if (NULL == str_buf) {
+            vs_log_mod_error("vs_index", "Could not allocate memory");
+            return NULL;
+        }
+        p_index->str_buf = str_buf;
+        p_index->buf_size = len;
+    }
+    char *p_end = p_index->str_buf + len - 1;
+    *p_end = '\0';
+    for (int32_t n = node; n > 0; n = p_index->p_nodes[n].parent) {
+        size_t seg_len = strlen(p_index->p_nodes[n].name);
+        p_end -= seg_len;
+        memcpy(p_end, p_index->p_nodes[n].name, seg_len);
+        if (p_end > p_index->str_buf) *(--p_end) = '.';
+    }
+    return p_index->str_buf;
+}
+
+typedef struct vs_index_query {
+    char **p_segs;              ///Pattern segments
+    int num_segs;               ///Number of pattern segments
+    vs_index_visitor_t visitor; ///Visitor function
+    void *p_user;               ///Visitor user data
+    int count;                  ///Number of visited objects
+} vs_index_query_t;
+
+/* Recursive matching, returns 0 to continue, 1 if stopped, -1 on error */
+static int match_node(vs_index_t *p_index, vs_index_query_t *p_query,
+    int32_t node, int i_seg)
+{
+    int retval;
+    int32_t child;
+
+    if (i_seg == p_query->num_segs) {
+        vs_index_node_t *p_node = &p_index->p_nodes[node];
+        if ((0 > p_node->type) || (p_node->mark == p_index->epoch)) {
+            return 0;
+        }
+        p_node->mark = p_index->epoch;
+        const char *str_path = node_path(p_index, node);
+        if (NULL == str_path) return -1;
+        p_query->count++;
+        return p_query->visitor(str_path, p_node->type, p_query->p_user) ?
+            1 : 0;
+    }
+
+    const char *str_seg = p_query->p_segs[i_seg];
+    if (strcmp(str_seg, "**") == 0) {
+        /* Zero level, then one or more levels */
+        retval = match_node(p_index, p_query, node, i_seg + 1);
+        if (0 != retval) return retval;
+        child = p_index->p_nodes[node].first_child;
+        while (0 <= child) {
+            retval = match_node(p_index, p_query, child, i_seg);
+            if (0 != retval) return retval;
+            child = p_index->p_nodes[child].next_sibling;
+        }
+    } else if (vs_index_is_pattern(str_seg)) {
+        child = p_index->p_nodes[node].first_child;
+        while (0 <= child) {
+            if (glob_match(str_seg, p_index->p_nodes[child].name)) {
+                retval = match_node(p_index, p_query, child, i_seg + 1);
+                if (0 != retval) return retval;
+            }
+            child = p_index->p_nodes[child].next_sibling;
+        }
+    } else {
+        /* Literal segment: direct hash lookup */
+        const char *name = find_name(p_index, str_seg, strlen(str_seg));
+        if (NULL == name) return 0;
+        child = find_child(p_index, node, name);
+        if (0 > child) return 0;
+        return match_node(p_index, p_query, child, i_seg + 1);
+    }
+    return 0;
+}
+
+int vs_index_match(vs_index_t *p_index, const char *str_pattern,
+    vs_index_visitor_t visitor, void *p_user)
+{
+    int retval = -1;
+    char *str_copy = NULL;
+    char *str_seg;
+    size_t len;
+    vs_index_query_t query;
+    query.p_segs = NULL;
+    query.num_segs = 0;
+    query.visitor = visitor;
+    query.p_user = p_user;
+    query.count = 0;
+
+    if ((NULL == p_index) || (NULL == str_pattern) || (NULL == visitor)) {
+        vs_log_mod_error("vs_index", "Invalid argument");
+        return -1;
+    }
+
+    /* Split pattern into segments, collapsing consecutive "**" */
+    len = strlen(str_pattern);
+    str_copy = (char*) malloc(len + 1);
+    query.p_segs = (char**) malloc((len / 2 + 1) * sizeof(char*));
+    if ((NULL == str_copy) || (NULL == query.p_segs)) {
+        vs_log_mod_error("vs_index", "Could not allocate memory");
+        goto exit;
+    }
+    memcpy(str_copy, str_pattern, len + 1);
+    str_seg = str_copy;
+    for (;;) {
+        size_t seg_len = strcspn(str_seg, ".");
+        int b_last = ('\0' == str_seg[seg_len]);
+        str_seg[seg_len] = '\0';
+        if (0 == seg_len) {
+            vs_log_mod_error("vs_index", "Empty segment in pattern %s",
+                str_pattern);
+            goto exit;
+        }
+        if (!((query.num_segs > 0) && (strcmp(str_seg, "**") == 0) &&
+              (strcmp(query.p_segs[query.num_segs - 1], "**") == 0))) {
+            query.p_segs[query.num_segs++] = str_seg;
+        }
+        if (b_last) break;
+        str_seg += seg_len + 1;
+    }
+
+    /* New epoch so that each object is reported at most once */
+    if (0u == ++p_index->epoch) {
+        for (size_t i = 0; i < p_index->num_nodes; i++) {
+            p_index->p_nodes[i].mark = 0u;
+        }
+        p_index->epoch = 1u;
+    }
+
+    if (0 <= match_node(p_index, &query, 0, 0)) {
+        retval = query.count;
+    }
+
+    exit:
+    free(query.p_segs);
+    free(str_copy);
+    return retval;
+}
+//EOF
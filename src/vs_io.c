@@ -0,0 +1,433 @@
+/**************************************************************************//**
+@file vs_io.c
+@author jchabloz
+@brief Verisocks background socket I/O
+@date 2026-10-18
+******************************************************************************/
+/*
+MIT License
+
+Copyright (c) 2022-2025 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Needed for pthread_setaffinity_np */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "vs_logging.h"
+#include "vs_msg.h"
+#include "vs_io.h"
+
+#define QUEUE_MASK (VS_IO_QUEUE_LEN - 1u)
+
+/* Poll timeout (ms) used while the RX queue is full */
+#define RX_FULL_POLL_MS 10
+
+/**
+ * @brief Structure type for a message to be sent by the I/O thread
+ */
+typedef struct vs_io_tx {
+    char *str_msg;                  ///Message copy
+    size_t len;                     ///Full message length
+} vs_io_tx_t;
+
+/**
+ * @brief Structure type for a background I/O thread
+ *
+ * Both queues are ring buffers indexed by free-running counters. Each counter
+ * is only written by one thread (head by the producer, tail by the consumer),
+ * so that the queues do not need any lock. The mutexes and condition variables
+ * are only used to sleep when a queue is empty (RX) or full (TX).
+ */
+struct vs_io {
+    int fd;                         ///Client socket descriptor
+    int fd_wake[2];                 ///Pipe used to wake up the I/O thread
+    pthread_t thread;               ///I/O thread
+    int stop;                       ///Stop request flag (atomic access)
+    vs_io_msg_t rx_queue[VS_IO_QUEUE_LEN]; ///Received messages queue
+    size_t rx_head;                 ///RX queue head (written by I/O thread)
+    size_t rx_tail;                 ///RX queue tail (written by owner)
+    pthread_mutex_t rx_mutex;
+    pthread_cond_t rx_cond;
+    vs_io_tx_t tx_queue[VS_IO_QUEUE_LEN]; ///Messages to be sent queue
+    size_t tx_head;                 ///TX queue head (written by owner)
+    size_t tx_tail;                 ///TX queue tail (written by I/O thread)
+    pthread_mutex_t tx_mutex;
+    pthread_cond_t tx_cond;
+    struct vs_io *p_next;           ///Next running I/O thread (for vs_io_find)
+};
+
+/* Running I/O threads, only accessed by their owner thread. The list is
+thread-local, so that several simulation threads (e.g. the sessions of a
+multi-client server) can each own I/O threads. */
+static __thread vs_io_t *p_io_list = NULL;
+
+#define LOAD_ACQ(p) __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define STORE_REL(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+
+static void wake(vs_io_t *p_io)
+{
+    char c = 0;
+    if (0 > write(p_io->fd_wake[1], &c, 1)) {
+        /* Pipe full: the I/O thread is already being woken up */
+    }
+}
+
+static void drain_wake(vs_io_t *p_io)
+{
+    char buf[64];
+    while (0 < read(p_io->fd_wake[0], buf, sizeof(buf))) {}
+}
+
+/**
+ * @brief Send all the queued TX messages (I/O thread)
+ */
+static void flush_tx(vs_io_t *p_io)
+{
+    size_t tail = p_io->tx_tail;
+    size_t head = LOAD_ACQ(&p_io->tx_head);
+    vs_io_tx_t *p_tx;
+    size_t count;
+    ssize_t retval;
+
+    if (tail == head) return;
+    while (tail != head) {
+        p_tx = &p_io->tx_queue[tail & QUEUE_MASK];
+        for (count = 0; count < p_tx->len; count += (size_t) retval) {
+            retval = write(p_io->fd, p_tx->str_msg + count,
+                p_tx->len - count);
+            if (0 > retval) {
+                vs_log_mod_perror("vs_io", "Message cannot be written");
+                break;
+            }
+        }
+        free(p_tx->str_msg);
+        tail++;
+        STORE_REL(&p_io->tx_tail, tail);
+        head = LOAD_ACQ(&p_io->tx_head);
+    }
+    pthread_mutex_lock(&p_io->tx_mutex);
+    pthread_cond_signal(&p_io->tx_cond);
+    pthread_mutex_unlock(&p_io->tx_mutex);
+}
+
+/**
+ * @brief Push a received message to the RX queue (I/O thread)
+ *
+ * The I/O thread only reads from the socket when there is room in the queue.
+ */
+static void push_rx(vs_io_t *p_io, const vs_io_msg_t *p_msg)
+{
+    size_t head = p_io->rx_head;
+    p_io->rx_queue[head & QUEUE_MASK] = *p_msg;
+    STORE_REL(&p_io->rx_head, head + 1);
+    pthread_mutex_lock(&p_io->rx_mutex);
+    pthread_cond_signal(&p_io->rx_cond);
+    pthread_mutex_unlock(&p_io->rx_mutex);
+}
+
+/**
+ * @brief Read, frame and parse the next message from the socket (I/O thread)
+ *
+ * The read can be interrupted by a stop request, even if the message has only
+ * partially been received.
+ *
+ * @return Returns 0 if the connection is still open, -1 otherwise
+ */
+static int receive(vs_io_t *p_io, char **p_buffer, size_t *p_size)
+{
+    int msg_len;
+    vs_msg_info_t msg_info = VS_MSG_INFO_INIT_UNDEF;
+    vs_io_msg_t msg;
+
+    memset(&msg, 0, sizeof(vs_io_msg_t));
+    msg_len = vs_msg_read_alloc_wake(p_io->fd, p_buffer, p_size, &msg_info,
+        p_io->fd_wake[0], &p_io->stop);
+    if (0 > msg_len) {
+        msg.type = VS_IO_MSG_CLOSED;
+        push_rx(p_io, &msg);
+        return -1;
+    }
+    msg.uuid = msg_info.uuid;
+    msg.p_cmd = vs_msg_read_json(*p_buffer, &msg_info);
+    msg.type = (NULL != msg.p_cmd) ? VS_IO_MSG_CMD : VS_IO_MSG_INVALID;
+    push_rx(p_io, &msg);
+    return 0;
+}
+
+/**
+ * @brief I/O thread main function
+ */
+static void* io_thread(void *p_arg)
+{
+    vs_io_t *p_io = (vs_io_t*) p_arg;
+    char *p_buffer = NULL;
+    size_t buffer_size = 0;
+    int connected = 1;
+    int rx_full;
+    int timeout;
+    nfds_t nfds;
+    struct pollfd fds[2];
+
+    while (1) {
+        flush_tx(p_io);
+        if (LOAD_ACQ(&p_io->stop)) {
+            /* Last messages may have been queued right before the request */
+            flush_tx(p_io);
+            break;
+        }
+
+        rx_full = ((p_io->rx_head - LOAD_ACQ(&p_io->rx_tail)) >=
+            VS_IO_QUEUE_LEN);
+        fds[0].fd = p_io->fd_wake[0];
+        fds[0].events = POLLIN;
+        fds[1].fd = p_io->fd;
+        fds[1].events = POLLIN;
+        nfds = (connected && !rx_full) ? 2 : 1;
+        timeout = rx_full ? RX_FULL_POLL_MS : -1;
+        if (0 > poll(fds, nfds, timeout)) continue;
+
+        if (fds[0].revents & POLLIN) {
+            drain_wake(p_io);
+        }
+        if ((2 == nfds) && (fds[1].revents & (POLLIN | POLLHUP | POLLERR))) {
+            if (0 > receive(p_io, &p_buffer, &buffer_size)) {
+                connected = 0;
+            }
+        }
+    }
+
+    if (NULL != p_buffer) free(p_buffer);
+    return NULL;
+}
+
+vs_io_t* vs_io_start(int fd)
+{
+    vs_io_t *p_io;
+    int i;
+
+    p_io = (vs_io_t*) calloc(1, sizeof(vs_io_t));
+    if (NULL == p_io) {
+        vs_log_mod_error("vs_io", "Could not allocate memory");
+        return NULL;
+    }
+    p_io->fd = fd;
+    if (0 > pipe(p_io->fd_wake)) {
+        vs_log_mod_perror("vs_io", "Could not create pipe");
+        free(p_io);
+        return NULL;
+    }
+    for (i = 0; i < 2; i++) {
+        fcntl(p_io->fd_wake[i], F_SETFL,
+            fcntl(p_io->fd_wake[i], F_GETFL) | O_NONBLOCK);
+    }
+    pthread_mutex_init(&p_io->rx_mutex, NULL);
+    pthread_cond_init(&p_io->rx_cond, NULL);
+    pthread_mutex_init(&p_io->tx_mutex, NULL);
+    pthread_cond_init(&p_io->tx_cond, NULL);
+
+    if (0 != pthread_create(&p_io->thread, NULL, io_thread, p_io)) {
+        vs_log_mod_error("vs_io", "Could not create I/O thread");
+        goto error;
+    }
+    p_io->p_next = p_io_list;
+    p_io_list = p_io;
+    return p_io;
+
+    error:
+    pthread_mutex_destroy(&p_io->rx_mutex);
+    pthread_cond_destroy(&p_io->rx_cond);
+    pthread_mutex_destroy(&p_io->tx_mutex);
+    pthread_cond_destroy(&p_io->tx_cond);
+    close(p_io->fd_wake[0]);
+    close(p_io->fd_wake[1]);
+    free(p_io);
+    return NULL;
+}
+
+/**
+ * @brief Remove an I/O thread from the running I/O threads list
+ */
+static void unlist(vs_io_t *p_io)
+{
+    vs_io_t **pp_io;
+    for (pp_io = &p_io_list; NULL != *pp_io; pp_io = &(*pp_io)->p_next) {
+        if (*pp_io == p_io) {
+            *pp_io = p_io->p_next;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Discard the received commands which have not been read
+ */
+static void discard_rx(vs_io_t *p_io)
+{
+    size_t tail;
+    for (tail = p_io->rx_tail; tail != p_io->rx_head; tail++) {
+        if (NULL != p_io->rx_queue[tail & QUEUE_MASK].p_cmd) {
+            cJSON_Delete(p_io->rx_queue[tail & QUEUE_MASK].p_cmd);
+        }
+    }
+}
+
+void vs_io_stop(vs_io_t *p_io)
+{
+    if (NULL == p_io) return;
+
+    /* Remove from running I/O threads */
+    unlist(p_io);
+
+    STORE_REL(&p_io->stop, 1);
+    wake(p_io);
+    pthread_join(p_io->thread, NULL);
+
+    /* Discard unread commands */
+    discard_rx(p_io);
+
+    pthread_mutex_destroy(&p_io->rx_mutex);
+    pthread_cond_destroy(&p_io->rx_cond);
+    pthread_mutex_destroy(&p_io->tx_mutex);
+    pthread_cond_destroy(&p_io->tx_cond);
+    close(p_io->fd_wake[0]);
+    close(p_io->fd_wake[1]);
+    free(p_io);
+}
+
+int vs_io_read(vs_io_t *p_io, vs_io_msg_t *p_msg)
+{
+    size_t tail;
+
+    if ((NULL == p_io) || (NULL == p_msg)) {
+        vs_log_mod_error("vs_io", "NULL pointer");
+        return -1;
+    }
+    tail = p_io->rx_tail;
+    if (tail == LOAD_ACQ(&p_io->rx_head)) {
+        pthread_mutex_lock(&p_io->rx_mutex);
+        while (tail == LOAD_ACQ(&p_io->rx_head)) {
+            pthread_cond_wait(&p_io->rx_cond, &p_io->rx_mutex);
+        }
+        pthread_mutex_unlock(&p_io->rx_mutex);
+    }
+    *p_msg = p_io->rx_queue[tail & QUEUE_MASK];
+    STORE_REL(&p_io->rx_tail, tail + 1);
+    return 0;
+}
+
+int vs_io_write(vs_io_t *p_io, const char *str_msg, size_t full_len)
+{
+    size_t head;
+    char *str_copy;
+
+    if ((NULL == p_io) || (NULL == str_msg)) {
+        vs_log_mod_error("vs_io", "NULL pointer");
+        return -1;
+    }
+    if (0 == full_len) {
+        vs_log_mod_error("vs_io", "Invalid message length");
+        return -1;
+    }
+    str_copy = (char*) malloc(full_len);
+    if (NULL == str_copy) {
+        vs_log_mod_error("vs_io", "Could not allocate memory");
+        return -1;
+    }
+    memcpy(str_copy, str_msg, full_len);
+
+    /* Wait for room in the queue if needed */
+    head = p_io->tx_head;
+    if ((head - LOAD_ACQ(&p_io->tx_tail)) >= VS_IO_QUEUE_LEN) {
+        pthread_mutex_lock(&p_io->tx_mutex);
+        while ((head - LOAD_ACQ(&p_io->tx_tail)) >= VS_IO_QUEUE_LEN) {
+            pthread_cond_wait(&p_io->tx_cond, &p_io->tx_mutex);
+        }
+        pthread_mutex_unlock(&p_io->tx_mutex);
+    }
+    p_io->tx_queue[head & QUEUE_MASK].str_msg = str_copy;
+    p_io->tx_queue[head & QUEUE_MASK].len = full_len;
+    STORE_REL(&p_io->tx_head, head + 1);
+    wake(p_io);
+    return 0;
+}
+
+int vs_io_set_affinity(vs_io_t *p_io, int cpu)
+{
+    cpu_set_t cpu_set;
+
+    if (NULL == p_io) {
+        vs_log_mod_error("vs_io", "NULL pointer");
+        return -1;
+    }
+    if ((0 > cpu) || (CPU_SETSIZE <= cpu)) {
+        vs_log_mod_error("vs_io", "Invalid CPU index %d", cpu);
+        return -1;
+    }
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+    if (0 != pthread_setaffinity_np(p_io->thread, sizeof(cpu_set_t),
+        &cpu_set))
+    {
+        vs_log_mod_error("vs_io", "Could not set I/O thread affinity");
+        return -1;
+    }
+    return 0;
+}
+
+void vs_io_release_forked(vs_io_t *p_io)
+{
+    size_t tail;
+
+    if (NULL == p_io) return;
+    unlist(p_io);
+    discard_rx(p_io);
+
+    /* The mutexes may have been locked by the I/O thread when forking, so
+    that they are not destroyed */
+    for (tail = p_io->tx_tail; tail != p_io->tx_head; tail++) {
+        free(p_io->tx_queue[tail & QUEUE_MASK].str_msg);
+    }
+    close(p_io->fd_wake[0]);
+    close(p_io->fd_wake[1]);
+    free(p_io);
+}
+
+vs_io_t* vs_io_find(int fd)
+{
+    vs_io_t *p_io;
+    for (p_io = p_io_list; NULL != p_io; p_io = p_io->p_next) {
+        if (p_io->fd == fd) return p_io;
+    }
+    return NULL;
+}
+
+//EOF
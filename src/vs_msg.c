@@ -35,6 +35,7 @@ SOFTWARE.
 #include <unistd.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <poll.h>
 #include "vs_logging.h"
 #include "vs_msg.h"
 
@@ -601,12 +602,83 @@ static int readn(int fd, size_t len, char *buffer)
             vs_log_mod_perror("vs_msg", "Cannot read message");
             return -1;
         }
+        /* Only count trials without progress, so that long messages
+        received in many chunks can be read completely */
+        if (0 == retval) trials --;
         read_count += retval;
-        trials --;
     }
     return len - read_count;
 }
 
+/**
+ * @brief Helper function - Reads n bytes from descriptor to buffer, unless a
+ * stop is requested
+ *
+ * Same as readn, but waits for the data with poll() on both the descriptor and
+ * a wake-up descriptor. The stop request flag is checked before each wait;
+ * the wake-up descriptor is drained each time it is readable.
+ *
+ * @param fd I/O descriptor to be read from
+ * @param len Number of bytes to be read
+ * @param buffer Pointer to read buffer
+ * @param fd_wake Wake-up descriptor (ignored if < 0, same as readn)
+ * @param p_stop Pointer to stop request flag (atomic access)
+ * @return Returns 0 if successful, -1 if an error occurred or if a stop has
+ * been requested. Values > 0 indicate the number of bytes that were not
+ * successfully read.
+ */
+static int readn_wake(int fd, size_t len, char *buffer, int fd_wake,
+    const int *p_stop)
+{
+    size_t read_count = 0; //read bytes counter
+    unsigned int trials = VS_MSG_MAX_READ_TRIALS;
+    ssize_t retval;
+    struct pollfd fds[2];
+    char buf_wake[64];
+
+    if (0 > fd_wake) return readn(fd, len, buffer);
+    fds[0].fd = fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = fd_wake;
+    fds[1].events = POLLIN;
+    while (read_count < len && trials > 0) {
+        if (__atomic_load_n(p_stop, __ATOMIC_ACQUIRE)) {
+            vs_log_mod_debug("vs_msg", "Message read stopped");
+            return -1;
+        }
+        if (0 > poll(fds, 2, -1)) continue;
+        if (fds[1].revents & POLLIN) {
+            if (0 > read(fd_wake, buf_wake, sizeof(buf_wake))) {
+                /* Already drained */
+            }
+        }
+        if (0 == (fds[0].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+        retval = read(fd, buffer + read_count, len - read_count);
+        if (0 > retval) {
+            vs_log_mod_perror("vs_msg", "Cannot read message");
+            return -1;
+        }
+        if (0 == retval) trials --;
+        read_count += retval;
+    }
+    return len - read_count;
+}
+
+/* Grow a dynamically allocated read buffer to at least size bytes */
+static int grow_buffer(char **p_buffer, size_t *p_size, size_t size)
+{
+    if ((NULL != *p_buffer) && (*p_size >= size)) return 0;
+    char *buffer = (char*) realloc(*p_buffer, size);
+    if (NULL == buffer) {
+        vs_log_mod_error("vs_msg", "Could not allocate read buffer (%lu)",
+            (unsigned long) size);
+        return -1;
+    }
+    *p_buffer = buffer;
+    *p_size = size;
+    return 0;
+}
+
 int vs_msg_read(int fd, char *buffer, size_t len, vs_msg_info_t *p_msg_info)
 {
     vs_log_mod_debug("vs_msg", "Function vs_msg_read");
@@ -674,4 +746,80 @@ Socket probably disconnected");
     return total_len;
 }
 
+int vs_msg_read_alloc(int fd, char **p_buffer, size_t *p_size,
+    vs_msg_info_t *p_msg_info)
+{
+    return vs_msg_read_alloc_wake(fd, p_buffer, p_size, p_msg_info, -1, NULL);
+}
+
+int vs_msg_read_alloc_wake(int fd, char **p_buffer, size_t *p_size,
+    vs_msg_info_t *p_msg_info, int fd_wake, const int *p_stop)
+{
+    vs_log_mod_debug("vs_msg", "Function vs_msg_read_alloc_wake");
+
+    if ((NULL == p_buffer) || (NULL == p_size)) {
+        vs_log_mod_error("vs_msg", "NULL pointer");
+        return -1;
+    }
+    if (0 > grow_buffer(p_buffer, p_size, VS_MSG_MIN_READ_SIZE)) {
+        return -1;
+    }
+
+    /* Get pre-header */
+    if (0 != readn_wake(fd, 2u, *p_buffer, fd_wake, p_stop)) {
+        vs_log_mod_debug("vs_msg", "Could not read pre-header value. \
+Socket probably disconnected");
+        return -1;
+    }
+    /* Get header length from pre-header */
+    size_t header_length = vs_msg_read_header_length(*p_buffer);
+    if (1 > header_length) {
+        vs_log_mod_error("vs_msg", "Issue with header length (value %d)",
+                     (int) header_length);
+        return -1;
+    }
+    vs_log_mod_debug("vs_msg", "Received message header length: %d",
+        (int) header_length);
+
+    /* Read header */
+    if (0 > grow_buffer(p_buffer, p_size, header_length + 3)) {
+        return -1;
+    }
+    if (0 != readn_wake(fd, header_length, *p_buffer + 2, fd_wake,
+        p_stop)) {
+        vs_log_mod_error("vs_msg", "Issue while reading header");
+        return -1;
+    }
+
+    /* Parse header */
+    if (0 > vs_msg_read_info(*p_buffer, p_msg_info)) {
+        vs_log_mod_error("vs_msg", "Issue while parsing message info");
+        return -1;
+    }
+    vs_log_mod_debug("vs_msg", "Received message type: %s",
+        VS_MSG_TYPES[p_msg_info->type]);
+    vs_log_mod_debug("vs_msg", "Received message length: %d",
+        (int) p_msg_info->len);
+
+    /* Read message content, growing the buffer as needed */
+    size_t total_len = p_msg_info->len + header_length + 2;
+    if (total_len > VS_MSG_MAX_READ_SIZE) {
+        vs_log_mod_error("vs_msg", "Message too long (%lu bytes)",
+            (unsigned long) total_len);
+        return -1;
+    }
+    if (0 > grow_buffer(p_buffer, p_size, total_len + 1)) {
+        return -1;
+    }
+    if (0 != readn_wake(fd, p_msg_info->len, *p_buffer + 2 + header_length,
+        fd_wake, p_stop)) {
+        vs_log_mod_error("vs_msg", "Issue while reading message content");
+        return -1;
+    }
+    (*p_buffer)[total_len] = '\0';
+
+    /* Return received message total length */
+    return (int) total_len;
+}
+
 //EOF
@@ -124,7 +124,8 @@ double vs_utils_time_to_double(s_vpi_time time, const char *time_unit)
     return time_value;
 }
 
-s_vpi_time vs_utils_double_to_time(double time_value, const char *time_unit)
+static s_vpi_time double_to_time(double time_value, const char *time_unit,
+    double offset)
 {
     double time_factor;
     if (NULL == time_unit || strcmp("", time_unit) == 0) {
@@ -135,7 +136,7 @@ s_vpi_time vs_utils_double_to_time(double time_value, const char *time_unit)
     double time_precision = (double) vpi_get(vpiTimePrecision, NULL);
     time_value *= pow(10.0, time_factor - time_precision);
 
-    PLI_UINT64 time_int = (PLI_UINT64) time_value;
+    PLI_UINT64 time_int = (PLI_UINT64) (time_value + offset);
 
     s_vpi_time vpi_time;
     vpi_time.type = vpiSimTime;
@@ -146,6 +147,17 @@ s_vpi_time vs_utils_double_to_time(double time_value, const char *time_unit)
     return vpi_time;
 }
 
+s_vpi_time vs_utils_double_to_time(double time_value, const char *time_unit)
+{
+    return double_to_time(time_value, time_unit, 0.0);
+}
+
+s_vpi_time vs_utils_double_to_time_nearest(double time_value,
+    const char *time_unit)
+{
+    return double_to_time(time_value, time_unit, 0.5);
+}
+
 typedef struct s_obj_format {
     PLI_INT32 obj_type;
     PLI_INT32 format;
@@ -208,6 +220,12 @@ currently not supported", val1.format);
 }
 
 PLI_INT32 vs_utils_set_value(vpiHandle h_obj, double value)
+{
+    return vs_utils_put_value(h_obj, value, NULL, vpiNoDelay);
+}
+
+PLI_INT32 vs_utils_put_value(vpiHandle h_obj, double value,
+    p_vpi_time p_delay, PLI_INT32 flags)
 {
     s_vpi_value vpi_value;
     vpi_value.format = vs_utils_get_format(h_obj);
@@ -222,12 +240,12 @@ PLI_INT32 vs_utils_set_value(vpiHandle h_obj, double value)
         vpi_value.value.real = value;
         break;
     default:
-        vs_log_mod_error("vs_utils", "vs_utils_set_value, format %d is \
+        vs_log_mod_error("vs_utils", "vs_utils_put_value, format %d is \
 currently not supported", vpi_value.format);
         return -1;
     }
 
-    vpi_put_value(h_obj, &vpi_value, NULL, vpiNoDelay);
+    vpi_put_value(h_obj, &vpi_value, p_delay, flags);
     return 0;
 }
 
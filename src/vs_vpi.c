@@ -51,6 +51,7 @@ VS_VPI_CMD_HANDLER(exit);
 VS_VPI_CMD_HANDLER(run);
 VS_VPI_CMD_HANDLER(get);
 VS_VPI_CMD_HANDLER(set);
+VS_VPI_CMD_HANDLER(schedule);
 
 /**
  * @brief Table registering the command handlers
@@ -66,6 +67,7 @@ static const vs_vpi_cmd_t vs_vpi_cmd_table[] =
     VS_VPI_CMD(run),
     VS_VPI_CMD(get),
     VS_VPI_CMD(set),
+    VS_VPI_CMD(schedule),
     {NULL, NULL, NULL}
 };
 
@@ -162,6 +164,17 @@ int vs_vpi_process_command(vs_vpi_data_t *p_data)
     return -1;
 }
 
+int vs_vpi_write(int fd, const char *str_msg,
+    const vs_msg_info_t *p_msg_info)
+{
+    vs_io_t *p_io = vs_io_find(fd);
+    if (NULL != p_io) {
+        return vs_io_write(p_io, str_msg,
+            vs_msg_read_header_length(str_msg) + p_msg_info->len + 2);
+    }
+    return vs_msg_write(fd, str_msg);
+}
+
 int vs_vpi_return(int fd, const char *str_type, const char *str_value,
     const vs_uuid_t *p_uuid)
 {
@@ -193,7 +206,7 @@ int vs_vpi_return(int fd, const char *str_type, const char *str_value,
     }
 
     int retval;
-    retval = vs_msg_write(fd, str_msg);
+    retval = vs_vpi_write(fd, str_msg, &msg_info);
     if (0 > retval) {
         vs_log_mod_error("vs_vpi", "Error writing return message");
         goto error;
@@ -506,3 +519,181 @@ Target path corresponds to a memory array.", str_path);
     );
     return -1;
 }
+
+/******************************************************************************
+Schedule command handler
+******************************************************************************/
+/**
+ * @brief Structure type for a scheduled stimulus event
+ */
+typedef struct vs_vpi_sched_event {
+    PLI_UINT64 time;        ///Absolute event time (in simulator precision)
+    const char *str_path;   ///Object path (owned by the command JSON object)
+    double value;           ///Value to be applied
+    int seq;                ///Position in the received list
+    vpiHandle h_obj;        ///Object handle
+} vs_vpi_sched_event_t;
+
+/* Sort events by path, so that each handle is only looked up once */
+static int sched_cmp_path(const void *p_a, const void *p_b)
+{
+    const vs_vpi_sched_event_t *p_ev_a = (const vs_vpi_sched_event_t*) p_a;
+    const vs_vpi_sched_event_t *p_ev_b = (const vs_vpi_sched_event_t*) p_b;
+    int cmp = strcmp(p_ev_a->str_path, p_ev_b->str_path);
+    if (0 != cmp) return cmp;
+    return (p_ev_a->seq > p_ev_b->seq) - (p_ev_a->seq < p_ev_b->seq);
+}
+
+/* Sort events by time. Events with the same time keep their received order */
+static int sched_cmp_time(const void *p_a, const void *p_b)
+{
+    const vs_vpi_sched_event_t *p_ev_a = (const vs_vpi_sched_event_t*) p_a;
+    const vs_vpi_sched_event_t *p_ev_b = (const vs_vpi_sched_event_t*) p_b;
+    if (p_ev_a->time != p_ev_b->time) {
+        return (p_ev_a->time > p_ev_b->time) ? 1 : -1;
+    }
+    return (p_ev_a->seq > p_ev_b->seq) - (p_ev_a->seq < p_ev_b->seq);
+}
+
+VS_VPI_CMD_HANDLER(schedule)
+{
+    cJSON *p_item_events;
+    cJSON *p_item_unit;
+    cJSON *p_event;
+    char *str_time_unit;
+    vs_vpi_sched_event_t *p_events = NULL;
+    int num_events;
+    int index;
+    s_vpi_time s_time;
+    PLI_UINT64 time_sim;
+    char str_ack[64];
+
+    /* Get the events list from the JSON message content */
+    p_item_events = cJSON_GetObjectItem(p_data->p_cmd, "events");
+    if ((NULL == p_item_events) || !cJSON_IsArray(p_item_events)) {
+        vs_vpi_log_error("Command field \"events\" invalid/not found");
+        goto error;
+    }
+    num_events = cJSON_GetArraySize(p_item_events);
+    if (1 > num_events) {
+        vs_vpi_log_error("Command field \"events\" empty");
+        goto error;
+    }
+    p_item_unit = cJSON_GetObjectItem(p_data->p_cmd, "time_unit");
+    if (NULL == p_item_unit) {
+        vs_vpi_log_error("Command field \"time_unit\" invalid/not found");
+        goto error;
+    }
+    str_time_unit = cJSON_GetStringValue(p_item_unit);
+    if ((NULL == str_time_unit) || (strcmp(str_time_unit, "") == 0)) {
+        vs_vpi_log_error("Command field \"time_unit\" NULL or empty");
+        goto error;
+    }
+    vs_vpi_log_info(
+        "Command \"schedule(events=[...], time_unit=%s)\" received with %d \
+events.", str_time_unit, num_events);
+
+    s_time.type = vpiSimTime;
+    vpi_get_time(NULL, &s_time);
+    time_sim = (PLI_UINT64) s_time.low + ((PLI_UINT64) s_time.high << 32u);
+
+    /* Parse and check all the events before scheduling any of them */
+    p_events = (vs_vpi_sched_event_t*) calloc(
+        num_events, sizeof(vs_vpi_sched_event_t));
+    if (NULL == p_events) {
+        vs_vpi_log_error("Could not allocate memory");
+        goto error;
+    }
+    index = 0;
+    cJSON_ArrayForEach(p_event, p_item_events) {
+        double time_value;
+        vs_vpi_sched_event_t *p_ev = &p_events[index];
+        if (!cJSON_IsArray(p_event) || (3 != cJSON_GetArraySize(p_event))) {
+            vs_vpi_log_error(
+                "Event %d should be a [time, path, value] array", index);
+            goto error;
+        }
+        time_value = cJSON_GetNumberValue(cJSON_GetArrayItem(p_event, 0));
+        p_ev->str_path = cJSON_GetStringValue(cJSON_GetArrayItem(p_event, 1));
+        p_ev->value = cJSON_GetNumberValue(cJSON_GetArrayItem(p_event, 2));
+        p_ev->seq = index;
+        if (isnan(time_value) || isnan(p_ev->value) ||
+            (NULL == p_ev->str_path) || (strcmp(p_ev->str_path, "") == 0)) {
+            vs_vpi_log_error("Event %d invalid", index);
+            goto error;
+        }
+        s_time = vs_utils_double_to_time_nearest(time_value, str_time_unit);
+        p_ev->time = (PLI_UINT64) s_time.low +
+            ((PLI_UINT64) s_time.high << 32u);
+        if (p_ev->time < time_sim) {
+            vs_vpi_log_error("Event %d time < current simulation time",
+                index);
+            goto error;
+        }
+        index++;
+    }
+
+    /* Look up the object handles, once per distinct path */
+    qsort(p_events, num_events, sizeof(vs_vpi_sched_event_t), sched_cmp_path);
+    for (index = 0; index < num_events; index++) {
+        vs_vpi_sched_event_t *p_ev = &p_events[index];
+        if ((0 < index) &&
+            (strcmp(p_ev->str_path, p_events[index - 1].str_path) == 0)) {
+            p_ev->h_obj = p_events[index - 1].h_obj;
+            continue;
+        }
+        p_ev->h_obj = vpi_handle_by_name((PLI_BYTE8*) p_ev->str_path, NULL);
+        if (NULL == p_ev->h_obj) {
+            vs_vpi_log_error("Attempt to get handle to %s unsuccessful",
+                p_ev->str_path);
+            goto error;
+        }
+        PLI_INT32 format = vs_utils_get_format(p_ev->h_obj);
+        if ((vpiIntVal != format) && (vpiRealVal != format)) {
+            vs_vpi_log_error("Object %s cannot be scheduled", p_ev->str_path);
+            goto error;
+        }
+    }
+
+    /* Hand over all the events to the simulator, in chronological order */
+    qsort(p_events, num_events, sizeof(vs_vpi_sched_event_t), sched_cmp_time);
+    for (index = 0; index < num_events; index++) {
+        vs_vpi_sched_event_t *p_ev = &p_events[index];
+        PLI_UINT64 delay = p_ev->time - time_sim;
+        PLI_INT32 retval;
+        if (0 == delay) {
+            retval = vs_utils_put_value(p_ev->h_obj, p_ev->value,
+                NULL, vpiNoDelay);
+        } else {
+            s_time.type = vpiSimTime;
+            s_time.low = (PLI_UINT32) (delay & 0xffffffff);
+            s_time.high = (PLI_UINT32) (delay >> 32u);
+            s_time.real = 0.0;
+            retval = vs_utils_put_value(p_ev->h_obj, p_ev->value,
+                &s_time, vpiTransportDelay);
+        }
+        if (0 > retval) {
+            vs_vpi_log_error("Could not schedule event for %s",
+                p_ev->str_path);
+            goto error;
+        }
+    }
+    free(p_events);
+
+    snprintf(str_ack, sizeof(str_ack), "Scheduled %d events", num_events);
+    p_data->state = VS_VPI_STATE_WAITING;
+    vs_vpi_return(p_data->fd_client_socket, "ack", str_ack,
+        &(p_data->uuid)
+    );
+    return 0;
+
+    /* Error handling */
+    error:
+    if (NULL != p_events) free(p_events);
+    p_data->state = VS_VPI_STATE_WAITING;
+    vs_vpi_return(p_data->fd_client_socket, "error",
+        "Error processing command schedule - Discarding",
+        &(p_data->uuid)
+    );
+    return -1;
+}
@@ -47,6 +47,7 @@ VS_VPI_CMD_HANDLER(get_sim_info);   //sub-command of "get"
 VS_VPI_CMD_HANDLER(get_sim_time);   //sub-command of "get"
 VS_VPI_CMD_HANDLER(get_value);      //sub-command of "get"
 VS_VPI_CMD_HANDLER(get_type);       //sub-command of "get"
+VS_VPI_CMD_HANDLER(get_list);       //sub-command of "get"
 
 /**
  * @brief Table registering the sub-command handlers for the get command
@@ -59,9 +60,222 @@ const vs_vpi_cmd_t vs_vpi_cmd_get_table[] =
     VS_VPI_CMDKEY(get_sim_time, sim_time),
     VS_VPI_CMDKEY(get_value, value),
     VS_VPI_CMDKEY(get_type, type),
+    VS_VPI_CMDKEY(get_list, list),
     {NULL, NULL, NULL}
 };
 
+/* Object types registered in the hierarchy index */
+static const PLI_INT32 index_obj_types[] = {
+    vpiNet,
+    vpiReg,
+    vpiMemory,
+    vpiIntegerVar,
+    vpiRealVar,
+    vpiNamedEvent,
+    vpiParameter
+};
+
+/**
+ * @brief Add all the objects within a scope and its internal scopes to a
+ * hierarchy index
+ *
+ * @param p_index Pointer to the index
+ * @param h_scope Scope handle
+ * @return Returns 0 if successful, -1 in case of error
+ */
+static int index_add_scope(vs_index_t *p_index, vpiHandle h_scope)
+{
+    vpiHandle h_iter;
+    vpiHandle h_obj;
+    size_t num_types = sizeof(index_obj_types)/sizeof(index_obj_types[0]);
+
+    for (size_t i = 0; i < num_types; i++) {
+        h_iter = vpi_iterate(index_obj_types[i], h_scope);
+        if (NULL == h_iter) continue;
+        while (NULL != (h_obj = vpi_scan(h_iter))) {
+            if (0 > vs_index_add(p_index, vpi_get_str(vpiFullName, h_obj),
+                                 vpi_get(vpiType, h_obj))) {
+                vpi_free_object(h_iter);
+                return -1;
+            }
+        }
+    }
+
+    /* Internal scopes (module instances, named blocks, generate scopes...) */
+    h_iter = vpi_iterate(vpiInternalScope, h_scope);
+    if (NULL == h_iter) return 0;
+    while (NULL != (h_obj = vpi_scan(h_iter))) {
+        if (0 > index_add_scope(p_index, h_obj)) {
+            vpi_free_object(h_iter);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Get the hierarchy index, building it from all the top-level modules
+ * on first use.
+ *
+ * @param p_data Pointer to a VPI instance-specific data
+ * @return Pointer to the index, NULL in case of error
+ */
+static vs_index_t* get_index(vs_vpi_data_t *p_data)
+{
+    vs_index_t *p_index;
+    vpiHandle h_iter;
+    vpiHandle h_module;
+
+    if (NULL != p_data->p_index) return p_data->p_index;
+
+    p_index = vs_index_create();
+    if (NULL == p_index) return NULL;
+    h_iter = vpi_iterate(vpiModule, NULL);
+    if (NULL != h_iter) {
+        while (NULL != (h_module = vpi_scan(h_iter))) {
+            if (0 > index_add_scope(p_index, h_module)) {
+                vs_vpi_log_error("Could not build hierarchy index");
+                vpi_free_object(h_iter);
+                vs_index_free(p_index);
+                return NULL;
+            }
+        }
+    }
+    vs_vpi_log_debug("Hierarchy index built with %zu objects",
+        vs_index_size(p_index));
+    p_data->p_index = p_index;
+    return p_index;
+}
+
+/**
+ * @brief Add the value of an object to a JSON object. Memory arrays are added
+ * as an array containing all the memory words values.
+ *
+ * @param h_obj Object handle
+ * @param p_obj JSON object
+ * @param str_key Key to be used for the value
+ * @return Returns 0 if successful, -1 in case of error
+ */
+static int add_object_value(vpiHandle h_obj, cJSON *p_obj,
+    const char *str_key)
+{
+    s_vpi_value vpi_value;
+
+    /* Object other than a memory array */
+    if (vpiMemory != vpi_get(vpiType, h_obj)) {
+        if (0 > vs_utils_get_value(h_obj, &vpi_value)) {
+            return -1;
+        }
+        return vs_utils_add_value(vpi_value, p_obj, str_key);
+    }
+
+    vs_log_mod_debug("vs_vpi", "Memory array identified!");
+    vpiHandle mem_iter;
+    mem_iter = vpi_iterate(vpiMemoryWord, h_obj);
+    if (NULL == mem_iter) {
+        vs_log_mod_error("vs_vpi", "Could not initialize memory iterator");
+        return -1;
+    }
+    PLI_INT32 mem_size = vpi_get(vpiSize, h_obj);
+    vs_log_mod_debug("vs_vpi", "Memory array depth: %d", mem_size);
+    cJSON *p_array = cJSON_AddArrayToObject(p_obj, str_key);
+    if (NULL == p_array) {
+        vs_log_mod_error("vs_vpi", "Could not create cJSON array");
+        vpi_free_object(mem_iter);
+        return -1;
+    }
+    vpiHandle h_mem_word;
+    while (mem_size > 0) {
+        h_mem_word = vpi_scan(mem_iter);
+        if (NULL == h_mem_word) {
+            return -1;
+        }
+        if (0 > vs_utils_get_value(h_mem_word, &vpi_value)) {
+            vpi_free_object(mem_iter);
+            return -1;
+        }
+        cJSON_AddItemToArray(p_array,
+            cJSON_CreateNumber(vpi_value.value.integer));
+        mem_size--;
+    }
+    vpi_free_object(mem_iter);
+    return 0;
+}
+
+/* Context for bulk value queries */
+typedef struct {
+    cJSON *p_values;    ///JSON object collecting the values
+    int b_check_dup;    ///If > 0, skip paths already present in p_values
+    int error;          ///Set if an error occurred
+} bulk_value_ctx_t;
+
+/* Add the value of an object to a bulk value query result */
+static int bulk_add_value(const char *str_path, bulk_value_ctx_t *p_ctx)
+{
+    if (p_ctx->b_check_dup &&
+        cJSON_HasObjectItem(p_ctx->p_values, str_path)) {
+        return 0;
+    }
+    vpiHandle h_obj = vpi_handle_by_name((PLI_BYTE8*) str_path, NULL);
+    if (NULL == h_obj) {
+        vs_vpi_log_error("Attempt to get handle to %s unsuccessful", str_path);
+        return -1;
+    }
+    return add_object_value(h_obj, p_ctx->p_values, str_path);
+}
+
+/* Hierarchy index visitor for bulk value queries */
+static int bulk_value_visitor(const char *str_path, int type, void *p_user)
+{
+    bulk_value_ctx_t *p_ctx = (bulk_value_ctx_t*) p_user;
+    /* Named events have no value, silently skipped for glob patterns */
+    if (vpiNamedEvent == type) return 0;
+    if (0 > bulk_add_value(str_path, p_ctx)) {
+        p_ctx->error = 1;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Add the values for a path or glob pattern to a bulk value query
+ * result.
+ *
+ * @param p_data Pointer to a VPI instance-specific data
+ * @param str_path Object path or glob pattern
+ * @param p_ctx Pointer to bulk query context
+ * @return Returns 0 if successful, -1 in case of error
+ */
+static int bulk_add_path(vs_vpi_data_t *p_data, const char *str_path,
+    bulk_value_ctx_t *p_ctx)
+{
+    if ((NULL == str_path) || (strcmp(str_path, "") == 0)) {
+        vs_vpi_log_error("Command field \"path\" NULL or empty");
+        return -1;
+    }
+    if (!vs_index_is_pattern(str_path)) {
+        return bulk_add_value(str_path, p_ctx);
+    }
+    vs_index_t *p_index = get_index(p_data);
+    if (NULL == p_index) return -1;
+    if ((0 > vs_index_match(p_index, str_path, bulk_value_visitor, p_ctx)) ||
+        p_ctx->error) {
+        return -1;
+    }
+    return 0;
+}
+
+/* Hierarchy index visitor for list queries */
+static int list_visitor(const char *str_path, int type, void *p_user)
+{
+    (void) type;
+    cJSON *p_array = (cJSON*) p_user;
+    cJSON *p_item = cJSON_CreateString(str_path);
+    if (NULL == p_item) return 1;
+    cJSON_AddItemToArray(p_array, p_item);
+    return 0;
+}
+
 VS_VPI_CMD_HANDLER(get_sim_info)
 {
     cJSON *p_msg;
@@ -120,7 +334,7 @@ VS_VPI_CMD_HANDLER(get_sim_info)
         vs_log_mod_error("vs_vpi", "NULL pointer");
         goto error;
     }
-    if (0 > vs_msg_write(p_data->fd_client_socket, str_msg)) {
+    if (0 > vs_vpi_write(p_data->fd_client_socket, str_msg, &msg_info)) {
         vs_log_mod_error("vs_vpi", "Error writing return message");
         goto error;
     }
@@ -180,7 +394,7 @@ VS_VPI_CMD_HANDLER(get_sim_time)
         vs_log_mod_error("vs_vpi", "NULL pointer");
         goto error;
     }
-    if (0 > vs_msg_write(p_data->fd_client_socket, str_msg)) {
+    if (0 > vs_vpi_write(p_data->fd_client_socket, str_msg, &msg_info)) {
         vs_log_mod_error("vs_vpi", "Error writing return message");
         goto error;
     }
@@ -229,60 +443,48 @@ VS_VPI_CMD_HANDLER(get_value)
         vs_vpi_log_error("Command field \"path\" invalid/not found");
         goto error;
     }
-    str_path = cJSON_GetStringValue(p_item_path);
-    if ((NULL == str_path) || (strcmp(str_path, "") == 0)) {
-        vs_vpi_log_error("Command field \"path\" NULL or empty");
-        goto error;
-    }
 
-    /* Attempt to get the object handle */
-    vpiHandle h_obj;
-    h_obj = vpi_handle_by_name(str_path, NULL);
-    if (NULL == h_obj) {
-        vs_vpi_log_error("Attempt to get handle to %s unsuccessful", str_path);
-        goto error;
-    }
-
-    s_vpi_value vpi_value;
-    /* Check if memory array */
-    if (vpiMemory == vpi_get(vpiType, h_obj)) {
-        vs_log_mod_debug("vs_vpi", "Memory array identified!");
-        vpiHandle mem_iter;
-        mem_iter = vpi_iterate(vpiMemoryWord, h_obj);
-        if (NULL == mem_iter) {
-            vs_log_mod_error("vs_vpi", "Could not initialize memory iterator");
+    /* Bulk query: list of paths and/or glob pattern(s) */
+    if (cJSON_IsArray(p_item_path) ||
+        vs_index_is_pattern(cJSON_GetStringValue(p_item_path))) {
+        bulk_value_ctx_t ctx;
+        ctx.p_values = cJSON_AddObjectToObject(p_msg, "value");
+        ctx.b_check_dup = (cJSON_GetArraySize(p_item_path) > 1);
+        ctx.error = 0;
+        if (NULL == ctx.p_values) {
+            vs_log_mod_error("vs_vpi", "Could not add object to object");
             goto error;
-        } else {
-            PLI_INT32 mem_size = vpi_get(vpiSize, h_obj);
-            vs_log_mod_debug("vs_vpi", "Memory array depth: %d", mem_size);
-            cJSON *p_array = cJSON_AddArrayToObject(p_msg, "value");
-            if (NULL == p_array) {
-                vs_log_mod_error("vs_vpi", "Could not create cJSON array");
-                goto error;
-            }
-            vpiHandle h_mem_word;
-            while (mem_size > 0) {
-                h_mem_word = vpi_scan(mem_iter);
-                if (NULL == h_mem_word) {
-                    goto error;
-                }
-                if (0 > vs_utils_get_value(h_mem_word, &vpi_value)) {
+        }
+        if (cJSON_IsArray(p_item_path)) {
+            cJSON *p_item;
+            cJSON_ArrayForEach(p_item, p_item_path) {
+                if (0 > bulk_add_path(p_data, cJSON_GetStringValue(p_item),
+                                      &ctx)) {
                     goto error;
                 }
-                cJSON_AddItemToArray(p_array,
-                    cJSON_CreateNumber(vpi_value.value.integer));
-                mem_size--;
             }
-            vpi_free_object(mem_iter);
+        } else if (0 > bulk_add_path(p_data,
+                           cJSON_GetStringValue(p_item_path), &ctx)) {
+            goto error;
         }
     } else {
-        /* Get object value */
-        if (0 > vs_utils_get_value(h_obj, &vpi_value)) {
+        str_path = cJSON_GetStringValue(p_item_path);
+        if ((NULL == str_path) || (strcmp(str_path, "") == 0)) {
+            vs_vpi_log_error("Command field \"path\" NULL or empty");
+            goto error;
+        }
+
+        /* Attempt to get the object handle */
+        vpiHandle h_obj;
+        h_obj = vpi_handle_by_name(str_path, NULL);
+        if (NULL == h_obj) {
+            vs_vpi_log_error("Attempt to get handle to %s unsuccessful",
+                str_path);
             goto error;
         }
 
         /* Add value to message */
-        if (0 > vs_utils_add_value(vpi_value, p_msg, "value")) {
+        if (0 > add_object_value(h_obj, p_msg, "value")) {
             goto error;
         }
     }
@@ -293,7 +495,7 @@ VS_VPI_CMD_HANDLER(get_value)
         vs_log_mod_error("vs_vpi", "NULL pointer");
         goto error;
     }
-    if (0 > vs_msg_write(p_data->fd_client_socket, str_msg)) {
+    if (0 > vs_vpi_write(p_data->fd_client_socket, str_msg, &msg_info)) {
         vs_log_mod_error("vs_vpi", "Error writing return message");
         goto error;
     }
@@ -366,7 +568,7 @@ VS_VPI_CMD_HANDLER(get_type)
         vs_log_mod_error("vs_vpi", "NULL pointer");
         goto error;
     }
-    if (0 > vs_msg_write(p_data->fd_client_socket, str_msg)) {
+    if (0 > vs_vpi_write(p_data->fd_client_socket, str_msg, &msg_info)) {
         vs_log_mod_error("vs_vpi", "Error writing return message");
         goto error;
     }
@@ -388,3 +590,76 @@ VS_VPI_CMD_HANDLER(get_type)
     );
     return -1;
 }
+
+VS_VPI_CMD_HANDLER(get_list)
+{
+    cJSON *p_msg;
+    cJSON *p_item_pattern;
+    cJSON *p_array;
+    char *str_pattern = "**";
+    char *str_msg = NULL;
+    vs_index_t *p_index;
+    vs_msg_info_t msg_info = VS_MSG_INFO_INIT_JSON;
+    vs_msg_copy_uuid(&msg_info, &p_data->uuid);
+
+    /* Create return message object */
+    p_msg = cJSON_CreateObject();
+    if (NULL == p_msg) {
+        vs_log_mod_error("vs_vpi", "Could not create cJSON object");
+        goto error;
+    }
+    if (NULL == cJSON_AddStringToObject(p_msg, "type", "result")) {
+        vs_log_mod_error("vs_vpi", "Could not add string to object");
+        goto error;
+    }
+
+    /* Get the optional pattern from the JSON message content */
+    p_item_pattern = cJSON_GetObjectItem(p_data->p_cmd, "pattern");
+    if (NULL != p_item_pattern) {
+        str_pattern = cJSON_GetStringValue(p_item_pattern);
+        if ((NULL == str_pattern) || (strcmp(str_pattern, "") == 0)) {
+            vs_vpi_log_error("Command field \"pattern\" NULL or empty");
+            goto error;
+        }
+    }
+
+    p_index = get_index(p_data);
+    if (NULL == p_index) {
+        goto error;
+    }
+    p_array = cJSON_AddArrayToObject(p_msg, "value");
+    if (NULL == p_array) {
+        vs_log_mod_error("vs_vpi", "Could not create cJSON array");
+        goto error;
+    }
+    if (0 > vs_index_match(p_index, str_pattern, list_visitor, p_array)) {
+        goto error;
+    }
+
+    str_msg = vs_msg_create_message(p_msg, &msg_info);
+    if (NULL == str_msg) {
+        vs_log_mod_error("vs_vpi", "NULL pointer");
+        goto error;
+    }
+    if (0 > vs_vpi_write(p_data->fd_client_socket, str_msg, &msg_info)) {
+        vs_log_mod_error("vs_vpi", "Error writing return message");
+        goto error;
+    }
+
+    /* Normal exit */
+    if (NULL != p_msg) cJSON_Delete(p_msg);
+    if (NULL != str_msg) cJSON_free(str_msg);
+    p_data->state = VS_VPI_STATE_WAITING;
+    return 0;
+
+    /* Handle errors */
+    error:
+    if (NULL != p_msg) cJSON_Delete(p_msg);
+    if (NULL != str_msg) cJSON_free(str_msg);
+    p_data->state = VS_VPI_STATE_WAITING;
+    vs_vpi_return(p_data->fd_client_socket, "error",
+        "Error processing command get(sel=list) - Discarding",
+        &(p_data->uuid)
+    );
+    return -1;
+}
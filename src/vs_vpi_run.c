@@ -48,6 +48,7 @@ VS_VPI_CMD_HANDLER(run_for_time);      //sub-command of "run"
 VS_VPI_CMD_HANDLER(run_until_time);    //sub-command of "run"
 VS_VPI_CMD_HANDLER(run_until_change);  //sub-command of "run"
 VS_VPI_CMD_HANDLER(run_to_next);       //sub-command of "run"
+VS_VPI_CMD_HANDLER(run_sample);        //sub-command of "run"
 
 /**
  * @brief Table registering the sub-command handlers for the run command
@@ -60,6 +61,7 @@ const vs_vpi_cmd_t vs_vpi_cmd_run_table[] =
     VS_VPI_CMDKEY(run_until_time, until_time),
     VS_VPI_CMDKEY(run_until_change, until_change),
     VS_VPI_CMDKEY(run_to_next, to_next),
+    VS_VPI_CMDKEY(run_sample, sample),
     {NULL, NULL, NULL}
 };
 
@@ -208,6 +210,77 @@ VS_VPI_CMD_HANDLER(run_until_time)
     return -1;
 }
 
+/**
+ * @brief Table associating the "edge" and "op" field values with trigger
+ * conditions (in the same order as the vs_vpi_trig_cond_t enum)
+ */
+static const struct {
+    const char *str_name;
+    vs_vpi_trig_cond_t cond;
+} trig_cond_table[] = {
+    {"eq", VS_VPI_TRIG_EQ},
+    {"ne", VS_VPI_TRIG_NE},
+    {"lt", VS_VPI_TRIG_LT},
+    {"le", VS_VPI_TRIG_LE},
+    {"gt", VS_VPI_TRIG_GT},
+    {"ge", VS_VPI_TRIG_GE},
+    {"rising", VS_VPI_TRIG_RISING},
+    {"falling", VS_VPI_TRIG_FALLING},
+    {"any", VS_VPI_TRIG_ANY},
+    {NULL, VS_VPI_TRIG_ENUM_LEN}
+};
+
+/**
+ * @brief Get the trigger condition from an "edge" or "op" field
+ *
+ * @param str_name Field value
+ * @param is_edge Set if only edge conditions are accepted, only comparisons
+ * are accepted otherwise
+ * @return Trigger condition, VS_VPI_TRIG_ENUM_LEN if not found
+ */
+static vs_vpi_trig_cond_t get_trig_cond(const char *str_name, int is_edge)
+{
+    int i;
+    int cond_is_edge;
+    if (NULL == str_name) return VS_VPI_TRIG_ENUM_LEN;
+    for (i = 0; NULL != trig_cond_table[i].str_name; i++) {
+        cond_is_edge = (trig_cond_table[i].cond >= VS_VPI_TRIG_RISING);
+        if ((cond_is_edge == is_edge) &&
+            (strcmp(str_name, trig_cond_table[i].str_name) == 0)) {
+            return trig_cond_table[i].cond;
+        }
+    }
+    return VS_VPI_TRIG_ENUM_LEN;
+}
+
+/**
+ * @brief Get the value to be evaluated by a trigger
+ *
+ * @param p_trigger Pointer to trigger struct
+ * @param p_value Pointer to VPI value struct
+ * @param p_result Pointer to the resulting value
+ * @return Returns 0 if successful, -1 if the value format is not supported
+ */
+static int get_trig_value(const vs_vpi_trigger_t *p_trigger,
+    const s_vpi_value *p_value, double *p_result)
+{
+    switch (p_value->format) {
+    case vpiIntVal:
+        if (0u != p_trigger->mask) {
+            *p_result = (double)
+                ((PLI_UINT32) p_value->value.integer & p_trigger->mask);
+        } else {
+            *p_result = (double) p_value->value.integer;
+        }
+        return 0;
+    case vpiRealVal:
+        *p_result = p_value->value.real;
+        return 0;
+    default:
+        return -1;
+    }
+}
+
 VS_VPI_CMD_HANDLER(run_until_change)
 {
     cJSON *p_item_path;
@@ -215,12 +288,16 @@ VS_VPI_CMD_HANDLER(run_until_change)
     vpiHandle h_obj;
     double value = NAN;
     cJSON *p_item_val;
+    cJSON *p_item_edge;
+    cJSON *p_item_op;
+    cJSON *p_item_mask;
+    cJSON *p_item_count;
+    double mask_value;
+    double count_value;
     PLI_INT32 format;
-    s_vpi_value target_value;
+    vs_vpi_trigger_t trigger;
+    vs_vpi_watch_t *p_watch;
     s_vpi_value cb_value;
-    s_vpi_time cb_time;
-    s_cb_data cb_data;
-    vpiHandle h_cb;
 
     /* Get the object path from the JSON message content */
     p_item_path = cJSON_GetObjectItem(p_data->p_cmd, "path");
@@ -234,70 +311,112 @@ VS_VPI_CMD_HANDLER(run_until_change)
         goto error;
     }
 
-    /* Attempt to get the object handle */
-    h_obj = vpi_handle_by_name(str_path, NULL);
-    if (NULL == h_obj) {
-        vs_vpi_log_error("Attempt to get handle to %s unsuccessful", str_path);
-        goto error;
-    }
+    /* Get the persistent value change callback for the object (the handle
+     * is only resolved and the callback only registered on first use) */
+    p_watch = vs_vpi_watch_get(p_data, str_path);
+    if (NULL == p_watch) goto error;
+    h_obj = p_watch->h_obj;
+    format = p_watch->format;
+
+    /* Default trigger: value equal to the expected value, first occurrence */
+    trigger.cond = VS_VPI_TRIG_EQ;
+    trigger.is_event = p_watch->is_event;
+    trigger.mask = 0u;
+    trigger.expected = 0.0;
+    trigger.last = 0.0;
+    trigger.count = 1;
 
-    if (vpi_get(vpiType, h_obj) != vpiNamedEvent) {
-        /* Get the value from the JSON message content */
-        p_item_val = cJSON_GetObjectItem(p_data->p_cmd, "value");
-        if (NULL == p_item_val) {
-            vs_vpi_log_error("Command field \"value\" invalid/not found");
+    /* Get the optional number of occurrences from the JSON message content */
+    p_item_count = cJSON_GetObjectItem(p_data->p_cmd, "count");
+    if (NULL != p_item_count) {
+        count_value = cJSON_GetNumberValue(p_item_count);
+        if (isnan(count_value) || (count_value < 1.0) ||
+            (count_value > 2147483647.0) ||
+            (count_value != floor(count_value))) {
+            vs_vpi_log_error("Command field \"count\" invalid");
             goto error;
         }
-        value = cJSON_GetNumberValue(p_item_val);
-        if (isnan(value)) {
-            vs_vpi_log_error("Command field \"value\" invalid (NaN)");
+        trigger.count = (int) count_value;
+    }
+
+    if (!trigger.is_event) {
+        /* Get the optional bit mask from the JSON message content */
+        p_item_mask = cJSON_GetObjectItem(p_data->p_cmd, "mask");
+        if (NULL != p_item_mask) {
+            mask_value = cJSON_GetNumberValue(p_item_mask);
+            if ((vpiIntVal != format) || isnan(mask_value) ||
+                (mask_value < 1.0) || (mask_value > 4294967295.0) ||
+                (mask_value != floor(mask_value))) {
+                vs_vpi_log_error("Command field \"mask\" invalid");
+                goto error;
+            }
+            trigger.mask = (PLI_UINT32) mask_value;
+        }
+
+        p_item_edge = cJSON_GetObjectItem(p_data->p_cmd, "edge");
+        if (NULL != p_item_edge) {
+            /* Edge condition, no expected value is required */
+            trigger.cond = get_trig_cond(
+                cJSON_GetStringValue(p_item_edge), 1);
+            if (VS_VPI_TRIG_ENUM_LEN == trigger.cond) {
+                vs_vpi_log_error("Command field \"edge\" invalid");
+                goto error;
+            }
+        } else {
+            /* Get the optional comparison operator */
+            p_item_op = cJSON_GetObjectItem(p_data->p_cmd, "op");
+            if (NULL != p_item_op) {
+                trigger.cond = get_trig_cond(
+                    cJSON_GetStringValue(p_item_op), 0);
+                if (VS_VPI_TRIG_ENUM_LEN == trigger.cond) {
+                    vs_vpi_log_error("Command field \"op\" invalid");
+                    goto error;
+                }
+            }
+
+            /* Get the value from the JSON message content */
+            p_item_val = cJSON_GetObjectItem(p_data->p_cmd, "value");
+            if (NULL == p_item_val) {
+                vs_vpi_log_error("Command field \"value\" invalid/not found");
+                goto error;
+            }
+            value = cJSON_GetNumberValue(p_item_val);
+            if (isnan(value)) {
+                vs_vpi_log_error("Command field \"value\" invalid (NaN)");
+                goto error;
+            }
+            /* Equality with an integer object is checked after conversion of
+             * the expected value, as it used to be */
+            if ((vpiIntVal == format) && (0u == trigger.mask) &&
+                ((VS_VPI_TRIG_EQ == trigger.cond) ||
+                (VS_VPI_TRIG_NE == trigger.cond))) {
+                trigger.expected = (double) ((PLI_INT32) value);
+            } else {
+                trigger.expected = value;
+            }
+        }
+
+        /* Get the current value, used as reference for edges */
+        cb_value.format = format;
+        vpi_get_value(h_obj, &cb_value);
+        if (0 > get_trig_value(&trigger, &cb_value, &trigger.last)) {
+            vs_vpi_log_error("Object value format not supported");
             goto error;
         }
         vs_vpi_log_info(
-            "Command \"run(cb=until_change, path=%s, value=%f)\" received.",
-            str_path, value);
+            "Command \"run(cb=until_change, path=%s, value=%f)\" received \
+(condition %s, count %d).", str_path, value,
+            trig_cond_table[trigger.cond].str_name, trigger.count);
     } else {
         vs_vpi_log_info(
             "Command \"run(cb=until_change, path=%s)\" received.",
             str_path);
     }
+    p_data->trigger = trigger;
 
-    /* Store value as user data, depending on desired format */
-    format = vs_utils_get_format(h_obj);
-    target_value.format = format;
-    if (0 > format) goto error;
-    switch (format) {
-    case vpiIntVal:
-        target_value.value.integer = (PLI_INT32) value;
-        break;
-    case vpiRealVal:
-        target_value.value.real = value;
-        break;
-    case vpiSuppressVal:
-        target_value.value.real = 0;
-        break;
-    default:
-        goto error;
-    }
-    p_data->value = target_value;
-
-    /* Register callback */
-    cb_time.type = vpiSimTime;
-    cb_value.format = format;
-
-    cb_data.reason = cbValueChange;
-    cb_data.time = &cb_time;
-    cb_data.obj = h_obj;
-    cb_data.value = &cb_value;
-    cb_data.index = 0;
-    cb_data.user_data = (PLI_BYTE8*) p_data;
-    cb_data.cb_rtn = verisocks_cb_value_change;
-    h_cb = vpi_register_cb(&cb_data);
-    if (NULL == h_cb) {
-        vs_vpi_log_error("Could not register callback");
-        goto error;
-    }
-    p_data->h_cb = h_cb;
+    /* Arm callback */
+    p_watch->armed = 1;
+    p_data->h_cb = NULL;
 
     /* Return control to simulator */
     p_data->state = VS_VPI_STATE_SIM_RUNNING;
@@ -315,6 +434,63 @@ VS_VPI_CMD_HANDLER(run_until_change)
     return -1;
 }
 
+int vs_vpi_trigger_check(vs_vpi_trigger_t *p_trigger, p_vpi_value p_value)
+{
+    double x;
+    double last;
+    int match = 0;
+
+    /* Evaluate the condition (any trigger of a named event is a match) */
+    if (NULL != p_value) {
+        if (0 > get_trig_value(p_trigger, p_value, &x)) {
+            vs_vpi_log_error("Value format %d not supported for trigger",
+                p_value->format);
+            return -1;
+        }
+        last = p_trigger->last;
+        p_trigger->last = x;
+        switch (p_trigger->cond) {
+        case VS_VPI_TRIG_EQ:
+            match = (x == p_trigger->expected);
+            break;
+        case VS_VPI_TRIG_NE:
+            match = (x != p_trigger->expected);
+            break;
+        case VS_VPI_TRIG_LT:
+            match = (x < p_trigger->expected);
+            break;
+        case VS_VPI_TRIG_LE:
+            match = (x <= p_trigger->expected);
+            break;
+        case VS_VPI_TRIG_GT:
+            match = (x > p_trigger->expected);
+            break;
+        case VS_VPI_TRIG_GE:
+            match = (x >= p_trigger->expected);
+            break;
+        case VS_VPI_TRIG_RISING:
+            match = ((last == 0.0) && (x != 0.0));
+            break;
+        case VS_VPI_TRIG_FALLING:
+            match = ((last != 0.0) && (x == 0.0));
+            break;
+        case VS_VPI_TRIG_ANY:
+            match = (x != last);
+            break;
+        default:
+            return -1;
+        }
+        if (!match) return 0;
+    }
+
+    /* Count occurrences */
+    if (p_trigger->count > 1) {
+        p_trigger->count--;
+        return 0;
+    }
+    return 1;
+}
+
 VS_VPI_CMD_HANDLER(run_to_next)
 {
     /* Log received command */
@@ -355,3 +531,558 @@ VS_VPI_CMD_HANDLER(run_to_next)
     );
     return -1;
 }
+
+VS_VPI_CMD_HANDLER(run_sample)
+{
+    cJSON *p_item_period;
+    cJSON *p_item_unit;
+    cJSON *p_item_count;
+    cJSON *p_item_path;
+    cJSON *iterator;
+    char *str_time_unit;
+    char *str_path;
+    double period_value;
+    double count_value;
+    int num_paths;
+    int index = 0;
+    vs_vpi_sampler_t *p_sampler = NULL;
+
+    /* Get the period field from the JSON message content */
+    p_item_period = cJSON_GetObjectItem(p_data->p_cmd, "period");
+    if (NULL == p_item_period) {
+        vs_vpi_log_error("Command field \"period\" invalid/not found");
+        goto error;
+    }
+    period_value = cJSON_GetNumberValue(p_item_period);
+    if (isnan(period_value) || (period_value <= 0.0)) {
+        vs_vpi_log_error("Command field \"period\" invalid or <= 0.0");
+        goto error;
+    }
+    p_item_unit = cJSON_GetObjectItem(p_data->p_cmd, "time_unit");
+    if (NULL == p_item_unit) {
+        vs_vpi_log_error("Command field \"time_unit\" invalid/not found");
+        goto error;
+    }
+    str_time_unit = cJSON_GetStringValue(p_item_unit);
+    if ((NULL == str_time_unit) || (strcmp(str_time_unit, "") == 0)) {
+        vs_vpi_log_error("Command field \"time_unit\" NULL or empty");
+        goto error;
+    }
+
+    /* Get the number of samples from the JSON message content */
+    p_item_count = cJSON_GetObjectItem(p_data->p_cmd, "count");
+    if (NULL == p_item_count) {
+        vs_vpi_log_error("Command field \"count\" invalid/not found");
+        goto error;
+    }
+    count_value = cJSON_GetNumberValue(p_item_count);
+    if (isnan(count_value) || (count_value < 1.0) ||
+        (count_value > 2147483647.0) ||
+        (count_value != floor(count_value))) {
+        vs_vpi_log_error("Command field \"count\" invalid");
+        goto error;
+    }
+
+    /* Get the list of paths (a single path string is also accepted) */
+    p_item_path = cJSON_GetObjectItem(p_data->p_cmd, "path");
+    if (NULL == p_item_path) {
+        vs_vpi_log_error("Command field \"path\" invalid/not found");
+        goto error;
+    }
+    if (cJSON_IsArray(p_item_path)) {
+        num_paths = cJSON_GetArraySize(p_item_path);
+    } else if (cJSON_IsString(p_item_path)) {
+        num_paths = 1;
+    } else {
+        vs_vpi_log_error("Command field \"path\" should be a string or an \
+array of strings");
+        goto error;
+    }
+    if (1 > num_paths) {
+        vs_vpi_log_error("Command field \"path\" empty");
+        goto error;
+    }
+    if ((size_t) count_value > VS_VPI_SAMPLER_MAX_VALUES / (size_t) num_paths)
+    {
+        vs_vpi_log_error("Too many values to be sampled (maximum %u)",
+            VS_VPI_SAMPLER_MAX_VALUES);
+        goto error;
+    }
+
+    vs_vpi_log_info(
+        "Command \"run(cb=sample, period=%f %s, count=%d, path=[%d])\" \
+received.", period_value, str_time_unit, (int) count_value, num_paths);
+
+    /* Allocate sampler and its buffers */
+    p_sampler = (vs_vpi_sampler_t*) calloc(1, sizeof(vs_vpi_sampler_t));
+    if (NULL == p_sampler) {
+        vs_vpi_log_error("Issue allocating virtual memory");
+        goto error;
+    }
+    p_sampler->num_paths = num_paths;
+    p_sampler->num_samples = (size_t) count_value;
+    p_sampler->index = 0;
+    p_sampler->period = vs_utils_double_to_time(period_value, str_time_unit);
+    if ((0 == p_sampler->period.low) && (0 == p_sampler->period.high)) {
+        vs_vpi_log_error("Sampling period shorter than time precision");
+        goto error;
+    }
+    p_sampler->str_paths = (char**) calloc(num_paths, sizeof(char*));
+    p_sampler->h_objs = (vpiHandle*) calloc(num_paths, sizeof(vpiHandle));
+    p_sampler->p_time = (double*) malloc(
+        p_sampler->num_samples * sizeof(double));
+    p_sampler->p_values = (double*) malloc(
+        p_sampler->num_samples * num_paths * sizeof(double));
+    if ((NULL == p_sampler->str_paths) || (NULL == p_sampler->h_objs) ||
+        (NULL == p_sampler->p_time) || (NULL == p_sampler->p_values)) {
+        vs_vpi_log_error("Issue allocating virtual memory");
+        goto error;
+    }
+
+    /* Resolve all object handles once, before starting the sampling */
+    if (cJSON_IsArray(p_item_path)) {
+        cJSON_ArrayForEach(iterator, p_item_path) {
+            str_path = cJSON_GetStringValue(iterator);
+            if ((NULL == str_path) || (strcmp(str_path, "") == 0)) {
+                vs_vpi_log_error("Command field \"path\" NULL or empty");
+                goto error;
+            }
+            p_sampler->str_paths[index++] = strdup(str_path);
+        }
+    } else {
+        str_path = cJSON_GetStringValue(p_item_path);
+        if (strcmp(str_path, "") == 0) {
+            vs_vpi_log_error("Command field \"path\" NULL or empty");
+            goto error;
+        }
+        p_sampler->str_paths[index++] = strdup(str_path);
+    }
+    for (index = 0; index < num_paths; index++) {
+        if (NULL == p_sampler->str_paths[index]) {
+            vs_vpi_log_error("Issue allocating virtual memory");
+            goto error;
+        }
+        p_sampler->h_objs[index] =
+            vpi_handle_by_name(p_sampler->str_paths[index], NULL);
+        if (NULL == p_sampler->h_objs[index]) {
+            vs_vpi_log_error("Attempt to get handle to %s unsuccessful",
+                p_sampler->str_paths[index]);
+            goto error;
+        }
+        switch (vs_utils_get_format(p_sampler->h_objs[index])) {
+        case vpiIntVal:
+        case vpiRealVal:
+            break;
+        default:
+            vs_vpi_log_error("Object %s cannot be sampled",
+                p_sampler->str_paths[index]);
+            goto error;
+        }
+    }
+
+    /* Register callback for the first sample */
+    vs_vpi_sampler_free(p_data->p_sampler);
+    p_data->p_sampler = p_sampler;
+    if (0 > vs_vpi_sampler_arm(p_data)) {
+        p_data->p_sampler = NULL;
+        goto error;
+    }
+
+    /* Return control to simulator */
+    p_data->state = VS_VPI_STATE_SIM_RUNNING;
+    return 0;
+
+    error:
+    vs_vpi_sampler_free(p_sampler);
+    p_data->state = VS_VPI_STATE_WAITING;
+    vs_vpi_log_warning(
+        "Error processing command run(sample) - Discarding");
+    vs_vpi_return(p_data->fd_client_socket, "error",
+        "Error processing command run - Discarding",
+        &(p_data->uuid)
+    );
+    return -1;
+}
+
+/******************************************************************************
+Sampling run helper functions
+******************************************************************************/
+int vs_vpi_sampler_arm(vs_vpi_data_t *p_data)
+{
+    s_vpi_time cb_time;
+    s_cb_data cb_data;
+    vpiHandle h_cb;
+
+    if ((NULL == p_data) || (NULL == p_data->p_sampler)) {
+        vs_vpi_log_error("NULL pointer to sampler");
+        return -1;
+    }
+
+    cb_time = p_data->p_sampler->period;
+    cb_data.reason = cbAfterDelay;
+    cb_data.time = &cb_time;
+    cb_data.obj = NULL;
+    cb_data.value = NULL;
+    cb_data.index = 0;
+    cb_data.user_data = (PLI_BYTE8*) p_data;
+    cb_data.cb_rtn = verisocks_cb_sample;
+    h_cb = vpi_register_cb(&cb_data);
+    if (NULL == h_cb) {
+        vs_vpi_log_error("Could not register callback");
+        return -1;
+    }
+    vpi_free_object(h_cb);
+    p_data->h_cb = NULL;
+    return 0;
+}
+
+int vs_vpi_sampler_sample(vs_vpi_sampler_t *p_sampler)
+{
+    s_vpi_time s_time;
+    s_vpi_value vpi_value;
+    double *p_column;
+    int i;
+
+    if (NULL == p_sampler) {
+        vs_vpi_log_error("NULL pointer to sampler");
+        return -1;
+    }
+    if (p_sampler->index >= p_sampler->num_samples) {
+        vs_vpi_log_error("Sampler buffer already full");
+        return -1;
+    }
+
+    s_time.type = vpiSimTime;
+    vpi_get_time(NULL, &s_time);
+    p_sampler->p_time[p_sampler->index] =
+        vs_utils_time_to_double(s_time, NULL);
+
+    p_column = p_sampler->p_values + p_sampler->index;
+    for (i = 0; i < p_sampler->num_paths; i++) {
+        if (0 > vs_utils_get_value(p_sampler->h_objs[i], &vpi_value)) {
+            return -1;
+        }
+        *p_column = (vpiRealVal == vpi_value.format) ?
+            vpi_value.value.real : (double) vpi_value.value.integer;
+        p_column += p_sampler->num_samples;
+    }
+    p_sampler->index++;
+    return (int) (p_sampler->num_samples - p_sampler->index);
+}
+
+int vs_vpi_sampler_return(vs_vpi_data_t *p_data)
+{
+    cJSON *p_msg;
+    cJSON *p_values;
+    cJSON *p_array;
+    char *str_msg = NULL;
+    vs_vpi_sampler_t *p_sampler;
+    int num_samples;
+    int i;
+    vs_msg_info_t msg_info = VS_MSG_INFO_INIT_JSON;
+    vs_msg_copy_uuid(&msg_info, &p_data->uuid);
+
+    p_sampler = p_data->p_sampler;
+    if (NULL == p_sampler) {
+        vs_vpi_log_error("NULL pointer to sampler");
+        return -1;
+    }
+    num_samples = (int) p_sampler->index;
+
+    /* Create return message object */
+    p_msg = cJSON_CreateObject();
+    if (NULL == p_msg) {
+        vs_log_mod_error("vs_vpi", "Could not create cJSON object");
+        goto error;
+    }
+    if (NULL == cJSON_AddStringToObject(p_msg, "type", "result")) {
+        vs_log_mod_error("vs_vpi", "Could not add string to object");
+        goto error;
+    }
+    p_array = cJSON_CreateDoubleArray(p_sampler->p_time, num_samples);
+    if (NULL == p_array) {
+        vs_log_mod_error("vs_vpi", "Could not create cJSON array");
+        goto error;
+    }
+    cJSON_AddItemToObject(p_msg, "time", p_array);
+    p_values = cJSON_AddObjectToObject(p_msg, "value");
+    if (NULL == p_values) {
+        vs_log_mod_error("vs_vpi", "Could not add object to object");
+        goto error;
+    }
+    for (i = 0; i < p_sampler->num_paths; i++) {
+        p_array = cJSON_CreateDoubleArray(
+            p_sampler->p_values + i * p_sampler->num_samples, num_samples);
+        if (NULL == p_array) {
+            vs_log_mod_error("vs_vpi", "Could not create cJSON array");
+            goto error;
+        }
+        cJSON_AddItemToObject(p_values, p_sampler->str_paths[i], p_array);
+    }
+
+    str_msg = vs_msg_create_message(p_msg, &msg_info);
+    if (NULL == str_msg) {
+        vs_log_mod_error("vs_vpi", "NULL pointer");
+        goto error;
+    }
+    if (0 > vs_vpi_write(p_data->fd_client_socket, str_msg, &msg_info)) {
+        vs_log_mod_error("vs_vpi", "Error writing return message");
+        goto error;
+    }
+
+    /* Normal exit */
+    if (NULL != p_msg) cJSON_Delete(p_msg);
+    if (NULL != str_msg) cJSON_free(str_msg);
+    return 0;
+
+    /* Error handling */
+    error:
+    if (NULL != p_msg) cJSON_Delete(p_msg);
+    if (NULL != str_msg) cJSON_free(str_msg);
+    vs_vpi_return(p_data->fd_client_socket, "error",
+        "Error processing command run(sample) - Discarding",
+        &(p_data->uuid)
+    );
+    return -1;
+}
+
+vs_vpi_watch_t* vs_vpi_watch_get(vs_vpi_data_t *p_data, const char *str_path)
+{
+    int i;
+    vs_vpi_watch_t *p_watch = NULL;
+    vs_vpi_watch_t **p_watches;
+    s_vpi_time cb_time;
+    s_vpi_value cb_value;
+    s_cb_data cb_data;
+
+    /* Look for an existing watch */
+    for (i = 0; i < p_data->num_watches; i++) {
+        if (strcmp(p_data->p_watches[i]->str_path, str_path) == 0) {
+            return p_data->p_watches[i];
+        }
+    }
+
+    /* Make room in the pool if needed, removing the oldest watch */
+    if (NULL == p_data->p_watches) {
+        p_watches = (vs_vpi_watch_t**) malloc(
+            VS_VPI_WATCH_MAX * sizeof(vs_vpi_watch_t*));
+        if (NULL == p_watches) {
+            vs_vpi_log_error("Could not allocate memory for watches");
+            return NULL;
+        }
+        p_data->p_watches = p_watches;
+        p_data->num_watches = 0;
+    }
+    if (VS_VPI_WATCH_MAX <= p_data->num_watches) {
+        p_watch = p_data->p_watches[0];
+        vs_vpi_log_debug("Removing watch on %s", p_watch->str_path);
+        vpi_remove_cb(p_watch->h_cb);
+        free(p_watch->str_path);
+        free(p_watch);
+        p_data->num_watches--;
+        memmove(&p_data->p_watches[0], &p_data->p_watches[1],
+            p_data->num_watches * sizeof(vs_vpi_watch_t*));
+    }
+
+    /* Create new watch */
+    p_watch = (vs_vpi_watch_t*) calloc(1, sizeof(vs_vpi_watch_t));
+    if (NULL == p_watch) {
+        vs_vpi_log_error("Could not allocate memory for watch");
+        return NULL;
+    }
+    p_watch->p_data = p_data;
+    p_watch->str_path = (char*) malloc(strlen(str_path) + 1);
+    if (NULL == p_watch->str_path) {
+        vs_vpi_log_error("Could not allocate memory for watch");
+        goto error;
+    }
+    strcpy(p_watch->str_path, str_path);
+
+    p_watch->h_obj = vpi_handle_by_name((PLI_BYTE8*) str_path, NULL);
+    if (NULL == p_watch->h_obj) {
+        vs_vpi_log_error("Attempt to get handle to %s unsuccessful", str_path);
+        goto error;
+    }
+    p_watch->format = vs_utils_get_format(p_watch->h_obj);
+    if (0 > p_watch->format) goto error;
+    p_watch->is_event = (vpi_get(vpiType, p_watch->h_obj) == vpiNamedEvent);
+
+    /* Register callback (not armed). The simulator does not provide the value,
+    which is only read by the callback while the watch is armed. */
+    cb_time.type = vpiSimTime;
+    cb_value.format = vpiSuppressVal;
+    cb_data.reason = cbValueChange;
+    cb_data.time = &cb_time;
+    cb_data.obj = p_watch->h_obj;
+    cb_data.value = &cb_value;
+    cb_data.index = 0;
+    cb_data.user_data = (PLI_BYTE8*) p_watch;
+    cb_data.cb_rtn = verisocks_cb_value_change;
+    p_watch->h_cb = vpi_register_cb(&cb_data);
+    if (NULL == p_watch->h_cb) {
+        vs_vpi_log_error("Could not register callback");
+        goto error;
+    }
+
+    p_data->p_watches[p_data->num_watches++] = p_watch;
+    vs_vpi_log_debug("Added watch on %s", str_path);
+    return p_watch;
+
+    error:
+    if (NULL != p_watch->str_path) free(p_watch->str_path);
+    free(p_watch);
+    return NULL;
+}
+
+void vs_vpi_watch_free_all(vs_vpi_data_t *p_data)
+{
+    int i;
+    if (NULL == p_data->p_watches) return;
+    for (i = 0; i < p_data->num_watches; i++) {
+        vpi_remove_cb(p_data->p_watches[i]->h_cb);
+        free(p_data->p_watches[i]->str_path);
+        free(p_data->p_watches[i]);
+    }
+    free(p_data->p_watches);
+    p_data->p_watches = NULL;
+    p_data->num_watches = 0;
+}
+
+void vs_vpi_sampler_free(vs_vpi_sampler_t *p_sampler)
+{
+    int i;
+    if (NULL == p_sampler) return;
+    if (NULL != p_sampler->str_paths) {
+        for (i = 0; i < p_sampler->num_paths; i++) {
+            if (NULL != p_sampler->str_paths[i]) free(p_sampler->str_paths[i]);
+        }
+        free(p_sampler->str_paths);
+    }
+    if (NULL != p_sampler->h_objs) free(p_sampler->h_objs);
+    if (NULL != p_sampler->p_time) free(p_sampler->p_time);
+    if (NULL != p_sampler->p_values) free(p_sampler->p_values);
+    free(p_sampler);
+}
+
+/******************************************************************************
+Callbacks processing
+******************************************************************************/
+static void cb_return_ack(vs_vpi_data_t *p_data)
+{
+    vs_vpi_log_info("Reached callback - Verisocks taking over and waiting \
+for command ...");
+    vs_vpi_return(p_data->fd_client_socket, "ack",
+        "Reached callback - Getting back to Verisocks main loop",
+        &(p_data->uuid)
+    );
+    p_data->state = VS_VPI_STATE_WAITING;
+}
+
+int vs_vpi_cb_process(vs_vpi_data_t *p_data)
+{
+    if (NULL == p_data) {
+        vs_vpi_log_error("Could not get stored data - Aborting callback");
+        return -1;
+    }
+
+    /* Check state */
+    if (p_data->state != VS_VPI_STATE_SIM_RUNNING) {
+        vs_vpi_log_error("Inconsistent state");
+        p_data->state = VS_VPI_STATE_ERROR;
+        return -1;
+    }
+
+    /* Signalling that the callback function has been reached */
+    cb_return_ack(p_data);
+    return 1;
+}
+
+int vs_vpi_cb_value_change_process(vs_vpi_watch_t *p_watch)
+{
+    int retval;
+    s_vpi_value value;
+    vs_vpi_data_t *p_data;
+
+    if (NULL == p_watch) {
+        vs_vpi_log_error("Could not get stored data - Aborting callback");
+        return -1;
+    }
+    if (!p_watch->armed) {
+        return 0;
+    }
+    p_data = p_watch->p_data;
+
+    /* Check state */
+    if (p_data->state != VS_VPI_STATE_SIM_RUNNING) {
+        vs_vpi_log_error("Inconsistent state - Aborting callback");
+        p_data->state = VS_VPI_STATE_ERROR;
+        return -1;
+    }
+
+    /* If the trigger condition is not met, get back to sim until next time.
+    The callback is registered with vpiSuppressVal: get the value here. */
+    if (p_data->trigger.is_event) {
+        retval = vs_vpi_trigger_check(&p_data->trigger, NULL);
+    } else {
+        value.format = p_watch->format;
+        vpi_get_value(p_watch->h_obj, &value);
+        retval = vs_vpi_trigger_check(&p_data->trigger, &value);
+    }
+    if (0 > retval) {
+        vs_vpi_log_error("Could not evaluate trigger - Aborting callback");
+        p_data->state = VS_VPI_STATE_ERROR;
+        return -1;
+    }
+    if (0 == retval) {
+        return 0;
+    }
+
+    /* Disarm callback (it remains registered for later use) */
+    p_watch->armed = 0;
+    cb_return_ack(p_data);
+    return 1;
+}
+
+int vs_vpi_cb_sample_process(vs_vpi_data_t *p_data)
+{
+    int remaining;
+
+    if (NULL == p_data) {
+        vs_vpi_log_error("Could not get stored data - Aborting callback");
+        return -1;
+    }
+
+    /* Check state */
+    if ((p_data->state != VS_VPI_STATE_SIM_RUNNING) ||
+        (NULL == p_data->p_sampler)) {
+        vs_vpi_log_error("Inconsistent state - Aborting callback");
+        p_data->state = VS_VPI_STATE_ERROR;
+        return -1;
+    }
+
+    /* Take sample and get back to sim until next sample, if any */
+    remaining = vs_vpi_sampler_sample(p_data->p_sampler);
+    if (0 < remaining) {
+        if (0 > vs_vpi_sampler_arm(p_data)) {
+            p_data->state = VS_VPI_STATE_ERROR;
+            return -1;
+        }
+        return 0;
+    }
+
+    /* Return the time series */
+    if (0 == remaining) {
+        vs_vpi_log_info("Reached last sample - Verisocks taking over and \
+waiting for command ...");
+        vs_vpi_sampler_return(p_data);
+    } else {
+        vs_vpi_return(p_data->fd_client_socket, "error",
+            "Error processing command run(sample) - Discarding",
+            &(p_data->uuid)
+        );
+    }
+    vs_vpi_sampler_free(p_data->p_sampler);
+    p_data->p_sampler = NULL;
+    p_data->state = VS_VPI_STATE_WAITING;
+    return 1;
+}
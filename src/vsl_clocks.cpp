@@ -124,75 +124,224 @@ namespace vsl{
         return -1;
     }
 
+    VslClock::State VslClock::get_state() const {
+        return State {b_is_enabled, b_wait_dis, cycles_counter,
+            prev_event_time, next_event_time, duty_cycle, period, period_low,
+            period_high};
+    }
+
+    void VslClock::set_state(const State& state) {
+        b_is_enabled = state.b_is_enabled;
+        b_wait_dis = state.b_wait_dis;
+        cycles_counter = state.cycles_counter;
+        prev_event_time = state.prev_event_time;
+        next_event_time = state.next_event_time;
+        duty_cycle = state.duty_cycle;
+        period = state.period;
+        period_low = state.period_low;
+        period_high = state.period_high;
+    }
+
     /***************************************************************************
     VslClockMap class methods
     ***************************************************************************/
+    static const size_t NOT_SCHEDULED = static_cast<size_t>(-1);
+
     void VslClockMap::add_clock(const char* namep, std::any datap) {
-        clock_list.push_front(VslClock {namep, datap, 0, 0.5});
-        clock_list.sort();
+        add_clock(namep, datap, 0, 0.5);
     }
 
     void VslClockMap::add_clock(const char* namep, std::any datap,
         const vsl_time_t period, const double duty_cycle)
     {
-        clock_list.push_front(
-            VslClock {namep, datap, period, duty_cycle});
-        clock_list.sort();
+        /* The clock name refers to the index key, so that namep does not
+        need to outlive the map */
+        auto it = clock_index.try_emplace(namep, clocks.size()).first;
+        insert_clock(it->second,
+            VslClock {it->first.c_str(), datap, period, duty_cycle});
     }
 
     void VslClockMap::add_clock(const char* namep, std::any datap,
         const double period, const char* unit, const double duty_cycle,
         VerilatedContext* const p_context)
     {
-        clock_list.push_front(
-            VslClock {namep, datap, period, unit, duty_cycle, p_context});
-        clock_list.sort();
+        auto it = clock_index.try_emplace(namep, clocks.size()).first;
+        insert_clock(it->second, VslClock {
+            it->first.c_str(), datap, period, unit, duty_cycle, p_context});
     }
 
-    const bool VslClockMap::has_next_event() const {
-        // Check if any clock is enabled
-        if (clock_list.empty()) {return false;}
-        for (const auto &clock : clock_list) {
-            if (clock.is_enabled()) {return true;}
+    void VslClockMap::insert_clock(size_t index, const VslClock& clock) {
+        if (index == clocks.size()) {
+            clocks.push_back(clock);
+            heap_pos.push_back(NOT_SCHEDULED);
+        } else {
+            // Clock registered again
+            clocks[index] = clock;
         }
-        return false;
+        schedule(index);
+    }
+
+    int VslClockMap::enable_clock(const std::string& name,
+        VerilatedContext* const p_context)
+    {
+        auto it = clock_index.find(name);
+        if (it == clock_index.end()) {return -1;}
+        clocks[it->second].enable(p_context);
+        schedule(it->second);
+        return 0;
+    }
+
+    int VslClockMap::disable_clock(const std::string& name) {
+        auto it = clock_index.find(name);
+        if (it == clock_index.end()) {return -1;}
+        clocks[it->second].disable();
+        schedule(it->second);
+        return 0;
+    }
+
+    int VslClockMap::set_clock_period(const std::string& name,
+        const double period, const char* unit, const double duty_cycle,
+        VerilatedContext* const p_context)
+    {
+        auto it = clock_index.find(name);
+        if (it == clock_index.end()) {return -1;}
+        int retval = clocks[it->second].set_period(
+            period, unit, duty_cycle, p_context);
+        schedule(it->second);
+        return retval;
+    }
+
+    const bool VslClockMap::has_next_event() const {
+        // Only the enabled clocks are scheduled
+        return !heap.empty();
     }
 
     const vsl_time_t VslClockMap::get_next_event() const {
-        // !! Assumes that the clocks list is not empty and already sorted
-        auto it = clock_list.begin();
-        return it->get_next_event();
+        // !! Assumes that at least one clock is enabled
+        return heap.front().time;
     }
 
     int VslClockMap::eval(vsl_time_t time) {
-        // !! Assumes that the clocks list is already sorted
         unsigned int total_evals = 0;
-        int eval_status = 0;
-        if (clock_list.empty()) {return 0;}
-        do {
-            auto it = clock_list.begin();
-            eval_status = it->eval(time);
-            if (eval_status > 0) {total_evals++;}
-            clock_list.sort();
-        } while (eval_status > 0);
+        while (!heap.empty()) {
+            size_t index = heap.front().index;
+            if (0 >= clocks[index].eval(time)) {break;}
+            total_evals++;
+            schedule(index);
+        }
         return total_evals;
     }
 
-    const bool VslClockMap::has_clock(const std::string name) {
-        if (clock_list.empty()) {return false;}
-        auto has_name = [&name](VslClock& clock) {
-            return clock.get_name().compare(name) == 0;
-        };
-        auto it = std::find_if(clock_list.begin(), clock_list.end(), has_name);
-        return it != clock_list.end();
+    const bool VslClockMap::has_clock(const std::string name) const {
+        return clock_index.count(name) > 0;
+    }
+
+    const VslClock& VslClockMap::get_clock(const std::string name) const {
+        return clocks[clock_index.at(name)];
+    }
+
+    std::vector<VslClock::State> VslClockMap::get_states() const {
+        std::vector<VslClock::State> states;
+        states.reserve(clocks.size());
+        for (const VslClock& clock : clocks) {
+            states.push_back(clock.get_state());
+        }
+        return states;
     }
 
-    VslClock& VslClockMap::get_clock(const std::string name) {
-        auto has_name = [&name](VslClock& clock) {
-            return clock.get_name().compare(name) == 0;
-        };
-        auto it = std::find_if(clock_list.begin(), clock_list.end(), has_name);
-        return *it;
+    int VslClockMap::set_states(const std::vector<VslClock::State>& states) {
+        if (states.size() != clocks.size()) {return -1;}
+        for (size_t index = 0; index < clocks.size(); index++) {
+            clocks[index].set_state(states[index]);
+            schedule(index);
+        }
+        return 0;
+    }
+
+    std::vector<double> VslClockMap::get_levels() {
+        std::vector<double> levels;
+        levels.reserve(clocks.size());
+        for (VslClock& clock : clocks) {
+            levels.push_back(clock.get_value());
+        }
+        return levels;
+    }
+
+    int VslClockMap::set_levels(const std::vector<double>& levels) {
+        if (levels.size() != clocks.size()) {return -1;}
+        for (size_t index = 0; index < clocks.size(); index++) {
+            clocks[index].set_value(levels[index]);
+        }
+        return 0;
+    }
+
+    void VslClockMap::rebind(const std::function<void*(void*)>& fn) {
+        for (VslClock& clock : clocks) {
+            clock.rebind(fn(clock.get_datap()));
+        }
+    }
+
+    /* Inserts, moves or removes a clock in the heap according to its state */
+    void VslClockMap::schedule(size_t index) {
+        const VslClock& clock = clocks[index];
+        size_t pos = heap_pos[index];
+        if (!clock.is_enabled()) {
+            if (NOT_SCHEDULED != pos) {heap_remove(pos);}
+            return;
+        }
+        if (NOT_SCHEDULED == pos) {
+            pos = heap.size();
+            heap.push_back(VslClockEvent {clock.get_next_event(), index});
+            heap_pos[index] = pos;
+            sift_up(pos);
+            return;
+        }
+        heap[pos].time = clock.get_next_event();
+        sift_up(pos);
+        sift_down(heap_pos[index]);
+    }
+
+    void VslClockMap::heap_swap(size_t pos_a, size_t pos_b) {
+        std::swap(heap[pos_a], heap[pos_b]);
+        heap_pos[heap[pos_a].index] = pos_a;
+        heap_pos[heap[pos_b].index] = pos_b;
+    }
+
+    void VslClockMap::sift_up(size_t pos) {
+        while (pos > 0) {
+            size_t parent = (pos - 1)/2;
+            if (heap[parent].time <= heap[pos].time) {break;}
+            heap_swap(pos, parent);
+            pos = parent;
+        }
+    }
+
+    void VslClockMap::sift_down(size_t pos) {
+        size_t size = heap.size();
+        while (true) {
+            size_t child = 2*pos + 1;
+            if (child >= size) {break;}
+            if ((child + 1 < size) &&
+                (heap[child + 1].time < heap[child].time)) {child++;}
+            if (heap[pos].time <= heap[child].time) {break;}
+            heap_swap(pos, child);
+            pos = child;
+        }
+    }
+
+    void VslClockMap::heap_remove(size_t pos) {
+        size_t last = heap.size() - 1;
+        heap_pos[heap[pos].index] = NOT_SCHEDULED;
+        if (pos != last) {
+            size_t moved = heap[last].index;
+            heap[pos] = heap[last];
+            heap_pos[moved] = pos;
+            heap.pop_back();
+            sift_up(pos);
+            sift_down(heap_pos[moved]);
+        } else {
+            heap.pop_back();
+        }
     }
 
 } // namespace vsl
@@ -0,0 +1,367 @@
+/**************************************************************************//**
+ @file vsl_trigger.cpp
+ @brief Trigger expressions for the Verisocks Verilator integration
+
+ @author Jérémie Chabloz
+ @copyright Copyright (c) 2026 Jérémie Chabloz Distributed under the MIT
+ License. See file for details.
+******************************************************************************/
+/*
+Copyright (c) 2026 Jérémie Chabloz
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "vsl/vsl_trigger.hpp"
+#include "vsl/vsl_utils.hpp"
+#include "vs_logging.h"
+#include <cctype>
+#include <cstdlib>
+
+namespace vsl{
+
+    /***************************************************************************
+    Parser
+    ***************************************************************************/
+    struct VslTrigger::Parser {
+        const std::string& expr;
+        VslVarMap& var_map;
+        std::vector<Op>& program;
+        size_t pos {0};
+        size_t depth {0};       // Current stack depth
+        size_t max_depth {0};   // Maximum stack depth
+        size_t nesting {0};     // Current nesting level of unary expressions
+        static constexpr size_t max_nesting {256};
+
+        Parser(const std::string& expr, VslVarMap& var_map,
+            std::vector<Op>& program) :
+            expr {expr}, var_map {var_map}, program {program} {};
+
+        int error(const char* str_msg) {
+            vs_log_mod_error("vsl_trigger", "%s at position %d in expression \
+\"%s\"", str_msg, (int) pos, expr.c_str());
+            return -1;
+        }
+
+        /* Character as expected by the <cctype> functions */
+        int at(size_t i) const {
+            return static_cast<unsigned char>(expr[i]);
+        }
+
+        void skip_spaces() {
+            while ((pos < expr.size()) && std::isspace(at(pos))) pos++;
+        }
+
+        bool accept(const char* str_token) {
+            skip_spaces();
+            size_t len = std::char_traits<char>::length(str_token);
+            if (0 != expr.compare(pos, len, str_token)) return false;
+            pos += len;
+            return true;
+        }
+
+        /* Emits an instruction, with its effect on the stack depth */
+        void emit(OpCode code, int stack_incr, double value = 0.0,
+            VslVar* p_var = nullptr, size_t index = 0) {
+            program.push_back(Op {code, value, p_var, index});
+            depth += stack_incr;
+            if (depth > max_depth) max_depth = depth;
+        }
+
+        /* or := and ('||' and)* */
+        int parse_or() {
+            if (0 > parse_and()) return -1;
+            while (accept("||")) {
+                if (0 > parse_and()) return -1;
+                emit(OP_OR, -1);
+            }
+            return 0;
+        }
+
+        /* and := cmp ('&&' cmp)* */
+        int parse_and() {
+            if (0 > parse_cmp()) return -1;
+            while (accept("&&")) {
+                if (0 > parse_cmp()) return -1;
+                emit(OP_AND, -1);
+            }
+            return 0;
+        }
+
+        /* cmp := mask (cmp_op mask)? */
+        int parse_cmp() {
+            if (0 > parse_mask()) return -1;
+            static const struct {const char* str; OpCode code;} cmp_ops[] = {
+                {"==", OP_EQ}, {"!=", OP_NE}, {"<=", OP_LE}, {">=", OP_GE},
+                {"<", OP_LT}, {">", OP_GT}};
+            for (const auto& cmp_op : cmp_ops) {
+                if (accept(cmp_op.str)) {
+                    if (0 > parse_mask()) return -1;
+                    emit(cmp_op.code, -1);
+                    return 0;
+                }
+            }
+            return 0;
+        }
+
+        /* mask := unary ('&' unary)* */
+        int parse_mask() {
+            if (0 > parse_unary()) return -1;
+            while (true) {
+                skip_spaces();
+                if ((pos + 1 < expr.size()) && (expr[pos] == '&') &&
+                    (expr[pos + 1] != '&'))
+                {
+                    pos++;
+                    if (0 > parse_unary()) return -1;
+                    emit(OP_MASK, -1);
+                } else {
+                    return 0;
+                }
+            }
+        }
+
+        /* Limits the recursion depth of the parser */
+        int parse_unary() {
+            if (nesting >= max_nesting) {
+                return error("Expression nested too deeply");
+            }
+            nesting++;
+            int retval = parse_unary_nested();
+            nesting--;
+            return retval;
+        }
+
+        /* unary := '!' unary | edge '(' or ')' | '(' or ')' | number | path */
+        int parse_unary_nested() {
+            skip_spaces();
+            if ((pos < expr.size()) && (expr[pos] == '!') &&
+                ((pos + 1 >= expr.size()) || (expr[pos + 1] != '=')))
+            {
+                pos++;
+                if (0 > parse_unary()) return -1;
+                emit(OP_NOT, 0);
+                return 0;
+            }
+            static const struct {const char* str; OpCode code;} edges[] = {
+                {"rise(", OP_RISE}, {"fall(", OP_FALL}, {"change(", OP_CHANGE}};
+            for (const auto& edge : edges) {
+                if (accept(edge.str)) {
+                    if (0 > parse_or()) return -1;
+                    if (!accept(")")) return error("Missing )");
+                    emit(edge.code, 0);
+                    return 0;
+                }
+            }
+            if (accept("(")) {
+                if (0 > parse_or()) return -1;
+                if (!accept(")")) return error("Missing )");
+                return 0;
+            }
+            if (pos >= expr.size()) return error("Unexpected end");
+            if (std::isdigit(at(pos)) || ((expr[pos] == '-') &&
+                (pos + 1 < expr.size()) && std::isdigit(at(pos + 1))))
+            {
+                return parse_number();
+            }
+            return parse_path();
+        }
+
+        /* number := '-'? (decimal | hexadecimal) */
+        int parse_number() {
+            bool negative = (expr[pos] == '-');
+            if (negative) pos++;
+            const char* cstr_start = expr.c_str() + pos;
+            char* cstr_end = nullptr;
+            double value;
+            if ((0 == expr.compare(pos, 2, "0x")) ||
+                (0 == expr.compare(pos, 2, "0X")))
+            {
+                value = static_cast<double>(
+                    std::strtoull(cstr_start + 2, &cstr_end, 16));
+                if (cstr_end == cstr_start + 2) return error("Invalid number");
+            } else {
+                value = std::strtod(cstr_start, &cstr_end);
+            }
+            pos += static_cast<size_t>(cstr_end - cstr_start);
+            emit(OP_CONST, 1, negative ? -value : value);
+            return 0;
+        }
+
+        /* Operands have to be numerical values */
+        int check_operand(VslVar* p_var) {
+            if (VLVT_WDATA == p_var->get_vltype()) {
+                return error("Wide variables not supported");
+            }
+            if (VSL_TYPE_EVENT == p_var->get_type()) {
+                return error("Events not supported");
+            }
+            return 0;
+        }
+
+        int parse_path() {
+            size_t start = pos;
+            while ((pos < expr.size()) && (std::isalnum(at(pos)) ||
+                (expr[pos] == '_') || (expr[pos] == '.') ||
+                (expr[pos] == '$') || (expr[pos] == '[') ||
+                (expr[pos] == ']') || (expr[pos] == ':')))
+            {
+                pos++;
+            }
+            if (start == pos) return error("Unexpected character");
+            std::string str_path = expr.substr(start, pos - start);
+            if (!has_range(str_path)) {
+                VslVar* p_var = var_map.get_var(str_path);
+                if (nullptr == p_var) return error("Unknown variable");
+                if (p_var->is_array()) return error("Array index missing");
+                if (0 > check_operand(p_var)) return -1;
+                emit(OP_LOAD, 1, 0.0, p_var);
+                return 0;
+            }
+
+            /* Array element, with one index per dimension */
+            VslArrayRanges path_ranges = get_ranges(str_path);
+            VslVar* p_var = var_map.get_var(path_ranges.array_name);
+            if (nullptr == p_var) return error("Unknown variable");
+            if (0 > check_operand(p_var)) return -1;
+            std::vector<size_t> shape = p_var->get_shape();
+            if (VSL_TYPE_ARRAY == p_var->get_type()) {
+                shape = {p_var->get_depth()};
+            } else if (VSL_TYPE_MDARRAY != p_var->get_type()) {
+                return error("Index on a variable which is not an array");
+            }
+            if (path_ranges.ranges.size() != shape.size()) {
+                return error("One index per array dimension expected");
+            }
+            size_t index = 0;
+            for (size_t dim = 0; dim < shape.size(); dim++) {
+                const VslArrayRange& range = path_ranges.ranges[dim];
+                if (range.left != range.right) {
+                    return error("Ranges not supported, only indexes");
+                }
+                if (range.left >= shape[dim]) {
+                    return error("Index exceeds array depth");
+                }
+                index = index * shape[dim] + range.left;
+            }
+            emit(OP_LOAD_AT, 1, 0.0, p_var, index);
+            return 0;
+        }
+    };
+
+    /***************************************************************************
+    VslTrigger class methods
+    ***************************************************************************/
+
+    /* Bit pattern of a mask operand, negative values as two's complement */
+    static uint64_t to_mask(double value) {
+        if (!(value > -9223372036854775808.0)) {
+            return (value < 0.0) ? (UINT64_C(1) << 63) : 0u;
+        }
+        if (value < 0.0) {
+            return static_cast<uint64_t>(static_cast<int64_t>(value));
+        }
+        if (value >= 18446744073709551616.0) return UINT64_MAX;
+        return static_cast<uint64_t>(value);
+    }
+
+    int VslTrigger::compile(const std::string& expr, VslVarMap& var_map) {
+        clear();
+        Parser parser {expr, var_map, program};
+        int retval = parser.parse_or();
+        parser.skip_spaces();
+        if ((0 == retval) && (parser.pos < expr.size())) {
+            retval = parser.error("Unexpected token");
+        }
+        if (0 > retval) {
+            clear();
+            return -1;
+        }
+        this->expr = expr;
+        stack.resize(parser.max_depth);
+
+        /* Initialize edge detectors with the current values */
+        eval();
+        return 0;
+    }
+
+    void VslTrigger::clear() {
+        expr.clear();
+        program.clear();
+    }
+
+    bool VslTrigger::eval() {
+        if (program.empty()) return false;
+        double* p_top = stack.data() - 1;
+        for (auto& op : program) {
+            double value;
+            switch (op.code) {
+                case OP_CONST:
+                    *(++p_top) = op.value;
+                    break;
+                case OP_LOAD:
+                    *(++p_top) = op.p_var->get_value();
+                    break;
+                case OP_LOAD_AT:
+                    *(++p_top) = op.p_var->get_array_value(op.index);
+                    break;
+                case OP_RISE:
+                    value = *p_top;
+                    *p_top = ((0.0 != value) && (0.0 == op.value)) ? 1.0 : 0.0;
+                    op.value = value;
+                    break;
+                case OP_FALL:
+                    value = *p_top;
+                    *p_top = ((0.0 == value) && (0.0 != op.value)) ? 1.0 : 0.0;
+                    op.value = value;
+                    break;
+                case OP_CHANGE:
+                    value = *p_top;
+                    *p_top = (value != op.value) ? 1.0 : 0.0;
+                    op.value = value;
+                    break;
+                case OP_MASK:
+                    p_top--;
+                    *p_top = static_cast<double>(
+                        to_mask(*p_top) & to_mask(*(p_top + 1)));
+                    break;
+                case OP_EQ: p_top--; *p_top = (*p_top == p_top[1]); break;
+                case OP_NE: p_top--; *p_top = (*p_top != p_top[1]); break;
+                case OP_LT: p_top--; *p_top = (*p_top < p_top[1]); break;
+                case OP_LE: p_top--; *p_top = (*p_top <= p_top[1]); break;
+                case OP_GT: p_top--; *p_top = (*p_top > p_top[1]); break;
+                case OP_GE: p_top--; *p_top = (*p_top >= p_top[1]); break;
+                case OP_NOT:
+                    *p_top = (0.0 == *p_top) ? 1.0 : 0.0;
+                    break;
+                case OP_AND:
+                    p_top--;
+                    *p_top = ((0.0 != *p_top) && (0.0 != p_top[1])) ? 1.0 : 0.0;
+                    break;
+                case OP_OR:
+                    p_top--;
+                    *p_top = ((0.0 != *p_top) || (0.0 != p_top[1])) ? 1.0 : 0.0;
+                    break;
+            }
+        }
+        return 0.0 != *p_top;
+    }
+
+} // namespace vsl
+// EOF
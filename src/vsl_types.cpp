@@ -32,215 +32,648 @@ SOFTWARE.
 #include "vsl/vsl_types.hpp"
 #include "verilated.h"
 #include <any>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+#include <vector>
 
 namespace vsl{
 
+/******************************************************************************
+Typed accessors
+******************************************************************************/
+template <typename T>
+static double load(const void* datap) {
+    return static_cast<double>(*static_cast<const T*>(datap));
+}
+
+template <typename T>
+static double load_at(const void* datap, size_t index) {
+    return static_cast<double>(static_cast<const T*>(datap)[index]);
+}
+
 template <typename T>
-static inline T __get_value(std::any &datap) {
-    return *(std::any_cast<T*>(datap));
+static int store(void* datap, double value) {
+    *static_cast<T*>(datap) = static_cast<T>(value);
+    return 0;
 }
 
 template <typename T>
-static inline T __get_array_value(std::any &datap, size_t index) {
-    return std::any_cast<T*>(datap)[index];
+static int store_at(void* datap, double value, size_t index) {
+    static_cast<T*>(datap)[index] = static_cast<T>(value);
+    return 0;
 }
 
 template <typename T>
-static inline void __set_value(std::any &datap, double value)
+static int load_block(const void* datap, double* p_values, size_t index,
+    size_t num)
 {
-    *(std::any_cast<T*>(datap)) = static_cast<T>(value);
+    const T* p_data = static_cast<const T*>(datap) + index;
+    for (size_t i = 0; i < num; i++) {
+        p_values[i] = static_cast<double>(p_data[i]);
+    }
+    return 0;
 }
 
 template <typename T>
-static inline void __set_array_value(std::any &datap, double value, size_t index)
+static int store_block(void* datap, const double* p_values, size_t index,
+    size_t num)
+{
+    T* p_data = static_cast<T*>(datap) + index;
+    for (size_t i = 0; i < num; i++) {
+        p_data[i] = static_cast<T>(p_values[i]);
+    }
+    return 0;
+}
+
+template <typename T>
+static int load_words(const void* datap, EData* p_words, size_t num_words,
+    size_t index)
+{
+    uint64_t value = static_cast<uint64_t>(
+        static_cast<const T*>(datap)[index]);
+    p_words[0] = static_cast<EData>(value);
+    if (num_words > 1) p_words[1] = static_cast<EData>(value >> 32);
+    return 0;
+}
+
+template <typename T>
+static int store_words(void* datap, const EData* p_words, size_t num_words,
+    size_t index)
+{
+    uint64_t value = p_words[0];
+    if (num_words > 1) value |= static_cast<uint64_t>(p_words[1]) << 32;
+    static_cast<T*>(datap)[index] = static_cast<T>(value);
+    return 0;
+}
+
+static int load_wide(const void* datap, EData* p_words, size_t num_words,
+    size_t index)
+{
+    std::memcpy(p_words, static_cast<const EData*>(datap) + index*num_words,
+        num_words*sizeof(EData));
+    return 0;
+}
+
+static int store_wide(void* datap, const EData* p_words, size_t num_words,
+    size_t index)
 {
-    std::any_cast<T*>(datap)[index] = static_cast<T>(value);
+    std::memcpy(static_cast<EData*>(datap) + index*num_words, p_words,
+        num_words*sizeof(EData));
+    return 0;
+}
+
+static double load_event(const void* datap) {
+    return static_cast<const VlEvent*>(datap)->isTriggered() ? 1.0 : 0.0;
+}
+
+static int store_event(void* datap, double) {
+    static_cast<VlEvent*>(datap)->fire();
+    return 0;
+}
+
+/* In case of a non-scalar (resp. non-array) variable, a value of 0.0 is
+returned by default - the check for the variable type should be performed
+beforehand */
+static double load_none(const void*) {return 0.0;}
+static double load_at_none(const void*, size_t) {return 0.0;}
+
+static double load_not_supported(const void*) {
+    vs_log_mod_warning("vsl_types",
+        "Type not supported (yet) for scalar variable - Returning 0.0");
+    return 0.0;
+}
+
+static int store_not_supported(void*, double) {
+    vs_log_mod_error("vsl_types",
+        "Type not supported (yet) for scalar variable");
+    return -1;
+}
+
+static int store_clock_not_supported(void*, double) {
+    vs_log_mod_error("vsl_types", "Type not supported for clock variable");
+    return -1;
+}
+
+static int store_param(void*, double) {
+    vs_log_mod_error("vsl_types", "Cannot set parameter value");
+    return -1;
 }
 
+static int store_non_scalar(void*, double) {
+    vs_log_mod_error("vsl_types", "Cannot set variable value (non-scalar)");
+    return -1;
+}
+
+static int store_at_not_supported(void*, double, size_t) {
+    vs_log_mod_error("vsl_types", "Type not supported for array value");
+    return -1;
+}
+
+static int store_at_non_array(void*, double, size_t) {
+    vs_log_mod_error("vsl_types", "Cannot set value (not part of an array)");
+    return -1;
+}
+
+static int load_block_non_array(const void*, double*, size_t, size_t) {
+    vs_log_mod_error("vsl_types", "Cannot get values (not an array)");
+    return -1;
+}
+
+static int store_block_non_array(void*, const double*, size_t, size_t) {
+    vs_log_mod_error("vsl_types", "Cannot set values (not an array)");
+    return -1;
+}
+
+static int store_block_not_supported(void*, const double*, size_t, size_t) {
+    vs_log_mod_error("vsl_types", "Type not supported for array value");
+    return -1;
+}
+
+static int load_block_not_supported(const void*, double*, size_t, size_t) {
+    vs_log_mod_error("vsl_types", "Type not supported for array value");
+    return -1;
+}
+
+static int load_words_not_supported(const void*, EData*, size_t, size_t) {
+    vs_log_mod_error("vsl_types", "Type not supported for integer value");
+    return -1;
+}
+
+static int store_words_not_supported(void*, const EData*, size_t, size_t) {
+    vs_log_mod_error("vsl_types", "Type not supported for integer value");
+    return -1;
+}
+
+static int store_words_param(void*, const EData*, size_t, size_t) {
+    vs_log_mod_error("vsl_types", "Cannot set parameter value");
+    return -1;
+}
+
+static double load_wide_not_supported(const void*) {
+    vs_log_mod_warning("vsl_types",
+        "Wide variable cannot be converted to a number - Returning 0.0");
+    return 0.0;
+}
+
+static double load_at_wide_not_supported(const void*, size_t) {
+    vs_log_mod_warning("vsl_types",
+        "Wide variable cannot be converted to a number - Returning 0.0");
+    return 0.0;
+}
+
+static int store_wide_not_supported(void*, double) {
+    vs_log_mod_error("vsl_types",
+        "Wide variable cannot be set from a number");
+    return -1;
+}
+
+static int store_at_wide_not_supported(void*, double, size_t) {
+    vs_log_mod_error("vsl_types",
+        "Wide variable cannot be set from a number");
+    return -1;
+}
+
+static int load_block_wide_not_supported(const void*, double*, size_t,
+    size_t)
+{
+    vs_log_mod_error("vsl_types",
+        "Wide variable cannot be converted to a number");
+    return -1;
+}
+
+static int store_block_wide_not_supported(void*, const double*, size_t,
+    size_t)
+{
+    vs_log_mod_error("vsl_types",
+        "Wide variable cannot be set from a number");
+    return -1;
+}
+
+const VslVarOps VslVar::ops_none {
+    load_none, load_at_none, store_non_scalar, store_at_non_array,
+    load_block_non_array, store_block_non_array,
+    load_words_not_supported, store_words_not_supported};
+
+static const VslVarOps ops_event {
+    load_event, load_at_none, store_event, store_at_non_array,
+    load_block_non_array, store_block_non_array,
+    load_words_not_supported, store_words_not_supported};
+
 /**
- * @brief Retrieves the value of the variable as a double.
+ * @brief Returns the accessors for a variable type and a value type T
  *
- * This method returns the value stored in the VslVar instance, converted to a
- * double.
- * The returned value depends on the variable's type (`type`) and value type
- * (`vltype`):
- * - For scalar and parameter types, the underlying value is cast to double.
- * - For event types, returns 1.0 if the event is triggered, otherwise 0.0.
- * - For unsupported or non-scalar types, returns 0.0.
- *
- * @return The value of the variable as a double, or 0.0 if the type is
- * unsupported.
+ * @param type Variable type
+ * @return Pointer to the accessors table
  */
-double VslVar::get_value() {
+template <typename T>
+static const VslVarOps* get_ops(VslType type) {
+    static const VslVarOps ops_scalar {
+        load<T>, load_at_none, store<T>, store_at_non_array,
+        load_block_non_array, store_block_non_array,
+        load_words<T>, store_words<T>};
+    static const VslVarOps ops_clock {
+        load<T>, load_at_none,
+        std::is_same<T, uint8_t>::value ? store<T> : store_clock_not_supported,
+        store_at_non_array, load_block_non_array, store_block_non_array,
+        load_words<T>, store_words_not_supported};
+    static const VslVarOps ops_param {
+        load<T>, load_at_none, store_param, store_at_non_array,
+        load_block_non_array, store_block_non_array,
+        load_words<T>, store_words_param};
+    static const VslVarOps ops_array {
+        load_none, load_at<T>, store_non_scalar, store_at<T>,
+        load_block<T>, store_block<T>,
+        load_words<T>, store_words<T>};
     switch (type) {
-        case VSL_TYPE_SCALAR:
-        case VSL_TYPE_CLOCK:
-            switch (vltype) {
-                case VLVT_UINT8:
-                    return static_cast<double>(__get_value<uint8_t>(datap));
-                case VLVT_UINT16:
-                    return static_cast<double>(__get_value<uint16_t>(datap));
-                case VLVT_UINT32:
-                    return static_cast<double>(__get_value<uint32_t>(datap));
-                case VLVT_UINT64:
-                    return static_cast<double>(__get_value<uint64_t>(datap));
-                case VLVT_REAL:
-                    return __get_value<double>(datap);
-                default:
-                    vs_log_mod_warning(
-                        "vsl_types",
-                        "Type not supported (yet) for scalar variable - \
-Returning 0.0"
-                    );
-       return 0.0;
-            }
-        case VSL_TYPE_PARAM:
-            switch (vltype) {
-                case VLVT_UINT8:
-                    return static_cast<const double>(
-                        __get_value<const uint8_t>(datap));
-                case VLVT_UINT16:
-                    return static_cast<const double>(
-                        __get_value<const uint16_t>(datap));
-                case VLVT_UINT32:
-                    return static_cast<const double>(
-                        __get_value<const uint32_t>(datap));
-                case VLVT_UINT64:
-                    return static_cast<const double>(
-                        __get_value<const uint64_t>(datap));
-                case VLVT_REAL:
-                    return __get_value<const double>(datap);
-                default:
-                    return 0.0;
-            }
-        case VSL_TYPE_EVENT:
-            if (std::any_cast<VlEvent*>(datap)->isTriggered())
-                return 1.0f;
-            else
-                return 0.0;
-        default:
-            /* In case of a non-scalar variable, a value of 0.0 is returned by
-            default - the check for the variable type should be performed
-            beforehand */
-            return 0.0;
+        case VSL_TYPE_SCALAR: return &ops_scalar;
+        case VSL_TYPE_CLOCK: return &ops_clock;
+        case VSL_TYPE_PARAM: return &ops_param;
+        case VSL_TYPE_ARRAY:
+        case VSL_TYPE_MDARRAY: return &ops_array;
+        default: return &VslVar::ops_none;
     }
 }
 
-double VslVar::get_array_value(size_t index) {
+/**
+ * @brief Returns the accessors for a real variable, which has no integer
+ * representation
+ *
+ * @param type Variable type
+ * @return Pointer to the accessors table
+ */
+static const VslVarOps* get_ops_real(VslType type) {
+    static const VslVarOps ops_scalar {
+        load<double>, load_at_none, store<double>, store_at_non_array,
+        load_block_non_array, store_block_non_array,
+        load_words_not_supported, store_words_not_supported};
+    static const VslVarOps ops_clock {
+        load<double>, load_at_none, store_clock_not_supported,
+        store_at_non_array, load_block_non_array, store_block_non_array,
+        load_words_not_supported, store_words_not_supported};
+    static const VslVarOps ops_param {
+        load<double>, load_at_none, store_param, store_at_non_array,
+        load_block_non_array, store_block_non_array,
+        load_words_not_supported, store_words_not_supported};
+    static const VslVarOps ops_array {
+        load_none, load_at<double>, store_non_scalar, store_at<double>,
+        load_block<double>, store_block<double>,
+        load_words_not_supported, store_words_not_supported};
     switch (type) {
+        case VSL_TYPE_SCALAR: return &ops_scalar;
+        case VSL_TYPE_CLOCK: return &ops_clock;
+        case VSL_TYPE_PARAM: return &ops_param;
         case VSL_TYPE_ARRAY:
-            switch (vltype) {
-                case VLVT_UINT8:
-                    return static_cast<double>(
-                        __get_array_value<uint8_t>(datap, index));
-                case VLVT_UINT16:
-                    return static_cast<double>(
-                        __get_array_value<uint16_t>(datap, index));
-                case VLVT_UINT32:
-                    return static_cast<double>(
-                        __get_array_value<uint32_t>(datap, index));
-                case VLVT_UINT64:
-                    return static_cast<double>(
-                        __get_array_value<uint64_t>(datap, index));
-                case VLVT_REAL:
-                    return __get_array_value<double>(datap, index);
-                default:
-                    return 0.0;
-            }
-        default:
-            /* In case of a non-array variable, a value of 0.0 is returned by
-            default - the check for the variable type should be performed
-            beforehand */
-            return 0.0;
+        case VSL_TYPE_MDARRAY: return &ops_array;
+        default: return &VslVar::ops_none;
     }
 }
 
-int VslVar::set_value(double value) {
+/**
+ * @brief Returns the accessors for a wide variable (VLVT_WDATA), which is
+ * only accessed as an array of words
+ *
+ * @param type Variable type
+ * @return Pointer to the accessors table
+ */
+static const VslVarOps* get_ops_wide(VslType type) {
+    static const VslVarOps ops_scalar {
+        load_wide_not_supported, load_at_none, store_wide_not_supported,
+        store_at_non_array, load_block_non_array, store_block_non_array,
+        load_wide, store_wide};
+    static const VslVarOps ops_param {
+        load_wide_not_supported, load_at_none, store_param,
+        store_at_non_array, load_block_non_array, store_block_non_array,
+        load_wide, store_words_param};
+    static const VslVarOps ops_array {
+        load_none, load_at_wide_not_supported, store_non_scalar,
+        store_at_wide_not_supported, load_block_wide_not_supported,
+        store_block_wide_not_supported, load_wide, store_wide};
     switch (type) {
-        case VSL_TYPE_SCALAR:
-            switch (vltype) {
-                case VLVT_UINT8:
-                    __set_value<uint8_t>(datap, value);
-                    return 0;
-                case VLVT_UINT16:
-                    __set_value<uint16_t>(datap, value);
-                    return 0;
-                case VLVT_UINT32:
-                    __set_value<uint32_t>(datap, value);
-                    return 0;
-                case VLVT_UINT64:
-                    __set_value<uint64_t>(datap, value);
-                    return 0;
-                case VLVT_REAL:
-                    *(std::any_cast<double*>(datap)) = value;
-                    return 0;
-                default:
-                    vs_log_mod_error(
-                        "vsl_types",
-                        "Type not supported (yet) for scalar variable");
-                    return -1;
-            }
-        case VSL_TYPE_CLOCK:
-            if (VLVT_UINT8 == vltype) {
-                __set_value<uint8_t>(datap, value);
-                return 0;
-            } else {
-                vs_log_mod_error(
-                    "vsl_types",
-                    "Type not supported for clock variable");
-                return -1;
-            }
-        case VSL_TYPE_EVENT:
-            std::any_cast<VlEvent*>(datap)->fire();
-            return 0;
-        case VSL_TYPE_PARAM:
-            vs_log_mod_error(
-                "vsl_types", "Cannot set parameter value");
-            return -1;
-        default:
-            vs_log_mod_error(
-                "vsl_types", "Cannot set variable value (non-scalar)");
-            return -1;
+        case VSL_TYPE_SCALAR: return &ops_scalar;
+        case VSL_TYPE_PARAM: return &ops_param;
+        case VSL_TYPE_ARRAY:
+        case VSL_TYPE_MDARRAY: return &ops_array;
+        default: return nullptr;
     }
 }
 
-int VslVar::set_array_value(double value, size_t index) {
+/**
+ * @brief Returns the accessors for a variable with a value type which is not
+ * supported
+ *
+ * @param type Variable type
+ * @return Pointer to the accessors table
+ */
+static const VslVarOps* get_ops_not_supported(VslType type) {
+    static const VslVarOps ops_scalar {
+        load_not_supported, load_at_none, store_not_supported,
+        store_at_non_array, load_block_non_array, store_block_non_array,
+        load_words_not_supported, store_words_not_supported};
+    static const VslVarOps ops_clock {
+        load_not_supported, load_at_none, store_clock_not_supported,
+        store_at_non_array, load_block_non_array, store_block_non_array,
+        load_words_not_supported, store_words_not_supported};
+    static const VslVarOps ops_param {
+        load_none, load_at_none, store_param, store_at_non_array,
+        load_block_non_array, store_block_non_array,
+        load_words_not_supported, store_words_not_supported};
+    static const VslVarOps ops_array {
+        load_none, load_at_none, store_non_scalar, store_at_not_supported,
+        load_block_not_supported, store_block_not_supported,
+        load_words_not_supported, store_words_not_supported};
     switch (type) {
+        case VSL_TYPE_SCALAR: return &ops_scalar;
+        case VSL_TYPE_CLOCK: return &ops_clock;
+        case VSL_TYPE_PARAM: return &ops_param;
         case VSL_TYPE_ARRAY:
-            if (index > (depth - 1)) {
-                vs_log_mod_error(
-                    "vsl_types", "Index exceeds array depth");
+        case VSL_TYPE_MDARRAY: return &ops_array;
+        default: return &VslVar::ops_none;
+    }
+}
+
+/**
+ * @brief Gets the typed pointer held by a std::any, whether it has been
+ * provided as a pointer to T or a pointer to const T.
+ *
+ * @param datap Pointer held as a std::any
+ * @return Typed pointer, nullptr if the pointer type does not match
+ */
+template <typename T>
+static void* get_pointer(const std::any& datap) {
+    if (auto pp = std::any_cast<T*>(&datap)) return *pp;
+    if (auto pp = std::any_cast<const T*>(&datap)) {
+        return const_cast<T*>(*pp);
+    }
+    return nullptr;
+}
+
+template <typename T>
+static const VslVarOps* resolve(const std::any& any_datap, VslType type,
+    void** p_datap)
+{
+    *p_datap = get_pointer<T>(any_datap);
+    if (nullptr == *p_datap) return nullptr;
+    return get_ops<T>(type);
+}
+
+/******************************************************************************
+VslVar class
+******************************************************************************/
+VslVar::VslVar(const char* namep, std::any datap, VerilatedVarType vltype,
+    VslType type, size_t dims, size_t width, size_t depth,
+    const std::vector<size_t>& shape) :
+    namep {namep}, vltype {vltype}, type {type}, dims {dims}, width {width},
+    depth {depth}, shape {shape}
+{
+    const VslVarOps* p_typed_ops = nullptr;
+    if (VSL_TYPE_MDARRAY == type) {
+        if (shape.empty()) {
+            vs_log_mod_error("vsl_types",
+                "Variable %s - Multi-dimensional array without shape", namep);
+            p_ops = get_ops_not_supported(type);
+            return;
+        }
+        this->dims = shape.size() + 1;
+        this->depth = 1;
+        for (auto num : shape) this->depth *= num;
+    }
+    if (VSL_TYPE_EVENT == type) {
+        this->datap = get_pointer<VlEvent>(datap);
+        if (nullptr != this->datap) p_typed_ops = &ops_event;
+    } else {
+        switch (vltype) {
+            case VLVT_UINT8:
+                p_typed_ops = resolve<uint8_t>(datap, type, &this->datap);
+                break;
+            case VLVT_UINT16:
+                p_typed_ops = resolve<uint16_t>(datap, type, &this->datap);
+                break;
+            case VLVT_UINT32:
+                p_typed_ops = resolve<uint32_t>(datap, type, &this->datap);
+                break;
+            case VLVT_UINT64:
+                p_typed_ops = resolve<uint64_t>(datap, type, &this->datap);
+                break;
+            case VLVT_REAL:
+                this->datap = get_pointer<double>(datap);
+                if (nullptr != this->datap) p_typed_ops = get_ops_real(type);
+                break;
+            case VLVT_WDATA:
+                this->datap = get_pointer<EData>(datap);
+                if (nullptr == this->datap) break;
+                p_typed_ops = get_ops_wide(type);
+                if (nullptr == p_typed_ops) {
+                    vs_log_mod_error("vsl_types",
+                        "Variable %s - Wide type not supported for this \
+variable type", namep);
+                    this->datap = nullptr;
+                    p_ops = get_ops_not_supported(type);
+                    return;
+                }
+                break;
+            default:
+                p_ops = get_ops_not_supported(type);
+                return;
+        }
+    }
+    if (nullptr == p_typed_ops) {
+        vs_log_mod_error("vsl_types",
+            "Variable %s - Pointer type does not match the variable type",
+            namep);
+        this->datap = nullptr;
+        p_ops = get_ops_not_supported(type);
+        return;
+    }
+    p_ops = p_typed_ops;
+}
+
+int VslVar::set_array_value(double value, size_t index) {
+    if (is_array() && (index > (depth - 1))) {
+        vs_log_mod_error(
+            "vsl_types", "Index exceeds array depth");
+        return -1;
+    }
+    return p_ops->set_array_value(datap, value, index);
+}
+
+int VslVar::get_array_values(double* p_values, size_t index, size_t num) {
+    if (is_array() && ((index > depth) || (num > depth - index)))
+    {
+        vs_log_mod_error("vsl_types", "Index exceeds array depth");
+        return -1;
+    }
+    return p_ops->get_array_values(datap, p_values, index, num);
+}
+
+int VslVar::set_array_values(const double* p_values, size_t index,
+    size_t num)
+{
+    if (is_array() && ((index > depth) || (num > depth - index)))
+    {
+        vs_log_mod_error("vsl_types", "Index exceeds array depth");
+        return -1;
+    }
+    return p_ops->set_array_values(datap, p_values, index, num);
+}
+
+/******************************************************************************
+Integer-exact accessors
+******************************************************************************/
+size_t VslVar::get_num_words() const {
+    if (width <= VL_EDATASIZE) return 1;
+    return (width + VL_EDATASIZE - 1)/VL_EDATASIZE;
+}
+
+size_t VslVar::get_size() const {
+    size_t size {0};
+    if (VSL_TYPE_EVENT == type) return 0;
+    switch (vltype) {
+        case VLVT_UINT8: size = sizeof(CData); break;
+        case VLVT_UINT16: size = sizeof(SData); break;
+        case VLVT_UINT32: size = sizeof(IData); break;
+        case VLVT_UINT64: size = sizeof(QData); break;
+        case VLVT_REAL: size = sizeof(double); break;
+        case VLVT_WDATA: size = get_num_words()*sizeof(EData); break;
+        default: return 0;
+    }
+    return is_array() ? size*depth : size;
+}
+
+int VslVar::get_words(EData* p_words, size_t index) {
+    if (is_array() && (index > (depth - 1))) {
+        vs_log_mod_error("vsl_types", "Index exceeds array depth");
+        return -1;
+    }
+    return p_ops->get_words(datap, p_words, get_num_words(), index);
+}
+
+int VslVar::set_words(const EData* p_words, size_t index) {
+    if (is_array() && (index > (depth - 1))) {
+        vs_log_mod_error("vsl_types", "Index exceeds array depth");
+        return -1;
+    }
+    /* Bits beyond the variable width are expected to be zero */
+    size_t num_words = get_num_words();
+    size_t num_msb = width % VL_EDATASIZE;
+    if ((0 != num_msb) && (0 != (p_words[num_words - 1] >> num_msb))) {
+        vs_log_mod_error("vsl_types", "Value exceeds variable width (%zu)",
+            width);
+        return -1;
+    }
+    return p_ops->set_words(datap, p_words, num_words, index);
+}
+
+int VslVar::get_hex_value(std::string& str_value, size_t index) {
+    static const char hex_digits[] = "0123456789abcdef";
+    size_t num_words = get_num_words();
+    std::vector<EData> words(num_words);
+    if (0 > get_words(words.data(), index)) return -1;
+
+    size_t num_digits = (width > 0) ? (width + 3)/4 : 2*sizeof(EData);
+    str_value.assign(num_digits + 2, '0');
+    str_value[1] = 'x';
+    for (size_t i = 0; i < num_digits; i++) {
+        EData word = words[i/(2*sizeof(EData))];
+        unsigned int nibble = (word >> (4*(i % (2*sizeof(EData))))) & 0xfu;
+        str_value[num_digits + 1 - i] = hex_digits[nibble];
+    }
+    return 0;
+}
+
+int VslVar::set_hex_value(const char* str_value, size_t index) {
+    if (nullptr == str_value) return -1;
+    const char* p_char = str_value;
+    if ((p_char[0] == '0') && ((p_char[1] == 'x') || (p_char[1] == 'X'))) {
+        p_char += 2;
+    }
+    std::vector<EData> words(get_num_words(), 0u);
+    size_t num_nibbles = 0;
+    const char* p_end = p_char + strlen(p_char);
+    if (p_end == p_char) {
+        vs_log_mod_error("vsl_types", "Empty hexadecimal value");
+        return -1;
+    }
+    /* Digits are read from the least significant one */
+    while (p_end != p_char) {
+        char c = *(--p_end);
+        unsigned int nibble;
+        if ((c >= '0') && (c <= '9')) {
+            nibble = c - '0';
+        } else if ((c >= 'a') && (c <= 'f')) {
+            nibble = c - 'a' + 10;
+        } else if ((c >= 'A') && (c <= 'F')) {
+            nibble = c - 'A' + 10;
+        } else if (c == '_') {
+            continue;
+        } else {
+            vs_log_mod_error("vsl_types", "Invalid hexadecimal value %s",
+                str_value);
+            return -1;
+        }
+        size_t word_index = num_nibbles/(2*sizeof(EData));
+        if (word_index >= words.size()) {
+            if (0 != nibble) {
+                vs_log_mod_error("vsl_types",
+                    "Value %s exceeds variable width (%zu)", str_value, width);
                 return -1;
             }
-            switch (vltype) {
-                case VLVT_UINT8:
-                    __set_array_value<uint8_t>(datap, value, index);
-                    return 0;
-                case VLVT_UINT16:
-                    __set_array_value<uint16_t>(datap, value, index);
-                    return 0;
-                case VLVT_UINT32:
-                    __set_array_value<uint32_t>(datap, value, index);
-                    return 0;
-                case VLVT_UINT64:
-                    __set_array_value<uint64_t>(datap, value, index);
-                    return 0;
-                case VLVT_REAL:
-                    std::any_cast<double*>(datap)[index] = value;
-                    return 0;
-                default:
-                    vs_log_mod_error(
-                        "vsl_types", "Type not supported for array value");
-                    return -1;
-            }
-        default:
-            vs_log_mod_error(
-                "vsl_types", "Cannot set value (not part of an array)");
+        } else {
+            words[word_index] |= static_cast<EData>(nibble) <<
+                (4*(num_nibbles % (2*sizeof(EData))));
+        }
+        num_nibbles++;
+    }
+    return set_words(words.data(), index);
+}
+
+cJSON* VslVar::create_json_value(size_t index, bool hex) {
+    if ((hex && (VLVT_REAL != vltype)) || (VLVT_WDATA == vltype)) {
+        std::string str_value;
+        if (0 > get_hex_value(str_value, index)) return nullptr;
+        return cJSON_CreateString(str_value.c_str());
+    }
+    if (is_array()) {
+        return cJSON_CreateNumber(get_array_value(index));
+    }
+    return cJSON_CreateNumber(get_value());
+}
+
+int VslVar::set_json_value(const cJSON* p_item, size_t index) {
+    if (cJSON_IsString(p_item)) {
+        return set_hex_value(cJSON_GetStringValue(p_item), index);
+    }
+    if (!cJSON_IsNumber(p_item)) {
+        vs_log_mod_error("vsl_types",
+            "Value should be a number or a hexadecimal string");
+        return -1;
+    }
+    double value = cJSON_GetNumberValue(p_item);
+    if (std::isnan(value)) {
+        vs_log_mod_error("vsl_types", "Value invalid (NaN)");
+        return -1;
+    }
+    if (VLVT_WDATA == vltype) {
+        /* Numbers are only exact up to 2^53 */
+        if ((value < 0.0) || (value >= 9007199254740992.0)) {
+            vs_log_mod_error("vsl_types", "Value out of range for a number \
+- Use a hexadecimal string instead");
             return -1;
+        }
+        uint64_t int_value = static_cast<uint64_t>(value);
+        std::vector<EData> words(get_num_words(), 0u);
+        words[0] = static_cast<EData>(int_value);
+        if (words.size() > 1) words[1] = static_cast<EData>(int_value >> 32);
+        return set_words(words.data(), index);
     }
+    if (is_array()) return set_array_value(value, index);
+    return set_value(value);
 }
 
 int VslVar::set_array_variable_value(cJSON* p_obj) {
+    if (VSL_TYPE_MDARRAY == type) return set_slice_value(p_obj, {});
+
     /* Detect if the variable is not an array */
     if (type != VSL_TYPE_ARRAY) {
         vs_log_mod_error(
@@ -265,17 +698,31 @@ int VslVar::set_array_variable_value(cJSON* p_obj) {
     }
 
     cJSON *iterator;
-    double value = 0.0f;
+    bool by_value = (VLVT_WDATA == vltype);
+    cJSON_ArrayForEach(iterator, p_obj) {
+        if (cJSON_IsString(iterator) ||
+            std::isnan(cJSON_GetNumberValue(iterator))) by_value = true;
+    }
+
+    /* Hexadecimal strings (and invalid items) set value by value, so that
+    they never go through a double, numbers only as a block */
     size_t index = 0;
+    if (by_value) {
+        cJSON_ArrayForEach(iterator, p_obj) {
+            if (0 > set_json_value(iterator, index)) return -1;
+            index++;
+        }
+        return 0;
+    }
+    std::vector<double> values;
+    values.reserve(depth);
     cJSON_ArrayForEach(iterator, p_obj) {
-        value = cJSON_GetNumberValue(iterator);
-        set_array_value(value, index);
-        index++;
+        values.push_back(cJSON_GetNumberValue(iterator));
     }
-    return 0;
+    return set_array_values(values.data(), 0, depth);
 }
 
-int VslVar::add_value_to_msg(cJSON* p_msg, const char* key) {
+int VslVar::add_value_to_msg(cJSON* p_msg, const char* key, bool hex) {
     cJSON* p_value = nullptr;
     switch (type) {
         case VSL_TYPE_SCALAR:
@@ -287,10 +734,15 @@ int VslVar::add_value_to_msg(cJSON* p_msg, const char* key) {
                 case VLVT_UINT16:
                 case VLVT_UINT32:
                 case VLVT_UINT64:
+                case VLVT_WDATA:
                 case VLVT_REAL:
-                    p_value = cJSON_AddNumberToObject(
-                        p_msg, key, get_value());
+                    p_value = create_json_value(0, hex &&
+                        (VSL_TYPE_EVENT != type));
                     if (p_value == nullptr) {return -1;}
+                    if (1 != cJSON_AddItemToObject(p_msg, key, p_value)) {
+                        cJSON_Delete(p_value);
+                        return -1;
+                    }
                     return 0;
                 default:
                     vs_log_mod_error(
@@ -309,9 +761,9 @@ int VslVar::add_value_to_msg(cJSON* p_msg, const char* key) {
     return 0;
 }
 
-int VslVar::add_array_to_msg(cJSON* p_msg, const char* key) {
+int VslVar::add_array_to_msg(cJSON* p_msg, const char* key, bool hex) {
     cJSON* p_array = nullptr;
-    size_t mem_index = 0;
+    std::vector<double> values;
     switch (type) {
         case VSL_TYPE_ARRAY:
             if (dims != 2) {
@@ -321,25 +773,40 @@ int VslVar::add_array_to_msg(cJSON* p_msg, const char* key) {
                 );
                 return -1;
             }
-            p_array = cJSON_AddArrayToObject(p_msg, key);
+            if ((hex && (VLVT_REAL != vltype)) || (VLVT_WDATA == vltype)) {
+                p_array = cJSON_AddArrayToObject(p_msg, key);
+                if (p_array == nullptr) {
+                    vs_log_mod_error(
+                        "vsl_type", "Could not create cJSON array");
+                    return -1;
+                }
+                for (size_t index = 0; index < depth; index++) {
+                    cJSON* p_value = create_json_value(index, true);
+                    if (nullptr == p_value) return -1;
+                    if (1 != cJSON_AddItemToArray(p_array, p_value)) {
+                        vs_log_mod_error(
+                            "vsl_type", "Error adding value to array");
+                        cJSON_Delete(p_value);
+                        return -1;
+                    }
+                }
+                return 0;
+            }
+            values.resize(depth);
+            if (0 > get_array_values(values.data(), 0, depth)) return -1;
+            p_array = cJSON_CreateDoubleArray(values.data(), (int) depth);
             if (p_array == nullptr) {
                 vs_log_mod_error("vsl_type", "Could not create cJSON array");
                 return -1;
             }
-            cJSON_bool retval;
-            while (mem_index < depth) {
-                retval = cJSON_AddItemToArray(
-                    p_array,
-                    cJSON_CreateNumber(get_array_value(mem_index))
-                );
-                if (1 != retval) {
-                    vs_log_mod_error(
-                        "vsl_type", "Error adding number to array");
-                    return -1;
-                }
-                mem_index++;
+            if (1 != cJSON_AddItemToObject(p_msg, key, p_array)) {
+                vs_log_mod_error("vsl_type", "Error adding array to message");
+                cJSON_Delete(p_array);
+                return -1;
             }
             return 0;
+        case VSL_TYPE_MDARRAY:
+            return add_slice_to_msg(p_msg, key, {}, hex);
         default:
             vs_log_mod_error(
                 "vsl_type",
@@ -351,13 +818,16 @@ int VslVar::add_array_to_msg(cJSON* p_msg, const char* key) {
 }
 
 int VslVar::add_array_to_msg(cJSON* p_msg, const char* key,
-    const VslArrayRange& range)
+    const VslArrayRange& range, bool hex)
 {
     cJSON* p_obj = nullptr;
     if (range.left == range.right) {
-        p_obj = cJSON_AddNumberToObject(
-            p_msg, key, get_array_value(range.left));
+        p_obj = create_json_value(range.left, hex);
         if (p_obj == nullptr) {return -1;}
+        if (1 != cJSON_AddItemToObject(p_msg, key, p_obj)) {
+            cJSON_Delete(p_obj);
+            return -1;
+        }
         return 0;
     }
     p_obj = cJSON_AddArrayToObject(p_msg, key);
@@ -368,13 +838,13 @@ int VslVar::add_array_to_msg(cJSON* p_msg, const char* key,
     cJSON_bool retval;
     size_t mem_index = range.right;
     while (mem_index != (range.left + range.incr)) {
-        retval = cJSON_AddItemToArray(
-            p_obj,
-            cJSON_CreateNumber(get_array_value(mem_index))
-        );
+        cJSON* p_value = create_json_value(mem_index, hex);
+        if (nullptr == p_value) return -1;
+        retval = cJSON_AddItemToArray(p_obj, p_value);
         if (1 != retval) {
             vs_log_mod_error(
                 "vsl_type", "Error adding number to array");
+            cJSON_Delete(p_value);
             return -1;
         }
         mem_index += range.incr;
@@ -382,6 +852,264 @@ int VslVar::add_array_to_msg(cJSON* p_msg, const char* key,
     return 0;
 }
 
+/**
+ * @brief Returns the number of elements of a range
+ */
+static inline size_t range_length(const VslArrayRange& range) {
+    return ((range.left > range.right) ?
+        (range.left - range.right) : (range.right - range.left)) + 1;
+}
+
+/**
+ * @brief Iterates over the contiguous blocks of a multi-dimensional array
+ * slice, in the order in which the values are listed in messages
+ *
+ * Each block spans the range of the dimension dim_block, taken in full for
+ * all the inner dimensions. The function f is called with the index of the
+ * first element of the block in the array storage, the number of chunks of
+ * strides[dim_block] elements in the block and whether the chunks are listed
+ * in descending order.
+ */
+template <typename F>
+static int for_each_block(const std::vector<VslArrayRange>& ranges,
+    const std::vector<size_t>& strides, size_t dim_block, size_t dim,
+    size_t offset, F&& f)
+{
+    const VslArrayRange& range = ranges[dim];
+    size_t num = range_length(range);
+    if (dim == dim_block) {
+        return f(offset + std::min(range.left, range.right) * strides[dim],
+            num, range.incr < 0);
+    }
+    size_t index = range.right;
+    for (size_t i = 0; i < num; i++) {
+        if (0 > for_each_block(ranges, strides, dim_block, dim + 1,
+            offset + index * strides[dim], f)) return -1;
+        index += range.incr;
+    }
+    return 0;
+}
+
+/**
+ * @brief Returns the outermost dimension such that all the inner dimensions
+ * of the slice are taken in full and in ascending order, and computes the
+ * storage strides of all the dimensions
+ */
+static size_t get_block_dim(const std::vector<VslArrayRange>& ranges,
+    const std::vector<size_t>& shape, std::vector<size_t>& strides)
+{
+    size_t num_dims = shape.size();
+    strides.assign(num_dims, 1u);
+    for (size_t dim = num_dims - 1; dim > 0; dim--) {
+        strides[dim - 1] = strides[dim] * shape[dim];
+    }
+    size_t dim_block = num_dims - 1;
+    while ((dim_block > 0) && (0 == ranges[dim_block].right) &&
+        (shape[dim_block] - 1 == ranges[dim_block].left)) {
+        dim_block--;
+    }
+    return dim_block;
+}
+
+/**
+ * @brief Creates nested cJSON arrays for a slice, one level for each
+ * dimension for which the range length is larger than 1
+ */
+template <typename F>
+static cJSON* create_nested_item(const std::vector<VslArrayRange>& ranges,
+    size_t dim, size_t& pos, F&& create_item)
+{
+    if (dim == ranges.size()) return create_item(pos++);
+    size_t num = range_length(ranges[dim]);
+    if (1 == num) return create_nested_item(ranges, dim + 1, pos, create_item);
+    cJSON* p_array = cJSON_CreateArray();
+    if (nullptr == p_array) {
+        vs_log_mod_error("vsl_type", "Could not create cJSON array");
+        return nullptr;
+    }
+    for (size_t i = 0; i < num; i++) {
+        cJSON* p_item = create_nested_item(ranges, dim + 1, pos, create_item);
+        if ((nullptr == p_item) || (1 != cJSON_AddItemToArray(p_array, p_item)))
+        {
+            vs_log_mod_error("vsl_type", "Error adding value to array");
+            cJSON_Delete(p_item);
+            cJSON_Delete(p_array);
+            return nullptr;
+        }
+    }
+    return p_array;
+}
+
+/**
+ * @brief Lists the values of nested cJSON arrays for a slice, with the same
+ * nesting as created by create_nested_item()
+ */
+static int get_nested_items(const cJSON* p_item,
+    const std::vector<VslArrayRange>& ranges, size_t dim,
+    std::vector<const cJSON*>& items)
+{
+    if (dim == ranges.size()) {
+        if (!cJSON_IsNumber(p_item) && !cJSON_IsString(p_item)) {
+            vs_log_mod_error("vsl_types",
+                "Value should be a number or a hexadecimal string");
+            return -1;
+        }
+        items.push_back(p_item);
+        return 0;
+    }
+    size_t num = range_length(ranges[dim]);
+    if (1 == num) return get_nested_items(p_item, ranges, dim + 1, items);
+    if (!cJSON_IsArray(p_item) ||
+        (num != (size_t) cJSON_GetArraySize(p_item)))
+    {
+        vs_log_mod_error("vsl_types",
+            "Value should be an array of length %d for dimension %d",
+            (int) num, (int) dim);
+        return -1;
+    }
+    const cJSON* p_sub;
+    cJSON_ArrayForEach(p_sub, p_item) {
+        if (0 > get_nested_items(p_sub, ranges, dim + 1, items)) return -1;
+    }
+    return 0;
+}
+
+int VslVar::get_full_ranges(const std::vector<VslArrayRange>& ranges,
+    std::vector<VslArrayRange>& full_ranges)
+{
+    if (VSL_TYPE_MDARRAY != type) {
+        vs_log_mod_error("vsl_types",
+            "Variable %s is not a multi-dimensional array", namep);
+        return -1;
+    }
+    if (ranges.size() > shape.size()) {
+        vs_log_mod_error("vsl_types",
+            "Variable %s - Too many dimensions in range (%d > %d)", namep,
+            (int) ranges.size(), (int) shape.size());
+        return -1;
+    }
+    full_ranges = ranges;
+    for (size_t dim = 0; dim < shape.size(); dim++) {
+        if (dim >= ranges.size()) {
+            full_ranges.push_back(
+                VslArrayRange {shape[dim] - 1, 0, 1, std::string {namep}});
+        } else if ((ranges[dim].left >= shape[dim]) ||
+            (ranges[dim].right >= shape[dim]))
+        {
+            vs_log_mod_error("vsl_types",
+                "Variable %s - Range exceeds array depth (%d) for dimension %d",
+                namep, (int) shape[dim], (int) dim);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int VslVar::add_slice_to_msg(cJSON* p_msg, const char* key,
+    const std::vector<VslArrayRange>& ranges, bool hex)
+{
+    std::vector<VslArrayRange> full_ranges;
+    if (0 > get_full_ranges(ranges, full_ranges)) return -1;
+    std::vector<size_t> strides;
+    size_t dim_block = get_block_dim(full_ranges, shape, strides);
+    size_t chunk = strides[dim_block];
+    size_t pos = 0;
+    cJSON* p_item = nullptr;
+
+    if ((hex && (VLVT_REAL != vltype)) || (VLVT_WDATA == vltype)) {
+        /* Values added one by one as hexadecimal strings */
+        std::vector<size_t> indexes;
+        for_each_block(full_ranges, strides, dim_block, 0, 0,
+            [&](size_t index, size_t num, bool reversed) {
+                for (size_t i = 0; i < num; i++) {
+                    size_t start = index + (reversed ? num - 1 - i : i) * chunk;
+                    for (size_t j = 0; j < chunk; j++) {
+                        indexes.push_back(start + j);
+                    }
+                }
+                return 0;
+            });
+        p_item = create_nested_item(full_ranges, 0, pos,
+            [&](size_t k) { return create_json_value(indexes[k], true); });
+    } else {
+        /* Values copied block by block from the array storage */
+        std::vector<double> values;
+        std::vector<double> block;
+        int retval = for_each_block(full_ranges, strides, dim_block, 0, 0,
+            [&](size_t index, size_t num, bool reversed) {
+                if (!reversed) {
+                    size_t pos_block = values.size();
+                    values.resize(pos_block + num * chunk);
+                    return get_array_values(
+                        values.data() + pos_block, index, num * chunk);
+                }
+                block.resize(num * chunk);
+                if (0 > get_array_values(block.data(), index, num * chunk)) {
+                    return -1;
+                }
+                for (size_t i = num; i > 0; i--) {
+                    values.insert(values.end(), block.begin() + (i - 1) * chunk,
+                        block.begin() + i * chunk);
+                }
+                return 0;
+            });
+        if (0 > retval) return -1;
+        p_item = create_nested_item(full_ranges, 0, pos,
+            [&](size_t k) { return cJSON_CreateNumber(values[k]); });
+    }
+    if (nullptr == p_item) return -1;
+    if (1 != cJSON_AddItemToObject(p_msg, key, p_item)) {
+        vs_log_mod_error("vsl_type", "Error adding array to message");
+        cJSON_Delete(p_item);
+        return -1;
+    }
+    return 0;
+}
+
+int VslVar::set_slice_value(const cJSON* p_item,
+    const std::vector<VslArrayRange>& ranges)
+{
+    std::vector<VslArrayRange> full_ranges;
+    if (0 > get_full_ranges(ranges, full_ranges)) return -1;
+    std::vector<const cJSON*> items;
+    if (0 > get_nested_items(p_item, full_ranges, 0, items)) return -1;
+    std::vector<size_t> strides;
+    size_t dim_block = get_block_dim(full_ranges, shape, strides);
+    size_t chunk = strides[dim_block];
+
+    bool by_value = (VLVT_WDATA == vltype);
+    for (auto p_value : items) {
+        if (cJSON_IsString(p_value) ||
+            std::isnan(cJSON_GetNumberValue(p_value))) by_value = true;
+    }
+
+    size_t pos = 0;
+    std::vector<double> block;
+    return for_each_block(full_ranges, strides, dim_block, 0, 0,
+        [&](size_t index, size_t num, bool reversed) {
+            if (by_value) {
+                /* Hexadecimal strings set value by value */
+                for (size_t i = 0; i < num; i++) {
+                    size_t start = index + (reversed ? num - 1 - i : i) * chunk;
+                    for (size_t j = 0; j < chunk; j++) {
+                        if (0 > set_json_value(items[pos++], start + j)) {
+                            return -1;
+                        }
+                    }
+                }
+                return 0;
+            }
+            block.resize(num * chunk);
+            for (size_t i = 0; i < num; i++) {
+                size_t start = (reversed ? num - 1 - i : i) * chunk;
+                for (size_t j = 0; j < chunk; j++) {
+                    block[start + j] = cJSON_GetNumberValue(items[pos++]);
+                }
+            }
+            return set_array_values(block.data(), index, num * chunk);
+        });
+}
+
 VslVar* VslVarMap::get_var(const std::string& str_path) {
     auto search = var_map.find(str_path);
     if (search != var_map.end()) {
@@ -393,5 +1121,15 @@ VslVar* VslVarMap::get_var(const std::string& str_path) {
     return nullptr;
 }
 
+std::vector<std::string> VslVarMap::get_names() const {
+    std::vector<std::string> names;
+    names.reserve(var_map.size());
+    for (const auto& item : var_map) {
+        names.push_back(item.first);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
 } //namespace vsl
 // EOF
@@ -52,6 +52,11 @@ bool check_time_unit(std::string time_unit) {
     return (TIME_DEF_MAP.find(time_unit) != TIME_DEF_MAP.end());
 }
 
+bool check_count(double value) {
+    return (!std::isnan(value) && (value >= 0.0) &&
+        (value <= 2147483647.0) && (value == std::floor(value)));
+}
+
 static int16_t get_time_factor(const char* time_unit)
 {
     std::string str_key {time_unit};
@@ -108,5 +113,33 @@ VslArrayRange get_range(const std::string& path) {
     return range;
 }
 
+VslArrayRanges get_ranges(const std::string& path) {
+    VslArrayRanges md_range {{}, "None"};
+    const std::regex range_regex {"\\[([0-9]+)(:([0-9]+))?\\]$"};
+    std::string str_path {path};
+    std::smatch m;
+    while (std::regex_search(str_path, m, range_regex)) {
+        VslArrayRange range {0, 0, 1, ""};
+        range.left = static_cast<size_t>(std::stoi(m[1]));
+        if (0 < m[3].length()) {
+            range.right = static_cast<size_t>(std::stoi(m[3]));
+        } else {
+            range.right = range.left;
+        }
+        if (range.right > range.left) range.incr = -1;
+        md_range.ranges.insert(md_range.ranges.begin(), range);
+        str_path.erase(m.position(0));
+    }
+    if (md_range.ranges.empty() || str_path.empty()) {
+        md_range.ranges.clear();
+        return md_range;
+    }
+    md_range.array_name = str_path;
+    for (auto& range : md_range.ranges) {
+        range.array_name = str_path;
+    }
+    return md_range;
+}
+
 } //namespace vsl
 //EOF
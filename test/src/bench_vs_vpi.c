@@ -0,0 +1,356 @@
+/**
+ * @file bench_vs_vpi.c
+ * @author jchabloz
+ * @brief Benchmark of the VPI command handlers using the mock VPI layer
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * Replays command streams through vs_vpi_process_command() and reports, for
+ * each stream, the number of commands processed per second and the number of
+ * allocations per command. For run commands, the measure includes the
+ * simulated time until the command's callback returns control to Verisocks.
+ *
+ * Usage: bench_vs_vpi [-n passes] [stream_file ...]
+ *
+ * Without stream files, the built-in streams are replayed. A stream file
+ * contains one JSON command per line.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "cJSON.h"
+#include "vs_msg.h"
+#include "vs_index.h"
+#include "vs_vpi.h"
+#include "vpi_mock.h"
+
+#define BENCH_DEFAULT_PASSES 10000
+#define BENCH_MAX_STEPS 100000
+
+
+/******************************************************************************
+* Allocations counter (linked with -Wl,--wrap=malloc,--wrap=calloc,
+* --wrap=realloc)
+******************************************************************************/
+static size_t num_allocs = 0;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+    num_allocs++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+    num_allocs++;
+    return __real_calloc(nmemb, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    num_allocs++;
+    return __real_realloc(ptr, size);
+}
+
+
+/******************************************************************************
+* Callbacks - Same as in verisocks.c, without calling the Verisocks main loop
+* (the state is set to VS_VPI_STATE_WAITING when it would be called)
+******************************************************************************/
+PLI_INT32 verisocks_cb(p_cb_data cb_data)
+{
+    return (0 > vs_vpi_cb_process((vs_vpi_data_t*) cb_data->user_data)) ?
+        -1 : 0;
+}
+
+PLI_INT32 verisocks_cb_value_change(p_cb_data cb_data)
+{
+    return (0 > vs_vpi_cb_value_change_process(
+        (vs_vpi_watch_t*) cb_data->user_data)) ? -1 : 0;
+}
+
+PLI_INT32 verisocks_cb_sample(p_cb_data cb_data)
+{
+    return (0 > vs_vpi_cb_sample_process(
+        (vs_vpi_data_t*) cb_data->user_data)) ? -1 : 0;
+}
+
+
+/******************************************************************************
+* Command streams
+******************************************************************************/
+typedef struct bench_stream {
+    const char *str_name;
+    const char *str_cmds[8];    //NULL-terminated list of commands
+} bench_stream_t;
+
+static const bench_stream_t bench_streams[] = {
+    {"info", {
+        "{\"command\": \"info\", \"value\": \"Benchmark\"}",
+        NULL}},
+    {"get(sim_info)", {
+        "{\"command\": \"get\", \"sel\": \"sim_info\"}",
+        NULL}},
+    {"get(sim_time)", {
+        "{\"command\": \"get\", \"sel\": \"sim_time\"}",
+        NULL}},
+    {"get(value)", {
+        "{\"command\": \"get\", \"sel\": \"value\", \"path\": \"main.count\"}",
+        "{\"command\": \"get\", \"sel\": \"value\", \"path\": \"main.fclk\"}",
+        "{\"command\": \"get\", \"sel\": \"value\", "
+            "\"path\": \"main.count_memory\"}",
+        NULL}},
+    {"get(type)", {
+        "{\"command\": \"get\", \"sel\": \"type\", \"path\": \"main.count\"}",
+        NULL}},
+    {"get(list)", {
+        "{\"command\": \"get\", \"sel\": \"list\", \"pattern\": \"main.c*\"}",
+        NULL}},
+    {"set", {
+        "{\"command\": \"set\", \"path\": \"main.enable\", \"value\": 1}",
+        "{\"command\": \"set\", \"path\": \"main.counter_end\"}",
+        "{\"command\": \"set\", \"path\": \"main.count_memory\", \"value\": "
+            "[0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15]}",
+        NULL}},
+    {"schedule", {
+        "{\"command\": \"schedule\", \"time_unit\": \"us\", \"events\": "
+            "[[1.0, \"main.enable\", 0], [2.0, \"main.enable\", 1], "
+            "[1.5, \"main.count\", 12], [3.0, \"main.count\", 0]]}",
+        NULL}},
+    {"run(for_time)", {
+        "{\"command\": \"run\", \"cb\": \"for_time\", \"time\": 1.0, "
+            "\"time_unit\": \"us\"}",
+        NULL}},
+    {"run(to_next)", {
+        "{\"command\": \"run\", \"cb\": \"to_next\"}",
+        NULL}},
+    {"run(until_change)", {
+        "{\"command\": \"run\", \"cb\": \"until_change\", "
+            "\"path\": \"main.clk\", \"edge\": \"rising\"}",
+        "{\"command\": \"run\", \"cb\": \"until_change\", "
+            "\"path\": \"main.count\", \"op\": \"ne\", \"value\": 0}",
+        NULL}},
+    {"run(sample)", {
+        "{\"command\": \"run\", \"cb\": \"sample\", \"period\": 1.0, "
+            "\"time_unit\": \"us\", \"count\": 8, "
+            "\"path\": [\"main.count\", \"main.clk\"]}",
+        NULL}},
+    {NULL, {NULL}}
+};
+
+
+/******************************************************************************
+* Benchmark
+******************************************************************************/
+static double bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Process a command as the Verisocks main loop would, then let the
+ * mock simulator run until control is given back to Verisocks.
+ */
+static int bench_command(vs_vpi_data_t *p_data, cJSON *p_cmd)
+{
+    int steps = 0;
+    p_data->p_cmd = p_cmd;
+    p_data->state = VS_VPI_STATE_PROCESSING;
+    vs_vpi_process_command(p_data);
+    if (VS_VPI_STATE_PROCESSING == p_data->state) {
+        p_data->state = VS_VPI_STATE_WAITING;
+    }
+    while ((VS_VPI_STATE_SIM_RUNNING == p_data->state) &&
+           (steps++ < BENCH_MAX_STEPS)) {
+        vpi_mock_step();
+    }
+    p_data->p_cmd = NULL;
+    return (VS_VPI_STATE_WAITING == p_data->state) ? 0 : -1;
+}
+
+/**
+ * @brief Replay a list of commands and print the results
+ *
+ * @param str_name Stream name
+ * @param p_cmds Parsed commands
+ * @param num_cmds Number of commands
+ * @param passes Number of times the list of commands is replayed
+ * @param fd_null Descriptor to which the return messages are written
+ * @return Returns 0 if successful, -1 in case of error
+ */
+static int bench_stream(const char *str_name, cJSON **p_cmds, int num_cmds,
+    int passes, int fd_null)
+{
+    int i;
+    int pass;
+    int retval = 0;
+    double t_start;
+    double t_elapsed;
+    size_t allocs_start;
+    vs_vpi_data_t *p_data;
+
+    if (0 > vpi_mock_init()) return -1;
+    p_data = (vs_vpi_data_t*) calloc(1, sizeof(vs_vpi_data_t));
+    if (NULL == p_data) return -1;
+    p_data->fd_server_socket = -1;
+    p_data->fd_client_socket = fd_null;
+    p_data->state = VS_VPI_STATE_WAITING;
+
+    /* Warm-up pass (builds the hierarchy index, registers watches...) */
+    for (i = 0; i < num_cmds; i++) {
+        if (0 > bench_command(p_data, p_cmds[i])) {
+            fprintf(stderr, "%s: command %d failed\n", str_name, i);
+            retval = -1;
+            goto cleanup;
+        }
+    }
+
+    allocs_start = num_allocs;
+    t_start = bench_now();
+    for (pass = 0; pass < passes; pass++) {
+        for (i = 0; i < num_cmds; i++) {
+            if (0 > bench_command(p_data, p_cmds[i])) retval = -1;
+        }
+    }
+    t_elapsed = bench_now() - t_start;
+
+    printf("%-20s %10d %14.0f %12.2f\n", str_name, passes * num_cmds,
+        (double) (passes * num_cmds) / t_elapsed,
+        (double) (num_allocs - allocs_start) / (double) (passes * num_cmds));
+    if (0 > retval) fprintf(stderr, "%s: some commands failed\n", str_name);
+
+    cleanup:
+    vs_vpi_watch_free_all(p_data);
+    vs_vpi_sampler_free(p_data->p_sampler);
+    vs_index_free(p_data->p_index);
+    free(p_data);
+    return retval;
+}
+
+static int bench_builtin_stream(const bench_stream_t *p_stream, int passes,
+    int fd_null)
+{
+    int i;
+    int num_cmds = 0;
+    int retval = 0;
+    cJSON *p_cmds[8];
+
+    while (NULL != p_stream->str_cmds[num_cmds]) {
+        p_cmds[num_cmds] = cJSON_Parse(p_stream->str_cmds[num_cmds]);
+        if (NULL == p_cmds[num_cmds]) {
+            fprintf(stderr, "%s: could not parse command %d\n",
+                p_stream->str_name, num_cmds);
+            retval = -1;
+            break;
+        }
+        num_cmds++;
+    }
+    if (0 == retval) {
+        retval = bench_stream(p_stream->str_name, p_cmds, num_cmds, passes,
+            fd_null);
+    }
+    for (i = 0; i < num_cmds; i++) cJSON_Delete(p_cmds[i]);
+    return retval;
+}
+
+static int bench_file_stream(const char *str_file, int passes, int fd_null)
+{
+    FILE *p_file;
+    char *str_line = NULL;
+    size_t line_size = 0;
+    cJSON **p_cmds = NULL;
+    cJSON **p_cmds_new;
+    int num_cmds = 0;
+    int retval = 0;
+    int i;
+
+    p_file = fopen(str_file, "r");
+    if (NULL == p_file) {
+        fprintf(stderr, "Could not open %s\n", str_file);
+        return -1;
+    }
+    while (0 < getline(&str_line, &line_size, p_file)) {
+        if (strspn(str_line, " \t\r\n") == strlen(str_line)) continue;
+        p_cmds_new = (cJSON**) realloc(p_cmds,
+            (num_cmds + 1) * sizeof(cJSON*));
+        if (NULL == p_cmds_new) {
+            retval = -1;
+            break;
+        }
+        p_cmds = p_cmds_new;
+        p_cmds[num_cmds] = cJSON_Parse(str_line);
+        if (NULL == p_cmds[num_cmds]) {
+            fprintf(stderr, "%s: could not parse line %s", str_file,
+                str_line);
+            retval = -1;
+            break;
+        }
+        num_cmds++;
+    }
+    free(str_line);
+    fclose(p_file);
+    if ((0 == retval) && (0 < num_cmds)) {
+        retval = bench_stream(str_file, p_cmds, num_cmds, passes, fd_null);
+    }
+    for (i = 0; i < num_cmds; i++) cJSON_Delete(p_cmds[i]);
+    free(p_cmds);
+    return retval;
+}
+
+int main(int argc, char *argv[])
+{
+    int opt;
+    int passes = BENCH_DEFAULT_PASSES;
+    int retval = 0;
+    int fd_null;
+    const bench_stream_t *p_stream;
+
+    while (-1 != (opt = getopt(argc, argv, "n:"))) {
+        switch (opt) {
+        case 'n':
+            passes = atoi(optarg);
+            if (0 < passes) break;
+            /* fall through */
+        default:
+            fprintf(stderr, "Usage: %s [-n passes] [stream_file ...]\n",
+                argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* Return messages are written to the null device */
+    fd_null = open("/dev/null", O_WRONLY);
+    if (0 > fd_null) {
+        perror("Could not open /dev/null");
+        return EXIT_FAILURE;
+    }
+
+    printf("%-20s %10s %14s %12s\n", "Stream", "Commands", "Commands/s",
+        "Allocs/cmd");
+    if (optind < argc) {
+        for (; optind < argc; optind++) {
+            if (0 > bench_file_stream(argv[optind], passes, fd_null))
+                retval = -1;
+        }
+    } else {
+        for (p_stream = bench_streams; NULL != p_stream->str_name; p_stream++) {
+            if (0 > bench_builtin_stream(p_stream, passes, fd_null))
+                retval = -1;
+        }
+    }
+
+    close(fd_null);
+    return (0 == retval) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+//EOF
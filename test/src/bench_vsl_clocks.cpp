@@ -0,0 +1,130 @@
+/**
+ * @file bench_vsl_clocks.cpp
+ * @author jchabloz
+ * @brief Benchmark of the VslClockMap clocks scheduling
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * Measures the cost per clock edge of VslClockMap::get_next_event() and
+ * VslClockMap::eval(), as used by the simulation loop, for 1 up to 1000
+ * clocks with different periods. As a reference, the same edges are evaluated
+ * with the former implementation, which kept the clocks in a sorted list and
+ * sorted it again after each edge.
+ *
+ * Usage: bench_vsl_clocks [-n edges]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <vector>
+#include <chrono>
+#include "vsl/vsl_clocks.hpp"
+
+#define BENCH_DEFAULT_EDGES 20000
+
+using namespace vsl;
+
+static const size_t bench_num_clocks[] = {1, 2, 5, 10, 20, 50, 100, 200, 500,
+    1000};
+
+
+/******************************************************************************
+* Reference clock map (list sorted after each edge)
+******************************************************************************/
+class RefClockMap {
+public:
+    void add_clock(const char* namep, std::any datap,
+        const vsl_time_t period, const double duty_cycle) {
+        clock_list.push_front(VslClock {namep, datap, period, duty_cycle});
+        clock_list.sort();
+    }
+
+    vsl_time_t get_next_event() const {
+        return clock_list.begin()->get_next_event();
+    }
+
+    int eval(vsl_time_t time) {
+        unsigned int total_evals = 0;
+        int eval_status = 0;
+        if (clock_list.empty()) {return 0;}
+        do {
+            auto it = clock_list.begin();
+            eval_status = it->eval(time);
+            if (eval_status > 0) {total_evals++;}
+            clock_list.sort();
+        } while (eval_status > 0);
+        return total_evals;
+    }
+
+private:
+    std::list<VslClock> clock_list;
+};
+
+
+/******************************************************************************
+* Measurements
+******************************************************************************/
+typedef std::chrono::steady_clock bench_clock;
+
+/* Clock periods are all different, so that edges are spread over time */
+static vsl_time_t bench_period(size_t index) {
+    return static_cast<vsl_time_t>(1000u + 7u*index);
+}
+
+template <typename M>
+static double ns_per_edge(M& clock_map, size_t num_edges)
+{
+    size_t edges = 0;
+    auto t0 = bench_clock::now();
+    while (edges < num_edges) {
+        int num = clock_map.eval(clock_map.get_next_event());
+        if (0 >= num) {
+            fprintf(stderr, "Error: no clock evaluated\n");
+            exit(1);
+        }
+        edges += static_cast<size_t>(num);
+    }
+    std::chrono::duration<double, std::nano> dt = bench_clock::now() - t0;
+    return dt.count() / static_cast<double>(edges);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t num_edges = BENCH_DEFAULT_EDGES;
+
+    for (int i = 1; i < argc; i++) {
+        if ((0 == strcmp(argv[i], "-n")) && (i + 1 < argc)) {
+            num_edges = strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "Usage: %s [-n edges]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (0 == num_edges) num_edges = 1;
+
+    printf("%-10s %14s %14s %10s\n", "Clocks", "Before [ns]", "After [ns]",
+        "Speedup");
+
+    for (size_t num_clocks : bench_num_clocks) {
+        std::vector<uint8_t> values_ref(num_clocks, 0u);
+        std::vector<uint8_t> values_new(num_clocks, 0u);
+        std::vector<std::string> names(num_clocks);
+        RefClockMap ref_map;
+        VslClockMap new_map;
+        for (size_t i = 0; i < num_clocks; i++) {
+            names[i] = "clk" + std::to_string(i);
+            ref_map.add_clock(names[i].c_str(), &values_ref[i],
+                bench_period(i), 0.5);
+            new_map.add_clock(names[i].c_str(), &values_new[i],
+                bench_period(i), 0.5);
+        }
+
+        double t_ref = ns_per_edge(ref_map, num_edges);
+        double t_new = ns_per_edge(new_map, num_edges);
+        printf("%-10zu %14.2f %14.2f %9.2fx\n", num_clocks, t_ref, t_new,
+            (t_new > 0.0) ? t_ref/t_new : 0.0);
+    }
+    return 0;
+}
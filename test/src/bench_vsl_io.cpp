@@ -0,0 +1,239 @@
+/**
+ * @file bench_vsl_io.cpp
+ * @author jchabloz
+ * @brief Benchmark of the VslInteg background socket I/O thread
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * Measures the time per command for a client which sends its commands in
+ * advance (pipelined), with a simulation thread which spends a given time
+ * evaluating the model for each command. Without the I/O thread, the
+ * simulation thread reads, frames and parses each command and writes each
+ * response itself, as VslInteg::main_wait() does. With the I/O thread, it only
+ * gets already parsed commands and queues its responses, as
+ * VslInteg::main_wait_io() does. The model evaluation is emulated with a busy
+ * loop of the given duration.
+ *
+ * The overlap is reported as the part of the I/O cost (time per command
+ * without I/O thread and without evaluation) which is hidden behind the
+ * evaluation with the I/O thread.
+ *
+ * Usage: bench_vsl_io [-n commands] [-s values] [-c io_cpu,eval_cpu]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include "vsl/vsl_integ.hpp"
+
+#define BENCH_DEFAULT_COMMANDS 20000
+#define BENCH_DEFAULT_VALUES 64
+
+using namespace vsl;
+
+static const double bench_eval_us[] = {0.0, 2.0, 5.0, 10.0, 20.0, 50.0};
+
+typedef std::chrono::steady_clock bench_clock;
+
+
+/******************************************************************************
+* Client (separate process, so that only the server process parses JSON)
+******************************************************************************/
+/* Sends all the commands in advance and reads all the responses. The command
+is created once and written as raw bytes, so that only the reader thread uses
+cJSON. */
+static void client_run(int fd, const std::string& str_msg, size_t num_cmds)
+{
+    std::thread writer([&]() {
+        for (size_t i = 0; i < num_cmds; i++) {
+            size_t count = 0;
+            while (count < str_msg.size()) {
+                ssize_t retval = write(fd, str_msg.data() + count,
+                    str_msg.size() - count);
+                if (0 > retval) return;
+                count += static_cast<size_t>(retval);
+            }
+        }
+    });
+    char* p_buffer = nullptr;
+    size_t buffer_size = 0;
+    for (size_t i = 0; i < num_cmds; i++) {
+        vs_msg_info_t msg_info = VS_MSG_INFO_INIT_UNDEF;
+        if (0 > vs_msg_read_alloc(fd, &p_buffer, &buffer_size, &msg_info)) {
+            break;
+        }
+    }
+    writer.join();
+    free(p_buffer);
+}
+
+static std::string create_command(size_t num_values)
+{
+    cJSON* p_cmd = cJSON_CreateObject();
+    cJSON_AddStringToObject(p_cmd, "command", "set");
+    cJSON_AddStringToObject(p_cmd, "path", "main.count_memory");
+    cJSON* p_values = cJSON_AddArrayToObject(p_cmd, "value");
+    for (size_t i = 0; i < num_values; i++) {
+        cJSON_AddItemToArray(p_values, cJSON_CreateNumber(i & 0xffu));
+    }
+    vs_msg_info_t msg_info = VS_MSG_INFO_INIT_JSON;
+    char* str_msg = vs_msg_create_message(p_cmd, &msg_info);
+    cJSON_Delete(p_cmd);
+    std::string str_ret {str_msg, vs_msg_read_header_length(str_msg) +
+        msg_info.len + 2};
+    cJSON_free(str_msg);
+    return str_ret;
+}
+
+
+/******************************************************************************
+* Simulation thread
+******************************************************************************/
+static void eval_model(double eval_us)
+{
+    auto t_end = bench_clock::now() +
+        std::chrono::duration<double, std::micro>(eval_us);
+    while (bench_clock::now() < t_end) {}
+}
+
+/* Same as VslInteg::main_wait() and main_process(), without I/O thread */
+static void server_inline(int fd, size_t num_cmds, double eval_us)
+{
+    char* p_buffer = nullptr;
+    size_t buffer_size = 0;
+    vs_uuid_t uuid {0u, VS_UUID_NULL};
+    for (size_t i = 0; i < num_cmds; i++) {
+        vs_msg_info_t msg_info = VS_MSG_INFO_INIT_UNDEF;
+        if (0 > vs_msg_read_alloc(fd, &p_buffer, &buffer_size, &msg_info)) {
+            break;
+        }
+        cJSON* p_cmd = vs_msg_read_json(p_buffer, &msg_info);
+        eval_model(eval_us);
+        vsl_msg_return(fd, "ack", "Command processed", &uuid);
+        cJSON_Delete(p_cmd);
+    }
+    free(p_buffer);
+}
+
+/* Same as VslInteg::main_wait_io() and main_process(), with I/O thread */
+static void server_io(int fd, size_t num_cmds, double eval_us, int io_cpu)
+{
+    vs_uuid_t uuid {0u, VS_UUID_NULL};
+    vs_io_t* p_io = vs_io_start(fd);
+    if (nullptr == p_io) {
+        fprintf(stderr, "Error: could not start I/O thread\n");
+        exit(1);
+    }
+    if (0 <= io_cpu) vs_io_set_affinity(p_io, io_cpu);
+    for (size_t i = 0; i < num_cmds; i++) {
+        vs_io_msg_t msg;
+        if ((0 > vs_io_read(p_io, &msg)) || (VS_IO_MSG_CLOSED == msg.type)) {
+            break;
+        }
+        eval_model(eval_us);
+        vsl_msg_return(fd, "ack", "Command processed", &uuid);
+        cJSON_Delete(msg.p_cmd);
+    }
+    vs_io_stop(p_io);
+}
+
+/* Returns the time per command, in us */
+static double us_per_command(const std::string& str_msg, size_t num_cmds,
+    double eval_us, bool use_io, int io_cpu)
+{
+    int fd_pair[2];
+    if (0 > socketpair(AF_UNIX, SOCK_STREAM, 0, fd_pair)) {
+        perror("socketpair");
+        exit(1);
+    }
+    pid_t pid = fork();
+    if (0 > pid) {
+        perror("fork");
+        exit(1);
+    }
+    if (0 == pid) {
+        close(fd_pair[0]);
+        client_run(fd_pair[1], str_msg, num_cmds);
+        close(fd_pair[1]);
+        _exit(0);
+    }
+    close(fd_pair[1]);
+
+    auto t0 = bench_clock::now();
+    if (use_io) {
+        server_io(fd_pair[0], num_cmds, eval_us, io_cpu);
+    } else {
+        server_inline(fd_pair[0], num_cmds, eval_us);
+    }
+    std::chrono::duration<double, std::micro> dt = bench_clock::now() - t0;
+    close(fd_pair[0]);
+    waitpid(pid, nullptr, 0);
+    return dt.count() / static_cast<double>(num_cmds);
+}
+
+
+/******************************************************************************
+* Main
+******************************************************************************/
+int main(int argc, char* argv[])
+{
+    size_t num_cmds = BENCH_DEFAULT_COMMANDS;
+    size_t num_values = BENCH_DEFAULT_VALUES;
+    int io_cpu = -1;
+    int eval_cpu = -1;
+
+    for (int i = 1; i < argc; i++) {
+        bool b_valid = (i + 1 < argc);
+        if (b_valid && (0 == strcmp(argv[i], "-n"))) {
+            num_cmds = strtoul(argv[++i], nullptr, 10);
+        } else if (b_valid && (0 == strcmp(argv[i], "-s"))) {
+            num_values = strtoul(argv[++i], nullptr, 10);
+        } else if (b_valid && (0 == strcmp(argv[i], "-c"))) {
+            b_valid = (2 == sscanf(argv[++i], "%d,%d", &io_cpu, &eval_cpu));
+        } else {
+            b_valid = false;
+        }
+        if (!b_valid) {
+            fprintf(stderr,
+                "Usage: %s [-n commands] [-s values] [-c io_cpu,eval_cpu]\n",
+                argv[0]);
+            return 1;
+        }
+    }
+    if (0 == num_cmds) num_cmds = 1;
+
+    if (0 <= eval_cpu) {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(eval_cpu, &cpu_set);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set);
+    }
+
+    std::string str_msg = create_command(num_values);
+    printf("Command size: %zu bytes\n", str_msg.size());
+    printf("%-10s %14s %14s %10s %12s\n", "Eval [us]", "Before [us]",
+        "After [us]", "Speedup", "Overlap [%]");
+
+    double io_cost = 0.0;
+    for (double eval_us : bench_eval_us) {
+        double t_ref = us_per_command(str_msg, num_cmds, eval_us, false,
+            io_cpu);
+        double t_new = us_per_command(str_msg, num_cmds, eval_us, true,
+            io_cpu);
+        if (0.0 == eval_us) io_cost = t_ref;
+        double overlap = (io_cost > 0.0) ?
+            100.0 * (t_ref - t_new) / io_cost : 0.0;
+        printf("%-10.1f %14.2f %14.2f %9.2fx %12.1f\n", eval_us, t_ref,
+            t_new, (t_new > 0.0) ? t_ref/t_new : 0.0, overlap);
+    }
+    return 0;
+}
@@ -0,0 +1,255 @@
+/**
+ * @file bench_vsl_types.cpp
+ * @author jchabloz
+ * @brief Benchmark of the VslVar value accessors
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * Measures the cost per access of VslVar::get_value(), set_value(),
+ * get_array_value() and set_array_value(), for a scalar variable and for a
+ * 64K-element array. As a reference, the same accesses are measured with the
+ * former implementation, which casted a std::any and switched on the variable
+ * type at each access. For the array, the block accessors get_array_values()
+ * and set_array_values() are measured as well, against the same reference
+ * element by element accesses.
+ *
+ * Usage: bench_vsl_types [-n passes]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <any>
+#include <chrono>
+#include "vsl/vsl_types.hpp"
+
+#define BENCH_DEFAULT_PASSES 100
+#define BENCH_ARRAY_DEPTH 65536
+
+using namespace vsl;
+
+static volatile double sink = 0.0;
+
+
+/******************************************************************************
+* Reference accessors (std::any cast and type switch at each access)
+******************************************************************************/
+class RefVar {
+public:
+    RefVar(std::any datap, VerilatedVarType vltype, VslType type) :
+        datap {datap}, vltype {vltype}, type {type} {};
+
+    double get_value() {
+        switch (type) {
+            case VSL_TYPE_SCALAR:
+            case VSL_TYPE_CLOCK:
+                switch (vltype) {
+                    case VLVT_UINT8: return get<uint8_t>();
+                    case VLVT_UINT16: return get<uint16_t>();
+                    case VLVT_UINT32: return get<uint32_t>();
+                    case VLVT_UINT64: return get<uint64_t>();
+                    case VLVT_REAL: return get<double>();
+                    default: return 0.0;
+                }
+            default:
+                return 0.0;
+        }
+    }
+
+    double get_array_value(size_t index) {
+        switch (type) {
+            case VSL_TYPE_ARRAY:
+                switch (vltype) {
+                    case VLVT_UINT8: return get_at<uint8_t>(index);
+                    case VLVT_UINT16: return get_at<uint16_t>(index);
+                    case VLVT_UINT32: return get_at<uint32_t>(index);
+                    case VLVT_UINT64: return get_at<uint64_t>(index);
+                    case VLVT_REAL: return get_at<double>(index);
+                    default: return 0.0;
+                }
+            default:
+                return 0.0;
+        }
+    }
+
+    int set_value(double value) {
+        switch (type) {
+            case VSL_TYPE_SCALAR:
+                switch (vltype) {
+                    case VLVT_UINT8: set<uint8_t>(value); return 0;
+                    case VLVT_UINT16: set<uint16_t>(value); return 0;
+                    case VLVT_UINT32: set<uint32_t>(value); return 0;
+                    case VLVT_UINT64: set<uint64_t>(value); return 0;
+                    case VLVT_REAL: set<double>(value); return 0;
+                    default: return -1;
+                }
+            default:
+                return -1;
+        }
+    }
+
+    int set_array_value(double value, size_t index) {
+        switch (type) {
+            case VSL_TYPE_ARRAY:
+                switch (vltype) {
+                    case VLVT_UINT8: set_at<uint8_t>(value, index); return 0;
+                    case VLVT_UINT16: set_at<uint16_t>(value, index); return 0;
+                    case VLVT_UINT32: set_at<uint32_t>(value, index); return 0;
+                    case VLVT_UINT64: set_at<uint64_t>(value, index); return 0;
+                    case VLVT_REAL: set_at<double>(value, index); return 0;
+                    default: return -1;
+                }
+            default:
+                return -1;
+        }
+    }
+
+private:
+    std::any datap;
+    VerilatedVarType vltype;
+    VslType type;
+
+    template <typename T> double get() {
+        return static_cast<double>(*std::any_cast<T*>(datap));
+    }
+    template <typename T> double get_at(size_t index) {
+        return static_cast<double>(std::any_cast<T*>(datap)[index]);
+    }
+    template <typename T> void set(double value) {
+        *std::any_cast<T*>(datap) = static_cast<T>(value);
+    }
+    template <typename T> void set_at(double value, size_t index) {
+        std::any_cast<T*>(datap)[index] = static_cast<T>(value);
+    }
+};
+
+
+/******************************************************************************
+* Measurements
+******************************************************************************/
+typedef std::chrono::steady_clock bench_clock;
+
+static double ns_per_access(bench_clock::time_point t0, size_t num_accesses)
+{
+    std::chrono::duration<double, std::nano> dt = bench_clock::now() - t0;
+    return dt.count() / static_cast<double>(num_accesses);
+}
+
+template <typename V>
+static void bench_scalar(V& var, size_t num, double* p_get, double* p_set)
+{
+    double acc = 0.0;
+    auto t0 = bench_clock::now();
+    for (size_t i = 0; i < num; i++) {
+        acc += var.get_value();
+    }
+    *p_get = ns_per_access(t0, num);
+    sink = acc;
+
+    t0 = bench_clock::now();
+    for (size_t i = 0; i < num; i++) {
+        var.set_value(static_cast<double>(i & 0xffu));
+    }
+    *p_set = ns_per_access(t0, num);
+}
+
+template <typename V>
+static void bench_array(V& var, size_t passes, double* p_get, double* p_set)
+{
+    double acc = 0.0;
+    auto t0 = bench_clock::now();
+    for (size_t n = 0; n < passes; n++) {
+        for (size_t i = 0; i < BENCH_ARRAY_DEPTH; i++) {
+            acc += var.get_array_value(i);
+        }
+    }
+    *p_get = ns_per_access(t0, passes * BENCH_ARRAY_DEPTH);
+    sink = acc;
+
+    t0 = bench_clock::now();
+    for (size_t n = 0; n < passes; n++) {
+        for (size_t i = 0; i < BENCH_ARRAY_DEPTH; i++) {
+            var.set_array_value(static_cast<double>(i & 0xffu), i);
+        }
+    }
+    *p_set = ns_per_access(t0, passes * BENCH_ARRAY_DEPTH);
+}
+
+static void bench_block(VslVar& var, size_t passes, double* p_get,
+    double* p_set)
+{
+    double* p_values = new double[BENCH_ARRAY_DEPTH];
+    double acc = 0.0;
+    auto t0 = bench_clock::now();
+    for (size_t n = 0; n < passes; n++) {
+        var.get_array_values(p_values, 0, BENCH_ARRAY_DEPTH);
+        acc += p_values[n % BENCH_ARRAY_DEPTH];
+    }
+    *p_get = ns_per_access(t0, passes * BENCH_ARRAY_DEPTH);
+    sink = acc;
+
+    for (size_t i = 0; i < BENCH_ARRAY_DEPTH; i++) {
+        p_values[i] = static_cast<double>(i & 0xffu);
+    }
+    t0 = bench_clock::now();
+    for (size_t n = 0; n < passes; n++) {
+        var.set_array_values(p_values, 0, BENCH_ARRAY_DEPTH);
+    }
+    *p_set = ns_per_access(t0, passes * BENCH_ARRAY_DEPTH);
+    delete[] p_values;
+}
+
+static void print_row(const char* name, double t_ref, double t_new)
+{
+    printf("%-24s %12.2f %12.2f %10.2fx\n", name, t_ref, t_new,
+        (t_new > 0.0) ? t_ref/t_new : 0.0);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t passes = BENCH_DEFAULT_PASSES;
+    double ref_get, ref_set, new_get, new_set;
+
+    for (int i = 1; i < argc; i++) {
+        if ((0 == strcmp(argv[i], "-n")) && (i + 1 < argc)) {
+            passes = strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "Usage: %s [-n passes]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (0 == passes) passes = 1;
+
+    uint32_t scalar_ref {0u};
+    uint32_t scalar_new {0u};
+    uint32_t* array_ref = new uint32_t[BENCH_ARRAY_DEPTH]();
+    uint32_t* array_new = new uint32_t[BENCH_ARRAY_DEPTH]();
+
+    RefVar ref_scalar {&scalar_ref, VLVT_UINT32, VSL_TYPE_SCALAR};
+    RefVar ref_array {array_ref, VLVT_UINT32, VSL_TYPE_ARRAY};
+    VslVar new_scalar {"scalar", &scalar_new, VLVT_UINT32, VSL_TYPE_SCALAR,
+        0, 32, 0};
+    VslVar new_array {"array", array_new, VLVT_UINT32, VSL_TYPE_ARRAY,
+        1, 32, BENCH_ARRAY_DEPTH};
+
+    printf("%-24s %12s %12s %11s\n", "Access (uint32)", "Before [ns]",
+        "After [ns]", "Speedup");
+
+    bench_scalar(ref_scalar, passes * BENCH_ARRAY_DEPTH, &ref_get, &ref_set);
+    bench_scalar(new_scalar, passes * BENCH_ARRAY_DEPTH, &new_get, &new_set);
+    print_row("scalar get_value", ref_get, new_get);
+    print_row("scalar set_value", ref_set, new_set);
+
+    bench_array(ref_array, passes, &ref_get, &ref_set);
+    bench_array(new_array, passes, &new_get, &new_set);
+    print_row("64K array get_value", ref_get, new_get);
+    print_row("64K array set_value", ref_set, new_set);
+
+    bench_block(new_array, passes, &new_get, &new_set);
+    print_row("64K array get_values", ref_get, new_get);
+    print_row("64K array set_values", ref_set, new_set);
+
+    delete[] array_ref;
+    delete[] array_new;
+    return 0;
+}
@@ -22,6 +22,16 @@
 ******************************************************************************/
 #include "test_vs_server.c"
 
+/******************************************************************************
+* Test suite - vs_index module
+******************************************************************************/
+#include "test_vs_index.c"
+
+/******************************************************************************
+* Test suite - vs_io module
+******************************************************************************/
+#include "test_vs_io.c"
+
 /******************************************************************************
 * Main
 ******************************************************************************/
@@ -96,6 +106,72 @@ int main(void)
         return CU_get_error();
     }
 
+    /* Add vs_index module test suite to registry */
+    pSuite = CU_add_suite("Test suite vs_index",
+        init_suite_vs_index, clean_suite_vs_index);
+    if (NULL == pSuite) {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* Add tests to suite*/
+    if (
+        (NULL == CU_add_test(pSuite,
+            "Tests adding paths to a hierarchy index",
+            test_vs_index_size)) ||
+        (NULL == CU_add_test(pSuite,
+            "Tests querying a hierarchy index with literal paths",
+            test_vs_index_match_literal)) ||
+        (NULL == CU_add_test(pSuite,
+            "Tests querying a hierarchy index with glob patterns",
+            test_vs_index_match_glob)) ||
+        (NULL == CU_add_test(pSuite,
+            "Tests querying a hierarchy index with recursive patterns",
+            test_vs_index_match_recursive)) ||
+        (NULL == CU_add_test(pSuite,
+            "Tests stopping a hierarchy index query",
+            test_vs_index_match_stop))
+    ) {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* Add vs_io module test suite to registry */
+    pSuite = CU_add_suite("Test suite vs_io",
+        init_suite_vs_io, clean_suite_vs_io);
+    if (NULL == pSuite) {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* Add tests to suite*/
+    if (
+        (NULL == CU_add_test(pSuite,
+            "Tests reading commands from an I/O thread",
+            test_vs_io_read)) ||
+        (NULL == CU_add_test(pSuite,
+            "Tests reading an invalid message from an I/O thread",
+            test_vs_io_read_invalid)) ||
+        (NULL == CU_add_test(pSuite,
+            "Tests writing messages through an I/O thread",
+            test_vs_io_write)) ||
+        (NULL == CU_add_test(pSuite,
+            "Tests setting the CPU affinity of an I/O thread",
+            test_vs_io_affinity)) ||
+        (NULL == CU_add_test(pSuite,
+            "Tests releasing an I/O thread in a forked process",
+            test_vs_io_release_forked)) ||
+        (NULL == CU_add_test(pSuite,
+            "Tests stopping an I/O thread during a partial message",
+            test_vs_io_stop_partial)) ||
+        (NULL == CU_add_test(pSuite,
+            "Tests closing the connection of an I/O thread",
+            test_vs_io_closed))
+    ) {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
 /******************************************************************************
  * Run test suites
 ******************************************************************************/
@@ -0,0 +1,134 @@
+/**
+ * @file test_vs_index.c
+ * @author jchabloz
+ * @brief Test suite for the verisocks vs_index module using CUnit
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ */
+#include <stdio.h>
+#include <string.h>
+#include <CUnit/Basic.h>
+#include <CUnit/Automated.h>
+#include "vs_index.h"
+
+
+/******************************************************************************
+* Test suite - vs_index module
+******************************************************************************/
+static vs_index_t *p_index = NULL;
+static char str_matches[1024];
+
+int init_suite_vs_index(void)
+{
+    char str_path[64];
+    p_index = vs_index_create();
+    if (NULL == p_index) return -1;
+    if ((0 > vs_index_add(p_index, "tb.dut.fsm.state", 1)) ||
+        (0 > vs_index_add(p_index, "tb.dut.ctl.state", 2)) ||
+        (0 > vs_index_add(p_index, "tb.dut.ctl.count", 3)) ||
+        (0 > vs_index_add(p_index, "tb.dut.mem[3]", 4)) ||
+        (0 > vs_index_add(p_index, "tb.clk", 5)))
+    {
+        return -1;
+    }
+    /* Enough entries to force the internal tables to grow */
+    for (int i = 0; i < 1000; i++) {
+        snprintf(str_path, sizeof(str_path), "tb.u%d.sig%d", i % 20, i);
+        if (0 > vs_index_add(p_index, str_path, 0)) return -1;
+    }
+    return 0;
+}
+
+int clean_suite_vs_index(void)
+{
+    vs_index_free(p_index);
+    return 0;
+}
+
+static int append_match(const char *str_path, int type, void *p_user)
+{
+    (void) type;
+    char *str = (char*) p_user;
+    if ('\0' != str[0]) strcat(str, " ");
+    strcat(str, str_path);
+    return 0;
+}
+
+static int count_match(const char *str_path, int type, void *p_user)
+{
+    (void) str_path;
+    (void) type;
+    (*(int*) p_user)++;
+    return 0;
+}
+
+static int stop_match(const char *str_path, int type, void *p_user)
+{
+    (void) str_path;
+    (void) type;
+    (void) p_user;
+    return 1;
+}
+
+static int query(const char *str_pattern)
+{
+    str_matches[0] = '\0';
+    return vs_index_match(p_index, str_pattern, append_match, str_matches);
+}
+
+void test_vs_index_size(void)
+{
+    CU_ASSERT_EQUAL(vs_index_size(p_index), 1005);
+    /* Adding an existing path does not create a new object */
+    CU_ASSERT_EQUAL(vs_index_add(p_index, "tb.clk", 6), 0);
+    CU_ASSERT_EQUAL(vs_index_size(p_index), 1005);
+    /* Invalid paths */
+    CU_ASSERT_EQUAL(vs_index_add(p_index, "tb..clk", 0), -1);
+    CU_ASSERT_EQUAL(vs_index_add(p_index, "tb.clk", VS_INDEX_SCOPE), -1);
+}
+
+void test_vs_index_match_literal(void)
+{
+    CU_ASSERT_EQUAL(query("tb.dut.ctl.count"), 1);
+    CU_ASSERT_STRING_EQUAL(str_matches, "tb.dut.ctl.count");
+    CU_ASSERT_EQUAL(query("tb.dut.mem[3]"), 1);
+    CU_ASSERT_STRING_EQUAL(str_matches, "tb.dut.mem[3]");
+    CU_ASSERT_EQUAL(query("tb.u7.sig987"), 1);
+    /* Scope-only nodes are not reported */
+    CU_ASSERT_EQUAL(query("tb.dut"), 0);
+    CU_ASSERT_EQUAL(query("tb.nothere"), 0);
+}
+
+void test_vs_index_match_glob(void)
+{
+    CU_ASSERT_EQUAL(query("tb.dut.*.state"), 2);
+    CU_ASSERT_STRING_EQUAL(str_matches, "tb.dut.fsm.state tb.dut.ctl.state");
+    CU_ASSERT_EQUAL(query("tb.dut.c?l.*"), 2);
+    CU_ASSERT_STRING_EQUAL(str_matches, "tb.dut.ctl.state tb.dut.ctl.count");
+    CU_ASSERT_EQUAL(query("tb.*"), 1);
+    CU_ASSERT_STRING_EQUAL(str_matches, "tb.clk");
+    CU_ASSERT_EQUAL(query("tb.u?9.sig99*"), 2);
+    CU_ASSERT_STRING_EQUAL(str_matches, "tb.u19.sig99 tb.u19.sig999");
+}
+
+void test_vs_index_match_recursive(void)
+{
+    CU_ASSERT_EQUAL(query("**.state"), 2);
+    CU_ASSERT_STRING_EQUAL(str_matches, "tb.dut.fsm.state tb.dut.ctl.state");
+    CU_ASSERT_EQUAL(query("tb.dut.**"), 4);
+    /* Objects are only reported once, even if matched several times */
+    CU_ASSERT_EQUAL(query("**.**.state"), 2);
+    CU_ASSERT_EQUAL(query("**.*.**.state"), 2);
+    int count = 0;
+    CU_ASSERT_EQUAL(vs_index_match(p_index, "**", count_match, &count), 1005);
+    CU_ASSERT_EQUAL(count, 1005);
+}
+
+void test_vs_index_match_stop(void)
+{
+    CU_ASSERT_EQUAL(vs_index_match(p_index, "**", stop_match, NULL), 1);
+    CU_ASSERT_EQUAL(vs_index_match(p_index, "tb..*", stop_match, NULL), -1);
+    CU_ASSERT_EQUAL(vs_index_is_pattern("tb.dut.*"), 1);
+    CU_ASSERT_EQUAL(vs_index_is_pattern("tb.dut.mem[3]"), 0);
+}
@@ -0,0 +1,213 @@
+/**
+ * @file test_vs_io.c
+ * @author jchabloz
+ * @brief Test suite for the verisocks vs_io module using CUnit
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <CUnit/Basic.h>
+#include <CUnit/Automated.h>
+#include "cJSON.h"
+#include "vs_msg.h"
+#include "vs_io.h"
+
+
+/******************************************************************************
+* Test suite - vs_io module
+******************************************************************************/
+static int fd_pair[2] = {-1, -1};
+static vs_io_t *p_io = NULL;
+
+int init_suite_vs_io(void)
+{
+    if (0 > socketpair(AF_UNIX, SOCK_STREAM, 0, fd_pair)) return -1;
+    p_io = vs_io_start(fd_pair[0]);
+    if (NULL == p_io) return -1;
+    return 0;
+}
+
+int clean_suite_vs_io(void)
+{
+    vs_io_stop(p_io);
+    if (0 <= fd_pair[0]) close(fd_pair[0]);
+    if (0 <= fd_pair[1]) close(fd_pair[1]);
+    return 0;
+}
+
+/* Sends a command from the client side of the socket pair (without parsing any
+ * JSON, as only the I/O thread is expected to do so) */
+static int client_send(const char *str_cmd, const char *str_cb,
+    const vs_uuid_t *p_uuid)
+{
+    int retval;
+    size_t len;
+    char *str_msg;
+    cJSON *p_obj = cJSON_CreateObject();
+    vs_msg_info_t msg_info = VS_MSG_INFO_INIT_JSON;
+    if (NULL == p_obj) return -1;
+    cJSON_AddStringToObject(p_obj, "command", str_cmd);
+    if (NULL != str_cb) cJSON_AddStringToObject(p_obj, "cb", str_cb);
+    if (NULL != p_uuid) vs_msg_copy_uuid(&msg_info, p_uuid);
+    str_msg = vs_msg_create_message(p_obj, &msg_info);
+    cJSON_Delete(p_obj);
+    if (NULL == str_msg) return -1;
+    len = vs_msg_read_header_length(str_msg) + msg_info.len + 2;
+    retval = (write(fd_pair[1], str_msg, len) == (ssize_t) len) ? 0 : -1;
+    cJSON_free(str_msg);
+    return retval;
+}
+
+void test_vs_io_read(void)
+{
+    vs_io_msg_t msg;
+    vs_uuid_t uuid = {1u, {0u}};
+    uuid.value[3] = 0x5a;
+
+    CU_ASSERT_EQUAL(client_send("info", NULL, &uuid), 0);
+    CU_ASSERT_EQUAL(client_send("run", "to_next", NULL), 0);
+
+    CU_ASSERT_EQUAL(vs_io_read(p_io, &msg), 0);
+    CU_ASSERT_EQUAL(msg.type, VS_IO_MSG_CMD);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(msg.p_cmd);
+    CU_ASSERT_STRING_EQUAL(cJSON_GetStringValue(
+        cJSON_GetObjectItem(msg.p_cmd, "command")), "info");
+    CU_ASSERT_EQUAL(msg.uuid.valid, 1u);
+    CU_ASSERT_EQUAL(msg.uuid.value[3], 0x5a);
+    cJSON_Delete(msg.p_cmd);
+
+    CU_ASSERT_EQUAL(vs_io_read(p_io, &msg), 0);
+    CU_ASSERT_EQUAL(msg.type, VS_IO_MSG_CMD);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(msg.p_cmd);
+    CU_ASSERT_STRING_EQUAL(cJSON_GetStringValue(
+        cJSON_GetObjectItem(msg.p_cmd, "cb")), "to_next");
+    CU_ASSERT_EQUAL(msg.uuid.valid, 0u);
+    cJSON_Delete(msg.p_cmd);
+
+    CU_ASSERT_EQUAL(vs_io_read(NULL, &msg), -1);
+}
+
+void test_vs_io_read_invalid(void)
+{
+    vs_io_msg_t msg;
+    char *str_msg;
+    size_t len;
+    vs_msg_info_t msg_info = VS_MSG_INFO_INIT_TXT;
+
+    /* Plain text content cannot be interpreted as a command */
+    str_msg = vs_msg_create_message("not a command", &msg_info);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(str_msg);
+    len = vs_msg_read_header_length(str_msg) + msg_info.len + 2;
+    CU_ASSERT_EQUAL(write(fd_pair[1], str_msg, len), (ssize_t) len);
+    cJSON_free(str_msg);
+    CU_ASSERT_EQUAL(vs_io_read(p_io, &msg), 0);
+    CU_ASSERT_EQUAL(msg.type, VS_IO_MSG_INVALID);
+    CU_ASSERT_PTR_NULL(msg.p_cmd);
+}
+
+void test_vs_io_write(void)
+{
+    int i;
+    int msg_len;
+    size_t len = 0;
+    char *p_buffer = NULL;
+    size_t buffer_size = 0;
+    char *str_msg;
+    cJSON *p_obj;
+    cJSON *p_rx;
+    vs_msg_info_t msg_info = VS_MSG_INFO_INIT_JSON;
+
+    CU_ASSERT_PTR_EQUAL(vs_io_find(fd_pair[0]), p_io);
+    CU_ASSERT_PTR_NULL(vs_io_find(fd_pair[1]));
+
+    /* More messages than the queue length, sent in order */
+    p_obj = cJSON_CreateObject();
+    cJSON_AddStringToObject(p_obj, "type", "result");
+    cJSON *p_value = cJSON_AddNumberToObject(p_obj, "value", 0);
+    for (i = 0; i < 3 * (int) VS_IO_QUEUE_LEN; i++) {
+        cJSON_SetNumberValue(p_value, i);
+        str_msg = vs_msg_create_message(p_obj, &msg_info);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(str_msg);
+        len = vs_msg_read_header_length(str_msg) + msg_info.len + 2;
+        CU_ASSERT_EQUAL(vs_io_write(p_io, str_msg, len), 0);
+        cJSON_free(str_msg);
+    }
+    cJSON_Delete(p_obj);
+
+    for (i = 0; i < 3 * (int) VS_IO_QUEUE_LEN; i++) {
+        msg_info.type = VS_MSG_UNDEFINED;
+        msg_len = vs_msg_read_alloc(fd_pair[1], &p_buffer, &buffer_size,
+            &msg_info);
+        CU_ASSERT_FATAL(msg_len > 0);
+        p_rx = vs_msg_read_json(p_buffer, &msg_info);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(p_rx);
+        CU_ASSERT_EQUAL(cJSON_GetNumberValue(
+            cJSON_GetObjectItem(p_rx, "value")), i);
+        cJSON_Delete(p_rx);
+    }
+    free(p_buffer);
+
+    CU_ASSERT_EQUAL(vs_io_write(p_io, NULL, len), -1);
+}
+
+void test_vs_io_affinity(void)
+{
+    CU_ASSERT_EQUAL(vs_io_set_affinity(p_io, 0), 0);
+    CU_ASSERT_EQUAL(vs_io_set_affinity(p_io, -1), -1);
+    CU_ASSERT_EQUAL(vs_io_set_affinity(NULL, 0), -1);
+}
+
+void test_vs_io_release_forked(void)
+{
+    int status;
+    pid_t pid;
+
+    /* The child process releases its copy of the I/O thread struct, while
+     * the I/O thread of the parent process keeps running */
+    pid = fork();
+    CU_ASSERT_FATAL(0 <= pid);
+    if (0 == pid) {
+        vs_io_release_forked(vs_io_find(fd_pair[0]));
+        _exit((NULL == vs_io_find(fd_pair[0])) ? 0 : 1);
+    }
+    CU_ASSERT_EQUAL(waitpid(pid, &status, 0), pid);
+    CU_ASSERT(WIFEXITED(status));
+    CU_ASSERT_EQUAL(WEXITSTATUS(status), 0);
+    CU_ASSERT_PTR_EQUAL(vs_io_find(fd_pair[0]), p_io);
+}
+
+void test_vs_io_stop_partial(void)
+{
+    int fds[2];
+    vs_io_t *p_io_partial;
+    const char partial[] = {0, 40, '{', '"', 't'};
+
+    /* An I/O thread blocked on a partially received message can be stopped */
+    CU_ASSERT_FATAL(0 <= socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+    p_io_partial = vs_io_start(fds[0]);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(p_io_partial);
+    CU_ASSERT_EQUAL(write(fds[1], partial, sizeof(partial)),
+        (ssize_t) sizeof(partial));
+    usleep(10000);
+    vs_io_stop(p_io_partial);
+    CU_ASSERT_PTR_NULL(vs_io_find(fds[0]));
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_vs_io_closed(void)
+{
+    vs_io_msg_t msg;
+
+    close(fd_pair[1]);
+    fd_pair[1] = -1;
+    CU_ASSERT_EQUAL(vs_io_read(p_io, &msg), 0);
+    CU_ASSERT_EQUAL(msg.type, VS_IO_MSG_CLOSED);
+    CU_ASSERT_PTR_NULL(msg.p_cmd);
+}
@@ -0,0 +1,660 @@
+/**
+ * @file vpi_mock.c
+ * @author jchabloz
+ * @brief Mock VPI layer (in-memory simulator model) using fff fakes
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ */
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
+#include "vpi_mock.h"
+
+DEFINE_FFF_GLOBALS
+
+DEFINE_FAKE_VALUE_FUNC(vpiHandle, vpi_handle_by_name, const char*, vpiHandle)
+DEFINE_FAKE_VALUE_FUNC(vpiHandle, vpi_iterate, PLI_INT32, vpiHandle)
+DEFINE_FAKE_VALUE_FUNC(vpiHandle, vpi_scan, vpiHandle)
+DEFINE_FAKE_VALUE_FUNC(PLI_INT32, vpi_free_object, vpiHandle)
+DEFINE_FAKE_VALUE_FUNC(PLI_INT32, vpi_get, PLI_INT32, vpiHandle)
+DEFINE_FAKE_VALUE_FUNC(char*, vpi_get_str, PLI_INT32, vpiHandle)
+DEFINE_FAKE_VOID_FUNC(vpi_get_time, vpiHandle, p_vpi_time)
+DEFINE_FAKE_VOID_FUNC(vpi_get_value, vpiHandle, p_vpi_value)
+DEFINE_FAKE_VALUE_FUNC(vpiHandle, vpi_put_value, vpiHandle, p_vpi_value,
+    p_vpi_time, PLI_INT32)
+DEFINE_FAKE_VALUE_FUNC(vpiHandle, vpi_register_cb, p_cb_data)
+DEFINE_FAKE_VALUE_FUNC(PLI_INT32, vpi_remove_cb, vpiHandle)
+DEFINE_FAKE_VALUE_FUNC(PLI_INT32, vpi_get_vlog_info, s_vpi_vlog_info*)
+DEFINE_FAKE_VALUE_FUNC_VARARG(PLI_INT32, vpi_control, PLI_INT32, ...)
+DEFINE_FAKE_VALUE_FUNC_VARARG(PLI_INT32, vpi_printf, const char*, ...)
+
+/******************************************************************************
+* In-memory model
+******************************************************************************/
+#define MOCK_MAX_OBJECTS 64
+#define MOCK_MAX_ITERATORS 16
+#define MOCK_MAX_NAME_LEN 64
+#define MOCK_TIME_UNIT -6           //1us
+#define MOCK_TIME_PRECISION -12     //1ps
+#define MOCK_CLK_HALF_PERIOD 495050u //1/fclk/2 in ps
+#define MOCK_NEXT_SIM_TIME UINT64_MAX
+
+typedef enum {
+    MOCK_OBJECT,
+    MOCK_ITERATOR,
+    MOCK_CALLBACK
+} mock_kind_t;
+
+/* All the handles returned by the mock layer point to this struct type, which
+ * is opaque for VPI applications. */
+struct __vpiHandle {
+    mock_kind_t kind;
+    int in_use;
+    /* Objects */
+    PLI_INT32 type;
+    PLI_INT32 size;
+    char str_name[MOCK_MAX_NAME_LEN];
+    char str_full_name[MOCK_MAX_NAME_LEN];
+    double value;
+    vpiHandle h_first;      //First object in scope
+    vpiHandle h_next;       //Next object in the same scope
+    /* Iterators */
+    PLI_INT32 iter_type;
+    vpiHandle h_iter_next;
+    /* Callbacks */
+    s_cb_data cb_data;
+    s_vpi_time cb_time;
+    s_vpi_value cb_value;
+};
+
+typedef struct mock_event {
+    int in_use;
+    uint64_t time;          //Due time (MOCK_NEXT_SIM_TIME for cbNextSimTime)
+    uint64_t seq;           //Registration order
+    vpiHandle h_cb;         //Callback, or NULL for a delayed value
+    vpiHandle h_obj;        //Object for a delayed value
+    double value;           //Delayed value
+} mock_event_t;
+
+static struct __vpiHandle mock_root;
+static struct __vpiHandle mock_objects[MOCK_MAX_OBJECTS];
+static struct __vpiHandle mock_iterators[MOCK_MAX_ITERATORS];
+static struct __vpiHandle mock_callbacks[VPI_MOCK_MAX_EVENTS];
+static mock_event_t mock_events[VPI_MOCK_MAX_EVENTS];
+static int mock_num_objects;
+static int mock_num_cb_slots;       //High-water mark of used callback slots
+static uint64_t mock_time;
+static uint64_t mock_seq;
+static uint64_t mock_clk_next;
+static char mock_printf_buffer[1024];
+
+static vpiHandle h_enable;
+static vpiHandle h_clk;
+static vpiHandle h_count;
+static vpiHandle h_count_memory;
+static vpiHandle h_mem_pointer;
+static vpiHandle h_counter_end;
+
+static vpiHandle mock_add(vpiHandle h_scope, const char *str_name,
+    PLI_INT32 type, PLI_INT32 size, double value)
+{
+    vpiHandle h_obj;
+    vpiHandle *p_last;
+
+    if (MOCK_MAX_OBJECTS <= mock_num_objects) return NULL;
+    h_obj = &mock_objects[mock_num_objects++];
+    memset(h_obj, 0, sizeof(struct __vpiHandle));
+    h_obj->kind = MOCK_OBJECT;
+    h_obj->in_use = 1;
+    h_obj->type = type;
+    h_obj->size = size;
+    h_obj->value = value;
+    snprintf(h_obj->str_name, MOCK_MAX_NAME_LEN, "%s", str_name);
+    if (MOCK_MAX_NAME_LEN <= snprintf(h_obj->str_full_name,
+        MOCK_MAX_NAME_LEN, "%s%s%s", h_scope->str_full_name,
+        (&mock_root == h_scope) ? "" : ".", str_name)) return NULL;
+
+    /* Append to scope, keeping the declaration order */
+    p_last = &h_scope->h_first;
+    while (NULL != *p_last) p_last = &(*p_last)->h_next;
+    *p_last = h_obj;
+    return h_obj;
+}
+
+static int mock_add_event(uint64_t time, vpiHandle h_cb, vpiHandle h_obj,
+    double value)
+{
+    int i;
+    for (i = 0; i < VPI_MOCK_MAX_EVENTS; i++) {
+        if (!mock_events[i].in_use) {
+            mock_events[i].in_use = 1;
+            mock_events[i].time = time;
+            mock_events[i].seq = mock_seq++;
+            mock_events[i].h_cb = h_cb;
+            mock_events[i].h_obj = h_obj;
+            mock_events[i].value = value;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static uint64_t mock_get_delay(p_vpi_time p_time)
+{
+    if (NULL == p_time) return 0u;
+    switch (p_time->type) {
+    case vpiSimTime:
+        return ((uint64_t) p_time->high << 32u) + (uint64_t) p_time->low;
+    case vpiScaledRealTime:
+        return (uint64_t) (p_time->real * 1e6 + 0.5);
+    default:
+        return 0u;
+    }
+}
+
+static void mock_fill_value(vpiHandle h_obj, p_vpi_value p_value)
+{
+    switch (p_value->format) {
+    case vpiObjTypeVal:
+        if ((vpiRealVar == h_obj->type) || (vpiParameter == h_obj->type)) {
+            p_value->format = vpiRealVal;
+            p_value->value.real = h_obj->value;
+        } else {
+            p_value->format = vpiIntVal;
+            p_value->value.integer = (PLI_INT32) (int64_t) h_obj->value;
+        }
+        break;
+    case vpiIntVal:
+        p_value->value.integer = (PLI_INT32) (int64_t) h_obj->value;
+        break;
+    case vpiScalarVal:
+        p_value->value.scalar = (0.0 != h_obj->value) ? vpi1 : vpi0;
+        break;
+    case vpiRealVal:
+        p_value->value.real = h_obj->value;
+        break;
+    default:
+        /* String and vector formats are not modelled */
+        p_value->format = vpiSuppressVal;
+        break;
+    }
+}
+
+static void mock_value_change(vpiHandle h_obj)
+{
+    int i;
+    vpiHandle h_cb;
+    for (i = 0; i < mock_num_cb_slots; i++) {
+        h_cb = &mock_callbacks[i];
+        if (!h_cb->in_use || (cbValueChange != h_cb->cb_data.reason) ||
+            (h_obj != h_cb->cb_data.obj)) continue;
+        h_cb->cb_time.type = vpiSimTime;
+        h_cb->cb_time.high = (PLI_UINT32) (mock_time >> 32u);
+        h_cb->cb_time.low = (PLI_UINT32) mock_time;
+        if (vpiSuppressVal != h_cb->cb_value.format) {
+            mock_fill_value(h_obj, &h_cb->cb_value);
+        }
+        h_cb->cb_data.cb_rtn(&h_cb->cb_data);
+    }
+}
+
+static void mock_apply_value(vpiHandle h_obj, double value)
+{
+    if (vpiNamedEvent == h_obj->type) {
+        mock_value_change(h_obj);
+        return;
+    }
+    if ((vpiReg == h_obj->type) || (vpiNet == h_obj->type) ||
+        (vpiMemoryWord == h_obj->type)) {
+        uint64_t mask = (h_obj->size < 64) ?
+            ((uint64_t) 1u << h_obj->size) - 1u : UINT64_MAX;
+        value = (double) ((uint64_t) (int64_t) value & mask);
+    }
+    if (h_obj->value == value) return;
+    h_obj->value = value;
+    mock_value_change(h_obj);
+}
+
+/* Behavioral model of the always blocks of test_0.v */
+static void mock_clk_edge(void)
+{
+    double count;
+    mock_apply_value(h_clk, (0.0 == h_clk->value) ? 1.0 : 0.0);
+    if ((0.0 == h_clk->value) || (0.0 == h_enable->value)) return;
+
+    count = h_count->value;
+    vpiHandle h_word = h_count_memory->h_first;
+    for (int i = 0; (i < (int) h_mem_pointer->value) && (NULL != h_word); i++)
+        h_word = h_word->h_next;
+    if (NULL != h_word) mock_apply_value(h_word, count);
+    mock_apply_value(h_mem_pointer, h_mem_pointer->value + 1.0);
+    mock_apply_value(h_count, count + 1.0);
+    if (255.0 == h_count->value) mock_apply_value(h_counter_end, 0.0);
+}
+
+/* Get the pending event due at the current time with the lowest sequence
+ * number, if any */
+static mock_event_t* mock_next_due_event(void)
+{
+    int i;
+    mock_event_t *p_event = NULL;
+    for (i = 0; i < VPI_MOCK_MAX_EVENTS; i++) {
+        if (!mock_events[i].in_use || (mock_events[i].time > mock_time))
+            continue;
+        if ((NULL == p_event) || (mock_events[i].seq < p_event->seq))
+            p_event = &mock_events[i];
+    }
+    return p_event;
+}
+
+/* Get the pending cbNextSimTime callback registered before seq_limit with the
+ * lowest sequence number, if any */
+static mock_event_t* mock_next_sim_time_event(uint64_t seq_limit)
+{
+    int i;
+    mock_event_t *p_event = NULL;
+    for (i = 0; i < VPI_MOCK_MAX_EVENTS; i++) {
+        if (!mock_events[i].in_use ||
+            (MOCK_NEXT_SIM_TIME != mock_events[i].time) ||
+            (mock_events[i].seq >= seq_limit)) continue;
+        if ((NULL == p_event) || (mock_events[i].seq < p_event->seq))
+            p_event = &mock_events[i];
+    }
+    return p_event;
+}
+
+static void mock_process_event(mock_event_t *p_event)
+{
+    vpiHandle h_cb = p_event->h_cb;
+    p_event->in_use = 0;
+    if (NULL == h_cb) {
+        mock_apply_value(p_event->h_obj, p_event->value);
+        return;
+    }
+    if (!h_cb->in_use) return;
+    /* One-shot callback, released before calling it so that it can register
+     * a new one */
+    h_cb->in_use = 0;
+    h_cb->cb_time.type = vpiSimTime;
+    h_cb->cb_time.high = (PLI_UINT32) (mock_time >> 32u);
+    h_cb->cb_time.low = (PLI_UINT32) mock_time;
+    h_cb->cb_data.cb_rtn(&h_cb->cb_data);
+}
+
+/******************************************************************************
+* Custom fakes
+******************************************************************************/
+static vpiHandle mock_handle_by_name(const char *name, vpiHandle scope)
+{
+    int i;
+    char str_full_name[2*MOCK_MAX_NAME_LEN];
+    if (NULL == name) return NULL;
+    if (NULL != scope) {
+        snprintf(str_full_name, sizeof(str_full_name), "%s.%s",
+            scope->str_full_name, name);
+        name = str_full_name;
+    }
+    for (i = 0; i < mock_num_objects; i++) {
+        if (strcmp(mock_objects[i].str_full_name, name) == 0)
+            return &mock_objects[i];
+    }
+    return NULL;
+}
+
+static int mock_iter_match(PLI_INT32 iter_type, vpiHandle h_obj)
+{
+    if (vpiInternalScope == iter_type) return (vpiModule == h_obj->type);
+    return (iter_type == h_obj->type);
+}
+
+static vpiHandle mock_iter_from(PLI_INT32 iter_type, vpiHandle h_obj)
+{
+    while ((NULL != h_obj) && !mock_iter_match(iter_type, h_obj))
+        h_obj = h_obj->h_next;
+    return h_obj;
+}
+
+static vpiHandle mock_iterate(PLI_INT32 type, vpiHandle refHandle)
+{
+    int i;
+    vpiHandle h_first;
+    vpiHandle h_scope = (NULL == refHandle) ? &mock_root : refHandle;
+    if (MOCK_OBJECT != h_scope->kind) return NULL;
+
+    /* As per the standard, NULL is returned if there is nothing to iterate */
+    h_first = mock_iter_from(type, h_scope->h_first);
+    if (NULL == h_first) return NULL;
+    for (i = 0; i < MOCK_MAX_ITERATORS; i++) {
+        if (!mock_iterators[i].in_use) {
+            mock_iterators[i].in_use = 1;
+            mock_iterators[i].kind = MOCK_ITERATOR;
+            mock_iterators[i].iter_type = type;
+            mock_iterators[i].h_iter_next = h_first;
+            return &mock_iterators[i];
+        }
+    }
+    return NULL;
+}
+
+static vpiHandle mock_scan(vpiHandle iterator)
+{
+    vpiHandle h_obj;
+    if ((NULL == iterator) || (MOCK_ITERATOR != iterator->kind) ||
+        !iterator->in_use) return NULL;
+    h_obj = iterator->h_iter_next;
+    if (NULL == h_obj) {
+        /* Iterator is freed once exhausted */
+        iterator->in_use = 0;
+        return NULL;
+    }
+    iterator->h_iter_next = mock_iter_from(iterator->iter_type, h_obj->h_next);
+    return h_obj;
+}
+
+static PLI_INT32 mock_free_object(vpiHandle object)
+{
+    /* Freeing a callback handle does not remove the callback */
+    if ((NULL != object) && (MOCK_ITERATOR == object->kind))
+        object->in_use = 0;
+    return 1;
+}
+
+static PLI_INT32 mock_get(PLI_INT32 property, vpiHandle object)
+{
+    switch (property) {
+    case vpiTimeUnit:
+        return MOCK_TIME_UNIT;
+    case vpiTimePrecision:
+        return MOCK_TIME_PRECISION;
+    case vpiType:
+        if (NULL == object) return vpiUndefined;
+        if (MOCK_ITERATOR == object->kind) return vpiIterator;
+        return object->type;
+    case vpiSize:
+        if ((NULL == object) || (MOCK_OBJECT != object->kind))
+            return vpiUndefined;
+        return object->size;
+    default:
+        return vpiUndefined;
+    }
+}
+
+static char* mock_get_str(PLI_INT32 property, vpiHandle object)
+{
+    if ((NULL == object) || (MOCK_OBJECT != object->kind)) return NULL;
+    switch (property) {
+    case vpiName:
+        return object->str_name;
+    case vpiFullName:
+        return object->str_full_name;
+    default:
+        return NULL;
+    }
+}
+
+static void mock_get_time(vpiHandle object, p_vpi_time time_p)
+{
+    (void) object;
+    switch (time_p->type) {
+    case vpiSimTime:
+        time_p->high = (PLI_UINT32) (mock_time >> 32u);
+        time_p->low = (PLI_UINT32) mock_time;
+        break;
+    case vpiScaledRealTime:
+        time_p->real = (double) mock_time * 1e-6;
+        break;
+    default:
+        break;
+    }
+}
+
+static void mock_get_value(vpiHandle expr, p_vpi_value value_p)
+{
+    if ((NULL == expr) || (MOCK_OBJECT != expr->kind) || (NULL == value_p))
+        return;
+    mock_fill_value(expr, value_p);
+}
+
+static vpiHandle mock_put_value(vpiHandle object, p_vpi_value value_p,
+    p_vpi_time time_p, PLI_INT32 flags)
+{
+    double value = 0.0;
+    uint64_t delay;
+    if ((NULL == object) || (MOCK_OBJECT != object->kind)) return NULL;
+    if (NULL != value_p) {
+        switch (value_p->format) {
+        case vpiIntVal:
+            value = (double) value_p->value.integer;
+            break;
+        case vpiScalarVal:
+            value = (vpi1 == value_p->value.scalar) ? 1.0 : 0.0;
+            break;
+        case vpiRealVal:
+            value = value_p->value.real;
+            break;
+        default:
+            return NULL;
+        }
+    }
+    delay = ((flags & ~vpiReturnEvent) == vpiNoDelay) ?
+        0u : mock_get_delay(time_p);
+    if ((0u == delay) ||
+        (0 > mock_add_event(mock_time + delay, NULL, object, value))) {
+        mock_apply_value(object, value);
+    }
+    return NULL;
+}
+
+static vpiHandle mock_register_cb(p_cb_data cb_data_p)
+{
+    int i;
+    vpiHandle h_cb = NULL;
+    uint64_t time;
+
+    if ((NULL == cb_data_p) || (NULL == cb_data_p->cb_rtn)) return NULL;
+    if ((cbValueChange == cb_data_p->reason) && (NULL == cb_data_p->obj))
+        return NULL;
+    for (i = 0; i < VPI_MOCK_MAX_EVENTS; i++) {
+        if (!mock_callbacks[i].in_use) {
+            h_cb = &mock_callbacks[i];
+            break;
+        }
+    }
+    if (NULL == h_cb) return NULL;
+    if (i >= mock_num_cb_slots) mock_num_cb_slots = i + 1;
+
+    memset(h_cb, 0, sizeof(struct __vpiHandle));
+    h_cb->kind = MOCK_CALLBACK;
+    h_cb->in_use = 1;
+    h_cb->cb_data = *cb_data_p;
+    h_cb->cb_time.type = vpiSimTime;
+    if (NULL != cb_data_p->time) h_cb->cb_time = *cb_data_p->time;
+    h_cb->cb_value.format = vpiSuppressVal;
+    if (NULL != cb_data_p->value) h_cb->cb_value = *cb_data_p->value;
+    h_cb->cb_data.time = &h_cb->cb_time;
+    h_cb->cb_data.value = &h_cb->cb_value;
+
+    switch (cb_data_p->reason) {
+    case cbAfterDelay:
+        time = mock_time + mock_get_delay(cb_data_p->time);
+        break;
+    case cbNextSimTime:
+        time = MOCK_NEXT_SIM_TIME;
+        break;
+    case cbReadWriteSynch:
+    case cbReadOnlySynch:
+        time = mock_time;
+        break;
+    default:
+        /* Value change and simulation phase callbacks */
+        return h_cb;
+    }
+    if (0 > mock_add_event(time, h_cb, NULL, 0.0)) {
+        h_cb->in_use = 0;
+        return NULL;
+    }
+    return h_cb;
+}
+
+static PLI_INT32 mock_remove_cb(vpiHandle cb_obj)
+{
+    int i;
+    if ((NULL == cb_obj) || (MOCK_CALLBACK != cb_obj->kind) ||
+        !cb_obj->in_use) return 0;
+    cb_obj->in_use = 0;
+    for (i = 0; i < VPI_MOCK_MAX_EVENTS; i++) {
+        if (mock_events[i].in_use && (cb_obj == mock_events[i].h_cb))
+            mock_events[i].in_use = 0;
+    }
+    return 1;
+}
+
+static PLI_INT32 mock_get_vlog_info(s_vpi_vlog_info *vlog_info_p)
+{
+    static char str_product[] = "Verisocks VPI mock";
+    static char str_version[] = "0.1";
+    vlog_info_p->argc = 0;
+    vlog_info_p->argv = NULL;
+    vlog_info_p->product = str_product;
+    vlog_info_p->version = str_version;
+    return 1;
+}
+
+static PLI_INT32 mock_control(PLI_INT32 operation, va_list ap)
+{
+    (void) operation;
+    (void) ap;
+    return 1;
+}
+
+static PLI_INT32 mock_printf(const char *format, va_list ap)
+{
+    /* Messages are formatted (as a simulator would) but discarded */
+    return vsnprintf(mock_printf_buffer, sizeof(mock_printf_buffer), format,
+        ap);
+}
+
+/******************************************************************************
+* Public functions
+******************************************************************************/
+int vpi_mock_init(void)
+{
+    int i;
+    char str_word[MOCK_MAX_NAME_LEN];
+    vpiHandle h_main;
+
+    RESET_FAKE(vpi_handle_by_name);
+    RESET_FAKE(vpi_iterate);
+    RESET_FAKE(vpi_scan);
+    RESET_FAKE(vpi_free_object);
+    RESET_FAKE(vpi_get);
+    RESET_FAKE(vpi_get_str);
+    RESET_FAKE(vpi_get_time);
+    RESET_FAKE(vpi_get_value);
+    RESET_FAKE(vpi_put_value);
+    RESET_FAKE(vpi_register_cb);
+    RESET_FAKE(vpi_remove_cb);
+    RESET_FAKE(vpi_get_vlog_info);
+    RESET_FAKE(vpi_control);
+    RESET_FAKE(vpi_printf);
+    FFF_RESET_HISTORY();
+
+    vpi_handle_by_name_fake.custom_fake = mock_handle_by_name;
+    vpi_iterate_fake.custom_fake = mock_iterate;
+    vpi_scan_fake.custom_fake = mock_scan;
+    vpi_free_object_fake.custom_fake = mock_free_object;
+    vpi_get_fake.custom_fake = mock_get;
+    vpi_get_str_fake.custom_fake = mock_get_str;
+    vpi_get_time_fake.custom_fake = mock_get_time;
+    vpi_get_value_fake.custom_fake = mock_get_value;
+    vpi_put_value_fake.custom_fake = mock_put_value;
+    vpi_register_cb_fake.custom_fake = mock_register_cb;
+    vpi_remove_cb_fake.custom_fake = mock_remove_cb;
+    vpi_get_vlog_info_fake.custom_fake = mock_get_vlog_info;
+    vpi_control_fake.custom_fake = mock_control;
+    vpi_printf_fake.custom_fake = mock_printf;
+
+    memset(&mock_root, 0, sizeof(mock_root));
+    memset(mock_iterators, 0, sizeof(mock_iterators));
+    memset(mock_callbacks, 0, sizeof(mock_callbacks));
+    memset(mock_events, 0, sizeof(mock_events));
+    mock_root.kind = MOCK_OBJECT;
+    mock_num_objects = 0;
+    mock_num_cb_slots = 0;
+    mock_time = 0u;
+    mock_seq = 0u;
+    mock_clk_next = MOCK_CLK_HALF_PERIOD;
+
+    h_main = mock_add(&mock_root, "main", vpiModule, vpiUndefined, 0.0);
+    if (NULL == h_main) return -1;
+    mock_add(h_main, "int_param", vpiParameter, 32, 598402.0);
+    mock_add(h_main, "fclk", vpiParameter, 64, 1.01);
+    h_enable = mock_add(h_main, "enable", vpiReg, 1, 1.0);
+    h_clk = mock_add(h_main, "clk", vpiReg, 1, 0.0);
+    h_count = mock_add(h_main, "count", vpiReg, 8, 0.0);
+    h_count_memory = mock_add(h_main, "count_memory", vpiMemory, 16, 0.0);
+    h_mem_pointer = mock_add(h_main, "mem_pointer", vpiReg, 4, 0.0);
+    h_counter_end = mock_add(h_main, "counter_end", vpiNamedEvent, 0, 0.0);
+    if ((NULL == h_enable) || (NULL == h_clk) || (NULL == h_count) ||
+        (NULL == h_count_memory) || (NULL == h_mem_pointer) ||
+        (NULL == h_counter_end)) return -1;
+    for (i = 0; i < 16; i++) {
+        snprintf(str_word, sizeof(str_word), "count_memory[%d]", i);
+        if (NULL == mock_add(h_count_memory, str_word, vpiMemoryWord, 8, 0.0))
+            return -1;
+    }
+    return 0;
+}
+
+int vpi_mock_step(void)
+{
+    int i;
+    uint64_t time_next = mock_clk_next;
+    mock_event_t *p_event;
+
+    /* Events already due (e.g. read-write synchronization callbacks) are
+     * processed without advancing time */
+    if (NULL == mock_next_due_event()) {
+        for (i = 0; i < VPI_MOCK_MAX_EVENTS; i++) {
+            if (mock_events[i].in_use &&
+                (MOCK_NEXT_SIM_TIME != mock_events[i].time) &&
+                (mock_events[i].time < time_next))
+                time_next = mock_events[i].time;
+        }
+        mock_time = time_next;
+
+        /* Next simulation time callbacks registered before this time step
+         * are called first */
+        uint64_t seq_limit = mock_seq;
+        while (NULL != (p_event = mock_next_sim_time_event(seq_limit))) {
+            mock_process_event(p_event);
+        }
+        if (mock_time == mock_clk_next) {
+            mock_clk_next += MOCK_CLK_HALF_PERIOD;
+            mock_clk_edge();
+        }
+    }
+    while (NULL != (p_event = mock_next_due_event())) {
+        mock_process_event(p_event);
+    }
+    return 0;
+}
+
+uint64_t vpi_mock_get_time(void)
+{
+    return mock_time;
+}
+
+int vpi_mock_num_cbs(void)
+{
+    int i;
+    int num_cbs = 0;
+    for (i = 0; i < mock_num_cb_slots; i++) {
+        if (mock_callbacks[i].in_use) num_cbs++;
+    }
+    return num_cbs;
+}
+
+//EOF
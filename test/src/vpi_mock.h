@@ -0,0 +1,85 @@
+/**
+ * @file vpi_mock.h
+ * @author jchabloz
+ * @brief Mock VPI layer (in-memory simulator model) using fff fakes
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * The VPI functions used by the Verisocks command handlers are replaced by
+ * fff fakes. Their custom fakes implement a small in-memory object table
+ * mirroring the test bench python/test/test_0.v (timescale 1us/1ps), so that
+ * the command handlers can be exercised without any simulator.
+ *
+ * The model contains the module main with the objects enable, clk,
+ * count[7:0], count_memory[0:15], mem_pointer[3:0], counter_end (named event)
+ * and the parameters int_param and fclk. Time only advances when calling
+ * vpi_mock_step(), which processes the next pending callback, delayed value
+ * or clock edge.
+ */
+#ifndef VPI_MOCK_H
+#define VPI_MOCK_H
+
+#include <stdint.h>
+#include <string.h>
+#include "vpi_config.h"
+#include "fff.h"
+
+/**
+ * @brief Maximum number of callbacks and delayed values pending at once
+ */
+#define VPI_MOCK_MAX_EVENTS 1024
+
+DECLARE_FAKE_VALUE_FUNC(vpiHandle, vpi_handle_by_name, const char*, vpiHandle)
+DECLARE_FAKE_VALUE_FUNC(vpiHandle, vpi_iterate, PLI_INT32, vpiHandle)
+DECLARE_FAKE_VALUE_FUNC(vpiHandle, vpi_scan, vpiHandle)
+DECLARE_FAKE_VALUE_FUNC(PLI_INT32, vpi_free_object, vpiHandle)
+DECLARE_FAKE_VALUE_FUNC(PLI_INT32, vpi_get, PLI_INT32, vpiHandle)
+DECLARE_FAKE_VALUE_FUNC(char*, vpi_get_str, PLI_INT32, vpiHandle)
+DECLARE_FAKE_VOID_FUNC(vpi_get_time, vpiHandle, p_vpi_time)
+DECLARE_FAKE_VOID_FUNC(vpi_get_value, vpiHandle, p_vpi_value)
+DECLARE_FAKE_VALUE_FUNC(vpiHandle, vpi_put_value, vpiHandle, p_vpi_value,
+    p_vpi_time, PLI_INT32)
+DECLARE_FAKE_VALUE_FUNC(vpiHandle, vpi_register_cb, p_cb_data)
+DECLARE_FAKE_VALUE_FUNC(PLI_INT32, vpi_remove_cb, vpiHandle)
+DECLARE_FAKE_VALUE_FUNC(PLI_INT32, vpi_get_vlog_info, s_vpi_vlog_info*)
+DECLARE_FAKE_VALUE_FUNC_VARARG(PLI_INT32, vpi_control, PLI_INT32, ...)
+DECLARE_FAKE_VALUE_FUNC_VARARG(PLI_INT32, vpi_printf, const char*, ...)
+
+/**
+ * @brief Reset all the fakes and (re-)build the in-memory model
+ *
+ * The simulation time is reset to 0, all the callbacks and delayed values are
+ * discarded and the objects are set to their initial values (enable is 1).
+ *
+ * @return Returns 0 if successful, -1 in case of error
+ */
+int vpi_mock_init(void);
+
+/**
+ * @brief Advance the simulation to the next pending event
+ *
+ * Pending events are registered callbacks (cbAfterDelay, cbNextSimTime,
+ * cbReadWriteSynch, cbReadOnlySynch), values put with a delay and the edges
+ * of main.clk. All the events due at the same time are processed in the
+ * order in which they have been registered.
+ *
+ * @return Returns 0 if successful, -1 in case of error
+ */
+int vpi_mock_step(void);
+
+/**
+ * @brief Get the current simulation time
+ *
+ * @return Simulation time in simulation precision units (ps)
+ */
+uint64_t vpi_mock_get_time(void);
+
+/**
+ * @brief Get the number of registered callbacks
+ *
+ * @return Number of registered callbacks (including value change callbacks)
+ */
+int vpi_mock_num_cbs(void);
+
+#endif //VPI_MOCK_H
+//EOF